@@ -285,6 +285,23 @@ protected:
   /// Split @p BB to create a new one we can use to clone @p BB in.
   BasicBlock *splitBB(BasicBlock *BB);
 
+  /// Leave the generated code if the exit condition of the dynamic-exit loop
+  /// holds after the copy of its latch statement @p Stmt.
+  ///
+  /// The condition is evaluated at the current insert point, which must be the
+  /// end of the copy of @p Stmt. The block of the insert point is terminated
+  /// by a branch to the exiting block of the optimized region or to a new
+  /// block, which is returned.
+  ///
+  /// @param Stmt  The latch statement of the dynamic-exit loop.
+  /// @param LTS   A map from old loops to new induction variables as SCEVs.
+  /// @param BBMap A mapping from old values to their new values in this block.
+  ///
+  /// @returns The block the generated code continues in if the loop is not
+  ///          left.
+  BasicBlock *generateDynamicExit(ScopStmt &Stmt, LoopToScevMapT &LTS,
+                                  ValueMapT &BBMap);
+
   /// Copy the given basic block.
   ///
   /// @param Stmt      The statement to code generate.
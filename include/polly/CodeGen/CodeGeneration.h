@@ -17,10 +17,15 @@
 namespace llvm {
 
 class BasicBlock;
+class DominatorTree;
+class LoopInfo;
+class RegionInfo;
+class ScalarEvolution;
 } // namespace llvm
 
 namespace polly {
 
+class IslAstInfo;
 class Scop;
 
 enum VectorizerChoice {
@@ -30,12 +35,23 @@ enum VectorizerChoice {
 };
 extern VectorizerChoice PollyVectorizerChoice;
 
+/// Return the vectorizer choice for the SCoP currently processed, i.e.
+/// PollyVectorizerChoice unless an optimization profile overrides it.
+VectorizerChoice getVectorizerChoice();
+
 /// Mark a basic block unreachable.
 ///
 /// Marks the basic block @p Block unreachable by equipping it with an
 /// UnreachableInst.
 void markBlockUnreachable(BasicBlock &Block, PollyIRBuilder &Builder);
 
+/// Generate LLVM-IR for the SCoP @p S from its AST @p AI and update the
+/// analyses for the new code.
+///
+/// @return Whether the IR was changed.
+bool generateCode(Scop &S, IslAstInfo &AI, LoopInfo &LI, DominatorTree &DT,
+                  ScalarEvolution &SE, RegionInfo &RI);
+
 struct CodeGenerationPass : public PassInfoMixin<CodeGenerationPass> {
   PreservedAnalyses run(Scop &S, ScopAnalysisManager &SAM,
                         ScopStandardAnalysisResults &AR, SPMUpdater &U);
@@ -23,7 +23,9 @@
 
 #include "polly/Config/config.h"
 #include "polly/ScopPass.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/PassManager.h"
 #include "isl/ast.h"
 #include "isl/ctx.h"
@@ -49,6 +51,7 @@ namespace polly {
 struct Dependences;
 class MemoryAccess;
 class Scop;
+class ScopArrayInfo;
 
 class IslAst {
 public:
@@ -118,6 +121,9 @@ public:
     /// Flag to mark parallel loops which break reductions.
     bool IsReductionParallel = false;
 
+    /// Flag to mark loops the user requested to be executed in parallel.
+    bool IsUserParallel = false;
+
     /// The minimal dependence distance for non parallel loops.
     isl::pw_aff MinimalDependenceDistance;
 
@@ -126,6 +132,10 @@ public:
 
     /// Set of accesses which break reduction dependences.
     MemoryAccessSet BrokenReductions;
+
+    /// Arrays that need a private copy per iteration for the loop to be
+    /// parallel.
+    SmallVector<const ScopArrayInfo *, 4> PrivatizedArrays;
   };
 
 private:
@@ -172,6 +182,9 @@ public:
   /// Is this loop a reduction parallel loop?
   static bool isReductionParallel(__isl_keep isl_ast_node *Node);
 
+  /// Did the user request this loop to be executed in parallel?
+  static bool isUserParallel(__isl_keep isl_ast_node *Node);
+
   /// Will the loop be run as thread parallel?
   static bool isExecutedInParallel(__isl_keep isl_ast_node *Node);
 
@@ -188,6 +201,10 @@ public:
   /// Get the nodes build context or a nullptr if not available.
   static __isl_give isl_ast_build *getBuild(__isl_keep isl_ast_node *Node);
 
+  /// Get the arrays that must be privatized to execute the loop in parallel.
+  static ArrayRef<const ScopArrayInfo *>
+  getPrivatizedArrays(__isl_keep isl_ast_node *Node);
+
   ///}
 };
 
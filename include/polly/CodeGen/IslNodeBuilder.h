@@ -38,6 +38,7 @@ class BasicBlock;
 class DataLayout;
 class DominatorTree;
 class Function;
+class GlobalVariable;
 class Instruction;
 class Loop;
 class LoopInfo;
@@ -51,7 +52,9 @@ namespace polly {
 
 struct InvariantEquivClassTy;
 class MemoryAccess;
+class PerfMonitor;
 class Scop;
+class ScopArrayInfo;
 class ScopStmt;
 } // namespace polly
 
@@ -153,6 +156,9 @@ public:
     return ParallelSubfunctions;
   }
 
+  /// Measure the parallel loops that are generated with @p Monitor.
+  void setPerfMonitor(PerfMonitor *Monitor) { this->Monitor = Monitor; }
+
 protected:
   Scop &S;
   PollyIRBuilder &Builder;
@@ -184,6 +190,9 @@ protected:
   DominatorTree &DT;
   BasicBlock *StartBlock;
 
+  /// The performance monitor of the scop, if run-time monitoring is enabled.
+  PerfMonitor *Monitor = nullptr;
+
   /// The current iteration of out-of-scop loops
   ///
   /// This map provides for a given loop a llvm::Value that contains the current
@@ -455,6 +464,21 @@ private:
   /// track of the induction variable.
   /// See [Code generation of induction variables of loops outside Scops]
   Value *materializeNonScopLoopInductionVariable(const Loop *L);
+
+  /// Create a heap array whose buffer is reused by later executions of the
+  /// SCoP in the same thread.
+  ///
+  /// The buffer is taken from a thread-local slot at the start of the SCoP
+  /// and put back at its exit. Only the first execution in each thread (or a
+  /// nested one) allocates memory.
+  ///
+  /// @param SAI             The array to create.
+  /// @param StartExitBlocks The start and exit block of the generated code.
+  /// @param Size            The size of the array in bytes.
+  ///
+  /// @return The thread-local slot of the buffer.
+  GlobalVariable *createReusedHeapArray(ScopArrayInfo *SAI,
+                                        BBPair StartExitBlocks, uint64_t Size);
 };
 
 #endif // POLLY_ISLNODEBUILDER_H
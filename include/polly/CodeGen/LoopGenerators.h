@@ -27,6 +27,7 @@ class BasicBlock;
 
 namespace polly {
 using namespace llvm;
+class PerfMonitor;
 
 /// Create a scalar do/for-style loop.
 ///
@@ -104,12 +105,16 @@ Value *createLoop(Value *LowerBound, Value *UpperBound, Value *Stride,
 class ParallelLoopGenerator {
 public:
   /// Create a parallel loop generator for the current function.
+  ///
+  /// If @p Monitor is given, the parallel regions are measured with it.
   ParallelLoopGenerator(PollyIRBuilder &Builder, LoopInfo &LI,
-                        DominatorTree &DT, const DataLayout &DL)
+                        DominatorTree &DT, const DataLayout &DL,
+                        PerfMonitor *Monitor = nullptr)
       : Builder(Builder), LI(LI), DT(DT),
         LongType(
             Type::getIntNTy(Builder.getContext(), DL.getPointerSizeInBits())),
-        M(Builder.GetInsertBlock()->getParent()->getParent()) {}
+        M(Builder.GetInsertBlock()->getParent()->getParent()),
+        Monitor(Monitor) {}
 
   /// Create a parallel loop.
   ///
@@ -148,6 +153,9 @@ private:
   /// The current module
   Module *M;
 
+  /// The performance monitor of the scop, if any.
+  PerfMonitor *Monitor;
+
 public:
   /// The functions below can be used if one does not want to generate a
   /// specific OpenMP parallel loop, but generate individual parts of it
@@ -18,7 +18,10 @@
 enum GPUArch { NVPTX64, SPIR32, SPIR64 };
 
 /// The GPU Runtime implementation to use.
-enum GPURuntime { CUDA, OpenCL };
+///
+/// The host runtime emulates the CUDA runtime on the CPU, such that the data
+/// movement of the generated code can be tested without a GPU.
+enum GPURuntime { CUDA, OpenCL, Host };
 
 namespace polly {
 extern bool PollyManagedMemory;
@@ -45,6 +45,20 @@ public:
   /// @param InsertBefore The instruction before which the timing region starts.
   void insertRegionEnd(llvm::Instruction *InsertBefore);
 
+  /// Measure a parallel region of the scop.
+  ///
+  /// The cycles from spawning to joining the threads, the cycles the master
+  /// thread spends executing loop iterations and the number of executions of
+  /// the region are added to the counters of the scop. The difference of the
+  /// former two is the fork/join overhead (including load imbalance) the
+  /// master thread observes.
+  ///
+  /// @param Spawn The runtime call that spawns the worker threads.
+  /// @param Work  The call of the subfunction by the master thread.
+  /// @param Join  The runtime call that joins the worker threads.
+  void insertParallelRegion(llvm::Instruction *Spawn, llvm::Instruction *Work,
+                            llvm::Instruction *Join);
+
 private:
   llvm::Module *M;
   PollyIRBuilder Builder;
@@ -64,6 +78,18 @@ private:
   /// The total number of times the current scop S is executed.
   llvm::Value *TripCountForCurrentScopPtr;
 
+  /// The total number of cycles spent in parallel regions of the current
+  /// scop S.
+  llvm::Value *CyclesInParallelRegionsPtr;
+
+  /// The total number of cycles the master thread spent executing the loop
+  /// iterations of parallel regions of the current scop S.
+  llvm::Value *CyclesOfParallelWorkPtr;
+
+  /// The total number of times parallel regions of the current scop S are
+  /// executed.
+  llvm::Value *ParallelRegionCountPtr;
+
   /// The total number of cycles spent within scops.
   llvm::Value *CyclesInScopsPtr;
 
@@ -0,0 +1,46 @@
+//===- ConcurrentScopOptimizer.h --------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Run the Polly pipeline on all SCoPs of a function at once, computing the
+// dependences, the schedules and the ASTs of different SCoPs on a thread pool.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef POLLY_CONCURRENTSCOPOPTIMIZER_H
+#define POLLY_CONCURRENTSCOPOPTIMIZER_H
+
+namespace llvm {
+class Pass;
+class PassRegistry;
+void initializeConcurrentScopOptimizerPass(PassRegistry &);
+} // namespace llvm
+
+namespace polly {
+
+/// The passes of the SCoP pipeline that the concurrent SCoP optimizer runs.
+struct ConcurrentScopPasses {
+  bool Simplify = true;
+  bool ForwardOpTree = true;
+  bool DeLICM = true;
+  bool PruneUnprofitable = true;
+  bool ScheduleOptimizer = true;
+};
+
+/// Create a pass that optimizes and generates code for all SCoPs of a
+/// function.
+///
+/// The SCoPs are built and simplified one after another, as these steps query
+/// ScalarEvolution. Their dependences, schedules and ASTs only use the isl_ctx
+/// of each SCoP and are computed concurrently. LLVM-IR is generated for one
+/// SCoP after another again; a SCoP that uses values of a SCoP that was
+/// already code generated is rebuilt and optimized anew at this point.
+llvm::Pass *
+createConcurrentScopOptimizerPass(ConcurrentScopPasses Passes = {});
+} // namespace polly
+
+#endif // POLLY_CONCURRENTSCOPOPTIMIZER_H
@@ -17,17 +17,33 @@
 #ifndef POLLY_DELICM_H
 #define POLLY_DELICM_H
 
+#include "polly/ScopPass.h"
 #include "polly/Support/GICHelper.h"
 
 namespace llvm {
+class LoopInfo;
 class PassRegistry;
 class Pass;
 } // namespace llvm
 
 namespace polly {
+class Scop;
+
 /// Create a new DeLICM pass instance.
 llvm::Pass *createDeLICMPass();
 
+/// Collapse the scalars of the SCoP @p S to unused array elements as the
+/// DeLICM pass does, outside of a pass manager.
+///
+/// @return Whether @p S was modified.
+bool runDeLICM(Scop &S, llvm::LoopInfo &LI);
+
+/// The DeLICM pass for the new pass manager.
+struct DeLICMPass : public llvm::PassInfoMixin<DeLICMPass> {
+  llvm::PreservedAnalyses run(Scop &S, ScopAnalysisManager &SAM,
+                              ScopStandardAnalysisResults &AR, SPMUpdater &U);
+};
+
 /// Determine whether two lifetimes are conflicting.
 ///
 /// Used by unittesting.
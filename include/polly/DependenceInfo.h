@@ -137,6 +137,19 @@ struct Dependences {
   ///         dependences.
   bool isValidSchedule(Scop &S, const StatementToIslMapTy &NewSchedules) const;
 
+  /// Check if a new schedule tree is valid.
+  ///
+  /// The statement schedules of a schedule tree may differ in their number of
+  /// dimensions. They are padded with zeros before checking them against the
+  /// dependences.
+  ///
+  /// @param S             The current SCoP.
+  /// @param NewSchedule   The new schedule tree.
+  ///
+  /// @return True if the new schedule is valid, false if it reverses
+  ///         dependences.
+  bool isValidSchedule(Scop &S, isl::schedule NewSchedule) const;
+
   /// Print the stored dependence information.
   void print(llvm::raw_ostream &OS) const;
 
@@ -154,6 +167,8 @@ struct Dependences {
   friend struct DependenceInfoPrinterPass;
   friend class DependenceInfo;
   friend class DependenceInfoWrapperPass;
+  friend std::unique_ptr<Dependences> computeDependences(Scop &S,
+                                                         AnalysisLevel Level);
 
   /// Destructor that will free internal objects.
   ~Dependences() { releaseMemory(); }
@@ -200,6 +215,11 @@ private:
   const AnalysisLevel Level;
 };
 
+/// Compute the dependences of the SCoP @p S at the granularity @p Level,
+/// outside of a pass manager.
+std::unique_ptr<Dependences> computeDependences(Scop &S,
+                                                Dependences::AnalysisLevel Level);
+
 struct DependenceAnalysis : public AnalysisInfoMixin<DependenceAnalysis> {
   static AnalysisKey Key;
   struct Result {
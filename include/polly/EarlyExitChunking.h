@@ -0,0 +1,51 @@
+//===- EarlyExitChunking.h --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Evaluate the exit conditions of early-exit loops, such as searches, in
+// chunks of iterations without early exits.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef POLLY_EARLYEXITCHUNKING_H
+#define POLLY_EARLYEXITCHUNKING_H
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+class Pass;
+class PassRegistry;
+void initializeEarlyExitChunkingPass(PassRegistry &);
+} // namespace llvm
+
+namespace polly {
+
+/// Create a pass that evaluates the early exits of loops in chunks.
+///
+/// A loop qualifies if its latch leaves it after an affine number of
+/// iterations, it has further exits under data-dependent conditions, and all
+/// of its instructions can be executed speculatively within its affine bound.
+/// Its iterations are split into chunks, and for one chunk after another a
+/// loop without early exits computes the first iteration of the chunk whose
+/// exit conditions hold, which the loop vectorizer can vectorize. The original
+/// loop is then resumed at this iteration, or at the start of the last chunk.
+///
+/// The loads of a chunk are executed for all of its iterations, even those
+/// after the loop would have left. Hence the affine bound is further limited
+/// to the iterations for which every load is known to access dereferenceable
+/// and aligned memory, and loops whose loads are not known to be
+/// dereferenceable for a whole chunk are not transformed.
+llvm::Pass *createEarlyExitChunkingPass();
+
+struct EarlyExitChunkingPass
+    : public llvm::PassInfoMixin<EarlyExitChunkingPass> {
+  llvm::PreservedAnalyses run(llvm::Function &F,
+                              llvm::FunctionAnalysisManager &FAM);
+};
+} // namespace polly
+
+#endif // POLLY_EARLYEXITCHUNKING_H
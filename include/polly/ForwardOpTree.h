@@ -13,8 +13,11 @@
 #ifndef POLLY_FORWARDOPTREE_H
 #define POLLY_FORWARDOPTREE_H
 
+#include "polly/ScopPass.h"
+
 namespace llvm {
 
+class LoopInfo;
 class PassRegistry;
 
 void initializeForwardOpTreePass(PassRegistry &);
@@ -22,9 +25,22 @@ void initializeForwardOpTreePass(PassRegistry &);
 
 namespace polly {
 
+class Scop;
 class ScopPass;
 
 ScopPass *createForwardOpTreePass();
+
+/// Forward the operand trees of the SCoP @p S as the ForwardOpTree pass does,
+/// outside of a pass manager.
+///
+/// @return Whether @p S was modified.
+bool runForwardOpTree(Scop &S, llvm::LoopInfo &LI);
+
+/// The ForwardOpTree pass for the new pass manager.
+struct ForwardOpTreePass : public llvm::PassInfoMixin<ForwardOpTreePass> {
+  llvm::PreservedAnalyses run(Scop &S, ScopAnalysisManager &SAM,
+                              ScopStandardAnalysisResults &AR, SPMUpdater &U);
+};
 } // namespace polly
 
 #endif // POLLY_FORWARDOPTREE_H
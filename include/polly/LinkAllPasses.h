@@ -15,7 +15,9 @@
 #define POLLY_LINKALLPASSES_H
 
 #include "polly/CodeGen/PPCGCodeGeneration.h"
+#include "polly/ConcurrentScopOptimizer.h"
 #include "polly/Config/config.h"
+#include "polly/EarlyExitChunking.h"
 #include "polly/PruneUnprofitable.h"
 #include "polly/Simplify.h"
 #include "polly/Support/DumpModulePass.h"
@@ -61,6 +63,8 @@ llvm::Pass *createIslScheduleOptimizerPass();
 llvm::Pass *createFlattenSchedulePass();
 llvm::Pass *createDeLICMPass();
 llvm::Pass *createMaximalStaticExpansionPass();
+llvm::Pass *createAoSToSoAPass();
+llvm::Pass *createArrayTranspositionPass();
 
 extern char &CodePreparationID;
 } // namespace polly
@@ -96,11 +100,15 @@ struct PollyForcePassLinking {
 #endif
     polly::createIslScheduleOptimizerPass();
     polly::createMaximalStaticExpansionPass();
+    polly::createAoSToSoAPass();
+    polly::createArrayTranspositionPass();
     polly::createFlattenSchedulePass();
     polly::createDeLICMPass();
     polly::createDumpModulePass("", true);
     polly::createSimplifyPass();
     polly::createPruneUnprofitablePass();
+    polly::createConcurrentScopOptimizerPass();
+    polly::createEarlyExitChunkingPass();
   }
 } PollyForcePassLinking; // Force link by creating a global definition.
 } // namespace
@@ -121,6 +129,8 @@ void initializeManagedMemoryRewritePassPass(llvm::PassRegistry &);
 #endif
 void initializeIslScheduleOptimizerPass(llvm::PassRegistry &);
 void initializeMaximalStaticExpanderPass(llvm::PassRegistry &);
+void initializeAoSToSoAPass(llvm::PassRegistry &);
+void initializeArrayTranspositionPass(llvm::PassRegistry &);
 void initializePollyCanonicalizePass(llvm::PassRegistry &);
 void initializeFlattenSchedulePass(llvm::PassRegistry &);
 void initializeDeLICMPass(llvm::PassRegistry &);
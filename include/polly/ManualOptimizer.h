@@ -0,0 +1,46 @@
+//===------ ManualOptimizer.h -----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Handle pragma/metadata-directed transformations.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef POLLY_MANUALOPTIMIZER_H
+#define POLLY_MANUALOPTIMIZER_H
+
+#include "isl/isl-noexceptions.h"
+
+namespace llvm {
+class OptimizationRemarkEmitter;
+} // namespace llvm
+
+namespace polly {
+class Scop;
+struct Dependences;
+
+/// Apply loop-transformation metadata.
+///
+/// The loop metadata are taken from the "Loop with Metadata" mark nodes in
+/// @p Sched, inserted by Scop::buildSchedule for loops that carry
+/// '#pragma clang loop' transformation directives. Every transformation is
+/// checked against the dependences @p D; transformations that would violate
+/// them are not applied and a warning is emitted through @p ORE instead.
+///
+/// @param S     The SCoP @p Sched belongs to.
+/// @param Sched The schedule tree to transform.
+/// @param D     The dependences of @p S.
+/// @param ORE   Emitter for remarks and warnings about the directives.
+///
+/// @return The transformed schedule if at least one directive was applied,
+///         nullptr otherwise.
+isl::schedule applyManualTransformations(Scop *S, isl::schedule Sched,
+                                         const Dependences &D,
+                                         llvm::OptimizationRemarkEmitter *ORE);
+} // namespace polly
+
+#endif /* POLLY_MANUALOPTIMIZER_H */
@@ -13,6 +13,8 @@
 #ifndef POLLY_PRUNEUNPROFITABLE_H
 #define POLLY_PRUNEUNPROFITABLE_H
 
+#include "polly/ScopPass.h"
+
 namespace llvm {
 
 class Pass;
@@ -23,7 +25,22 @@ void initializePruneUnprofitablePass(PassRegistry &);
 
 namespace polly {
 
+class Scop;
+
 llvm::Pass *createPruneUnprofitablePass();
+
+/// Invalidate the SCoP @p S if it is unprofitable, as the PruneUnprofitable
+/// pass does, outside of a pass manager.
+///
+/// @return Whether @p S was invalidated.
+bool runPruneUnprofitable(Scop &S);
+
+/// The PruneUnprofitable pass for the new pass manager.
+struct PruneUnprofitablePass
+    : public llvm::PassInfoMixin<PruneUnprofitablePass> {
+  llvm::PreservedAnalyses run(Scop &S, ScopAnalysisManager &SAM,
+                              ScopStandardAnalysisResults &AR, SPMUpdater &U);
+};
 } // namespace polly
 
 #endif // POLLY_PRUNEUNPROFITABLE_H
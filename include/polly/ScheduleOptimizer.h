@@ -9,8 +9,11 @@
 #ifndef POLLY_SCHEDULEOPTIMIZER_H
 #define POLLY_SCHEDULEOPTIMIZER_H
 
+#include "polly/ScopPass.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 #include "isl/isl-noexceptions.h"
+#include <mutex>
 
 namespace llvm {
 
@@ -47,10 +50,11 @@ class Scop;
 /// Additional parameters of the schedule optimizer.
 ///
 /// Target Transform Info and the SCoP dependencies used by the schedule
-/// optimizer.
+/// optimizer, and the lock of the state shared with other SCoPs, if any.
 struct OptimizerAdditionalInfoTy {
   const llvm::TargetTransformInfo *TTI;
   const Dependences *D;
+  std::mutex *SharedStateLock;
 };
 
 /// Parameters of the matrix multiplication operands.
@@ -68,6 +72,31 @@ struct MatMulInfoTy {
 };
 
 extern bool DisablePollyTiling;
+
+/// Optimize the schedule of the SCoP @p S as the IslScheduleOptimizer pass
+/// does, outside of a pass manager.
+///
+/// @param GetDeps         Return the statement-level dependences of @p S. It
+///                        is not called for SCoPs that are not rescheduled.
+/// @param TTI             The target information for the tiling and the
+///                        optimization of matrix multiplications.
+/// @param SharedStateLock If not null, held while the state shared with other
+///                        SCoPs of the function (ScalarEvolution, the
+///                        LLVMContext and the output streams) is used, such
+///                        that the SCoPs can be optimized by several threads.
+///
+/// @return Whether a new schedule was set.
+bool runIslScheduleOptimizer(Scop &S,
+                             llvm::function_ref<const Dependences &()> GetDeps,
+                             const llvm::TargetTransformInfo *TTI,
+                             std::mutex *SharedStateLock = nullptr);
+
+/// The IslScheduleOptimizer pass for the new pass manager.
+struct IslScheduleOptimizerPass
+    : public llvm::PassInfoMixin<IslScheduleOptimizerPass> {
+  llvm::PreservedAnalyses run(Scop &S, ScopAnalysisManager &SAM,
+                              ScopStandardAnalysisResults &AR, SPMUpdater &U);
+};
 } // namespace polly
 
 class ScheduleTreeOptimizer {
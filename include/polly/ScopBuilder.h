@@ -19,6 +19,7 @@
 #include "polly/ScopInfo.h"
 #include "polly/Support/ScopHelper.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallVector.h"
 #include <algorithm>
@@ -29,6 +30,7 @@ namespace llvm {
 
 class AssumptionCache;
 class BasicBlock;
+class CallInst;
 class DataLayout;
 class DominatorTree;
 class Instruction;
@@ -48,6 +50,7 @@ void initializeScopInfoWrapperPassPass(PassRegistry &);
 namespace polly {
 
 class ScopDetection;
+struct FunctionAccessSummary;
 
 /// Command line switch whether to model read-only accesses.
 extern bool ModelReadOnlyScalars;
@@ -75,9 +78,31 @@ class ScopBuilder {
   /// Set of instructions that might read any memory location.
   SmallVector<std::pair<ScopStmt *, Instruction *>, 16> GlobalReads;
 
+  /// Calls with unknown side effects, kept as opaque statements.
+  SmallVector<std::pair<ScopStmt *, CallInst *>, 4> BookkeepingCalls;
+
   /// Set of all accessed array base pointers.
   SmallSetVector<Value *, 16> ArrayBasePointers;
 
+  /// The elements accessed by a call, as given by the callee's summary.
+  struct SummarizedAccess {
+    /// The call that accesses the elements.
+    CallInst *Call;
+
+    /// The number of the pointer argument the elements are relative to.
+    unsigned ArgNo;
+
+    /// The accessed elements (see FunctionAccessSummary).
+    StringRef Elements;
+
+    /// The size of the accessed elements in bytes.
+    unsigned ElementSize;
+  };
+
+  /// Accesses of calls to summarized functions, whose access relation is
+  /// restricted to the summarized elements after all arrays are known.
+  DenseMap<MemoryAccess *, SummarizedAccess> SummarizedAccesses;
+
   // The Scop
   std::unique_ptr<Scop> scop;
 
@@ -178,6 +203,23 @@ class ScopBuilder {
   /// @returns True if the access could be built, False otherwise.
   bool buildAccessCallInst(MemAccInst Inst, ScopStmt *Stmt);
 
+  /// Build the MemoryAccesses of a call modeled by the callee's summary.
+  ///
+  /// @param CI      The call instruction.
+  /// @param Summary The access summary of the called function.
+  /// @param Stmt    The parent statement of the call.
+  void buildAccessSummarizedCall(CallInst *CI,
+                                 const FunctionAccessSummary &Summary,
+                                 ScopStmt *Stmt);
+
+  /// Restrict the accesses of summarized calls to the summarized elements.
+  ///
+  /// The access relations are one-dimensional in bytes, like the access
+  /// relations of other single-dimensional accesses before
+  /// Scop::updateAccessDimensionality(). Accesses to arrays that are
+  /// multi-dimensional keep accessing the whole array.
+  void applyAccessSummaries();
+
   /// Build a single-dimensional parametric sized MemoryAccess
   ///        from the Load/Store instruction.
   ///
@@ -292,12 +334,16 @@ class ScopBuilder {
   /// @param Sizes       The array dimension's sizes.
   /// @param AccessValue Value read or written.
   ///
+  /// @return The created MemoryAccess.
+  ///
   /// @see MemoryKind
-  void addArrayAccess(ScopStmt *Stmt, MemAccInst MemAccInst,
-                      MemoryAccess::AccessType AccType, Value *BaseAddress,
-                      Type *ElemType, bool IsAffine,
-                      ArrayRef<const SCEV *> Subscripts,
-                      ArrayRef<const SCEV *> Sizes, Value *AccessValue);
+  MemoryAccess *addArrayAccess(ScopStmt *Stmt, MemAccInst MemAccInst,
+                               MemoryAccess::AccessType AccType,
+                               Value *BaseAddress, Type *ElemType,
+                               bool IsAffine,
+                               ArrayRef<const SCEV *> Subscripts,
+                               ArrayRef<const SCEV *> Sizes,
+                               Value *AccessValue);
 
   /// Create a MemoryAccess for writing an llvm::Instruction.
   ///
@@ -47,9 +47,11 @@
 #define POLLY_SCOPDETECTION_H
 
 #include "polly/ScopDetectionDiagnostic.h"
+#include "polly/ScopSummary.h"
 #include "polly/Support/ScopHelper.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/AliasAnalysis.h"
@@ -92,6 +94,7 @@ void initializeScopDetectionWrapperPassPass(PassRegistry &);
 } // namespace llvm
 
 namespace polly {
+struct FunctionAccessSummary;
 
 using ParamSetType = std::set<const SCEV *>;
 
@@ -183,6 +186,10 @@ public:
     /// The set of loops contained in non-affine regions.
     BoxedLoopsSetTy BoxedLoopsSet;
 
+    /// The loop forming the region whose exit condition is only evaluated at
+    /// run time, if any.
+    Loop *DynamicExitLoop = nullptr;
+
     /// Loads that need to be invariant during execution.
     InvariantLoadsSetTy RequiredILS;
 
@@ -190,6 +197,13 @@ public:
     ///        instructions.
     MapInsnToMemAcc InsnToMemAcc;
 
+    /// Calls that are modeled by the access summary of the callee.
+    SmallPtrSet<const CallInst *, 4> SummarizedCalls;
+
+    /// Calls with unknown side effects between the loop nests of the region
+    /// that are kept as opaque statements.
+    SmallPtrSet<const CallInst *, 4> BookkeepingCalls;
+
     /// Initialize a DetectionContext from scratch.
     DetectionContext(Region &R, AliasAnalysis &AA, bool Verify)
         : CurRegion(R), AST(AA), Verifying(Verify), Log(&R) {}
@@ -204,7 +218,10 @@ public:
           hasStores(DC.hasStores), HasUnknownAccess(DC.HasUnknownAccess),
           NonAffineSubRegionSet(std::move(DC.NonAffineSubRegionSet)),
           BoxedLoopsSet(std::move(DC.BoxedLoopsSet)),
-          RequiredILS(std::move(DC.RequiredILS)) {
+          DynamicExitLoop(DC.DynamicExitLoop),
+          RequiredILS(std::move(DC.RequiredILS)),
+          SummarizedCalls(std::move(DC.SummarizedCalls)),
+          BookkeepingCalls(std::move(DC.BookkeepingCalls)) {
       AST.add(DC.AST);
     }
   };
@@ -231,6 +248,9 @@ private:
   using DetectionContextMapTy = DenseMap<BBPair, DetectionContext>;
   mutable DetectionContextMapTy DetectionContextMap;
 
+  /// The access summaries of the functions called in this function.
+  mutable FunctionAccessSummaries Summaries;
+
   /// Remove cached results for @p R.
   void removeCachedResults(const Region &R);
 
@@ -380,6 +400,36 @@ private:
   /// @return True if the call instruction is valid, false otherwise.
   bool isValidCallInst(CallInst &CI, DetectionContext &Context) const;
 
+  /// Check if a call to a function with an access summary can be modeled.
+  ///
+  /// The pointer arguments accessed by the callee must be affine offsets of
+  /// invariant base pointers and the integer arguments the summary depends on
+  /// must be affine.
+  ///
+  /// @param CI      The call instruction to check.
+  /// @param Summary The access summary of the called function.
+  /// @param Context The current detection context.
+  ///
+  /// @return True if the call can be modeled by its summary, false otherwise.
+  bool isValidSummarizedCall(CallInst &CI,
+                             const FunctionAccessSummary &Summary,
+                             DetectionContext &Context) const;
+
+  /// Check if a call with unknown side effects can be kept as an opaque
+  /// statement.
+  ///
+  /// Such bookkeeping calls (e.g. debug counters or progress output between
+  /// two loop nests) must not be contained in a loop of the region, must not
+  /// unwind and must return exactly once, i.e. the callee must be known to
+  /// return (willreturn). ScopBuilder models them by accesses to all arrays
+  /// of the SCoP the call may access.
+  ///
+  /// @param CI      The call instruction to check.
+  /// @param Context The current detection context.
+  ///
+  /// @return True if the call can be kept as an opaque statement.
+  bool isValidBookkeepingCall(CallInst &CI, DetectionContext &Context) const;
+
   /// Check if the given loads could be invariant and can be hoisted.
   ///
   /// If true is returned the loads are added to the required invariant loads
@@ -522,6 +572,29 @@ private:
   /// @return True if ISL can compute the trip count of the loop.
   bool canUseISLTripCount(Loop *L, DetectionContext &Context) const;
 
+  /// Is the trip count of a loop bounded by an affine exit condition?
+  ///
+  /// This is the case if the latch of @p L leaves the loop under an affine
+  /// condition, even if other blocks leave it under data-dependent ones.
+  ///
+  /// @param L The loop to check.
+  /// @param Context The context of scop detection.
+  ///
+  /// @return True if the latch of @p L has a valid affine exit condition.
+  bool hasAffineLoopBound(const Loop *L, DetectionContext &Context) const;
+
+  /// Can the exit condition of a loop be evaluated at run time?
+  ///
+  /// This is the case if @p L only leaves at its latch and forms the whole
+  /// region, such that no statement outside of @p L depends on how many
+  /// iterations it executes.
+  ///
+  /// @param L The loop to check.
+  /// @param Context The context of scop detection.
+  ///
+  /// @return True if @p L can be modeled with a dynamic exit.
+  bool isDynamicExitLoop(Loop *L, DetectionContext &Context) const;
+
   /// Print the locations of all detected scops.
   void printLocations(Function &F);
 
@@ -544,9 +617,15 @@ private:
                       Args &&... Arguments) const;
 
 public:
+  /// Detect the SCoPs of @p F.
+  ///
+  /// @param IgnoreProfitability Also detect the SCoPs that are not considered
+  ///                            profitable, as -polly-process-unprofitable
+  ///                            does.
   ScopDetection(Function &F, const DominatorTree &DT, ScalarEvolution &SE,
                 LoopInfo &LI, RegionInfo &RI, AliasAnalysis &AA,
-                OptimizationRemarkEmitter &ORE);
+                OptimizationRemarkEmitter &ORE,
+                bool IgnoreProfitability = false);
 
   /// Get the RegionInfo stored in this pass.
   ///
@@ -568,6 +647,16 @@ public:
   /// Return the detection context for @p R, nullptr if @p R was invalid.
   DetectionContext *getDetectionContext(const Region *R) const;
 
+  /// Return the access summary of @p F, a function called in this function.
+  ///
+  /// @return The summary of @p F, or nullptr if @p F cannot be summarized.
+  const FunctionAccessSummary *getFunctionAccessSummary(Function &F) const {
+    return Summaries.get(F);
+  }
+
+  /// Are SCoPs kept even if they are not considered profitable?
+  bool processesUnprofitable() const { return ProcessUnprofitable; }
+
   /// Return the set of rejection causes for @p R.
   const RejectLog *lookupRejectionLog(const Region *R) const;
 
@@ -631,6 +720,9 @@ public:
 private:
   /// OptimizationRemarkEmitter object used to emit diagnostic remarks
   OptimizationRemarkEmitter &ORE;
+
+  /// Whether SCoPs are kept even if they are not considered profitable.
+  bool ProcessUnprofitable;
 };
 
 struct ScopAnalysis : public AnalysisInfoMixin<ScopAnalysis> {
@@ -640,7 +732,14 @@ struct ScopAnalysis : public AnalysisInfoMixin<ScopAnalysis> {
 
   ScopAnalysis();
 
+  /// @param IgnoreProfitability Also detect the SCoPs that are not considered
+  ///                            profitable.
+  explicit ScopAnalysis(bool IgnoreProfitability);
+
   Result run(Function &F, FunctionAnalysisManager &FAM);
+
+private:
+  bool IgnoreProfitability = false;
 };
 
 struct ScopAnalysisPrinterPass : public PassInfoMixin<ScopAnalysisPrinterPass> {
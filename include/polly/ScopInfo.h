@@ -955,6 +955,10 @@ public:
   /// the dimension of the innermost loop containing the statement.
   isl::set getStride(isl::map Schedule) const;
 
+  /// Get the stride of the accesses described by @p AccessRelation in the
+  /// specified Schedule, e.g. to evaluate a different data layout.
+  static isl::set getStride(isl::map AccessRelation, isl::map Schedule);
+
   /// Get the FortranArrayDescriptor corresponding to this memory access if
   /// it exists, and nullptr otherwise.
   Value *getFortranArrayDescriptor() const { return this->FAD; }
@@ -1631,6 +1635,14 @@ public:
   /// Align the parameters in the statement to the scop context
   void realignParams();
 
+  /// Reduce the memory taken by this statement and its accesses.
+  ///
+  /// @see Scop::compact()
+  void compact();
+
+  /// Return the number of bytes taken by the lookup tables of this statement.
+  size_t getLookupTableBytes() const;
+
   /// Print the ScopStmt.
   ///
   /// @param OS                The output stream the ScopStmt is printed to.
@@ -1663,6 +1675,34 @@ public:
 /// Print ScopStmt S to raw_ostream OS.
 raw_ostream &operator<<(raw_ostream &OS, const ScopStmt &S);
 
+/// The memory taken by the representation of a SCoP.
+struct ScopMemoryUsage {
+  /// Bytes of the Scop, ScopStmt, MemoryAccess and ScopArrayInfo objects.
+  size_t ObjectBytes = 0;
+
+  /// Bytes of the tables that map LLVM-IR to statements and accesses.
+  size_t LookupTableBytes = 0;
+
+  /// Bytes of the constraints, matrices and tableaus of the SCoP's isl_ctx.
+  /// These are only known if the isl_ctx allocates them from an arena, and
+  /// include those of other objects of the isl_ctx, e.g. the dependences.
+  size_t IslBytes = 0;
+
+  unsigned NumStmts = 0;
+  unsigned NumAccesses = 0;
+
+  /// The number of access relations, original and new, and the number of
+  /// distinct isl_maps among them.
+  unsigned NumAccessRelations = 0;
+  unsigned NumDistinctAccessRelations = 0;
+
+  size_t getTotalBytes() const {
+    return ObjectBytes + LookupTableBytes + IslBytes;
+  }
+
+  void print(raw_ostream &OS) const;
+};
+
 /// Static Control Part
 ///
 /// A Scop is the polyhedral representation of a control flow region detected
@@ -1772,6 +1812,11 @@ private:
   /// A map from instructions to SCoP statements.
   DenseMap<Instruction *, ScopStmt *> InstStmtMap;
 
+  /// Calls with unknown side effects that are kept as opaque statements.
+  ///
+  /// Their statements must not be removed and must keep their relative order.
+  SmallVector<Instruction *, 4> BookkeepingCalls;
+
   /// A map from basic blocks to their domains.
   DenseMap<BasicBlock *, isl::set> DomainMap;
 
@@ -2792,6 +2837,19 @@ public:
     return InstStmtMap.lookup(Inst);
   }
 
+  /// Record @p Call as a call with unknown side effects.
+  void addBookkeepingCall(Instruction *Call) {
+    BookkeepingCalls.push_back(Call);
+  }
+
+  /// Does @p Stmt contain a call with unknown side effects?
+  bool hasBookkeepingCall(const ScopStmt &Stmt) const {
+    for (Instruction *Call : BookkeepingCalls)
+      if (getStmtFor(Call) == &Stmt)
+        return true;
+    return false;
+  }
+
   /// Return the number of statements in the SCoP.
   size_t getSize() const { return Stmts.size(); }
 
@@ -2832,6 +2890,23 @@ public:
   /// Return the set of boxed (thus overapproximated) loops.
   const BoxedLoopsSetTy &getBoxedLoops() const { return DC.BoxedLoopsSet; }
 
+  /// Return the loop whose exit condition is evaluated at run time, or nullptr.
+  ///
+  /// Such a loop forms the whole SCoP. Its iteration domain is only bounded by
+  /// getDynamicExitLoopBound().
+  Loop *getDynamicExitLoop() const { return DC.DynamicExitLoop; }
+
+  /// Return the statement evaluating the exit condition of the dynamic-exit
+  /// loop, or nullptr if there is none.
+  ///
+  /// This is the last statement of the loop's latch. It depends on all
+  /// statements of its iteration and all statements of later iterations
+  /// depend on it.
+  ScopStmt *getDynamicExitStmt() const;
+
+  /// Return the largest iteration number of a dynamic-exit loop.
+  isl::val getDynamicExitLoopBound() const;
+
   /// Return true if and only if @p R is a non-affine subregion.
   bool isNonAffineSubRegion(const Region *R) {
     return DC.NonAffineSubRegionSet.count(R);
@@ -3026,6 +3101,18 @@ public:
   /// @return true if @p Schedule contains extension nodes.
   static bool containsExtensionNode(isl::schedule Schedule);
 
+  /// Reduce the memory taken by the representation of this SCoP.
+  ///
+  /// Drop the invalid domains of statements and accesses, which are only
+  /// needed while the SCoP is built, and new access relations that equal the
+  /// original ones. Let the accesses of a statement that have equal access
+  /// relations share one isl_map, and shrink the lookup tables to their
+  /// contents. This can be called again after passes changed the SCoP.
+  void compact();
+
+  /// Return the memory taken by the representation of this SCoP.
+  ScopMemoryUsage getMemoryUsage() const;
+
   /// Simplify the SCoP representation.
   ///
   /// @param AfterHoisting Whether it is called after invariant load hoisting.
@@ -3167,6 +3254,20 @@ public:
   /// This invalidates any iterators.
   void recompute();
 
+  /// Recompute the Scop of the region @p R only, e.g. after code was generated
+  /// for another Scop that it depends on.
+  ///
+  /// This invalidates any iterators.
+  ///
+  /// @return The new Scop, or nullptr if none can be built for @p R anymore.
+  Scop *recompute(Region *R);
+
+  /// Drop the Scop of the region @p R, e.g. because code was generated for it
+  /// and it does not describe the IR of the region anymore.
+  ///
+  /// This invalidates any iterators.
+  void erase(Region *R) { RegionToScopMap.erase(R); }
+
   /// Handle invalidation explicitly
   bool invalidate(Function &F, const PreservedAnalyses &PA,
                   FunctionAnalysisManager::Invalidator &Inv);
@@ -18,8 +18,10 @@
 #define POLLY_SCOP_PASS_H
 
 #include "polly/ScopInfo.h"
+#include "polly/Support/ScopHelper.h"
 #include "llvm/ADT/PriorityWorklist.h"
 #include "llvm/Analysis/RegionPass.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/IR/PassManager.h"
 
 using namespace llvm;
@@ -175,8 +177,14 @@ struct ScopStandardAnalysisResults {
   ScalarEvolution &SE;
   LoopInfo &LI;
   RegionInfo &RI;
+  TargetTransformInfo &TTI;
 };
 
+/// Return the analyses preserved by a pass that modified the Polly IR of a
+/// SCoP, but not the LLVM-IR: all analyses of the function, and none of the
+/// analyses of the SCoP.
+PreservedAnalyses getScopPassPreservedAnalyses();
+
 class SPMUpdater {
 public:
   SPMUpdater(SmallPriorityWorklist<Region *, 4> &Worklist,
@@ -214,16 +222,23 @@ public:
     if (SI.empty())
       return PA;
 
+    // Record the IR every SCoP was built from before code is generated for
+    // any of them.
     SmallPriorityWorklist<Region *, 4> Worklist;
+    DenseMap<Region *, ScopInputBlocks> Inputs;
     for (auto &S : SI)
-      if (S.second)
+      if (S.second) {
         Worklist.insert(S.first);
+        Inputs.try_emplace(S.first, *S.first);
+      }
+    SmallPtrSet<BasicBlock *, 32> GeneratedBlocks;
 
     ScopStandardAnalysisResults AR = {AM.getResult<DominatorTreeAnalysis>(F),
                                       AM.getResult<ScopInfoAnalysis>(F),
                                       AM.getResult<ScalarEvolutionAnalysis>(F),
                                       AM.getResult<LoopAnalysis>(F),
-                                      AM.getResult<RegionInfoAnalysis>(F)};
+                                      AM.getResult<RegionInfoAnalysis>(F),
+                                      AM.getResult<TargetIRAnalysis>(F)};
 
     ScopAnalysisManager &SAM =
         AM.getResult<ScopAnalysisManagerFunctionProxy>(F).getManager();
@@ -237,14 +252,27 @@ public:
       Scop *scop = SI.getScop(R);
       if (!scop)
         continue;
+
+      // Only the SCoPs using IR that was rewritten by the code generation of
+      // another SCoP are built anew, together with their analyses.
+      const ScopInputBlocks &Input = Inputs.find(R)->second;
+      if (Input.isAnyIn(GeneratedBlocks)) {
+        SAM.clear(*scop, scop->getName());
+        scop = SI.recompute(R);
+        if (!scop)
+          continue;
+      }
+
       Updater.CurrentScop = scop;
       Updater.InvalidateCurrentScop = false;
       PreservedAnalyses PassPA = Pass.run(*scop, SAM, AR, Updater);
 
       SAM.invalidate(*scop, PassPA);
       PA.intersect(std::move(PassPA));
-      if (Updater.invalidateCurrentScop())
-        SI.recompute();
+      if (Updater.invalidateCurrentScop()) {
+        Input.addGeneratedBlocks(GeneratedBlocks);
+        SI.erase(R);
+      }
     };
 
     PA.preserveSet<AllAnalysesOn<Scop>>();
@@ -0,0 +1,93 @@
+//===- ScopSummary.h - Polyhedral summaries of functions --------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Summarize the memory accesses of a function whose memory accesses are all
+// part of a single SCoP. The summary describes, for each pointer argument,
+// the set of elements read and written relative to the pointer, in terms of
+// the integer arguments of the function.
+//
+// A call to a summarized function can be modeled by ScopDetection and
+// ScopBuilder like any other statement, with the accesses given by the
+// summary, instead of inlining the callee (see ScopInliner) or bailing out.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef POLLY_SCOPSUMMARY_H
+#define POLLY_SCOPSUMMARY_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include <map>
+#include <memory>
+#include <string>
+
+namespace llvm {
+class Function;
+class Type;
+} // namespace llvm
+
+namespace polly {
+
+extern bool PollyUseScopSummaries;
+
+/// The memory accesses of a function, relative to its arguments.
+///
+/// The sets are stored as strings such that the summary does not depend on
+/// the isl_ctx of the SCoP it was computed from. Each set is a one-dimensional
+/// set of element indices; its parameters are named "argN" and stand for the
+/// value of the N-th (integer) argument of the function.
+struct FunctionAccessSummary {
+  /// The accesses through one pointer argument.
+  struct ArgumentAccesses {
+    /// The type of the elements indexed by the sets.
+    llvm::Type *ElementType = nullptr;
+
+    /// The size of ElementType in bytes.
+    unsigned ElementSize = 0;
+
+    /// The elements that may be read, or an empty string if none are read.
+    std::string Reads;
+
+    /// The elements that may be written, or an empty string if none are
+    /// written.
+    std::string Writes;
+  };
+
+  /// The accessed pointer arguments, indexed by the argument number.
+  std::map<unsigned, ArgumentAccesses> Arguments;
+
+  /// The numbers of the integer arguments the sets depend on.
+  llvm::SmallVector<unsigned, 4> ParamArguments;
+};
+
+/// The access summaries of the functions called by one function.
+///
+/// An instance is owned by the ScopDetection of the caller. The summaries
+/// hence live only as long as the detection result that validated the calls
+/// (ScopBuilder models the calls with the same summaries), and are recomputed
+/// when the pass manager invalidates that result. Summaries of a callee never
+/// outlive a modification or deletion of the callee between two runs.
+class FunctionAccessSummaries {
+public:
+  /// Return the access summary of @p F.
+  ///
+  /// The summary is computed on first use. Functions whose memory accesses
+  /// cannot be described exactly by a single SCoP do not have a summary.
+  ///
+  /// @return The summary of @p F, or nullptr if @p F cannot be summarized.
+  const FunctionAccessSummary *get(llvm::Function &F);
+
+private:
+  /// The summaries computed so far, including failed attempts (nullptr).
+  llvm::DenseMap<const llvm::Function *,
+                 std::unique_ptr<FunctionAccessSummary>>
+      Summaries;
+};
+} // namespace polly
+
+#endif // POLLY_SCOPSUMMARY_H
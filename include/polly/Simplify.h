@@ -13,9 +13,11 @@
 #ifndef POLLY_TRANSFORM_SIMPLIFY_H
 #define POLLY_TRANSFORM_SIMPLIFY_H
 
+#include "polly/ScopPass.h"
 #include "llvm/ADT/SmallVector.h"
 
 namespace llvm {
+class LoopInfo;
 class PassRegistry;
 class Pass;
 } // namespace llvm
@@ -23,6 +25,7 @@ class Pass;
 namespace polly {
 
 class MemoryAccess;
+class Scop;
 class ScopStmt;
 
 /// Return a vector that contains MemoryAccesses in the order in
@@ -50,6 +53,23 @@ llvm::SmallVector<MemoryAccess *, 32> getAccessesInOrder(ScopStmt &Stmt);
 ///
 /// @return The Simplify pass.
 llvm::Pass *createSimplifyPass(int CallNo = 0);
+
+/// Simplify the SCoP @p S as the Simplify pass with the same @p CallNo does,
+/// outside of a pass manager.
+///
+/// @return Whether @p S was modified.
+bool runSimplify(Scop &S, llvm::LoopInfo &LI, int CallNo = 0);
+
+/// The Simplify pass for the new pass manager.
+struct SimplifyPass : public llvm::PassInfoMixin<SimplifyPass> {
+  explicit SimplifyPass(int CallNo = 0) : CallNo(CallNo) {}
+
+  llvm::PreservedAnalyses run(Scop &S, ScopAnalysisManager &SAM,
+                              ScopStandardAnalysisResults &AR, SPMUpdater &U);
+
+private:
+  int CallNo;
+};
 } // namespace polly
 
 namespace llvm {
@@ -14,6 +14,7 @@
 #define POLLY_SUPPORT_GIC_HELPER_H
 
 #include "llvm/ADT/APInt.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/Support/raw_ostream.h"
 #include "isl/aff.h"
@@ -274,6 +275,23 @@ std::string getIslCompatibleName(const std::string &Prefix,
                                  const std::string &Middle,
                                  const std::string &Suffix);
 
+/// Write the input of an expensive isl operation to the directory given by
+/// -polly-capture-isl-inputs, if set.
+///
+/// The files use the formats of isl's test inputs, such that polly-isl-bench
+/// can replay them:
+///
+///  - *.ai: the input of isl_union_access_info_compute_flow
+///  - *.sc: the input of isl_schedule_constraints_compute_schedule
+///  - *.st: the input of isl_ast_build_node_from_schedule, the build context
+///          being a context node of the schedule tree
+///@{
+void captureIslInput(__isl_keep isl_union_access_info *Access);
+void captureIslInput(__isl_keep isl_schedule_constraints *Constraints);
+void captureIslInput(__isl_keep isl_schedule *Schedule,
+                     __isl_keep isl_set *Context);
+///@}
+
 inline llvm::DiagnosticInfoOptimizationBase &
 operator<<(llvm::DiagnosticInfoOptimizationBase &OS,
            const isl::union_map &Obj) {
@@ -354,10 +372,13 @@ public:
 /// scope, it will return to the error setting as it was before. That also means
 /// that the error setting should not be changed while in that scope.
 ///
-/// Such scopes are not allowed to be nested because the previous operations
-/// counter cannot be reset to the previous state, or one that adds the
-/// operations while being in the nested scope. Use therefore is only allowed
-/// while currently a no operations-limit is active.
+/// The operations counter of the isl_ctx is not reset when entering the scope.
+/// Instead, the limit is set to the current count plus the allowed number of
+/// operations, such that the counter keeps accumulating the operations of all
+/// scopes (see IslOperationsCounter). Such scopes are still not allowed to be
+/// nested, because the isl_ctx has a single limit, which a nested scope would
+/// replace and remove when leaving. Use therefore is only allowed while
+/// currently no operations-limit is active.
 class IslMaxOperationsGuard {
 private:
   /// The ISL context to set the operations limit.
@@ -366,7 +387,12 @@ private:
   /// scope.
   isl_ctx *IslCtx;
 
-  /// Maximum number of operations for the scope.
+  /// Value of the operations counter of the isl_ctx at which the scope runs
+  /// out of quota.
+  ///
+  /// The counter is not reset when entering the scope, such that it keeps
+  /// counting all operations performed in the isl_ctx (see
+  /// IslOperationsCounter).
   unsigned long LocalMaxOps;
 
   /// When AutoEnter is enabled, holds the IslQuotaScope object.
@@ -402,7 +428,7 @@ public:
       return;
     }
 
-    isl_ctx_reset_operations(IslCtx);
+    this->LocalMaxOps += isl_ctx_get_operations(IslCtx);
     TopLevelScope = enter(AutoEnter);
   }
 
@@ -424,6 +450,26 @@ public:
     return isl_ctx_last_error(IslCtx) == isl_error_quota;
   }
 };
+
+/// Add the number of isl operations performed during the lifetime of this
+/// object to a statistic.
+///
+/// This makes the isl work of the individual Polly passes visible in -stats,
+/// independent of the speed of the machine.
+class IslOperationsCounter {
+  isl_ctx *IslCtx;
+  unsigned long Start;
+  llvm::Statistic &Counter;
+
+public:
+  IslOperationsCounter(isl_ctx *IslCtx, llvm::Statistic &Counter)
+      : IslCtx(IslCtx), Start(isl_ctx_get_operations(IslCtx)),
+        Counter(Counter) {}
+  IslOperationsCounter(const IslOperationsCounter &) = delete;
+  const IslOperationsCounter &operator=(const IslOperationsCounter &) = delete;
+
+  ~IslOperationsCounter() { Counter += isl_ctx_get_operations(IslCtx) - Start; }
+};
 } // end namespace polly
 
 #endif
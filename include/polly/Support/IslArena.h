@@ -0,0 +1,97 @@
+//===------ IslArena.h ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An arena for the memory of an isl_ctx. isl keeps the constraints of basic
+// maps and the elements of matrices, vectors and tableaus in blocks of
+// integers that are allocated, resized and freed at a very high rate; with
+// isl_ctx_set_blk_allocator these blocks are taken from an IslArena instead of
+// malloc. The arena rounds the blocks up to power-of-two size classes, carves
+// them out of large slabs and keeps the freed blocks of every class for reuse.
+// All slabs are released at once when the arena is destroyed, together with
+// the isl_ctx.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef POLLY_SUPPORT_ISLARENA_H
+#define POLLY_SUPPORT_ISLARENA_H
+
+#include "llvm/Support/Allocator.h"
+#include <cstddef>
+#include <memory>
+
+struct isl_ctx;
+
+namespace polly {
+
+/// A size-class allocator over bump-allocated slabs for one isl_ctx.
+///
+/// Like the isl_ctx it serves, an arena must only be used by one thread.
+class IslArena {
+public:
+  /// The size of the smallest and the largest size class. Larger blocks are
+  /// allocated with malloc.
+  static constexpr size_t MinSize = 16;
+  static constexpr size_t MaxSize = 64 * 1024;
+
+  IslArena() = default;
+  IslArena(const IslArena &) = delete;
+  IslArena &operator=(const IslArena &) = delete;
+
+  /// Allocate @p Size bytes. Return nullptr if a block larger than MaxSize
+  /// cannot be allocated.
+  void *allocate(size_t Size);
+
+  /// Resize the memory at @p Ptr from @p OldSize to @p NewSize bytes,
+  /// preserving its contents. Return nullptr, and leave @p Ptr allocated, if
+  /// the new memory cannot be allocated.
+  void *reallocate(void *Ptr, size_t OldSize, size_t NewSize);
+
+  /// Free the @p Size bytes at @p Ptr for reuse by later allocations.
+  ///
+  /// Memory of size classes is only returned to the system when the arena is
+  /// destroyed.
+  void deallocate(void *Ptr, size_t Size);
+
+  /// Return the number of bytes taken from the system for the slabs.
+  size_t getSlabBytes() const { return Slabs.getTotalMemory(); }
+
+  /// Return the number of bytes currently allocated from the arena, including
+  /// the blocks larger than MaxSize.
+  size_t getBytesInUse() const { return BytesInUse; }
+
+private:
+  static constexpr unsigned NumSizeClasses = 13;
+  static_assert(MinSize << (NumSizeClasses - 1) == MaxSize,
+                "The size classes must range from MinSize to MaxSize");
+
+  /// Return the size class of blocks of @p Size bytes, which must not be
+  /// larger than MaxSize.
+  static unsigned getSizeClass(size_t Size);
+
+  /// The slabs of at least MaxSize bytes the blocks are carved out of.
+  llvm::BumpPtrAllocatorImpl<llvm::MallocAllocator, MaxSize> Slabs;
+
+  /// The freed blocks of each size class. The first bytes of a freed block
+  /// point to the next one.
+  void *FreeLists[NumSizeClasses] = {};
+
+  size_t BytesInUse = 0;
+};
+
+/// Allocate an isl_ctx whose blocks of integers come from an IslArena.
+///
+/// The arena is destroyed after the isl_ctx when the last reference to the
+/// returned pointer is dropped.
+std::shared_ptr<isl_ctx> allocIslCtxWithArena();
+
+/// Return the arena of an isl_ctx allocated with allocIslCtxWithArena, or
+/// nullptr if @p Ctx was allocated otherwise.
+const IslArena *getIslArena(const std::shared_ptr<isl_ctx> &Ctx);
+} // namespace polly
+
+#endif // POLLY_SUPPORT_ISLARENA_H
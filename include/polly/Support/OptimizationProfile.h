@@ -0,0 +1,134 @@
+//===------ OptimizationProfile.h -------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Per-function and per-SCoP overrides of Polly options, read from a JSON file
+// given by -polly-optimization-profiles. The file has the form
+//
+//   { "profiles": [
+//       { "name": "stencils",
+//         "function": "^stencil_",
+//         "file": "kernels\\.c$",
+//         "lines": [100, 250],
+//         "options": { "polly-tile-sizes": "64,4", "polly-parallel": "true" }
+//       } ] }
+//
+// "function" and "file" are regular expressions matched against the function
+// name and the source file of the SCoP, "lines" must overlap with the source
+// lines of the SCoP. All three are optional. The first matching profile is
+// applied; its options replace the command line values while the SCoP is
+// processed.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef POLLY_SUPPORT_OPTIMIZATIONPROFILE_H
+#define POLLY_SUPPORT_OPTIMIZATIONPROFILE_H
+
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CommandLine.h"
+#include <string>
+
+namespace llvm {
+class Function;
+class OptimizationRemarkEmitter;
+class Region;
+} // namespace llvm
+
+namespace polly {
+class Scop;
+
+/// A set of option overrides that applies to some SCoPs.
+struct OptimizationProfile {
+  /// The name of the profile, used in remarks.
+  std::string Name;
+
+  /// Option name (without leading dashes) to its value as it would be written
+  /// on the command line.
+  llvm::StringMap<std::string> Overrides;
+};
+
+/// Return the profile that applies to the SCoP of region @p R in @p F, or
+/// nullptr if none applies.
+const OptimizationProfile *findOptimizationProfile(const llvm::Function &F,
+                                                   const llvm::Region &R);
+
+/// Return the profile that applies to @p S, or nullptr if none applies.
+const OptimizationProfile *findOptimizationProfile(const Scop &S);
+
+/// Emit a remark that lists the overrides of @p Profile for the SCoP of @p R.
+void emitOptimizationProfileRemark(const OptimizationProfile &Profile,
+                                   const llvm::Region &R,
+                                   llvm::OptimizationRemarkEmitter &ORE);
+
+/// Make a profile the active one for the lifetime of this object.
+///
+/// Options read with getProfileOption take the value of the active profile if
+/// it overrides them.
+class OptimizationProfileScope {
+  const OptimizationProfile *Previous;
+
+public:
+  explicit OptimizationProfileScope(const OptimizationProfile *Profile);
+  explicit OptimizationProfileScope(const Scop &S);
+  ~OptimizationProfileScope();
+
+  OptimizationProfileScope(const OptimizationProfileScope &) = delete;
+  OptimizationProfileScope &
+  operator=(const OptimizationProfileScope &) = delete;
+};
+
+/// Return the value the active profile gives to option @p Name, if any.
+llvm::Optional<llvm::StringRef> getActiveProfileOverride(llvm::StringRef Name);
+
+/// Report that the value @p Value of a profile override of @p Name cannot be
+/// parsed. The command line value is used instead.
+void reportInvalidProfileOverride(llvm::StringRef Name, llvm::StringRef Value);
+
+/// Return the value of @p Opt, taking the active profile into account.
+template <typename DataType, bool ExternalStorage, typename ParserClass>
+DataType
+getProfileOption(llvm::cl::opt<DataType, ExternalStorage, ParserClass> &Opt) {
+  llvm::Optional<llvm::StringRef> Value = getActiveProfileOverride(Opt.ArgStr);
+  if (!Value)
+    return Opt;
+
+  DataType Result;
+  if (Opt.getParser().parse(Opt, Opt.ArgStr, *Value, Result)) {
+    reportInvalidProfileOverride(Opt.ArgStr, *Value);
+    return Opt;
+  }
+  return Result;
+}
+
+/// Return the values of the comma separated list @p Opt, taking the active
+/// profile into account.
+template <typename DataType, typename StorageClass, typename ParserClass>
+llvm::SmallVector<DataType, 4>
+getProfileOption(llvm::cl::list<DataType, StorageClass, ParserClass> &Opt) {
+  llvm::Optional<llvm::StringRef> Value = getActiveProfileOverride(Opt.ArgStr);
+  if (!Value)
+    return llvm::SmallVector<DataType, 4>(Opt.begin(), Opt.end());
+
+  llvm::SmallVector<llvm::StringRef, 4> Elements;
+  Value->split(Elements, ',', -1, false);
+
+  llvm::SmallVector<DataType, 4> Result;
+  for (llvm::StringRef Element : Elements) {
+    DataType ElementValue;
+    if (Opt.getParser().parse(Opt, Opt.ArgStr, Element.trim(), ElementValue)) {
+      reportInvalidProfileOverride(Opt.ArgStr, *Value);
+      return llvm::SmallVector<DataType, 4>(Opt.begin(), Opt.end());
+    }
+    Result.push_back(ElementValue);
+  }
+  return Result;
+}
+} // namespace polly
+
+#endif // POLLY_SUPPORT_OPTIMIZATIONPROFILE_H
@@ -15,9 +15,11 @@
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/ValueHandle.h"
+#include "isl/isl-noexceptions.h"
 #include <tuple>
 #include <vector>
 
@@ -31,6 +33,7 @@ class Pass;
 class DominatorTree;
 class RegionInfo;
 class GetElementPtrInst;
+class MDNode;
 } // namespace llvm
 
 namespace polly {
@@ -401,6 +404,13 @@ bool isHoistableLoad(llvm::LoadInst *LInst, llvm::Region &R, llvm::LoopInfo &LI,
 ///        generation.
 bool isIgnoredIntrinsic(const llvm::Value *V);
 
+/// Check whether the memory of @p Alloca is only accessed inside @p R.
+///
+/// This is the case if @p Alloca is static, its address does not escape, and
+/// all loads and stores through it are in @p R. Ignored intrinsics such as
+/// lifetime markers may be anywhere.
+bool isLocalToRegion(const llvm::AllocaInst *Alloca, const llvm::Region &R);
+
 /// Check whether a value an be synthesized by the code generator.
 ///
 /// Some value will be recalculated only from information that is code generated
@@ -479,5 +489,68 @@ bool isDebugCall(llvm::Instruction *Inst);
 ///
 /// Such a statement must not be removed, even if has no side-effects.
 bool hasDebugCall(ScopStmt *Stmt);
+
+/// The basic blocks whose IR a SCoP was built from.
+///
+/// Generating code for a SCoP rewrites the blocks of its region and its exit
+/// block. Another SCoP of the same function has to be rebuilt afterwards if it
+/// contains one of these blocks or uses a value defined in one of them.
+class ScopInputBlocks {
+public:
+  /// Collect the input blocks of the SCoP of the region @p R. This must be
+  /// done before any code is generated in the function.
+  explicit ScopInputBlocks(llvm::Region &R);
+
+  /// Does the SCoP use any of the @p GeneratedBlocks?
+  bool isAnyIn(
+      const llvm::SmallPtrSetImpl<llvm::BasicBlock *> &GeneratedBlocks) const;
+
+  /// Add the blocks rewritten by generating code for the SCoP to
+  /// @p GeneratedBlocks.
+  void addGeneratedBlocks(
+      llvm::SmallPtrSetImpl<llvm::BasicBlock *> &GeneratedBlocks) const;
+
+private:
+  /// The blocks of the region, and its exit block.
+  llvm::SmallPtrSet<llvm::BasicBlock *, 16> Blocks;
+  llvm::BasicBlock *Exit;
+
+  /// The blocks outside of the region defining values that the region uses,
+  /// directly or through the operands of other instructions outside of it.
+  llvm::SmallPtrSet<llvm::BasicBlock *, 16> DefiningBlocks;
+};
+
+/// Properties of a loop that are attached to the band node representing it.
+///
+/// isl band nodes cannot carry arbitrary data, hence a mark node whose
+/// isl::id points to a BandAttr is inserted directly above the band. The
+/// BandAttr is owned by that isl::id and freed together with it.
+struct BandAttr {
+  /// The loop's LoopID, carrying e.g. the '#pragma clang loop' directives.
+  llvm::MDNode *Metadata = nullptr;
+
+  /// The loop the band was derived from.
+  llvm::Loop *OriginalLoop = nullptr;
+};
+
+/// Does @p L carry a loop transformation directive Polly can apply?
+///
+/// The supported directives are:
+///
+///   llvm.loop.interchange.enable
+///   llvm.loop.tile.enable (llvm.loop.tile.size, llvm.loop.tile.depth)
+///   llvm.loop.unroll_and_jam.enable (llvm.loop.unroll_and_jam.count)
+///   llvm.loop.parallelize_thread.enable
+bool hasLoopTransformationMetadata(llvm::Loop *L);
+
+/// Create the isl::id for a "Loop with Metadata" mark of the loop @p L.
+isl::id getIslLoopAttr(isl::ctx Ctx, llvm::Loop *L);
+
+/// Is @p Id the isl::id of a "Loop with Metadata" mark?
+bool isLoopAttr(const isl::id &Id);
+
+/// Return the BandAttr of a "Loop with Metadata" mark or nullptr if @p Id is
+/// something else.
+BandAttr *getLoopAttr(const isl::id &Id);
 } // namespace polly
 #endif
@@ -25,6 +25,8 @@
 #include "polly/ScopInfo.h"
 #include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLTools.h"
+#include "polly/Support/OptimizationProfile.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Debug.h"
 #include <isl/aff.h>
 #include <isl/ctx.h>
@@ -83,6 +85,9 @@ static cl::opt<Dependences::AnalysisLevel> OptAnalysisLevel(
     cl::Hidden, cl::init(Dependences::AL_Statement), cl::ZeroOrMore,
     cl::cat(PollyCategory));
 
+STATISTIC(NumIslOperations,
+          "Number of isl operations performed by the dependence analysis");
+
 //===----------------------------------------------------------------------===//
 
 /// Tag the @p Relation domain with @p TagId
@@ -173,6 +178,23 @@ static void collectInfo(Scop &S, isl_union_map *&Read,
         MustWrite = isl_union_map_add_map(MustWrite, accdom);
     }
 
+    // Calls with unknown side effects must stay in order. Model them as
+    // reading and writing the same, otherwise unknown, memory location.
+    if (S.hasBookkeepingCall(Stmt)) {
+      isl_map *Unknown = isl_map_from_domain(Stmt.getDomain().release());
+      Unknown = isl_map_set_tuple_name(Unknown, isl_dim_out,
+                                       "__polly_unknown_memory");
+      if (Level > Dependences::AL_Statement) {
+        isl_id *TagId = isl_map_get_tuple_id(Unknown, isl_dim_out);
+        Unknown = tag(Unknown, TagId);
+        isl_map *Schedule = tag(Stmt.getSchedule().release(),
+                                isl_map_get_tuple_id(Unknown, isl_dim_out));
+        StmtSchedule = isl_union_map_add_map(StmtSchedule, Schedule);
+      }
+      Read = isl_union_map_add_map(Read, isl_map_copy(Unknown));
+      MayWrite = isl_union_map_add_map(MayWrite, Unknown);
+    }
+
     if (!ReductionArrays.empty() && Level == Dependences::AL_Statement)
       StmtSchedule =
           isl_union_map_add_map(StmtSchedule, Stmt.getSchedule().release());
@@ -298,6 +320,7 @@ static __isl_give isl_union_flow *buildFlow(__isl_keep isl_union_map *Snk,
   if (Src)
     AI = isl_union_access_info_set_must_source(AI, isl_union_map_copy(Src));
   AI = isl_union_access_info_set_schedule(AI, isl_schedule_copy(Schedule));
+  captureIslInput(AI);
   auto Flow = isl_union_access_info_compute_flow(AI);
   LLVM_DEBUG(if (!Flow) dbgs()
                  << "last error: "
@@ -406,7 +429,38 @@ static isl_union_map *buildWAR(isl_union_map *Write, isl_union_map *MustWrite,
   return WAR;
 }
 
+/// Compute the control dependences of the exit condition of a dynamic-exit
+/// loop.
+///
+/// The domains of a SCoP with a dynamic-exit loop over-approximate the
+/// iterations of the loop. Every statement instance of an iteration must
+/// therefore be executed before the exit condition is evaluated at the end of
+/// this iteration, and the exit condition must be evaluated before any
+/// statement instance of a later iteration is executed.
+///
+///   { Stmt[i, ...] -> ExitStmt[i] ; ExitStmt[i] -> Stmt[i', ...] : i' > i }
+static isl_union_map *buildDynamicExitDeps(Scop &S) {
+  isl::union_map Deps = isl::union_map::empty(S.getParamSpace());
+  ScopStmt *ExitStmt = S.getDynamicExitStmt();
+  if (!ExitStmt)
+    return Deps.release();
+
+  isl::set ExitDomain = ExitStmt->getDomain();
+  for (ScopStmt &Stmt : S) {
+    isl::set Domain = Stmt.getDomain();
+    if (&Stmt != ExitStmt) {
+      isl::map ToExit = isl::map::from_domain_and_range(Domain, ExitDomain);
+      Deps = Deps.add_map(ToExit.equate(isl::dim::in, 0, isl::dim::out, 0));
+    }
+    isl::map FromExit = isl::map::from_domain_and_range(ExitDomain, Domain);
+    Deps = Deps.add_map(FromExit.order_lt(isl::dim::in, 0, isl::dim::out, 0));
+  }
+  return Deps.release();
+}
+
 void Dependences::calculateDependences(Scop &S) {
+  OptimizationProfileScope ProfileScope(S);
+  IslOperationsCounter OpsCounter(IslCtx.get(), NumIslOperations);
   isl_union_map *Read, *MustWrite, *MayWrite, *ReductionTagMap;
   isl_schedule *Schedule;
   isl_union_set *TaggedStmtDomain;
@@ -466,7 +520,8 @@ void Dependences::calculateDependences(Scop &S) {
 
   isl_union_map *StrictWAW = nullptr;
   {
-    IslMaxOperationsGuard MaxOpGuard(IslCtx.get(), OptComputeOut);
+    IslMaxOperationsGuard MaxOpGuard(IslCtx.get(),
+                                     getProfileOption(OptComputeOut));
 
     RAW = WAW = WAR = RED = nullptr;
     isl_union_map *Write = isl_union_map_union(isl_union_map_copy(MustWrite),
@@ -590,6 +645,8 @@ void Dependences::calculateDependences(Scop &S) {
   // reduction dependences or dependences that are finer than statement
   // level dependences.
   if (!HasReductions && Level == AL_Statement) {
+    if (RAW)
+      RAW = isl_union_map_union(RAW, buildDynamicExitDeps(S));
     RED = isl_union_map_empty(isl_union_map_get_space(RAW));
     TC_RED = isl_union_map_empty(isl_union_set_get_space(TaggedStmtDomain));
     isl_union_set_free(TaggedStmtDomain);
@@ -722,6 +779,7 @@ void Dependences::calculateDependences(Scop &S) {
   });
 
   RAW = isl_union_map_union(RAW, STMT_RAW);
+  RAW = isl_union_map_union(RAW, buildDynamicExitDeps(S));
   WAW = isl_union_map_union(WAW, STMT_WAW);
   WAR = isl_union_map_union(WAR, STMT_WAR);
 
@@ -776,6 +834,47 @@ bool Dependences::isValidSchedule(
   return NonPositive.is_empty();
 }
 
+bool Dependences::isValidSchedule(Scop &S, isl::schedule NewSchedule) const {
+  if (LegalityCheckDisabled)
+    return true;
+
+  isl::union_map Map = NewSchedule.get_map();
+
+  unsigned MaxDims = 0;
+  StatementToIslMapTy NewSchedules;
+  for (ScopStmt &Stmt : S) {
+    isl::union_map StmtMap =
+        Map.intersect_domain(isl::union_set(Stmt.getDomain()));
+    if (StmtMap.is_empty())
+      continue;
+
+    isl::map StmtSchedule = isl::map::from_union_map(StmtMap);
+    MaxDims = std::max(MaxDims, StmtSchedule.dim(isl::dim::out));
+    NewSchedules[&Stmt] = StmtSchedule;
+  }
+
+  isl::space RangeSpace;
+  for (auto &StmtSchedule : NewSchedules) {
+    isl::map Padded = StmtSchedule.second;
+    unsigned Dims = Padded.dim(isl::dim::out);
+    Padded = Padded.add_dims(isl::dim::out, MaxDims - Dims);
+    for (unsigned i = Dims; i < MaxDims; i += 1)
+      Padded = Padded.fix_si(isl::dim::out, i, 0);
+    StmtSchedule.second = Padded;
+    RangeSpace = Padded.get_space().range();
+  }
+
+  // Statements without instances still need a schedule in the same space.
+  for (ScopStmt &Stmt : S) {
+    if (NewSchedules.count(&Stmt) || !RangeSpace)
+      continue;
+    NewSchedules[&Stmt] = isl::map::from_domain_and_range(
+        Stmt.getDomain(), isl::set::universe(RangeSpace));
+  }
+
+  return isValidSchedule(S, NewSchedules);
+}
+
 // Check if the current scheduling dimension is parallel.
 //
 // We check for parallelism by verifying that the loop does not carry any
@@ -913,6 +1012,13 @@ void Dependences::setReductionDependences(MemoryAccess *MA, isl_map *D) {
   ReductionDependences[MA] = D;
 }
 
+std::unique_ptr<Dependences>
+polly::computeDependences(Scop &S, Dependences::AnalysisLevel Level) {
+  std::unique_ptr<Dependences> D(new Dependences(S.getSharedIslCtx(), Level));
+  D->calculateDependences(S);
+  return D;
+}
+
 const Dependences &
 DependenceAnalysis::Result::getDependences(Dependences::AnalysisLevel Level) {
   if (Dependences *d = D[Level].get())
@@ -942,16 +1048,9 @@ DependenceInfoPrinterPass::run(Scop &S, ScopAnalysisManager &SAM,
                                SPMUpdater &U) {
   auto &DI = SAM.getResult<DependenceAnalysis>(S, SAR);
 
-  if (auto d = DI.D[OptAnalysisLevel].get()) {
-    d->print(OS);
-    return PreservedAnalyses::all();
-  }
-
-  // Otherwise create the dependences on-the-fly and print them
-  Dependences D(S.getSharedIslCtx(), OptAnalysisLevel);
-  D.calculateDependences(S);
-  D.print(OS);
-
+  // Keep the dependences in the analysis result, such that the passes after
+  // the printer do not compute them again.
+  DI.getDependences(OptAnalysisLevel).print(OS);
   return PreservedAnalyses::all();
 }
 
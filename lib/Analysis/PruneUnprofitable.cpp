@@ -41,23 +41,22 @@ STATISTIC(NumLoopsInScop, "Number of loops in scops after pruning");
 STATISTIC(NumBoxedLoops, "Number of boxed loops in SCoPs after pruning");
 STATISTIC(NumAffineLoops, "Number of affine loops in SCoPs after pruning");
 
-class PruneUnprofitable : public ScopPass {
-private:
-  void updateStatistics(Scop &S, bool Pruned) {
-    auto ScopStats = S.getStatistics();
-    if (Pruned) {
-      ScopsPruned++;
-      NumPrunedLoops += ScopStats.NumAffineLoops + ScopStats.NumBoxedLoops;
-      NumPrunedBoxedLoops += ScopStats.NumBoxedLoops;
-      NumPrunedAffineLoops += ScopStats.NumAffineLoops;
-    } else {
-      ScopsSurvived++;
-      NumLoopsInScop += ScopStats.NumAffineLoops + ScopStats.NumBoxedLoops;
-      NumBoxedLoops += ScopStats.NumBoxedLoops;
-      NumAffineLoops += ScopStats.NumAffineLoops;
-    }
+void updateStatistics(Scop &S, bool Pruned) {
+  auto ScopStats = S.getStatistics();
+  if (Pruned) {
+    ScopsPruned++;
+    NumPrunedLoops += ScopStats.NumAffineLoops + ScopStats.NumBoxedLoops;
+    NumPrunedBoxedLoops += ScopStats.NumBoxedLoops;
+    NumPrunedAffineLoops += ScopStats.NumAffineLoops;
+  } else {
+    ScopsSurvived++;
+    NumLoopsInScop += ScopStats.NumAffineLoops + ScopStats.NumBoxedLoops;
+    NumBoxedLoops += ScopStats.NumBoxedLoops;
+    NumAffineLoops += ScopStats.NumAffineLoops;
   }
+}
 
+class PruneUnprofitable : public ScopPass {
 public:
   static char ID;
 
@@ -71,25 +70,7 @@ public:
   }
 
   bool runOnScop(Scop &S) override {
-    if (PollyProcessUnprofitable) {
-      LLVM_DEBUG(
-          dbgs() << "NOTE: -polly-process-unprofitable active, won't prune "
-                    "anything\n");
-      return false;
-    }
-
-    ScopsProcessed++;
-
-    if (!S.isProfitable(true)) {
-      LLVM_DEBUG(
-          dbgs() << "SCoP pruned because it probably cannot be optimized in "
-                    "a significant way\n");
-      S.invalidate(PROFITABLE, DebugLoc());
-      updateStatistics(S, true);
-    } else {
-      updateStatistics(S, false);
-    }
-
+    runPruneUnprofitable(S);
     return false;
   }
 };
@@ -99,6 +80,39 @@ char PruneUnprofitable::ID;
 
 Pass *polly::createPruneUnprofitablePass() { return new PruneUnprofitable(); }
 
+bool polly::runPruneUnprofitable(Scop &S) {
+  if (PollyProcessUnprofitable) {
+    LLVM_DEBUG(
+        dbgs() << "NOTE: -polly-process-unprofitable active, won't prune "
+                  "anything\n");
+    return false;
+  }
+
+  ScopsProcessed++;
+
+  if (!S.isProfitable(true)) {
+    LLVM_DEBUG(
+        dbgs() << "SCoP pruned because it probably cannot be optimized in "
+                  "a significant way\n");
+    S.invalidate(PROFITABLE, DebugLoc());
+    updateStatistics(S, true);
+    return true;
+  }
+
+  updateStatistics(S, false);
+  return false;
+}
+
+PreservedAnalyses PruneUnprofitablePass::run(Scop &S, ScopAnalysisManager &SAM,
+                                             ScopStandardAnalysisResults &AR,
+                                             SPMUpdater &U) {
+  if (!runPruneUnprofitable(S))
+    return PreservedAnalyses::all();
+
+  // The run-time condition of the AST includes the assumptions of the SCoP.
+  return getScopPassPreservedAnalyses();
+}
+
 INITIALIZE_PASS_BEGIN(PruneUnprofitable, "polly-prune-unprofitable",
                       "Polly - Prune unprofitable SCoPs", false, false)
 INITIALIZE_PASS_END(PruneUnprofitable, "polly-prune-unprofitable",
@@ -18,7 +18,9 @@
 #include "polly/ScopDetection.h"
 #include "polly/ScopDetectionDiagnostic.h"
 #include "polly/ScopInfo.h"
+#include "polly/ScopSummary.h"
 #include "polly/Support/GICHelper.h"
+#include "polly/Support/OptimizationProfile.h"
 #include "polly/Support/SCEVValidator.h"
 #include "polly/Support/ScopHelper.h"
 #include "polly/Support/VirtualInstruction.h"
@@ -71,6 +73,8 @@ STATISTIC(ScopFound, "Number of valid Scops");
 STATISTIC(RichScopFound, "Number of Scops containing a loop");
 STATISTIC(InfeasibleScops,
           "Number of SCoPs with statically infeasible context.");
+STATISTIC(NumIslOperations,
+          "Number of isl operations performed while building SCoPs");
 
 bool polly::ModelReadOnlyScalars;
 
@@ -561,9 +565,22 @@ bool ScopBuilder::buildAccessCallInst(MemAccInst Inst, ScopStmt *Stmt) {
   if (CI->doesNotAccessMemory() || isIgnoredIntrinsic(CI) || isDebugCall(CI))
     return true;
 
+  auto *CalledFunction = CI->getCalledFunction();
+  auto *DC = SD.getDetectionContext(&scop->getRegion());
+  if (DC->SummarizedCalls.count(CI)) {
+    buildAccessSummarizedCall(
+        CI, *SD.getFunctionAccessSummary(*CalledFunction), Stmt);
+    return true;
+  }
+
+  if (DC->BookkeepingCalls.count(CI)) {
+    BookkeepingCalls.emplace_back(Stmt, CI);
+    scop->addBookkeepingCall(CI);
+    return true;
+  }
+
   bool ReadOnly = false;
   auto *AF = SE.getConstant(IntegerType::getInt64Ty(CI->getContext()), 0);
-  auto *CalledFunction = CI->getCalledFunction();
   switch (AA.getModRefBehavior(CalledFunction)) {
   case FMRB_UnknownModRefBehavior:
     llvm_unreachable("Unknown mod ref behaviour cannot be represented.");
@@ -601,6 +618,121 @@ bool ScopBuilder::buildAccessCallInst(MemAccInst Inst, ScopStmt *Stmt) {
   return true;
 }
 
+void ScopBuilder::buildAccessSummarizedCall(
+    CallInst *CI, const FunctionAccessSummary &Summary, ScopStmt *Stmt) {
+  auto *AF = SE.getConstant(IntegerType::getInt64Ty(CI->getContext()), 0);
+  Loop *L = LI.getLoopFor(CI->getParent());
+
+  for (auto &ArgAccesses : Summary.Arguments) {
+    unsigned ArgNo = ArgAccesses.first;
+    const FunctionAccessSummary::ArgumentAccesses &Accesses =
+        ArgAccesses.second;
+
+    auto *ArgSCEV = SE.getSCEVAtScope(CI->getArgOperand(ArgNo), L);
+    if (ArgSCEV->isZero())
+      continue;
+    auto *ArgBasePtr = cast<SCEVUnknown>(SE.getPointerBase(ArgSCEV));
+
+    // Model the accesses like other non-affine accesses first; they are
+    // restricted to the summarized elements by applyAccessSummaries().
+    if (!Accesses.Reads.empty()) {
+      MemoryAccess *Access = addArrayAccess(
+          Stmt, CI, MemoryAccess::READ, ArgBasePtr->getValue(),
+          Accesses.ElementType, false, {AF}, {nullptr}, CI);
+      SummarizedAccesses[Access] = {CI, ArgNo, Accesses.Reads,
+                                    Accesses.ElementSize};
+    }
+    if (!Accesses.Writes.empty()) {
+      MemoryAccess *Access = addArrayAccess(
+          Stmt, CI, MemoryAccess::MAY_WRITE, ArgBasePtr->getValue(),
+          Accesses.ElementType, false, {AF}, {nullptr}, CI);
+      SummarizedAccesses[Access] = {CI, ArgNo, Accesses.Writes,
+                                    Accesses.ElementSize};
+    }
+  }
+}
+
+/// Return the value of @p E in the iterations of @p Stmt, or nullptr if it is
+/// not representable in all of them.
+static isl::pw_aff getSummaryPwAff(Scop &S, ScopStmt &Stmt, const SCEV *E) {
+  PWACtx PWAC = S.getPwAff(E, Stmt.getEntryBlock());
+  isl::set StmtDom = Stmt.getDomain().reset_tuple_id();
+  if (!StmtDom.intersect(PWAC.second).is_empty())
+    return nullptr;
+  return PWAC.first;
+}
+
+void ScopBuilder::applyAccessSummaries() {
+  if (SummarizedAccesses.empty())
+    return;
+
+  isl::ctx Ctx = scop->getIslCtx();
+  for (ScopStmt &Stmt : *scop) {
+    for (MemoryAccess *Access : Stmt) {
+      auto It = SummarizedAccesses.find(Access);
+      if (It == SummarizedAccesses.end())
+        continue;
+      const SummarizedAccess &Summarized = It->second;
+
+      const ScopArrayInfo *SAI = Access->getScopArrayInfo();
+      if (SAI->getNumberOfDimensions() != 1)
+        continue;
+
+      CallInst *CI = Summarized.Call;
+      Loop *L = LI.getLoopFor(CI->getParent());
+      auto *ArgSCEV = SE.getSCEVAtScope(CI->getArgOperand(Summarized.ArgNo), L);
+      auto *ArgBasePtr = cast<SCEVUnknown>(SE.getPointerBase(ArgSCEV));
+
+      // Build { Stmt[i] -> [params(i), offset(i), o] : o in Elements }, where
+      // the params are the values of the integer arguments the summary
+      // depends on and offset is the byte offset of the pointer argument.
+      isl::set Elements(Ctx, Summarized.Elements.str());
+      unsigned NumParams = Elements.dim(isl::dim::param);
+
+      isl::map Relation =
+          isl::map::universe(isl::space(Ctx, 0, Stmt.getNumIterators(), 0));
+      bool Representable = true;
+      for (unsigned i = 0; i < NumParams && Representable; i++) {
+        unsigned ArgNo;
+        StringRef Name = Elements.get_dim_name(isl::dim::param, i);
+        bool Invalid = Name.drop_front(strlen("arg")).getAsInteger(10, ArgNo);
+        assert(!Invalid && "Summary parameters are named after arguments");
+        (void)Invalid;
+
+        isl::pw_aff Param = getSummaryPwAff(
+            *scop, Stmt, SE.getSCEVAtScope(CI->getArgOperand(ArgNo), L));
+        Representable = !Param.is_null();
+        if (Representable)
+          Relation = Relation.flat_range_product(isl::map::from_pw_aff(Param));
+      }
+
+      isl::pw_aff Offset = getSummaryPwAff(
+          *scop, Stmt, SE.getMinusSCEV(ArgSCEV, ArgBasePtr));
+      if (!Representable || !Offset)
+        continue;
+      Relation = Relation.flat_range_product(isl::map::from_pw_aff(Offset));
+      Relation = Relation.add_dims(isl::dim::out, 1);
+
+      Elements = Elements.move_dims(isl::dim::set, 0, isl::dim::param, 0,
+                                    NumParams);
+      Elements = Elements.insert_dims(isl::dim::set, NumParams, 1);
+      Relation = Relation.intersect_range(Elements);
+
+      // The address of an element o is offset + o * ElementSize.
+      isl::local_space LS(Relation.get_space().range());
+      isl::aff Address =
+          isl::aff::var_on_domain(LS, isl::dim::set, NumParams)
+              .add(isl::aff::var_on_domain(LS, isl::dim::set, NumParams + 1)
+                       .scale(isl::val(Ctx, Summarized.ElementSize)));
+      Relation = Relation.apply_range(isl::map::from_aff(Address));
+
+      Relation = Relation.set_tuple_id(isl::dim::in, Stmt.getDomainId());
+      Relation = Relation.set_tuple_id(isl::dim::out, SAI->getBasePtrId());
+      Access->setAccessRelation(Access->getAccessRelation().intersect(Relation));
+    }
+  }
+}
+
 void ScopBuilder::buildAccessSingleDim(MemAccInst Inst, ScopStmt *Stmt) {
   Value *Address = Inst.getPointerOperand();
   Value *Val = Inst.getValueOperand();
@@ -673,6 +805,14 @@ void ScopBuilder::buildAccessFunctions() {
       buildAccessFunctions(&Stmt, *BB, R);
   }
 
+  // Branch conditions are encoded in the domains, except the exit condition
+  // of a dynamic-exit loop, which the statement of its latch evaluates.
+  if (ScopStmt *ExitStmt = scop->getDynamicExitStmt()) {
+    auto *Latch = ExitStmt->getBasicBlock();
+    ensureValueRead(cast<BranchInst>(Latch->getTerminator())->getCondition(),
+                    ExitStmt);
+  }
+
   // Build write accesses for values that are used after the SCoP.
   // The instructions defining them might be synthesizable and therefore not
   // contained in any statement, hence we iterate over the original instructions
@@ -1034,6 +1174,15 @@ MemoryAccess *ScopBuilder::addMemoryAccess(
   if (Kind == MemoryKind::PHI || Kind == MemoryKind::ExitPHI)
     isKnownMustAccess = true;
 
+  // The domain of a loop with a data-dependent exit over-approximates its
+  // iterations, hence a write in it may not be overwritten by the write of the
+  // "next" iteration. Must-writes would let passes such as DeLICM assume that
+  // the value written in the last executed iteration is dead.
+  Loop *DynamicExitLoop = scop->getDynamicExitLoop();
+  if (Kind == MemoryKind::Array && DynamicExitLoop &&
+      DynamicExitLoop->contains(Stmt->getEntryBlock()))
+    isKnownMustAccess = false;
+
   if (!isKnownMustAccess && AccType == MemoryAccess::MUST_WRITE)
     AccType = MemoryAccess::MAY_WRITE;
 
@@ -1045,25 +1194,27 @@ MemoryAccess *ScopBuilder::addMemoryAccess(
   return Access;
 }
 
-void ScopBuilder::addArrayAccess(ScopStmt *Stmt, MemAccInst MemAccInst,
-                                 MemoryAccess::AccessType AccType,
-                                 Value *BaseAddress, Type *ElementType,
-                                 bool IsAffine,
-                                 ArrayRef<const SCEV *> Subscripts,
-                                 ArrayRef<const SCEV *> Sizes,
-                                 Value *AccessValue) {
+MemoryAccess *ScopBuilder::addArrayAccess(ScopStmt *Stmt,
+                                          MemAccInst MemAccInst,
+                                          MemoryAccess::AccessType AccType,
+                                          Value *BaseAddress, Type *ElementType,
+                                          bool IsAffine,
+                                          ArrayRef<const SCEV *> Subscripts,
+                                          ArrayRef<const SCEV *> Sizes,
+                                          Value *AccessValue) {
   ArrayBasePointers.insert(BaseAddress);
   auto *MemAccess = addMemoryAccess(Stmt, MemAccInst, AccType, BaseAddress,
                                     ElementType, IsAffine, AccessValue,
                                     Subscripts, Sizes, MemoryKind::Array);
 
   if (!DetectFortranArrays)
-    return;
+    return MemAccess;
 
   if (Value *FAD = findFADAllocationInvisible(MemAccInst))
     MemAccess->setFortranArrayDescriptor(FAD);
   else if (Value *FAD = findFADAllocationVisible(MemAccInst))
     MemAccess->setFortranArrayDescriptor(FAD);
+  return MemAccess;
 }
 
 void ScopBuilder::ensureValueWrite(Instruction *Inst) {
@@ -1446,6 +1597,7 @@ static inline BasicBlock *getRegionNodeBasicBlock(RegionNode *RN) {
 void ScopBuilder::buildScop(Region &R, AssumptionCache &AC,
                             OptimizationRemarkEmitter &ORE) {
   scop.reset(new Scop(R, SE, LI, DT, *SD.getDetectionContext(&R), ORE));
+  IslOperationsCounter OpsCounter(scop->getIslCtx().get(), NumIslOperations);
 
   buildStmts(R);
 
@@ -1504,6 +1656,24 @@ void ScopBuilder::buildScop(Region &R, AssumptionCache &AC,
                      BP, BP->getType(), false, {AF}, {nullptr}, GlobalRead);
   }
 
+  // Bookkeeping calls may access every array that alias analysis cannot
+  // prove to be untouched by them.
+  for (auto BookkeepingPair : BookkeepingCalls) {
+    ScopStmt *BookkeepingStmt = BookkeepingPair.first;
+    CallInst *Call = BookkeepingPair.second;
+    for (auto *BP : ArrayBasePointers) {
+      MemoryLocation Loc(BP, MemoryLocation::UnknownSize);
+      ModRefInfo MRI = AA.getModRefInfo(Call, Loc);
+      if (isRefSet(MRI))
+        addArrayAccess(BookkeepingStmt, MemAccInst(Call), MemoryAccess::READ,
+                       BP, BP->getType(), false, {AF}, {nullptr}, Call);
+      if (isModSet(MRI))
+        addArrayAccess(BookkeepingStmt, MemAccInst(Call),
+                       MemoryAccess::MAY_WRITE, BP, BP->getType(), false, {AF},
+                       {nullptr}, Call);
+    }
+  }
+
   scop->buildInvariantEquivalenceClasses();
 
   /// A map from basic blocks to their invalid domains.
@@ -1545,6 +1715,8 @@ void ScopBuilder::buildScop(Region &R, AssumptionCache &AC,
       checkForReductions(Stmt);
   }
 
+  applyAccessSummaries();
+
   // Check early for a feasible runtime context.
   if (!scop->hasFeasibleRuntimeContext()) {
     LLVM_DEBUG(dbgs() << "Bailing-out because of unfeasible context (early)\n");
@@ -1553,7 +1725,8 @@ void ScopBuilder::buildScop(Region &R, AssumptionCache &AC,
 
   // Check early for profitability. Afterwards it cannot change anymore,
   // only the runtime context could become infeasible.
-  if (!scop->isProfitable(UnprofitableScalarAccs)) {
+  if (!SD.processesUnprofitable() &&
+      !scop->isProfitable(UnprofitableScalarAccs)) {
     scop->invalidate(PROFITABLE, DebugLoc());
     LLVM_DEBUG(
         dbgs() << "Bailing-out because SCoP is not considered profitable\n");
@@ -1583,6 +1756,9 @@ void ScopBuilder::buildScop(Region &R, AssumptionCache &AC,
   scop->verifyInvariantLoads();
   scop->simplifySCoP(true);
 
+  // The invalid domains have been folded into the assumptions now.
+  scop->compact();
+
   // Check late for a feasible runtime context because profitability did not
   // change.
   if (!scop->hasFeasibleRuntimeContext()) {
@@ -1608,6 +1784,12 @@ ScopBuilder::ScopBuilder(Region *R, AssumptionCache &AC, AliasAnalysis &AA,
   ORE.emit(OptimizationRemarkAnalysis(DEBUG_TYPE, "ScopEntry", Beg, P.first)
            << Msg);
 
+  const OptimizationProfile *Profile =
+      findOptimizationProfile(*R->getEntry()->getParent(), *R);
+  if (Profile)
+    emitOptimizationProfileRemark(*Profile, *R, ORE);
+  OptimizationProfileScope ProfileScope(Profile);
+
   buildScop(*R, AC, ORE);
 
   LLVM_DEBUG(dbgs() << *scop);
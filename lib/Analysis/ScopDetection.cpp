@@ -47,6 +47,7 @@
 #include "polly/LinkAllPasses.h"
 #include "polly/Options.h"
 #include "polly/ScopDetectionDiagnostic.h"
+#include "polly/ScopSummary.h"
 #include "polly/Support/SCEVValidator.h"
 #include "polly/Support/ScopHelper.h"
 #include "polly/Support/ScopLocation.h"
@@ -197,6 +198,12 @@ static cl::opt<bool>
                     cl::Hidden, cl::init(false), cl::ZeroOrMore,
                     cl::cat(PollyCategory));
 
+static cl::opt<bool> AbsorbBookkeepingCalls(
+    "polly-absorb-bookkeeping-calls",
+    cl::desc("Allow calls with unknown side effects outside of loops and "
+             "model them as statements that may access all arrays"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 static cl::opt<bool> AllowNonAffineSubRegions(
     "polly-allow-nonaffine-branches",
     cl::desc("Allow non affine conditions for branches"), cl::Hidden,
@@ -208,6 +215,19 @@ static cl::opt<bool>
                            cl::Hidden, cl::init(false), cl::ZeroOrMore,
                            cl::cat(PollyCategory));
 
+static cl::opt<bool> AllowEarlyExitLoops(
+    "polly-allow-early-exit-loops",
+    cl::desc("Over-approximate loops with an affine bound whose other exits "
+             "are data-dependent, e.g. search loops, even if non-affine loops "
+             "are not allowed"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+static cl::opt<bool> AllowDynamicExitLoops(
+    "polly-allow-dynamic-exit-loops",
+    cl::desc("Model loops whose exit condition is only known at run time, e.g. "
+             "while loops, with an unbounded iteration domain"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 static cl::opt<bool, true>
     TrackFailures("polly-detect-track-failures",
                   cl::desc("Track failure strings in detecting scop regions"),
@@ -347,9 +367,11 @@ static bool doesStringMatchAnyRegex(StringRef Str,
 
 ScopDetection::ScopDetection(Function &F, const DominatorTree &DT,
                              ScalarEvolution &SE, LoopInfo &LI, RegionInfo &RI,
-                             AliasAnalysis &AA, OptimizationRemarkEmitter &ORE)
-    : DT(DT), SE(SE), LI(LI), RI(RI), AA(AA), ORE(ORE) {
-  if (!PollyProcessUnprofitable && LI.empty())
+                             AliasAnalysis &AA, OptimizationRemarkEmitter &ORE,
+                             bool IgnoreProfitability)
+    : DT(DT), SE(SE), LI(LI), RI(RI), AA(AA), ORE(ORE),
+      ProcessUnprofitable(PollyProcessUnprofitable || IgnoreProfitability) {
+  if (!ProcessUnprofitable && LI.empty())
     return;
 
   Region *TopRegion = RI.getTopLevelRegion();
@@ -463,7 +485,14 @@ bool ScopDetection::addOverApproximatedRegion(Region *AR,
       Context.BoxedLoopsSet.insert(L);
   }
 
-  return (AllowNonAffineSubLoops || Context.BoxedLoopsSet.empty());
+  if (AllowNonAffineSubLoops)
+    return true;
+
+  // Without non-affine loops, only early-exit loops may be over-approximated.
+  for (const Loop *L : Context.BoxedLoopsSet)
+    if (!AllowEarlyExitLoops || !hasAffineLoopBound(L, Context))
+      return false;
+  return true;
 }
 
 bool ScopDetection::onlyValidRequiredInvariantLoads(
@@ -606,6 +635,11 @@ bool ScopDetection::isValidBranch(BasicBlock &BB, BranchInst *BI,
     if (!IsLoopBranch && AllowNonAffineSubRegions &&
         addOverApproximatedRegion(RI.getRegionFor(&BB), Context))
       return true;
+
+    // The loop may still be modeled with a dynamic exit, see isValidLoop.
+    if (IsLoopBranch && AllowDynamicExitLoops)
+      return false;
+
     return invalid<ReportInvalidCond>(Context, /*Assert=*/true, BI, &BB);
   }
 
@@ -707,10 +741,25 @@ bool ScopDetection::isValidCallInst(CallInst &CI,
     return true;
   }
 
+  if (PollyUseScopSummaries)
+    if (const FunctionAccessSummary *Summary =
+            getFunctionAccessSummary(*CalledFunction))
+      if (isValidSummarizedCall(CI, *Summary, Context)) {
+        LLVM_DEBUG(dbgs() << "Allow call to summarized function: "
+                          << CalledFunction->getName() << '\n');
+        Context.SummarizedCalls.insert(&CI);
+
+        // The summarized accesses are one-dimensional; do not delinearize
+        // arrays accessed by them.
+        Context.HasUnknownAccess = true;
+        Context.AST.addUnknown(&CI);
+        return true;
+      }
+
   if (AllowModrefCall) {
     switch (AA.getModRefBehavior(CalledFunction)) {
     case FMRB_UnknownModRefBehavior:
-      return false;
+      break;
     case FMRB_DoesNotAccessMemory:
     case FMRB_OnlyReadsMemory:
       // Implicitly disable delinearization since we have an unknown
@@ -748,13 +797,70 @@ bool ScopDetection::isValidCallInst(CallInst &CI,
     case FMRB_DoesNotReadMemory:
     case FMRB_OnlyAccessesInaccessibleMem:
     case FMRB_OnlyAccessesInaccessibleOrArgMem:
-      return false;
+      break;
     }
   }
 
+  if (AbsorbBookkeepingCalls && isValidBookkeepingCall(CI, Context)) {
+    LLVM_DEBUG(dbgs() << "Allow bookkeeping call to: "
+                      << CalledFunction->getName() << '\n');
+    Context.BookkeepingCalls.insert(&CI);
+
+    // The call is modeled by accesses to whole arrays.
+    Context.HasUnknownAccess = true;
+    Context.AST.addUnknown(&CI);
+    return true;
+  }
+
   return false;
 }
 
+bool ScopDetection::isValidBookkeepingCall(CallInst &CI,
+                                           DetectionContext &Context) const {
+  // Calls in loops are executed many times; modeling them as accessing whole
+  // arrays would serialize the loop.
+  Loop *L = LI.getLoopFor(CI.getParent());
+  if (L && Context.CurRegion.contains(L))
+    return false;
+
+  // The side effects must not leave the SCoP by other means than memory.
+  if (CI.mayThrow() || CI.hasFnAttr(Attribute::ReturnsTwice))
+    return false;
+
+  // The code after the call, which may be reordered before it, must be
+  // executed only if the call returns.
+  if (CI.doesNotReturn() || !CI.hasFnAttr(Attribute::WillReturn))
+    return false;
+
+  return true;
+}
+
+bool ScopDetection::isValidSummarizedCall(CallInst &CI,
+                                          const FunctionAccessSummary &Summary,
+                                          DetectionContext &Context) const {
+  Loop *L = LI.getLoopFor(CI.getParent());
+
+  for (auto &ArgAccesses : Summary.Arguments) {
+    Value *Arg = CI.getArgOperand(ArgAccesses.first);
+    auto *ArgSCEV = SE.getSCEVAtScope(Arg, L);
+    if (ArgSCEV->isZero())
+      continue;
+
+    auto *BP = dyn_cast<SCEVUnknown>(SE.getPointerBase(ArgSCEV));
+    if (!BP || !isInvariant(*BP->getValue(), Context.CurRegion, Context))
+      return false;
+
+    if (!isAffine(SE.getMinusSCEV(ArgSCEV, BP), L, Context))
+      return false;
+  }
+
+  for (unsigned ArgNo : Summary.ParamArguments)
+    if (!isAffine(SE.getSCEVAtScope(CI.getArgOperand(ArgNo), L), L, Context))
+      return false;
+
+  return true;
+}
+
 bool ScopDetection::isValidIntrinsicInst(IntrinsicInst &II,
                                          DetectionContext &Context) const {
   if (isIgnoredIntrinsic(&II))
@@ -1115,6 +1221,15 @@ bool ScopDetection::isValidAccess(Instruction *Inst, const SCEV *AF,
     if (Context.BoxedLoopsSet.count(L))
       IsVariantInNonAffineLoop = true;
 
+  // The statement of an early-exit loop may access all elements of the
+  // arrays it accesses in the loop.
+  bool IsVariantInEarlyExitLoop =
+      IsVariantInNonAffineLoop && AllowEarlyExitLoops &&
+      llvm::all_of(Loops, [&](const Loop *L) {
+        return !Context.BoxedLoopsSet.count(L) ||
+               hasAffineLoopBound(L, Context);
+      });
+
   auto *Scope = LI.getLoopFor(Inst->getParent());
   bool IsAffine = !IsVariantInNonAffineLoop && isAffine(AF, Scope, Context);
   // Do not try to delinearize memory intrinsics and force them to be affine.
@@ -1127,7 +1242,7 @@ bool ScopDetection::isValidAccess(Instruction *Inst, const SCEV *AF,
     if (!IsAffine || hasIVParams(AF))
       Context.NonAffineAccesses.insert(
           std::make_pair(BP, LI.getLoopFor(Inst->getParent())));
-  } else if (!AllowNonAffine && !IsAffine) {
+  } else if (!AllowNonAffine && !IsAffine && !IsVariantInEarlyExitLoop) {
     return invalid<ReportNonAffineAccess>(Context, /*Assert=*/true, AF, Inst,
                                           BV);
   }
@@ -1287,6 +1402,27 @@ bool ScopDetection::canUseISLTripCount(Loop *L,
   return true;
 }
 
+bool ScopDetection::hasAffineLoopBound(const Loop *L,
+                                       DetectionContext &Context) const {
+  BasicBlock *Latch = L->getLoopLatch();
+  return Latch && L->isLoopExiting(Latch) &&
+         isValidCFG(*Latch, true, false, Context);
+}
+
+bool ScopDetection::isDynamicExitLoop(Loop *L,
+                                      DetectionContext &Context) const {
+  BasicBlock *Latch = L->getLoopLatch();
+  if (!Latch || L->getExitingBlock() != Latch)
+    return false;
+
+  auto *BI = dyn_cast<BranchInst>(Latch->getTerminator());
+  if (!BI || !BI->isConditional())
+    return false;
+
+  return llvm::all_of(Context.CurRegion.blocks(),
+                      [L](const BasicBlock *BB) { return L->contains(BB); });
+}
+
 bool ScopDetection::isValidLoop(Loop *L, DetectionContext &Context) const {
   // Loops that contain part but not all of the blocks of a region cannot be
   // handled by the schedule generation. Such loop constructs can happen
@@ -1335,7 +1471,23 @@ bool ScopDetection::isValidLoop(Loop *L, DetectionContext &Context) const {
   if (canUseISLTripCount(L, Context))
     return true;
 
-  if (AllowNonAffineSubLoops && AllowNonAffineSubRegions) {
+  // A loop that iterates until a condition computed in the loop holds, e.g.
+  // until a value converges, is modeled with an unbounded iteration domain.
+  // Its iterations stay sequential, but the nests within them can still be
+  // optimized.
+  if (AllowDynamicExitLoops && isDynamicExitLoop(L, Context)) {
+    Context.DynamicExitLoop = L;
+    return true;
+  }
+
+  // A loop whose latch has an affine exit condition, but that also has
+  // data-dependent exits, such as a search loop leaving at the first match,
+  // executes at most the iterations of its affine bound. It is modeled as a
+  // statement over-approximating all of them, which executes the loop and
+  // its exit conditions as they are.
+  bool IsEarlyExitLoop = AllowEarlyExitLoops && hasAffineLoopBound(L, Context);
+
+  if ((AllowNonAffineSubLoops || IsEarlyExitLoop) && AllowNonAffineSubRegions) {
     Region *R = RI.getRegionFor(L->getHeader());
     while (R != &Context.CurRegion && !R->contains(L))
       R = R->getParent();
@@ -1484,7 +1636,7 @@ void ScopDetection::findScops(Region &R) {
   DetectionContext &Context = It.first->second;
 
   bool RegionIsValid = false;
-  if (!PollyProcessUnprofitable && regionWithoutLoops(R, LI))
+  if (!ProcessUnprofitable && regionWithoutLoops(R, LI))
     invalid<ReportUnprofitable>(Context, /*Assert=*/true, &R);
   else
     RegionIsValid = isValidRegion(Context);
@@ -1558,10 +1710,15 @@ bool ScopDetection::allBlocksValid(DetectionContext &Context) const {
   for (BasicBlock *BB : CurRegion.blocks()) {
     bool IsErrorBlock = isErrorBlock(*BB, CurRegion, LI, DT);
 
+    // The exit condition of a dynamic-exit loop is evaluated at run time.
+    bool IsDynamicExit = Context.DynamicExitLoop &&
+                         Context.DynamicExitLoop->getLoopLatch() == BB;
+
     // Also check exception blocks (and possibly register them as non-affine
     // regions). Even though exception blocks are not modeled, we use them
     // to forward-propagate domain constraints during ScopInfo construction.
-    if (!isValidCFG(*BB, false, IsErrorBlock, Context) && !KeepGoing)
+    if (!IsDynamicExit && !isValidCFG(*BB, false, IsErrorBlock, Context) &&
+        !KeepGoing)
       return false;
 
     if (IsErrorBlock)
@@ -1617,7 +1774,7 @@ bool ScopDetection::hasPossiblyDistributableLoop(
 bool ScopDetection::isProfitableRegion(DetectionContext &Context) const {
   Region &CurRegion = Context.CurRegion;
 
-  if (PollyProcessUnprofitable)
+  if (ProcessUnprofitable)
     return true;
 
   // We can probably not do a lot on scops that only write or only read
@@ -1905,6 +2062,10 @@ ScopAnalysis::ScopAnalysis() {
     PollyUseRuntimeAliasChecks = false;
 }
 
+ScopAnalysis::ScopAnalysis(bool IgnoreProfitability) : ScopAnalysis() {
+  this->IgnoreProfitability = IgnoreProfitability;
+}
+
 void ScopDetectionWrapperPass::releaseMemory() { Result.reset(); }
 
 char ScopDetectionWrapperPass::ID;
@@ -1918,7 +2079,7 @@ ScopDetection ScopAnalysis::run(Function &F, FunctionAnalysisManager &FAM) {
   auto &SE = FAM.getResult<ScalarEvolutionAnalysis>(F);
   auto &DT = FAM.getResult<DominatorTreeAnalysis>(F);
   auto &ORE = FAM.getResult<OptimizationRemarkEmitterAnalysis>(F);
-  return {F, DT, SE, LI, RI, AA, ORE};
+  return {F, DT, SE, LI, RI, AA, ORE, IgnoreProfitability};
 }
 
 PreservedAnalyses ScopAnalysisPrinterPass::run(Function &F,
@@ -24,6 +24,8 @@
 #include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
 #include "polly/Support/ISLTools.h"
+#include "polly/Support/IslArena.h"
+#include "polly/Support/OptimizationProfile.h"
 #include "polly/Support/SCEVAffinator.h"
 #include "polly/Support/SCEVValidator.h"
 #include "polly/Support/ScopHelper.h"
@@ -147,6 +149,11 @@ STATISTIC(NumSingletonWrites, "Number of singleton writes after ScopInfo");
 STATISTIC(NumSingletonWritesInLoops,
           "Number of singleton writes nested in affine loops after ScopInfo");
 
+STATISTIC(NumSharedAccessRelations,
+          "Number of access relations shared by compacting SCoPs");
+STATISTIC(NumDroppedNewAccessRelations,
+          "Number of new access relations dropped by compacting SCoPs");
+
 // The maximal number of basic sets we allow during domain construction to
 // be created. More complex scops will result in very high compile time and
 // are also unlikely to result in good code
@@ -201,6 +208,23 @@ static cl::opt<bool>
                     cl::desc("Abort if an isl error is encountered"),
                     cl::init(true), cl::cat(PollyCategory));
 
+static cl::opt<bool> PollyIslArena(
+    "polly-isl-arena",
+    cl::desc("Allocate the constraints, matrices and tableaus of isl from a "
+             "per-SCoP arena that is released with the SCoP"),
+    cl::Hidden, cl::init(true), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+static cl::opt<bool> PollyCompactScops(
+    "polly-compact-scops",
+    cl::desc("Release the parts of the SCoP representation that are no longer "
+             "needed and share equal access relations"),
+    cl::Hidden, cl::init(true), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+static cl::opt<bool> PollyPrintScopMemoryUsage(
+    "polly-print-scop-memory-usage",
+    cl::desc("Print the memory taken by the representation of the SCoPs"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 static cl::opt<bool> PollyPreciseInbounds(
     "polly-precise-inbounds",
     cl::desc("Take more precise inbounds assumptions (do not scale well)"),
@@ -967,6 +991,7 @@ void MemoryAccess::buildAccessRelation(const ScopArrayInfo *SAI) {
   // Initialize the invalid domain which describes all iterations for which the
   // access relation is not modeled correctly.
   isl::set StmtInvalidDomain = getStatement()->getInvalidDomain();
+  assert(!StmtInvalidDomain.is_null() && "Statement has no invalid domain");
   InvalidDomain = isl::set::empty(StmtInvalidDomain.get_space());
 
   isl::ctx Ctx = Id.get_ctx();
@@ -1142,7 +1167,10 @@ static isl::map getEqualAndLarger(isl::space SetDomain) {
 }
 
 isl::set MemoryAccess::getStride(isl::map Schedule) const {
-  isl::map AccessRelation = getAccessRelation();
+  return getStride(getAccessRelation(), Schedule);
+}
+
+isl::set MemoryAccess::getStride(isl::map AccessRelation, isl::map Schedule) {
   isl::space Space = Schedule.get_space().range();
   isl::map NextScatt = getEqualAndLarger(Space);
 
@@ -1310,6 +1338,73 @@ void ScopStmt::realignParams() {
   Domain = Domain.gist_params(Ctx);
 }
 
+/// Rebuild @p Map with the fewest buckets that hold its entries.
+template <typename MapT> static void shrinkToFit(MapT &Map) {
+  MapT Compact(Map.size());
+  if (Compact.getMemorySize() >= Map.getMemorySize())
+    return;
+  for (auto &Entry : Map)
+    Compact.try_emplace(Entry.first, std::move(Entry.second));
+  Map.swap(Compact);
+}
+
+void ScopStmt::compact() {
+  // The invalid domains only contribute to the assumptions of the SCoP, which
+  // are taken while it is built. They are emptied rather than dropped because
+  // accesses added later, e.g. by ForwardOpTree, still derive their own
+  // invalid domain from the statement's.
+  if (!InvalidDomain.is_null())
+    InvalidDomain = isl::set::empty(InvalidDomain.get_space());
+
+  // Accesses to the same elements, like the load and the store of A[i] += 1,
+  // share one isl_map. The copies of an isl_map are reference counted, so all
+  // but the shared one are freed.
+  DenseMap<uint32_t, SmallVector<isl::map, 1>> Relations;
+  auto Share = [&Relations](isl::map &Rel) {
+    if (Rel.is_null())
+      return;
+    auto &Candidates = Relations[isl_map_get_hash(Rel.get())];
+    for (isl::map &Candidate : Candidates) {
+      if (Candidate.get() == Rel.get())
+        return;
+      if (isl_map_plain_is_equal(Candidate.get(), Rel.get()) == isl_bool_true) {
+        Rel = Candidate;
+        NumSharedAccessRelations++;
+        return;
+      }
+    }
+    Candidates.push_back(Rel);
+  };
+
+  for (MemoryAccess *MA : MemAccs) {
+    if (!MA->InvalidDomain.is_null())
+      MA->InvalidDomain = isl::set::empty(MA->InvalidDomain.get_space());
+
+    if (!MA->AccessRelation.is_null() && !MA->NewAccessRelation.is_null() &&
+        MA->NewAccessRelation.is_equal(MA->AccessRelation)) {
+      MA->NewAccessRelation = nullptr;
+      NumDroppedNewAccessRelations++;
+    }
+
+    Share(MA->AccessRelation);
+    Share(MA->NewAccessRelation);
+  }
+
+  shrinkToFit(InstructionToAccess);
+  shrinkToFit(ValueReads);
+  shrinkToFit(ValueWrites);
+  shrinkToFit(PHIWrites);
+  shrinkToFit(PHIReads);
+  Instructions.shrink_to_fit();
+}
+
+size_t ScopStmt::getLookupTableBytes() const {
+  return InstructionToAccess.getMemorySize() + ValueReads.getMemorySize() +
+         ValueWrites.getMemorySize() + PHIWrites.getMemorySize() +
+         PHIReads.getMemorySize() +
+         Instructions.capacity() * sizeof(Instruction *);
+}
+
 /// Add @p BSet to set @p BoundedParts if @p BSet is bounded.
 static isl::set collectBoundedParts(isl::set S) {
   isl::set BoundedParts = isl::set::empty(S.get_space());
@@ -2776,8 +2871,14 @@ bool Scop::buildDomainsWithBranchConstraints(
     SmallVector<isl_set *, 8> ConditionSets;
     if (RN->isSubRegion())
       ConditionSets.push_back(Domain.copy());
-    else if (!buildConditionSets(*this, BB, TI, BBLoop, Domain.get(),
-                                 InvalidDomainMap, ConditionSets))
+    else if (getDynamicExitLoop() &&
+             BB == getDynamicExitLoop()->getLoopLatch()) {
+      // The backedge and the exit of a dynamic-exit loop are both skipped
+      // below; the iterations are bounded in addLoopBoundsToHeaderDomain.
+      ConditionSets.push_back(Domain.copy());
+      ConditionSets.push_back(Domain.copy());
+    } else if (!buildConditionSets(*this, BB, TI, BBLoop, Domain.get(),
+                                   InvalidDomainMap, ConditionSets))
       return false;
 
     // Now iterate over the successors and set their initial domain based on
@@ -2985,7 +3086,9 @@ bool Scop::addLoopBoundsToHeaderDomain(
     BranchInst *BI = dyn_cast<BranchInst>(TI);
     assert(BI && "Only branch instructions allowed in loop latches");
 
-    if (BI->isUnconditional())
+    // The backedge of a dynamic-exit loop is taken until its exit condition,
+    // which is only evaluated at run time, holds.
+    if (BI->isUnconditional() || L == getDynamicExitLoop())
       BackedgeCondition = LatchBBDom;
     else {
       SmallVector<isl_set *, 8> ConditionSets;
@@ -3021,6 +3124,10 @@ bool Scop::addLoopBoundsToHeaderDomain(
   HeaderBBDom = HeaderBBDom.subtract(UnionBackedgeConditionComplement);
   HeaderBBDom = HeaderBBDom.apply(NextIterationMap);
 
+  if (L == getDynamicExitLoop())
+    HeaderBBDom = HeaderBBDom.upper_bound_val(isl::dim::set, LoopDepth,
+                                              getDynamicExitLoopBound());
+
   auto Parts = partitionSetParts(HeaderBBDom, LoopDepth);
   HeaderBBDom = Parts.second;
 
@@ -3175,7 +3282,8 @@ bool Scop::buildAliasGroups(AliasAnalysis &AA) {
       return false;
 
     {
-      IslMaxOperationsGuard MaxOpGuard(getIslCtx().get(), OptComputeOut);
+      IslMaxOperationsGuard MaxOpGuard(getIslCtx().get(),
+                                       getProfileOption(OptComputeOut));
       bool Valid = buildAliasGroup(AG, HasWriteAccess);
       if (!Valid)
         return false;
@@ -3304,9 +3412,12 @@ int Scop::getNextID(std::string ParentFunc) {
 Scop::Scop(Region &R, ScalarEvolution &ScalarEvolution, LoopInfo &LI,
            DominatorTree &DT, ScopDetection::DetectionContext &DC,
            OptimizationRemarkEmitter &ORE)
-    : IslCtx(isl_ctx_alloc(), isl_ctx_free), SE(&ScalarEvolution), DT(&DT),
-      R(R), name(None), HasSingleExitEdge(R.getExitingBlock()), DC(DC),
-      ORE(ORE), Affinator(this, LI),
+    : IslCtx(PollyIslArena ? allocIslCtxWithArena()
+                           : std::shared_ptr<isl_ctx>(isl_ctx_alloc(),
+                                                      isl_ctx_free)),
+      SE(&ScalarEvolution), DT(&DT), R(R), name(None),
+      HasSingleExitEdge(R.getExitingBlock()), DC(DC), ORE(ORE),
+      Affinator(this, LI),
       ID(getNextID((*R.getEntry()->getParent()).getName().str())) {
   if (IslOnErrorAbort)
     isl_options_set_on_error(getIslCtx().get(), ISL_ON_ERROR_ABORT);
@@ -3530,10 +3641,65 @@ void Scop::removeStmtNotInDomainMap() {
   removeStmts(ShouldDelete, false);
 }
 
+void Scop::compact() {
+  if (!PollyCompactScops)
+    return;
+
+  for (ScopStmt &Stmt : Stmts)
+    Stmt.compact();
+
+  shrinkToFit(StmtMap);
+  shrinkToFit(InstStmtMap);
+  shrinkToFit(DomainMap);
+  shrinkToFit(ValueDefAccs);
+  shrinkToFit(PHIReadAccs);
+  shrinkToFit(ValueUseAccs);
+  shrinkToFit(PHIIncomingAccs);
+}
+
+ScopMemoryUsage Scop::getMemoryUsage() const {
+  ScopMemoryUsage Usage;
+  Usage.ObjectBytes = sizeof(Scop) + Stmts.size() * sizeof(ScopStmt) +
+                      AccessFunctions.size() * sizeof(MemoryAccess) +
+                      ScopArrayInfoSet.size() * sizeof(ScopArrayInfo);
+
+  Usage.LookupTableBytes =
+      StmtMap.getMemorySize() + InstStmtMap.getMemorySize() +
+      DomainMap.getMemorySize() + ValueDefAccs.getMemorySize() +
+      PHIReadAccs.getMemorySize() + ValueUseAccs.getMemorySize() +
+      PHIIncomingAccs.getMemorySize();
+  for (auto &Entry : StmtMap)
+    Usage.LookupTableBytes += Entry.second.capacity() * sizeof(ScopStmt *);
+
+  DenseSet<isl_map *> DistinctRelations;
+  for (const ScopStmt &Stmt : Stmts) {
+    Usage.NumStmts++;
+    Usage.LookupTableBytes += Stmt.getLookupTableBytes();
+    for (MemoryAccess *MA : Stmt) {
+      Usage.NumAccesses++;
+      for (const isl::map &Rel : {MA->AccessRelation, MA->NewAccessRelation})
+        if (!Rel.is_null()) {
+          Usage.NumAccessRelations++;
+          DistinctRelations.insert(Rel.get());
+        }
+    }
+  }
+  Usage.NumDistinctAccessRelations = DistinctRelations.size();
+
+  if (const IslArena *Arena = getIslArena(IslCtx))
+    Usage.IslBytes = Arena->getBytesInUse();
+  return Usage;
+}
+
 void Scop::simplifySCoP(bool AfterHoisting) {
-  auto ShouldDelete = [AfterHoisting](ScopStmt &Stmt) -> bool {
-    // Never delete statements that contain calls to debug functions.
-    if (hasDebugCall(&Stmt))
+  auto ShouldDelete = [this, AfterHoisting](ScopStmt &Stmt) -> bool {
+    // Never delete statements that contain calls to debug functions or calls
+    // with unknown side effects.
+    if (hasDebugCall(&Stmt) || hasBookkeepingCall(Stmt))
+      return false;
+
+    // The exit condition of a dynamic-exit loop must be evaluated.
+    if (&Stmt == getDynamicExitStmt())
       return false;
 
     bool RemoveStmt = Stmt.isEmpty();
@@ -4348,6 +4514,18 @@ void Scop::printArrayInfo(raw_ostream &OS) const {
   OS.indent(4) << "}\n";
 }
 
+void ScopMemoryUsage::print(raw_ostream &OS) const {
+  OS << "Memory Usage: {\n";
+  OS.indent(8) << "Statements: " << NumStmts << "\n";
+  OS.indent(8) << "Accesses: " << NumAccesses << "\n";
+  OS.indent(8) << "Access relations: " << NumAccessRelations << " ("
+               << NumDistinctAccessRelations << " distinct)\n";
+  OS.indent(8) << "Object bytes: " << ObjectBytes << "\n";
+  OS.indent(8) << "Lookup table bytes: " << LookupTableBytes << "\n";
+  OS.indent(8) << "isl bytes: " << IslBytes << "\n";
+  OS.indent(4) << "}\n";
+}
+
 void Scop::print(raw_ostream &OS, bool PrintInstructions) const {
   OS.indent(4) << "Function: " << getFunction().getName() << "\n";
   OS.indent(4) << "Region: " << getNameStr() << "\n";
@@ -4368,6 +4546,8 @@ void Scop::print(raw_ostream &OS, bool PrintInstructions) const {
   printArrayInfo(OS.indent(4));
   printAliasAssumptions(OS);
   printStatements(OS.indent(4), PrintInstructions);
+  if (PollyPrintScopMemoryUsage)
+    getMemoryUsage().print(OS.indent(4));
 }
 
 #if !defined(NDEBUG) || defined(LLVM_ENABLE_DUMP)
@@ -4716,6 +4896,7 @@ void Scop::buildSchedule(RegionNode *RN, LoopStackTy &LoopStack, LoopInfo &LI) {
          LoopData->NumBlocksProcessed == getNumBlocksInLoop(LoopData->L)) {
     isl::schedule Schedule = LoopData->Schedule;
     auto NumBlocksProcessed = LoopData->NumBlocksProcessed;
+    Loop *L = LoopData->L;
 
     assert(std::next(LoopData) != LoopStack.rend());
     ++LoopData;
@@ -4725,6 +4906,15 @@ void Scop::buildSchedule(RegionNode *RN, LoopStackTy &LoopStack, LoopInfo &LI) {
       isl::union_set Domain = Schedule.get_domain();
       isl::multi_union_pw_aff MUPA = mapToDimension(Domain, Dimension);
       Schedule = Schedule.insert_partial_schedule(MUPA);
+
+      // Remember user-requested transformations of this loop with a mark
+      // node above its band, to be applied by the schedule optimizer.
+      if (hasLoopTransformationMetadata(L)) {
+        isl::schedule_node Band = Schedule.get_root().child(0);
+        Band = Band.insert_mark(getIslLoopAttr(getIslCtx(), L));
+        Schedule = Band.get_schedule();
+      }
+
       LoopData->Schedule = combineInSequence(LoopData->Schedule, Schedule);
     }
 
@@ -4765,6 +4955,18 @@ ScopStmt *Scop::getLastStmtFor(BasicBlock *BB) const {
   return nullptr;
 }
 
+ScopStmt *Scop::getDynamicExitStmt() const {
+  if (Loop *L = getDynamicExitLoop())
+    return getLastStmtFor(L->getLoopLatch());
+  return nullptr;
+}
+
+isl::val Scop::getDynamicExitLoopBound() const {
+  // Large enough for any loop to leave earlier, small enough for the
+  // iteration numbers and their sums to fit into 64 bits.
+  return isl::val::int_from_ui(getIslCtx(), 62).pow2().sub_ui(1);
+}
+
 ArrayRef<ScopStmt *> Scop::getStmtListFor(RegionNode *RN) const {
   if (RN->isSubRegion())
     return getStmtListFor(RN->getNodeAs<Region>());
@@ -5059,6 +5261,19 @@ void ScopInfo::recompute() {
   }
 }
 
+Scop *ScopInfo::recompute(Region *R) {
+  ScopBuilder SB(R, AC, AA, DL, DT, LI, SD, SE, ORE);
+  std::unique_ptr<Scop> S = SB.getScop();
+  if (!S) {
+    RegionToScopMap.erase(R);
+    return nullptr;
+  }
+
+  Scop *Result = S.get();
+  RegionToScopMap[R] = std::move(S);
+  return Result;
+}
+
 bool ScopInfo::invalidate(Function &F, const PreservedAnalyses &PA,
                           FunctionAnalysisManager::Invalidator &Inv) {
   // Check whether the analysis, all analyses on functions have been preserved
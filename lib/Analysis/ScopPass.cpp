@@ -57,6 +57,14 @@ void ScopPass::getAnalysisUsage(AnalysisUsage &AU) const {
   AU.addPreserved<TargetTransformInfoWrapperPass>();
 }
 
+PreservedAnalyses polly::getScopPassPreservedAnalyses() {
+  PreservedAnalyses PA;
+  PA.preserveSet<AllAnalysesOn<Module>>();
+  PA.preserveSet<AllAnalysesOn<Function>>();
+  PA.preserveSet<AllAnalysesOn<Loop>>();
+  return PA;
+}
+
 namespace polly {
 template class OwningInnerAnalysisManagerProxy<ScopAnalysisManager, Function>;
 }
@@ -80,6 +88,10 @@ PassManager<Scop, ScopAnalysisManager, ScopStandardAnalysisResults &,
 
     AM.invalidate(S, PassPA);
     PA.intersect(std::move(PassPA));
+
+    // The remaining passes must not see a SCoP whose code was generated.
+    if (U.invalidateCurrentScop())
+      break;
   }
 
   // All analyses for 'this' Scop have been invalidated above.
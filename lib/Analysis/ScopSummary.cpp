@@ -0,0 +1,251 @@
+//===- ScopSummary.cpp - Polyhedral summaries of function accesses --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Compute polyhedral summaries of the memory accesses of functions that are
+// (apart from accesses-free code) a single SCoP.
+//
+// The summary is computed by running ScopDetection and ScopInfo on the callee
+// with a private analysis manager, which only reads the callee and is
+// discarded together with its results once the summary is built. The callee's
+// SCoP is built even if it is not considered profitable. For every memory
+// access of the callee's SCoP the accessed elements are projected onto the
+// parameters. Parameters that are integer arguments of the callee are kept
+// (renamed to "argN"), all others are projected out, which over-approximates
+// the accessed elements.
+//
+//===----------------------------------------------------------------------===//
+
+#include "polly/ScopSummary.h"
+#include "polly/Options.h"
+#include "polly/ScopDetection.h"
+#include "polly/ScopInfo.h"
+#include "polly/Support/GICHelper.h"
+#include "polly/Support/ScopHelper.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Mutex.h"
+#include "isl/aff.h"
+
+using namespace llvm;
+using namespace polly;
+
+#define DEBUG_TYPE "polly-scop-summary"
+
+STATISTIC(SummariesComputed, "Number of functions summarized");
+STATISTIC(SummariesFailed, "Number of functions that cannot be summarized");
+
+bool polly::PollyUseScopSummaries;
+
+static cl::opt<bool, true> XUseScopSummaries(
+    "polly-scop-summaries",
+    cl::desc("Model calls to functions that are a single SCoP by a summary "
+             "of their memory accesses"),
+    cl::location(PollyUseScopSummaries), cl::Hidden, cl::init(false),
+    cl::ZeroOrMore, cl::cat(PollyCategory));
+
+/// The functions whose summary is being computed, to break recursion. A
+/// summary is computed by a nested analysis run with its own
+/// FunctionAccessSummaries, so this set is shared by all of them.
+static ManagedStatic<SmallPtrSet<const Function *, 4>> InProgress;
+
+/// Protects InProgress. Recursive, as computing a summary detects SCoPs in
+/// the callee, which may ask for summaries of its callees.
+static ManagedStatic<sys::SmartMutex<true>> SummaryLock;
+
+/// Map the elements accessed in @p SAI to a one-dimensional set of element
+/// indices relative to the base pointer.
+///
+/// @return The linearized elements, or nullptr if the inner dimensions of
+///         @p SAI do not have a constant size.
+static isl::set linearizeElements(const ScopArrayInfo *SAI,
+                                  isl::set Elements) {
+  unsigned Dims = SAI->getNumberOfDimensions();
+  Elements = Elements.reset_tuple_id();
+  if (Dims == 1)
+    return Elements;
+  if (Dims == 0)
+    return nullptr;
+
+  isl::local_space LS(Elements.get_space());
+  isl::aff Linear(LS);
+  int64_t Stride = 1;
+  for (int i = Dims - 1; i >= 0; i--) {
+    isl::aff Dim = isl::aff::var_on_domain(LS, isl::dim::set, i);
+    Linear = Linear.add(Dim.scale(isl::val(Elements.get_ctx(), Stride)));
+    if (i == 0)
+      break;
+
+    auto *Size = dyn_cast_or_null<SCEVConstant>(SAI->getDimensionSize(i));
+    if (!Size)
+      return nullptr;
+    Stride *= Size->getAPInt().getSExtValue();
+  }
+
+  return Elements.apply(isl::map::from_aff(Linear));
+}
+
+/// Express the parameters of @p Elements in terms of the arguments of the
+/// function.
+///
+/// Parameters that are integer arguments are renamed to "argN"; all other
+/// parameters are projected out.
+static isl::set renameParams(isl::set Elements,
+                             SmallVectorImpl<unsigned> &ParamArguments) {
+  for (int i = Elements.dim(isl::dim::param) - 1; i >= 0; i--) {
+    isl::id Id = Elements.get_dim_id(isl::dim::param, i);
+    auto *Param = static_cast<const SCEV *>(Id.get_user());
+    auto *Unknown = dyn_cast_or_null<SCEVUnknown>(Param);
+    auto *Arg = Unknown ? dyn_cast<Argument>(Unknown->getValue()) : nullptr;
+
+    if (!Arg || !Arg->getType()->isIntegerTy()) {
+      Elements = Elements.project_out(isl::dim::param, i, 1);
+      continue;
+    }
+
+    unsigned ArgNo = Arg->getArgNo();
+    std::string Name = "arg" + std::to_string(ArgNo);
+    Elements = Elements.set_dim_id(
+        isl::dim::param, i, isl::id::alloc(Elements.get_ctx(), Name, nullptr));
+    if (!is_contained(ParamArguments, ArgNo))
+      ParamArguments.push_back(ArgNo);
+  }
+  return Elements.coalesce();
+}
+
+static std::unique_ptr<FunctionAccessSummary> computeSummary(Function &F) {
+  if (F.isDeclaration() || F.isVarArg() || !F.hasExactDefinition())
+    return nullptr;
+
+  PassBuilder PB;
+  FunctionAnalysisManager FAM;
+  // Small leaf functions are rarely considered profitable on their own, but
+  // are the functions that summaries are most useful for.
+  FAM.registerPass([] { return ScopAnalysis(/*IgnoreProfitability=*/true); });
+  FAM.registerPass([] { return ScopInfoAnalysis(); });
+  PB.registerFunctionAnalyses(FAM);
+
+  ScopInfo &SI = FAM.getResult<ScopInfoAnalysis>(F);
+  Scop *S = nullptr;
+  for (auto &It : SI) {
+    if (!It.second)
+      continue;
+    if (S) {
+      LLVM_DEBUG(dbgs() << F.getName() << " has more than one SCoP\n");
+      return nullptr;
+    }
+    S = It.second.get();
+  }
+  if (!S) {
+    LLVM_DEBUG(dbgs() << F.getName() << " has no SCoP\n");
+    return nullptr;
+  }
+
+  // All memory accesses of the function must be modeled by the SCoP.
+  const Region &R = S->getRegion();
+  for (Instruction &Inst : instructions(F)) {
+    if (R.contains(&Inst) || !Inst.mayReadOrWriteMemory() ||
+        isIgnoredIntrinsic(&Inst))
+      continue;
+    LLVM_DEBUG(dbgs() << F.getName() << " accesses memory outside the SCoP: "
+                      << Inst << "\n");
+    return nullptr;
+  }
+
+  // The accesses of the SCoP describe the accesses of the function only if
+  // the SCoP does not depend on assumptions, i.e. its optimized version is
+  // always executed.
+  if (!S->hasTrivialInvalidContext() ||
+      !S->getContext().is_subset(S->getAssumedContext()) ||
+      !S->getInvariantAccesses().empty()) {
+    LLVM_DEBUG(dbgs() << F.getName() << " SCoP depends on assumptions\n");
+    return nullptr;
+  }
+
+  auto Summary = llvm::make_unique<FunctionAccessSummary>();
+  DenseMap<unsigned, std::pair<isl::set, isl::set>> AccessedElements;
+  for (ScopStmt &Stmt : *S) {
+    for (polly::MemoryAccess *MA : Stmt) {
+      if (!MA->isOriginalArrayKind())
+        continue;
+
+      const ScopArrayInfo *SAI = MA->getOriginalScopArrayInfo();
+      auto *Arg = dyn_cast<Argument>(SAI->getBasePtr());
+      if (!Arg) {
+        LLVM_DEBUG(dbgs() << F.getName() << " accesses memory not passed as "
+                          << "argument: " << SAI->getName() << "\n");
+        return nullptr;
+      }
+
+      isl::set Elements =
+          MA->getAccessRelation().intersect_domain(Stmt.getDomain()).range();
+      Elements = linearizeElements(SAI, Elements);
+      if (!Elements) {
+        LLVM_DEBUG(dbgs() << F.getName() << " has an array of parametric "
+                          << "size: " << SAI->getName() << "\n");
+        return nullptr;
+      }
+      Elements = renameParams(Elements, Summary->ParamArguments);
+
+      unsigned ArgNo = Arg->getArgNo();
+      auto &ArgAccesses = Summary->Arguments[ArgNo];
+      ArgAccesses.ElementType = SAI->getElementType();
+      ArgAccesses.ElementSize = SAI->getElemSizeInBytes();
+
+      auto &Accessed = AccessedElements[ArgNo];
+      isl::set &Union = MA->isRead() ? Accessed.first : Accessed.second;
+      Union = Union ? Union.unite(Elements) : Elements;
+    }
+  }
+
+  for (auto &Accessed : AccessedElements) {
+    auto &ArgAccesses = Summary->Arguments[Accessed.first];
+    if (isl::set Reads = Accessed.second.first)
+      ArgAccesses.Reads = Reads.coalesce().to_str();
+    if (isl::set Writes = Accessed.second.second)
+      ArgAccesses.Writes = Writes.coalesce().to_str();
+  }
+
+  return Summary;
+}
+
+const FunctionAccessSummary *FunctionAccessSummaries::get(Function &F) {
+  sys::SmartScopedLock<true> Lock(*SummaryLock);
+
+  auto It = Summaries.find(&F);
+  if (It != Summaries.end())
+    return It->second.get();
+
+  // A recursive call; its accesses are not known yet.
+  if (!InProgress->insert(&F).second)
+    return nullptr;
+
+  std::unique_ptr<FunctionAccessSummary> Summary = computeSummary(F);
+  InProgress->erase(&F);
+
+  if (Summary) {
+    SummariesComputed++;
+    LLVM_DEBUG({
+      dbgs() << "Summary of " << F.getName() << ":\n";
+      for (auto &ArgAccesses : Summary->Arguments)
+        dbgs() << "  arg" << ArgAccesses.first
+               << " reads: " << ArgAccesses.second.Reads
+               << " writes: " << ArgAccesses.second.Writes << "\n";
+    });
+  } else {
+    SummariesFailed++;
+  }
+
+  auto &Entry = Summaries[&F];
+  Entry = std::move(Summary);
+  return Entry.get();
+}
@@ -430,7 +430,62 @@ void BlockGenerator::copyStmt(ScopStmt &Stmt, LoopToScevMapT &LTS,
 
   BasicBlock *BB = Stmt.getBasicBlock();
   copyBB(Stmt, BB, BBMap, LTS, NewAccesses);
+
+  BasicBlock *ContBB = nullptr;
+  if (&Stmt == Stmt.getParent()->getDynamicExitStmt())
+    ContBB = generateDynamicExit(Stmt, LTS, BBMap);
+
   removeDeadInstructions(BB, BBMap);
+  if (ContBB)
+    Builder.SetInsertPoint(&ContBB->front());
+}
+
+/// Return the exiting block of the optimized version of @p S.
+///
+/// After the versioning of @p S, the exit of @p S merges the exiting block of
+/// the original region and the one of the optimized region.
+static BasicBlock *getOptimizedExitingBlock(Scop &S) {
+  // The exit block of the __unoptimized__ region.
+  BasicBlock *ExitBB = S.getExitingBlock();
+  // The merge block __just after__ the region and the optimized region.
+  BasicBlock *MergeBB = S.getExit();
+
+  BasicBlock *OptExitBB = *(pred_begin(MergeBB));
+  if (OptExitBB == ExitBB)
+    OptExitBB = *(++pred_begin(MergeBB));
+  return OptExitBB;
+}
+
+BasicBlock *BlockGenerator::generateDynamicExit(ScopStmt &Stmt,
+                                                LoopToScevMapT &LTS,
+                                                ValueMapT &BBMap) {
+  Scop &S = *Stmt.getParent();
+  Loop *L = S.getDynamicExitLoop();
+  auto *Latch = Stmt.getBasicBlock();
+  auto *BI = cast<BranchInst>(Latch->getTerminator());
+
+  Value *ExitCond = getNewValue(Stmt, BI->getCondition(), BBMap, LTS,
+                                getLoopForStmt(Stmt));
+  assert(ExitCond && "The exit condition must be available in the copy");
+  if (L->contains(BI->getSuccessor(0)))
+    ExitCond = Builder.CreateNot(ExitCond, "polly.dynamic_exit.cond");
+
+  // The domains of the statements over-approximate the iterations of the
+  // loop, hence the generated code is left where the original loop is left.
+  BasicBlock *CondBB = Builder.GetInsertBlock();
+  BasicBlock *ContBB = SplitBlock(CondBB, &*Builder.GetInsertPoint(), &DT, &LI);
+  ContBB->setName("polly.stmt." + Latch->getName() + ".cont");
+
+  BasicBlock *OptExitBB = getOptimizedExitingBlock(S);
+  CondBB->getTerminator()->eraseFromParent();
+  Builder.SetInsertPoint(CondBB);
+  Builder.CreateCondBr(ExitCond, OptExitBB, ContBB);
+
+  BasicBlock *IDom = DT.getNode(OptExitBB)->getIDom()->getBlock();
+  DT.changeImmediateDominator(OptExitBB,
+                              DT.findNearestCommonDominator(IDom, CondBB));
+  Builder.SetInsertPoint(CondBB->getTerminator());
+  return ContBB;
 }
 
 BasicBlock *BlockGenerator::splitBB(BasicBlock *BB) {
@@ -871,9 +926,7 @@ void BlockGenerator::createScalarFinalization(Scop &S) {
   BasicBlock *MergeBB = S.getExit();
 
   // The exit block of the __optimized__ region.
-  BasicBlock *OptExitBB = *(pred_begin(MergeBB));
-  if (OptExitBB == ExitBB)
-    OptExitBB = *(++pred_begin(MergeBB));
+  BasicBlock *OptExitBB = getOptimizedExitingBlock(S);
 
   Builder.SetInsertPoint(OptExitBB->getTerminator());
   for (const auto &EscapeMapping : EscapeMap) {
@@ -941,9 +994,7 @@ void BlockGenerator::createExitPHINodeMerges(Scop &S) {
   auto *ExitBB = S.getExitingBlock();
   auto *MergeBB = S.getExit();
   auto *AfterMergeBB = MergeBB->getSingleSuccessor();
-  BasicBlock *OptExitBB = *(pred_begin(MergeBB));
-  if (OptExitBB == ExitBB)
-    OptExitBB = *(++pred_begin(MergeBB));
+  BasicBlock *OptExitBB = getOptimizedExitingBlock(S);
 
   Builder.SetInsertPoint(OptExitBB->getTerminator());
 
@@ -29,14 +29,17 @@
 #include "polly/Options.h"
 #include "polly/ScopDetectionDiagnostic.h"
 #include "polly/ScopInfo.h"
+#include "polly/Support/OptimizationProfile.h"
 #include "polly/Support/ScopHelper.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/BasicAliasAnalysis.h"
 #include "llvm/Analysis/GlobalsModRef.h"
 #include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/RegionInfo.h"
 #include "llvm/Analysis/ScalarEvolutionAliasAnalysis.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
@@ -54,6 +57,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include "isl/ast.h"
 #include <cassert>
+#include <memory>
 #include <utility>
 
 using namespace llvm;
@@ -80,6 +84,8 @@ STATISTIC(CodegenedAffineLoops,
           "Number of original affine loops in SCoPs that have been generated");
 STATISTIC(CodegenedBoxedLoops,
           "Number of original boxed loops in SCoPs that have been generated");
+STATISTIC(NumIslOperations,
+          "Number of isl operations performed by the code generation");
 
 namespace polly {
 
@@ -178,8 +184,9 @@ static void removeLifetimeMarkers(Region *R) {
   }
 }
 
-static bool CodeGen(Scop &S, IslAstInfo &AI, LoopInfo &LI, DominatorTree &DT,
-                    ScalarEvolution &SE, RegionInfo &RI) {
+bool polly::generateCode(Scop &S, IslAstInfo &AI, LoopInfo &LI,
+                         DominatorTree &DT, ScalarEvolution &SE,
+                         RegionInfo &RI) {
   // Check whether IslAstInfo uses the same isl_ctx. Since -polly-codegen
   // reports itself to preserve DependenceInfo and IslAstInfo, we might get
   // those analysis that were computed by a different ScopInfo for a different
@@ -199,6 +206,9 @@ static bool CodeGen(Scop &S, IslAstInfo &AI, LoopInfo &LI, DominatorTree &DT,
     return false;
   }
 
+  OptimizationProfileScope ProfileScope(S);
+  IslOperationsCounter OpsCounter(S.getIslCtx().get(), NumIslOperations);
+
   // Check if we created an isl_ast root node, otherwise exit.
   isl_ast_node *AstRoot = Ast.getAst();
   if (!AstRoot)
@@ -242,13 +252,15 @@ static bool CodeGen(Scop &S, IslAstInfo &AI, LoopInfo &LI, DominatorTree &DT,
   NodeBuilder.allocateNewArrays(StartExitBlocks);
   Annotator.buildAliasScopes(S);
 
+  std::unique_ptr<PerfMonitor> P;
   if (PerfMonitoring) {
-    PerfMonitor P(S, EnteringBB->getParent()->getParent());
-    P.initialize();
-    P.insertRegionStart(SplitBlock->getTerminator());
+    P = llvm::make_unique<PerfMonitor>(S, EnteringBB->getParent()->getParent());
+    P->initialize();
+    P->insertRegionStart(SplitBlock->getTerminator());
 
     BasicBlock *MergeBlock = ExitBlock->getUniqueSuccessor();
-    P.insertRegionEnd(MergeBlock->getTerminator());
+    P->insertRegionEnd(MergeBlock->getTerminator());
+    NodeBuilder.setPerfMonitor(P.get());
   }
 
   // First generate code for the hoisted invariant loads and transitively the
@@ -345,7 +357,7 @@ public:
     SE = &getAnalysis<ScalarEvolutionWrapperPass>().getSE();
     DL = &S.getFunction().getParent()->getDataLayout();
     RI = &getAnalysis<RegionInfoPass>().getRegionInfo();
-    return CodeGen(S, *AI, *LI, *DT, *SE, *RI);
+    return generateCode(S, *AI, *LI, *DT, *SE, *RI);
   }
 
   /// Register all analyses and transformation required.
@@ -373,9 +385,26 @@ PreservedAnalyses CodeGenerationPass::run(Scop &S, ScopAnalysisManager &SAM,
                                           ScopStandardAnalysisResults &AR,
                                           SPMUpdater &U) {
   auto &AI = SAM.getResult<IslAstAnalysis>(S, AR);
-  if (CodeGen(S, AI, AR.LI, AR.DT, AR.SE, AR.RI)) {
+  if (generateCode(S, AI, AR.LI, AR.DT, AR.SE, AR.RI)) {
     U.invalidateScop(S);
-    return PreservedAnalyses::none();
+
+    // generateCode keeps the dominator tree, the loops, the regions and
+    // ScalarEvolution up to date, and the new code does not invalidate any
+    // aliasing or target information. The other SCoPs of the function are
+    // only built anew if they use the generated code.
+    PreservedAnalyses PA;
+    PA.preserve<AAManager>();
+    PA.preserve<BasicAA>();
+    PA.preserve<SCEVAA>();
+    PA.preserve<DominatorTreeAnalysis>();
+    PA.preserve<LoopAnalysis>();
+    PA.preserve<RegionInfoAnalysis>();
+    PA.preserve<ScalarEvolutionAnalysis>();
+    PA.preserve<OptimizationRemarkEmitterAnalysis>();
+    PA.preserve<TargetIRAnalysis>();
+    PA.preserve<ScopAnalysis>();
+    PA.preserve<ScopInfoAnalysis>();
+    return PA;
   }
 
   return PreservedAnalyses::all();
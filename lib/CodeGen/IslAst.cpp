@@ -35,8 +35,12 @@
 #include "polly/ScopInfo.h"
 #include "polly/ScopPass.h"
 #include "polly/Support/GICHelper.h"
+#include "polly/Support/OptimizationProfile.h"
+#include "polly/Support/ScopHelper.h"
+#include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/Pass.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
@@ -49,6 +53,7 @@
 #include "isl/map.h"
 #include "isl/printer.h"
 #include "isl/schedule.h"
+#include "isl/schedule_node.h"
 #include "isl/set.h"
 #include "isl/union_map.h"
 #include "isl/val.h"
@@ -92,6 +97,18 @@ static cl::opt<bool> DetectParallel("polly-ast-detect-parallel",
                                     cl::init(false), cl::ZeroOrMore,
                                     cl::cat(PollyCategory));
 
+static cl::opt<bool> PrivatizeArrays(
+    "polly-privatize-arrays",
+    cl::desc("Privatize temporary arrays to execute loops in parallel whose "
+             "only loop-carried dependences are on these arrays"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+static cl::opt<unsigned long> PrivatizationMaxOps(
+    "polly-privatization-max-ops",
+    cl::desc("Maximal number of isl operations for the privatization analysis "
+             "(0 = no limit)"),
+    cl::Hidden, cl::init(500000), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 STATISTIC(ScopsProcessed, "Number of SCoPs processed");
 STATISTIC(ScopsBeneficial, "Number of beneficial SCoPs");
 STATISTIC(BeneficialAffineLoops, "Number of beneficial affine loops");
@@ -102,11 +119,42 @@ STATISTIC(NumParallel, "Number of parallel for-loops");
 STATISTIC(NumInnermostParallel, "Number of innermost parallel for-loops");
 STATISTIC(NumOutermostParallel, "Number of outermost parallel for-loops");
 STATISTIC(NumReductionParallel, "Number of reduction-parallel for-loops");
+STATISTIC(NumPrivatizedParallel,
+          "Number of for-loops parallel after array privatization");
 STATISTIC(NumExecutedInParallel, "Number of for-loops executed in parallel");
 STATISTIC(NumIfConditions, "Number of if-conditions");
+STATISTIC(NumIslOperations,
+          "Number of isl operations performed by the AST generation");
 
 namespace polly {
 
+/// The dependences of a SCoP, separated into those on arrays that are
+/// candidates for privatization and all others.
+struct PrivatizationInfo {
+  /// The dependences on an array that can be privatized.
+  struct Candidate {
+    const ScopArrayInfo *SAI;
+
+    /// The read-after-write (flow) dependences.
+    isl::union_map Flow;
+
+    /// The read-after-write, write-after-write and write-after-read
+    /// dependences.
+    isl::union_map Deps;
+
+    /// The statement instances that read elements not written before.
+    isl::union_set NoSource;
+
+    /// The statement instances that access the array.
+    isl::union_set Accessors;
+  };
+
+  SmallVector<Candidate, 4> Candidates;
+
+  /// The dependences on all other arrays and scalars.
+  isl::union_map OtherDeps;
+};
+
 /// Temporary information used when building the ast.
 struct AstBuildUserInfo {
   /// Construct and initialize the helper struct for AST creation.
@@ -115,12 +163,20 @@ struct AstBuildUserInfo {
   /// The dependence information used for the parallelism check.
   const Dependences *Deps = nullptr;
 
+  /// The dependences used to find loops that are parallel after array
+  /// privatization, or nullptr if arrays are not privatized.
+  const PrivatizationInfo *Privatization = nullptr;
+
   /// Flag to indicate that we are inside a parallel for node.
   bool InParallelFor = false;
 
   /// Flag to indicate that we are inside an SIMD node.
   bool InSIMD = false;
 
+  /// Flag to indicate that the next for node was requested to be executed
+  /// in parallel by the user.
+  bool InParallelizeMark = false;
+
   /// The last iterator id created for the current SCoP.
   isl_id *LastForNodeId = nullptr;
 };
@@ -174,12 +230,29 @@ static const std::string getBrokenReductionsStr(__isl_keep isl_ast_node *Node) {
   return str;
 }
 
+/// Return the privatized arrays as a private clause (OpenMP style).
+static std::string getPrivatizedArraysStr(__isl_keep isl_ast_node *Node) {
+  ArrayRef<const ScopArrayInfo *> Arrays =
+      IslAstInfo::getPrivatizedArrays(Node);
+  if (Arrays.empty())
+    return "";
+
+  std::string str = " private(";
+  for (const ScopArrayInfo *SAI : Arrays) {
+    if (SAI != Arrays.front())
+      str += ", ";
+    str += SAI->getName();
+  }
+  return str + ")";
+}
+
 /// Callback executed for each for node in the ast in order to print it.
 static isl_printer *cbPrintFor(__isl_take isl_printer *Printer,
                                __isl_take isl_ast_print_options *Options,
                                __isl_keep isl_ast_node *Node, void *) {
   isl_pw_aff *DD = IslAstInfo::getMinimalDependenceDistance(Node);
   const std::string BrokenReductionsStr = getBrokenReductionsStr(Node);
+  const std::string PrivateStr = getPrivatizedArraysStr(Node);
   const std::string KnownParallelStr = "#pragma known-parallel";
   const std::string DepDisPragmaStr = "#pragma minimal dependence distance: ";
   const std::string SimdPragmaStr = "#pragma simd";
@@ -192,9 +265,10 @@ static isl_printer *cbPrintFor(__isl_take isl_printer *Printer,
     Printer = printLine(Printer, SimdPragmaStr + BrokenReductionsStr);
 
   if (IslAstInfo::isExecutedInParallel(Node))
-    Printer = printLine(Printer, OmpPragmaStr);
+    Printer = printLine(Printer, OmpPragmaStr + PrivateStr);
   else if (IslAstInfo::isOutermostParallel(Node))
-    Printer = printLine(Printer, KnownParallelStr + BrokenReductionsStr);
+    Printer =
+        printLine(Printer, KnownParallelStr + BrokenReductionsStr + PrivateStr);
 
   isl_pw_aff_free(DD);
   return isl_ast_node_for_print(Node, Printer, Options);
@@ -257,6 +331,67 @@ static bool astScheduleDimIsParallel(__isl_keep isl_ast_build *Build,
   return true;
 }
 
+/// Check if all schedule dimensions of @p Deps are zero under @p Schedule,
+/// i.e. if each dependence stays within one iteration of the current loop.
+static bool isLoopIndependent(isl::union_map Schedule, isl::union_map Deps) {
+  Deps = Deps.apply_domain(Schedule).apply_range(Schedule);
+  if (Deps.is_empty())
+    return true;
+
+  isl::set Range(Schedule.range());
+  isl::map Identity = isl::map::identity(Range.get_space().map_from_set());
+  return Deps.is_subset(isl::union_map(Identity));
+}
+
+/// Check if the current scheduling dimension becomes parallel when some of
+/// the arrays are privatized, i.e. each thread works on its own copy.
+///
+/// An array can be privatized if every element read in an iteration of the
+/// loop was written before in the same iteration and no element written in
+/// the loop is read after it. The arrays to privatize are added to
+/// @p NodeInfo.
+static bool astScheduleDimIsPrivatizable(__isl_keep isl_ast_build *Build,
+                                         const Dependences *D,
+                                         const PrivatizationInfo *PI,
+                                         IslAstUserPayload *NodeInfo) {
+  isl::union_map Schedule = isl::manage(isl_ast_build_get_schedule(Build));
+  isl::union_set Domain = Schedule.domain();
+  if (Domain.is_empty())
+    return false;
+
+  if (!D->isParallel(Schedule.get(), PI->OtherDeps.copy()))
+    return false;
+
+  SmallVector<const ScopArrayInfo *, 4> Privatized;
+  for (const PrivatizationInfo::Candidate &C : PI->Candidates) {
+    if (C.Accessors.intersect(Domain).is_empty())
+      continue;
+    if (D->isParallel(Schedule.get(), C.Deps.copy()))
+      continue;
+
+    if (!C.NoSource.intersect(Domain).is_empty())
+      return false;
+
+    // No element may be written outside the loop and read inside, or the
+    // other way around.
+    if (!C.Flow.intersect_domain(Domain).range().is_subset(Domain) ||
+        !C.Flow.intersect_range(Domain).domain().is_subset(Domain))
+      return false;
+
+    if (!isLoopIndependent(Schedule, C.Flow))
+      return false;
+
+    Privatized.push_back(C.SAI);
+  }
+
+  if (Privatized.empty())
+    return false;
+
+  NodeInfo->PrivatizedArrays.append(Privatized.begin(), Privatized.end());
+  NodeInfo->MinimalDependenceDistance = nullptr;
+  return true;
+}
+
 // This method is executed before the construction of a for node. It creates
 // an isl_id that is used to annotate the subsequently generated ast for nodes.
 //
@@ -272,8 +407,22 @@ static __isl_give isl_id *astBuildBeforeFor(__isl_keep isl_ast_build *Build,
   Id = isl_id_set_free_user(Id, freeIslAstUserPayload);
   BuildInfo->LastForNodeId = Id;
 
-  Payload->IsParallel =
-      astScheduleDimIsParallel(Build, BuildInfo->Deps, Payload);
+  // The schedule optimizer already verified that a loop the user requested
+  // to be parallelized does not carry any dependences.
+  if (BuildInfo->InParallelizeMark) {
+    Payload->IsParallel = Payload->IsUserParallel = true;
+    BuildInfo->InParallelizeMark = false;
+  } else {
+    Payload->IsParallel =
+        astScheduleDimIsParallel(Build, BuildInfo->Deps, Payload);
+
+    // Only the outermost parallel loop can create private copies.
+    if (!Payload->IsParallel && BuildInfo->Privatization &&
+        !BuildInfo->InParallelFor && !BuildInfo->InSIMD)
+      Payload->IsParallel =
+          astScheduleDimIsPrivatizable(Build, BuildInfo->Deps,
+                                       BuildInfo->Privatization, Payload);
+  }
 
   // Test for parallelism only if we are not already inside a parallel loop
   if (!BuildInfo->InParallelFor && !BuildInfo->InSIMD)
@@ -303,8 +452,11 @@ astBuildAfterFor(__isl_take isl_ast_node *Node, __isl_keep isl_ast_build *Build,
   Payload->Build = isl_ast_build_copy(Build);
   Payload->IsInnermost = (Id == BuildInfo->LastForNodeId);
 
+  // Private copies are only created for thread parallel execution.
   Payload->IsInnermostParallel =
-      Payload->IsInnermost && (BuildInfo->InSIMD || Payload->IsParallel);
+      Payload->IsInnermost &&
+      (BuildInfo->InSIMD ||
+       (Payload->IsParallel && Payload->PrivatizedArrays.empty()));
   if (Payload->IsOutermostParallel)
     BuildInfo->InParallelFor = false;
 
@@ -321,6 +473,8 @@ static isl_stat astBuildBeforeMark(__isl_keep isl_id *MarkId,
   AstBuildUserInfo *BuildInfo = (AstBuildUserInfo *)User;
   if (strcmp(isl_id_get_name(MarkId), "SIMD") == 0)
     BuildInfo->InSIMD = true;
+  if (strcmp(isl_id_get_name(MarkId), "Parallelize Thread") == 0)
+    BuildInfo->InParallelizeMark = true;
 
   return isl_stat_ok;
 }
@@ -333,6 +487,8 @@ astBuildAfterMark(__isl_take isl_ast_node *Node,
   auto *Id = isl_ast_node_mark_get_id(Node);
   if (strcmp(isl_id_get_name(Id), "SIMD") == 0)
     BuildInfo->InSIMD = false;
+  if (strcmp(isl_id_get_name(Id), "Parallelize Thread") == 0)
+    BuildInfo->InParallelizeMark = false;
   isl_id_free(Id);
   return Node;
 }
@@ -477,6 +633,140 @@ static bool benefitsFromPolly(Scop &Scop, bool PerformParallelTest) {
   return true;
 }
 
+/// Check if @p SAI is an array whose memory is only used inside @p S, such
+/// that a private copy can replace it.
+static bool isPrivatizationCandidate(Scop &S, const ScopArrayInfo *SAI) {
+  if (!SAI->isArrayKind())
+    return false;
+
+  // Arrays created by Polly are allocated at code generation; only those on
+  // the stack can be replaced by a stack-allocated copy.
+  Value *BasePtr = SAI->getBasePtr();
+  if (!BasePtr)
+    return !SAI->isOnHeap();
+
+  auto *Alloca = dyn_cast<AllocaInst>(BasePtr);
+  return Alloca && isLocalToRegion(Alloca, S.getRegion());
+}
+
+/// Compute the dependences of @p Reads, @p MustWrites and @p MayWrites.
+///
+/// @param Flow     Set to the read-after-write dependences.
+/// @param NoSource Set to the reads without a preceding write.
+///
+/// @return The read-after-write, write-after-write and write-after-read
+///         dependences.
+static isl::union_map computeArrayDeps(isl::union_map Reads,
+                                       isl::union_map MustWrites,
+                                       isl::union_map MayWrites,
+                                       isl::schedule Schedule,
+                                       isl::union_map &Flow,
+                                       isl::union_set &NoSource) {
+  isl::union_map Writes = MustWrites.unite(MayWrites);
+
+  isl::union_flow RAW = isl::union_access_info(Reads)
+                            .set_must_source(MustWrites)
+                            .set_may_source(MayWrites)
+                            .set_schedule(Schedule)
+                            .compute_flow();
+  Flow = RAW.get_may_dependence();
+  NoSource = RAW.get_may_no_source().domain();
+
+  isl::union_flow WAW = isl::union_access_info(Writes)
+                            .set_must_source(MustWrites)
+                            .set_may_source(MayWrites)
+                            .set_schedule(Schedule)
+                            .compute_flow();
+  isl::union_flow WAR = isl::union_access_info(Writes)
+                            .set_may_source(Reads)
+                            .set_schedule(Schedule)
+                            .compute_flow();
+
+  return Flow.unite(WAW.get_may_dependence()).unite(WAR.get_may_dependence());
+}
+
+/// Compute the dependences of @p S separately for the arrays that can be
+/// privatized.
+///
+/// @return The dependences, or nullptr if no array can be privatized or the
+///         computation exceeded its quota.
+static std::unique_ptr<PrivatizationInfo> computePrivatizationInfo(Scop &S) {
+  struct ArrayAccesses {
+    isl::union_map Reads, MustWrites, MayWrites;
+  };
+
+  isl::union_map Empty = isl::union_map::empty(S.getParamSpace());
+  MapVector<const ScopArrayInfo *, ArrayAccesses> Candidates;
+  ArrayAccesses Others = {Empty, Empty, Empty};
+  DenseMap<const ScopArrayInfo *, bool> IsCandidate;
+
+  for (ScopStmt &Stmt : S) {
+    for (MemoryAccess *MA : Stmt) {
+      const ScopArrayInfo *SAI = MA->getLatestScopArrayInfo();
+      auto Inserted = IsCandidate.insert({SAI, false});
+      if (Inserted.second)
+        Inserted.first->second = isPrivatizationCandidate(S, SAI);
+      if (MA->isReductionLike())
+        Inserted.first->second = false;
+    }
+  }
+
+  for (ScopStmt &Stmt : S) {
+    for (MemoryAccess *MA : Stmt) {
+      const ScopArrayInfo *SAI = MA->getLatestScopArrayInfo();
+      ArrayAccesses *Accesses = &Others;
+      if (IsCandidate.lookup(SAI)) {
+        auto It = Candidates.insert({SAI, {Empty, Empty, Empty}}).first;
+        Accesses = &It->second;
+      }
+
+      isl::union_map AccRel = isl::union_map(
+          MA->getLatestAccessRelation().intersect_domain(Stmt.getDomain()));
+      if (MA->isRead())
+        Accesses->Reads = Accesses->Reads.unite(AccRel);
+      else if (MA->isMustWrite())
+        Accesses->MustWrites = Accesses->MustWrites.unite(AccRel);
+      else
+        Accesses->MayWrites = Accesses->MayWrites.unite(AccRel);
+    }
+  }
+
+  if (Candidates.empty())
+    return nullptr;
+
+  auto Info = llvm::make_unique<PrivatizationInfo>();
+  isl::schedule Schedule = S.getScheduleTree();
+  {
+    IslMaxOperationsGuard MaxOpGuard(S.getIslCtx().get(), PrivatizationMaxOps);
+
+    isl::union_map Flow;
+    isl::union_set NoSource;
+    Info->OtherDeps = computeArrayDeps(Others.Reads, Others.MustWrites,
+                                       Others.MayWrites, Schedule, Flow,
+                                       NoSource);
+
+    for (auto &Candidate : Candidates) {
+      ArrayAccesses &Accesses = Candidate.second;
+      PrivatizationInfo::Candidate C;
+      C.SAI = Candidate.first;
+      C.Deps = computeArrayDeps(Accesses.Reads, Accesses.MustWrites,
+                                Accesses.MayWrites, Schedule, C.Flow,
+                                C.NoSource);
+      C.Accessors = Accesses.Reads.unite(Accesses.MustWrites)
+                        .unite(Accesses.MayWrites)
+                        .domain();
+      Info->Candidates.push_back(C);
+    }
+
+    if (MaxOpGuard.hasQuotaExceeded()) {
+      LLVM_DEBUG(dbgs() << "Privatization analysis exceeded its quota\n");
+      return nullptr;
+    }
+  }
+
+  return Info;
+}
+
 /// Collect statistics for the syntax tree rooted at @p Ast.
 static void walkAstForStatistics(__isl_keep isl_ast_node *Ast) {
   assert(Ast);
@@ -494,6 +784,8 @@ static void walkAstForStatistics(__isl_keep isl_ast_node *Ast) {
             NumOutermostParallel++;
           if (IslAstInfo::isReductionParallel(Node))
             NumReductionParallel++;
+          if (!IslAstInfo::getPrivatizedArrays(Node).empty())
+            NumPrivatizedParallel++;
           if (IslAstInfo::isExecutedInParallel(Node))
             NumExecutedInParallel++;
           break;
@@ -512,6 +804,27 @@ static void walkAstForStatistics(__isl_keep isl_ast_node *Ast) {
       nullptr);
 }
 
+/// Does @p Schedule contain a loop the user requested to be parallelized?
+static bool containsParallelizeMark(isl::schedule Schedule) {
+  bool Found = false;
+  isl_schedule_foreach_schedule_node_top_down(
+      Schedule.get(),
+      [](__isl_keep isl_schedule_node *Node, void *User) -> isl_bool {
+        bool &Found = *static_cast<bool *>(User);
+        if (Found)
+          return isl_bool_false;
+
+        if (isl_schedule_node_get_type(Node) == isl_schedule_node_mark) {
+          isl_id *Id = isl_schedule_node_mark_get_id(Node);
+          Found = strcmp(isl_id_get_name(Id), "Parallelize Thread") == 0;
+          isl_id_free(Id);
+        }
+        return isl_bool_true;
+      },
+      &Found);
+  return Found;
+}
+
 IslAst::IslAst(Scop &Scop) : S(Scop), Ctx(Scop.getSharedIslCtx()) {}
 
 IslAst::IslAst(IslAst &&O)
@@ -526,15 +839,18 @@ IslAst::~IslAst() {
 }
 
 void IslAst::init(const Dependences &D) {
-  bool PerformParallelTest = PollyParallel || DetectParallel ||
-                             PollyVectorizerChoice != VECTORIZER_NONE;
+  OptimizationProfileScope ProfileScope(S);
+  bool PerformParallelTest = getProfileOption(PollyParallel) ||
+                             DetectParallel ||
+                             getVectorizerChoice() != VECTORIZER_NONE;
 
   // We can not perform the dependence analysis and, consequently,
   // the parallel code generation in case the schedule tree contains
   // extension nodes.
   auto ScheduleTree = S.getScheduleTree();
   PerformParallelTest =
-      PerformParallelTest && !S.containsExtensionNode(ScheduleTree);
+      (PerformParallelTest || containsParallelizeMark(ScheduleTree)) &&
+      !S.containsExtensionNode(ScheduleTree);
 
   // Skip AST and code generation if there was no benefit achieved.
   if (!benefitsFromPolly(S, PerformParallelTest))
@@ -550,12 +866,11 @@ void IslAst::init(const Dependences &D) {
   isl_options_set_ast_build_detect_min_max(Ctx.get(), true);
   isl_ast_build *Build;
   AstBuildUserInfo BuildInfo;
+  std::unique_ptr<PrivatizationInfo> Privatization;
 
-  if (UseContext)
-    Build = isl_ast_build_from_context(S.getContext().release());
-  else
-    Build = isl_ast_build_from_context(
-        isl_set_universe(S.getParamSpace().release()));
+  isl::set Context =
+      UseContext ? S.getContext() : isl::set::universe(S.getParamSpace());
+  Build = isl_ast_build_from_context(Context.copy());
 
   Build = isl_ast_build_set_at_each_domain(Build, AtEachDomain, nullptr);
 
@@ -564,6 +879,12 @@ void IslAst::init(const Dependences &D) {
     BuildInfo.InParallelFor = false;
     BuildInfo.InSIMD = false;
 
+    if (PrivatizeArrays && getProfileOption(PollyParallel) &&
+        D.hasValidDependences()) {
+      Privatization = computePrivatizationInfo(S);
+      BuildInfo.Privatization = Privatization.get();
+    }
+
     Build = isl_ast_build_set_before_each_for(Build, &astBuildBeforeFor,
                                               &BuildInfo);
     Build =
@@ -578,7 +899,9 @@ void IslAst::init(const Dependences &D) {
 
   RunCondition = buildRunCondition(S, Build);
 
-  Root = isl_ast_build_node_from_schedule(Build, S.getScheduleTree().release());
+  isl::schedule Schedule = S.getScheduleTree();
+  captureIslInput(Schedule.get(), Context.get());
+  Root = isl_ast_build_node_from_schedule(Build, Schedule.release());
   walkAstForStatistics(Root);
 
   isl_ast_build_free(Build);
@@ -634,8 +957,18 @@ bool IslAstInfo::isReductionParallel(__isl_keep isl_ast_node *Node) {
   return Payload && Payload->IsReductionParallel;
 }
 
+bool IslAstInfo::isUserParallel(__isl_keep isl_ast_node *Node) {
+  IslAstUserPayload *Payload = getNodePayload(Node);
+  return Payload && Payload->IsUserParallel;
+}
+
 bool IslAstInfo::isExecutedInParallel(__isl_keep isl_ast_node *Node) {
-  if (!PollyParallel)
+  // Loops the user explicitly requested to be parallelized are executed in
+  // parallel independent of the cost model.
+  if (isUserParallel(Node))
+    return isOutermostParallel(Node) && !isReductionParallel(Node);
+
+  if (!getProfileOption(PollyParallel))
     return false;
 
   // Do not parallelize innermost loops.
@@ -676,6 +1009,14 @@ isl_ast_build *IslAstInfo::getBuild(__isl_keep isl_ast_node *Node) {
   return Payload ? Payload->Build : nullptr;
 }
 
+ArrayRef<const ScopArrayInfo *>
+IslAstInfo::getPrivatizedArrays(__isl_keep isl_ast_node *Node) {
+  IslAstUserPayload *Payload = getNodePayload(Node);
+  if (!Payload)
+    return {};
+  return Payload->PrivatizedArrays;
+}
+
 IslAstInfo IslAstAnalysis::run(Scop &S, ScopAnalysisManager &SAM,
                                ScopStandardAnalysisResults &SAR) {
   return {S, SAM.getResult<DependenceAnalysis>(S, SAR).getDependences(
@@ -814,6 +1155,7 @@ bool IslAstInfoWrapperPass::runOnScop(Scop &Scop) {
     return false;
   }
 
+  IslOperationsCounter OpsCounter(Scop.getIslCtx().get(), NumIslOperations);
   Ast.reset(new IslAstInfo(Scop, D));
 
   LLVM_DEBUG(printScop(dbgs(), Scop));
@@ -30,6 +30,7 @@
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/Triple.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/RegionInfo.h"
 #include "llvm/Analysis/ScalarEvolution.h"
@@ -44,12 +45,15 @@
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Value.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/ModuleUtils.h"
 #include "isl/aff.h"
 #include "isl/aff_type.h"
 #include "isl/ast.h"
@@ -77,6 +81,7 @@ STATISTIC(VersionedScops, "Number of SCoPs that required versioning.");
 
 STATISTIC(SequentialLoops, "Number of generated sequential for-loops");
 STATISTIC(ParallelLoops, "Number of generated parallel for-loops");
+STATISTIC(PrivatizedArrays, "Number of arrays privatized in parallel loops");
 STATISTIC(VectorLoops, "Number of generated vector for-loops");
 STATISTIC(IfConditions, "Number of generated if-conditions");
 
@@ -99,6 +104,16 @@ static cl::opt<int> PollyTargetFirstLevelCacheLineSize(
     cl::desc("The size of the first level cache line size specified in bytes."),
     cl::Hidden, cl::init(64), cl::ZeroOrMore, cl::cat(PollyCategory));
 
+static cl::opt<bool> PollyReuseHeapArrays(
+    "polly-reuse-heap-arrays",
+    cl::desc("Keep the heap arrays created by Polly in a per-thread cache "
+             "instead of allocating them on every execution of the SCoP"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+/// Heap arrays at least this large are aligned to (huge) pages instead of
+/// cache lines.
+static const uint64_t HugePageSize = 2 * 1024 * 1024;
+
 isl::ast_expr IslNodeBuilder::getUpperBound(isl::ast_node For,
                                             ICmpInst::Predicate &Predicate) {
   isl::ast_expr Cond = For.for_get_cond();
@@ -404,7 +419,7 @@ void IslNodeBuilder::createMark(__isl_take isl_ast_node *Node) {
   // it will be optimized away and we should skip it.
   if (strcmp(isl_id_get_name(Id), "SIMD") == 0 &&
       isl_ast_node_get_type(Child) == isl_ast_node_for) {
-    bool Vector = PollyVectorizerChoice == VECTORIZER_POLLY;
+    bool Vector = getVectorizerChoice() == VECTORIZER_POLLY;
     int VectorWidth = getNumberOfIterations(isl::manage_copy(Child));
     if (Vector && 1 < VectorWidth && VectorWidth <= 16)
       createForVector(Child, VectorWidth);
@@ -605,6 +620,19 @@ static void removeSubFuncFromDomTree(Function *F, DominatorTree &DT) {
     DT.eraseNode(BB);
 }
 
+/// Create a copy of the stack array @p SAI in the entry block of @p SubFn.
+static AllocaInst *createPrivateCopy(const ScopArrayInfo *SAI,
+                                     Function *SubFn) {
+  auto *Alloca = cast<AllocaInst>(SAI->getBasePtr());
+  Instruction *InsertBefore = &*SubFn->getEntryBlock().getFirstInsertionPt();
+  auto *Copy = new AllocaInst(Alloca->getAllocatedType(),
+                              Alloca->getType()->getAddressSpace(),
+                              Alloca->getArraySize(),
+                              SAI->getName() + ".private", InsertBefore);
+  Copy->setAlignment(Alloca->getAlignment());
+  return Copy;
+}
+
 void IslNodeBuilder::createForParallel(__isl_take isl_ast_node *For) {
   isl_ast_node *Body;
   isl_ast_expr *Init, *Inc, *Iterator, *UB;
@@ -668,7 +696,7 @@ void IslNodeBuilder::createForParallel(__isl_take isl_ast_node *For) {
   }
 
   ValueMapT NewValues;
-  ParallelLoopGenerator ParallelLoopGen(Builder, LI, DT, DL);
+  ParallelLoopGenerator ParallelLoopGen(Builder, LI, DT, DL, Monitor);
 
   IV = ParallelLoopGen.createParallelLoop(ValueLB, ValueUB, ValueInc,
                                           SubtreeValues, NewValues, &LoopBody);
@@ -690,6 +718,17 @@ void IslNodeBuilder::createForParallel(__isl_take isl_ast_node *For) {
   for (auto P : NewValues)
     NewValuesReverse[P.second] = P.first;
 
+  // Each thread accesses its own copy of the privatized arrays. As they are
+  // neither read before nor after the loop, the copies need no
+  // initialization or copy-out.
+  for (const ScopArrayInfo *SAI : IslAstInfo::getPrivatizedArrays(For)) {
+    Value *BasePtr = SAI->getBasePtr();
+    AllocaInst *Copy = createPrivateCopy(SAI, LoopBody->getFunction());
+    ValueMap[BasePtr] = Copy;
+    NewValuesReverse[Copy] = BasePtr;
+    PrivatizedArrays++;
+  }
+
   Annotator.addAlternativeAliasBases(NewValuesReverse);
 
   create(Body);
@@ -740,7 +779,7 @@ static bool hasPartialAccesses(__isl_take isl_ast_node *Node) {
 }
 
 void IslNodeBuilder::createFor(__isl_take isl_ast_node *For) {
-  bool Vector = PollyVectorizerChoice == VECTORIZER_POLLY;
+  bool Vector = getVectorizerChoice() == VECTORIZER_POLLY;
 
   if (Vector && IslAstInfo::isInnermostParallel(For) &&
       !IslAstInfo::isReductionParallel(For)) {
@@ -755,8 +794,11 @@ void IslNodeBuilder::createFor(__isl_take isl_ast_node *For) {
     createForParallel(For);
     return;
   }
+  // Loops that need private copies of arrays carry dependences when executed
+  // sequentially.
   bool Parallel =
-      (IslAstInfo::isParallel(For) && !IslAstInfo::isReductionParallel(For));
+      (IslAstInfo::isParallel(For) && !IslAstInfo::isReductionParallel(For) &&
+       IslAstInfo::getPrivatizedArrays(For).empty());
   createForSequential(isl::manage(For), Parallel);
 }
 
@@ -1420,7 +1462,225 @@ bool IslNodeBuilder::preloadInvariantEquivClass(
   return true;
 }
 
+/// Return the function @p Name of type @p Ty, which is declared as a weak
+/// symbol unless the module already declares it. Weak functions are null if
+/// the program is not linked against them.
+static Constant *getWeakFunction(Module *M, StringRef Name, FunctionType *Ty) {
+  Function *F = M->getFunction(Name);
+  if (!F)
+    F = Function::Create(Ty, GlobalValue::ExternalWeakLinkage, Name, M);
+  return ConstantExpr::getBitCast(F, Ty->getPointerTo());
+}
+
+/// Return the type of pthread_key_t, which is an unsigned long on Darwin and
+/// an unsigned int on the other supported systems.
+static Type *getPthreadKeyType(Module *M, Type *IntPtrTy) {
+  if (Triple(M->getTargetTriple()).isOSDarwin())
+    return IntPtrTy;
+  return Type::getInt32Ty(M->getContext());
+}
+
+/// Return the function that frees the buffers in the thread-local slots of
+/// @p M:
+///
+///   void polly.arena.cleanup()
+///
+/// Every SCoP that reuses heap arrays adds its slots to it. It is run for the
+/// main thread at program exit, and for all other threads at their exit by
+/// the destructor of the pthread key polly.arena.key, which is created at
+/// program start. The key is only used if polly.arena.keyed is set, i.e. if
+/// the program is linked against pthreads and the key could be created.
+/// Otherwise there are no other threads whose buffers could leak.
+static Function *getArenaCleanupFunction(Module *M, Type *IntPtrTy) {
+  const char *Name = "polly.arena.cleanup";
+  if (Function *F = M->getFunction(Name))
+    return F;
+
+  LLVMContext &Ctx = M->getContext();
+  PointerType *Int8PtrTy = Type::getInt8PtrTy(Ctx);
+  Type *VoidTy = Type::getVoidTy(Ctx);
+  Type *Int32Ty = Type::getInt32Ty(Ctx);
+  Type *KeyTy = getPthreadKeyType(M, IntPtrTy);
+
+  Function *Cleanup = Function::Create(FunctionType::get(VoidTy, false),
+                                       Function::InternalLinkage, Name, M);
+  Cleanup->addFnAttr(Attribute::NoUnwind);
+  ReturnInst::Create(Ctx, BasicBlock::Create(Ctx, "entry", Cleanup));
+  appendToGlobalDtors(*M, Cleanup, 65535);
+
+  FunctionType *ThreadExitTy = FunctionType::get(VoidTy, {Int8PtrTy}, false);
+  Function *ThreadExit =
+      Function::Create(ThreadExitTy, Function::InternalLinkage,
+                       "polly.arena.thread_exit", M);
+  ThreadExit->addFnAttr(Attribute::NoUnwind);
+  IRBuilder<> B(BasicBlock::Create(Ctx, "entry", ThreadExit));
+  B.CreateCall(Cleanup, {});
+  B.CreateRetVoid();
+
+  auto *Key = new GlobalVariable(*M, KeyTy, false, GlobalValue::InternalLinkage,
+                                 Constant::getNullValue(KeyTy),
+                                 "polly.arena.key");
+  auto *Keyed = new GlobalVariable(
+      *M, B.getInt1Ty(), false, GlobalValue::InternalLinkage,
+      ConstantInt::getFalse(Ctx), "polly.arena.keyed");
+
+  //   if (pthread_key_create)
+  //     polly.arena.keyed =
+  //         pthread_key_create(&polly.arena.key, polly.arena.thread_exit) == 0;
+  Function *Init = Function::Create(FunctionType::get(VoidTy, false),
+                                    Function::InternalLinkage,
+                                    "polly.arena.init", M);
+  Init->addFnAttr(Attribute::NoUnwind);
+  BasicBlock *EntryBB = BasicBlock::Create(Ctx, "entry", Init);
+  BasicBlock *CreateBB = BasicBlock::Create(Ctx, "create", Init);
+  BasicBlock *DoneBB = BasicBlock::Create(Ctx, "done", Init);
+  FunctionType *KeyCreateTy = FunctionType::get(
+      Int32Ty, {KeyTy->getPointerTo(), ThreadExitTy->getPointerTo()}, false);
+  Constant *KeyCreate = getWeakFunction(M, "pthread_key_create", KeyCreateTy);
+  B.SetInsertPoint(EntryBB);
+  B.CreateCondBr(B.CreateIsNull(KeyCreate), DoneBB, CreateBB);
+  B.SetInsertPoint(CreateBB);
+  Value *Ret = B.CreateCall(KeyCreateTy, KeyCreate, {Key, ThreadExit});
+  B.CreateStore(B.CreateIsNull(Ret), Keyed);
+  B.CreateBr(DoneBB);
+  B.SetInsertPoint(DoneBB);
+  B.CreateRetVoid();
+  appendToGlobalCtors(*M, Init, 65535);
+
+  return Cleanup;
+}
+
+/// Return the function that takes the buffer out of a thread-local slot, or
+/// allocates a new one if the slot is empty:
+///
+///   i8* polly.arena.acquire(i8** Slot, iN Size)
+///
+/// A thread that allocates a buffer sets its value of polly.arena.key, such
+/// that the buffers of the thread are freed when it exits.
+static Function *getArenaAcquireFunction(Module *M, Type *IntPtrTy) {
+  const char *Name = "polly.arena.acquire";
+  if (Function *F = M->getFunction(Name))
+    return F;
+
+  getArenaCleanupFunction(M, IntPtrTy);
+  GlobalVariable *Key = M->getGlobalVariable("polly.arena.key", true);
+  GlobalVariable *Keyed = M->getGlobalVariable("polly.arena.keyed", true);
+
+  LLVMContext &Ctx = M->getContext();
+  PointerType *Int8PtrTy = Type::getInt8PtrTy(Ctx);
+  FunctionType *Ty = FunctionType::get(
+      Int8PtrTy, {Int8PtrTy->getPointerTo(), IntPtrTy}, false);
+  Function *F = Function::Create(Ty, Function::InternalLinkage, Name, M);
+  F->addFnAttr(Attribute::NoUnwind);
+  Value *Slot = &*F->arg_begin();
+  Value *Size = &*std::next(F->arg_begin());
+
+  BasicBlock *EntryBB = BasicBlock::Create(Ctx, "entry", F);
+  BasicBlock *AllocBB = BasicBlock::Create(Ctx, "alloc", F);
+  BasicBlock *DoneBB = BasicBlock::Create(Ctx, "done", F);
+
+  // Take the buffer out of the slot, such that a nested execution of the
+  // SCoP does not use it as well.
+  IRBuilder<> B(EntryBB);
+  Value *Cached = B.CreateLoad(Int8PtrTy, Slot, "cached");
+  B.CreateStore(ConstantPointerNull::get(Int8PtrTy), Slot);
+  B.CreateCondBr(B.CreateIsNull(Cached), AllocBB, DoneBB);
+
+  BasicBlock *RegisterBB = BasicBlock::Create(Ctx, "register", F, DoneBB);
+  B.SetInsertPoint(AllocBB);
+  Value *IsKeyed = B.CreateLoad(B.getInt1Ty(), Keyed, "keyed");
+  Instruction *Br = B.CreateCondBr(IsKeyed, RegisterBB, DoneBB);
+  Instruction *Allocated =
+      CallInst::CreateMalloc(Br, IntPtrTy, B.getInt8Ty(),
+                             ConstantInt::get(IntPtrTy, 1), Size, nullptr);
+
+  // Any value but null makes the key's destructor run at thread exit.
+  B.SetInsertPoint(RegisterBB);
+  Type *KeyTy = Key->getValueType();
+  FunctionType *SetSpecificTy =
+      FunctionType::get(B.getInt32Ty(), {KeyTy, Int8PtrTy}, false);
+  B.CreateCall(SetSpecificTy,
+               getWeakFunction(M, "pthread_setspecific", SetSpecificTy),
+               {B.CreateLoad(KeyTy, Key, "key"), Allocated});
+  B.CreateBr(DoneBB);
+
+  B.SetInsertPoint(DoneBB);
+  PHINode *Buffer = B.CreatePHI(Int8PtrTy, 3, "buffer");
+  Buffer->addIncoming(Cached, EntryBB);
+  Buffer->addIncoming(Allocated, AllocBB);
+  Buffer->addIncoming(Allocated, RegisterBB);
+  B.CreateRet(Buffer);
+  return F;
+}
+
+/// Return the function that puts a buffer back into its thread-local slot:
+///
+///   void polly.arena.release(i8** Slot, i8* Buffer)
+///
+/// A buffer that a nested execution of the SCoP has put into the slot in the
+/// meantime is freed.
+static Function *getArenaReleaseFunction(Module *M) {
+  const char *Name = "polly.arena.release";
+  if (Function *F = M->getFunction(Name))
+    return F;
+
+  LLVMContext &Ctx = M->getContext();
+  PointerType *Int8PtrTy = Type::getInt8PtrTy(Ctx);
+  FunctionType *Ty = FunctionType::get(
+      Type::getVoidTy(Ctx), {Int8PtrTy->getPointerTo(), Int8PtrTy}, false);
+  Function *F = Function::Create(Ty, Function::InternalLinkage, Name, M);
+  F->addFnAttr(Attribute::NoUnwind);
+  Value *Slot = &*F->arg_begin();
+  Value *Buffer = &*std::next(F->arg_begin());
+
+  IRBuilder<> B(BasicBlock::Create(Ctx, "entry", F));
+  Value *Previous = B.CreateLoad(Int8PtrTy, Slot, "previous");
+  B.CreateStore(Buffer, Slot);
+  ReturnInst *Ret = B.CreateRetVoid();
+  CallInst::CreateFree(Previous, Ret);
+  return F;
+}
+
+GlobalVariable *IslNodeBuilder::createReusedHeapArray(ScopArrayInfo *SAI,
+                                                      BBPair StartExitBlocks,
+                                                      uint64_t Size) {
+  Module *M = Builder.GetInsertBlock()->getModule();
+  LLVMContext &Ctx = M->getContext();
+  PointerType *Int8PtrTy = Type::getInt8PtrTy(Ctx);
+  auto *IntPtrTy = DL.getIntPtrType(Ctx);
+
+  auto *Slot = new GlobalVariable(
+      *M, Int8PtrTy, false, GlobalValue::InternalLinkage,
+      ConstantPointerNull::get(Int8PtrTy), SAI->getName() + ".arena", nullptr,
+      GlobalVariable::GeneralDynamicTLSModel);
+
+  // Over-allocate the buffer such that it can be aligned.
+  uint64_t Alignment =
+      Size >= HugePageSize
+          ? HugePageSize
+          : PowerOf2Ceil(std::max<int>(PollyTargetFirstLevelCacheLineSize, 1));
+
+  IRBuilder<> B(std::get<0>(StartExitBlocks)->getTerminator());
+  Value *Buffer = B.CreateCall(
+      getArenaAcquireFunction(M, IntPtrTy),
+      {Slot, ConstantInt::get(IntPtrTy, Size + Alignment - 1)},
+      SAI->getName() + ".buffer");
+
+  // Buffer + (-Buffer & (Alignment - 1)) is the first aligned address.
+  Value *Offset = B.CreateAnd(B.CreateNeg(B.CreatePtrToInt(Buffer, IntPtrTy)),
+                              Alignment - 1);
+  Value *Aligned = B.CreateGEP(B.getInt8Ty(), Buffer, Offset);
+  SAI->setBasePtr(B.CreateBitCast(
+      Aligned, SAI->getElementType()->getPointerTo(), SAI->getName()));
+
+  B.SetInsertPoint(std::get<1>(StartExitBlocks)->getTerminator());
+  B.CreateCall(getArenaReleaseFunction(M), {Slot, Buffer});
+  return Slot;
+}
+
 void IslNodeBuilder::allocateNewArrays(BBPair StartExitBlocks) {
+  SmallVector<GlobalVariable *, 4> ArenaSlots;
+
   for (auto &SAI : S.arrays()) {
     if (SAI->getBasePtr())
       continue;
@@ -1446,7 +1706,10 @@ void IslNodeBuilder::allocateNewArrays(BBPair StartExitBlocks) {
       ArraySizeInt *= UnsignedDimSize;
     }
 
-    if (SAI->isOnHeap()) {
+    if (SAI->isOnHeap() && PollyReuseHeapArrays) {
+      ArenaSlots.push_back(createReusedHeapArray(
+          SAI, StartExitBlocks, ArraySizeInt * SAI->getElemSizeInBytes()));
+    } else if (SAI->isOnHeap()) {
       LLVMContext &Ctx = NewArrayType->getContext();
 
       // Get the IntPtrTy from the Datalayout
@@ -1480,6 +1743,21 @@ void IslNodeBuilder::allocateNewArrays(BBPair StartExitBlocks) {
       SAI->setBasePtr(CreatedArray);
     }
   }
+
+  if (ArenaSlots.empty())
+    return;
+
+  // Free the buffers of the slots when their thread exits.
+  Module *M = Builder.GetInsertBlock()->getModule();
+  LLVMContext &Ctx = M->getContext();
+  Function *Cleanup = getArenaCleanupFunction(M, DL.getIntPtrType(Ctx));
+  auto *Ret = cast<ReturnInst>(Cleanup->getEntryBlock().getTerminator());
+  IRBuilder<> B(Ret);
+  for (GlobalVariable *Slot : ArenaSlots) {
+    Value *Buffer = B.CreateLoad(Type::getInt8PtrTy(Ctx), Slot);
+    B.CreateStore(ConstantPointerNull::get(Type::getInt8PtrTy(Ctx)), Slot);
+    CallInst::CreateFree(Buffer, Ret);
+  }
 }
 
 bool IslNodeBuilder::preloadInvariantLoads() {
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "polly/CodeGen/LoopGenerators.h"
+#include "polly/CodeGen/PerfMonitor.h"
 #include "polly/ScopDetection.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/IR/DataLayout.h"
@@ -164,9 +165,15 @@ Value *ParallelLoopGenerator::createParallelLoop(
 
   // Tell the runtime we start a parallel loop
   createCallSpawnThreads(SubFn, SubFnParam, LB, UB, Stride);
-  Builder.CreateCall(SubFn, SubFnParam);
+  CallInst *Work = Builder.CreateCall(SubFn, SubFnParam);
   createCallJoinThreads();
 
+  // The runtime calls are the instructions right before and after the call
+  // of the subfunction.
+  if (Monitor)
+    Monitor->insertParallelRegion(Work->getPrevNode(), Work,
+                                  Work->getNextNode());
+
   return IV;
 }
 
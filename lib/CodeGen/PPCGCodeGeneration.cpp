@@ -99,6 +99,12 @@ static cl::opt<bool, true>
                    cl::location(PollyManagedMemory), cl::Hidden,
                    cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
 
+static cl::opt<bool> DeviceResidency(
+    "polly-acc-device-residency",
+    cl::desc("Keep device arrays allocated across scops and skip the "
+             "transfers of host data that is still valid on the device"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 static cl::opt<bool>
     FailOnVerifyModuleFailure("polly-acc-fail-on-verify-module-failure",
                               cl::desc("Fail and generate a backtrace if"
@@ -369,6 +375,9 @@ private:
   /// A map from ScopArrays to their corresponding device allocations.
   std::map<ScopArrayInfo *, Value *> DeviceAllocations;
 
+  /// The ScopArrays whose device allocations stay resident after the scop.
+  std::set<ScopArrayInfo *> ResidentArrays;
+
   /// The current GPU context.
   Value *GPUContext;
 
@@ -520,6 +529,15 @@ private:
   /// @param Array The array for which to compute a size.
   Value *getArraySize(gpu_array_info *Array);
 
+  /// Generate code that computes the host address of an array.
+  ///
+  /// This is the address of the first element of the array accessed in the
+  /// scop.
+  ///
+  /// @param Array  The array for which to compute the host address.
+  /// @param Offset The offset of the array, as returned by getArrayOffset.
+  Value *getArrayHostPtr(gpu_array_info *Array, Value *Offset);
+
   /// Generate code to compute the minimal offset at which an array is accessed.
   ///
   /// The offset of an array is the minimal array location accessed in a scop.
@@ -696,6 +714,20 @@ private:
   /// @param Array The device array to free.
   void createCallFreeDeviceMemory(Value *Array);
 
+  /// Create a call to acquire a device array that stays resident across scops.
+  ///
+  /// @param HostPtr The host data the device array mirrors.
+  /// @param Size    The size of the device array.
+  ///
+  /// @returns A pointer that identifies this allocation.
+  Value *createCallAcquireDeviceMemory(Value *HostPtr, Value *Size);
+
+  /// Create a call to release a device array that stays resident.
+  ///
+  /// @param Array   The device array to release.
+  /// @param Written Whether kernels of this scop may have written the array.
+  void createCallReleaseDeviceMemory(Value *Array, bool Written);
+
   /// Create a call to copy data from host to device.
   ///
   /// @param HostPtr A pointer to the host data that should be copied.
@@ -803,7 +835,14 @@ void GPUNodeBuilder::allocateDeviceArrays() {
       report_fatal_error("array size was computed to be 0");
     }
 
-    Value *DevArray = createCallAllocateMemoryForDevice(ArraySize);
+    Value *DevArray;
+    if (DeviceResidency && !gpu_array_is_scalar(Array)) {
+      Value *HostPtr = getArrayHostPtr(Array, Offset);
+      DevArray = createCallAcquireDeviceMemory(HostPtr, ArraySize);
+      ResidentArrays.insert(ScopArray);
+    } else {
+      DevArray = createCallAllocateMemoryForDevice(ArraySize);
+    }
     DevArray->setName(DevArrayName);
     DeviceAllocations[ScopArray] = DevArray;
   }
@@ -817,23 +856,8 @@ void GPUNodeBuilder::prepareManagedDeviceArrays() {
   for (int i = 0; i < Prog->n_array; ++i) {
     gpu_array_info *Array = &Prog->array[i];
     ScopArrayInfo *ScopArray = (ScopArrayInfo *)Array->user;
-    Value *HostPtr;
-
-    if (gpu_array_is_scalar(Array))
-      HostPtr = BlockGen.getOrCreateAlloca(ScopArray);
-    else
-      HostPtr = ScopArray->getBasePtr();
-    HostPtr = getLatestValue(HostPtr);
-
-    Value *Offset = getArrayOffset(Array);
-    if (Offset) {
-      HostPtr = Builder.CreatePointerCast(
-          HostPtr, ScopArray->getElementType()->getPointerTo());
-      HostPtr = Builder.CreateGEP(HostPtr, Offset);
-    }
-
-    HostPtr = Builder.CreatePointerCast(HostPtr, Builder.getInt8PtrTy());
-    DeviceAllocations[ScopArray] = HostPtr;
+    DeviceAllocations[ScopArray] =
+        getArrayHostPtr(Array, getArrayOffset(Array));
   }
 }
 
@@ -858,10 +882,24 @@ void GPUNodeBuilder::addCUDAAnnotations(Module *M, Value *BlockDimX,
   }
 }
 
+/// Return whether @p SAI may be written in @p S.
+static bool isArrayWritten(Scop &S, const ScopArrayInfo *SAI) {
+  for (ScopStmt &Stmt : S)
+    for (MemoryAccess *MA : Stmt)
+      if (MA->isWrite() && MA->getLatestScopArrayInfo() == SAI)
+        return true;
+  return false;
+}
+
 void GPUNodeBuilder::freeDeviceArrays() {
   assert(!PollyManagedMemory && "Managed memory does not use device arrays");
-  for (auto &Array : DeviceAllocations)
-    createCallFreeDeviceMemory(Array.second);
+  for (auto &Array : DeviceAllocations) {
+    if (ResidentArrays.count(Array.first))
+      createCallReleaseDeviceMemory(Array.second,
+                                    isArrayWritten(S, Array.first));
+    else
+      createCallFreeDeviceMemory(Array.second);
+  }
 }
 
 Value *GPUNodeBuilder::createCallGetKernel(Value *Buffer, Value *Entry) {
@@ -963,6 +1001,50 @@ void GPUNodeBuilder::createCallFreeDeviceMemory(Value *Array) {
   Builder.CreateCall(F, {Array});
 }
 
+Value *GPUNodeBuilder::createCallAcquireDeviceMemory(Value *HostPtr,
+                                                     Value *Size) {
+  assert(!PollyManagedMemory &&
+         "Managed memory does not allocate or free memory "
+         "for device");
+  const char *Name = "polly_acquireDeviceMemory";
+  Module *M = Builder.GetInsertBlock()->getParent()->getParent();
+  Function *F = M->getFunction(Name);
+
+  // If F is not available, declare it.
+  if (!F) {
+    GlobalValue::LinkageTypes Linkage = Function::ExternalLinkage;
+    std::vector<Type *> Args;
+    Args.push_back(Builder.getInt8PtrTy());
+    Args.push_back(Builder.getInt64Ty());
+    FunctionType *Ty = FunctionType::get(Builder.getInt8PtrTy(), Args, false);
+    F = Function::Create(Ty, Linkage, Name, M);
+  }
+
+  return Builder.CreateCall(F, {HostPtr, Size});
+}
+
+void GPUNodeBuilder::createCallReleaseDeviceMemory(Value *Array,
+                                                   bool Written) {
+  assert(!PollyManagedMemory &&
+         "Managed memory does not allocate or free memory "
+         "for device");
+  const char *Name = "polly_releaseDeviceMemory";
+  Module *M = Builder.GetInsertBlock()->getParent()->getParent();
+  Function *F = M->getFunction(Name);
+
+  // If F is not available, declare it.
+  if (!F) {
+    GlobalValue::LinkageTypes Linkage = Function::ExternalLinkage;
+    std::vector<Type *> Args;
+    Args.push_back(Builder.getInt8PtrTy());
+    Args.push_back(Builder.getInt32Ty());
+    FunctionType *Ty = FunctionType::get(Builder.getVoidTy(), Args, false);
+    F = Function::Create(Ty, Linkage, Name, M);
+  }
+
+  Builder.CreateCall(F, {Array, Builder.getInt32(Written)});
+}
+
 Value *GPUNodeBuilder::createCallAllocateMemoryForDevice(Value *Size) {
   assert(!PollyManagedMemory &&
          "Managed memory does not allocate or free memory "
@@ -1058,6 +1140,9 @@ Value *GPUNodeBuilder::createCallInitContext() {
   case GPURuntime::OpenCL:
     Name = "polly_initContextCL";
     break;
+  case GPURuntime::Host:
+    Name = "polly_initContextHost";
+    break;
   }
 
   Module *M = Builder.GetInsertBlock()->getParent()->getParent();
@@ -1157,6 +1242,25 @@ Value *GPUNodeBuilder::getArrayOffset(gpu_array_info *Array) {
   return ExprBuilder.create(Result.release());
 }
 
+Value *GPUNodeBuilder::getArrayHostPtr(gpu_array_info *Array, Value *Offset) {
+  auto ScopArray = (ScopArrayInfo *)(Array->user);
+  Value *HostPtr;
+
+  if (gpu_array_is_scalar(Array))
+    HostPtr = BlockGen.getOrCreateAlloca(ScopArray);
+  else
+    HostPtr = ScopArray->getBasePtr();
+  HostPtr = getLatestValue(HostPtr);
+
+  if (Offset) {
+    HostPtr = Builder.CreatePointerCast(
+        HostPtr, ScopArray->getElementType()->getPointerTo());
+    HostPtr = Builder.CreateGEP(HostPtr, Offset);
+  }
+
+  return Builder.CreatePointerCast(HostPtr, Builder.getInt8PtrTy());
+}
+
 Value *GPUNodeBuilder::getManagedDeviceArray(gpu_array_info *Array,
                                              ScopArrayInfo *ArrayInfo) {
   assert(PollyManagedMemory && "Only used when you wish to get a host "
@@ -1181,22 +1285,7 @@ void GPUNodeBuilder::createDataTransfer(__isl_take isl_ast_node *TransferStmt,
   Value *Size = getArraySize(Array);
   Value *Offset = getArrayOffset(Array);
   Value *DevPtr = DeviceAllocations[ScopArray];
-
-  Value *HostPtr;
-
-  if (gpu_array_is_scalar(Array))
-    HostPtr = BlockGen.getOrCreateAlloca(ScopArray);
-  else
-    HostPtr = ScopArray->getBasePtr();
-  HostPtr = getLatestValue(HostPtr);
-
-  if (Offset) {
-    HostPtr = Builder.CreatePointerCast(
-        HostPtr, ScopArray->getElementType()->getPointerTo());
-    HostPtr = Builder.CreateGEP(HostPtr, Offset);
-  }
-
-  HostPtr = Builder.CreatePointerCast(HostPtr, Builder.getInt8PtrTy());
+  Value *HostPtr = getArrayHostPtr(Array, Offset);
 
   if (Offset) {
     Size = Builder.CreateSub(
@@ -2276,7 +2365,7 @@ void GPUNodeBuilder::createKernelFunction(
 
   switch (Arch) {
   case GPUArch::NVPTX64:
-    if (Runtime == GPURuntime::CUDA)
+    if (Runtime == GPURuntime::CUDA || Runtime == GPURuntime::Host)
       GPUModule->setTargetTriple(Triple::normalize("nvptx64-nvidia-cuda"));
     else if (Runtime == GPURuntime::OpenCL)
       GPUModule->setTargetTriple(Triple::normalize("nvptx64-nvidia-nvcl"));
@@ -2328,6 +2417,7 @@ std::string GPUNodeBuilder::createKernelASM() {
   case GPUArch::NVPTX64:
     switch (Runtime) {
     case GPURuntime::CUDA:
+    case GPURuntime::Host:
       GPUTriple = llvm::Triple(Triple::normalize("nvptx64-nvidia-cuda"));
       break;
     case GPURuntime::OpenCL:
@@ -3574,6 +3664,13 @@ public:
       return false;
     }
 
+    // The exit of a dynamic-exit loop cannot be taken from within a kernel.
+    if (CurrentScop.getDynamicExitLoop()) {
+      LLVM_DEBUG(dbgs() << getUniqueScopName(S)
+                        << " contains a dynamic-exit loop. Bailing out.\n";);
+      return false;
+    }
+
     auto PPCGScop = createPPCGScop();
     auto PPCGProg = createPPCGProg(PPCGScop);
     auto PPCGGen = generateGPU(PPCGScop, PPCGProg);
@@ -98,6 +98,15 @@ void PerfMonitor::addScopCounter() {
 
   TryRegisterGlobal(M, (varname + "_trip_count").c_str(), Builder.getInt64(0),
                     &TripCountForCurrentScopPtr);
+
+  TryRegisterGlobal(M, (varname + "_parallel_cycles").c_str(),
+                    Builder.getInt64(0), &CyclesInParallelRegionsPtr);
+
+  TryRegisterGlobal(M, (varname + "_parallel_work_cycles").c_str(),
+                    Builder.getInt64(0), &CyclesOfParallelWorkPtr);
+
+  TryRegisterGlobal(M, (varname + "_parallel_regions").c_str(),
+                    Builder.getInt64(0), &ParallelRegionCountPtr);
 }
 
 void PerfMonitor::addGlobalVariables() {
@@ -159,7 +168,8 @@ Function *PerfMonitor::insertFinalReporting() {
 
   RuntimeDebugBuilder::createCPUPrinter(
       Builder, "scop function, "
-               "entry block name, exit block name, total time, trip count\n");
+               "entry block name, exit block name, total time, trip count, "
+               "parallel time, parallel work time, parallel regions\n");
   ReturnFromFinal = Builder.CreateRetVoid();
   return ExitFn;
 }
@@ -182,13 +192,22 @@ void PerfMonitor::AppendScopReporting() {
   Value *TripCountForCurrentScop =
       Builder.CreateLoad(this->TripCountForCurrentScopPtr, true);
 
+  Value *CyclesInParallelRegions =
+      Builder.CreateLoad(this->CyclesInParallelRegionsPtr, true);
+  Value *CyclesOfParallelWork =
+      Builder.CreateLoad(this->CyclesOfParallelWorkPtr, true);
+  Value *ParallelRegionCount =
+      Builder.CreateLoad(this->ParallelRegionCountPtr, true);
+
   std::string EntryName, ExitName;
   std::tie(EntryName, ExitName) = S.getEntryExitStr();
 
   // print in CSV for easy parsing with other tools.
   RuntimeDebugBuilder::createCPUPrinter(
       Builder, S.getFunction().getName(), ", ", EntryName, ", ", ExitName, ", ",
-      CyclesInCurrentScop, ", ", TripCountForCurrentScop, "\n");
+      CyclesInCurrentScop, ", ", TripCountForCurrentScop, ", ",
+      CyclesInParallelRegions, ", ", CyclesOfParallelWork, ", ",
+      ParallelRegionCount, "\n");
 
   ReturnFromFinal = Builder.CreateRetVoid();
 }
@@ -296,3 +315,32 @@ void PerfMonitor::insertRegionEnd(Instruction *InsertBefore) {
   Builder.CreateStore(TripCountForCurrentScop, TripCountForCurrentScopPtr,
                       true);
 }
+
+void PerfMonitor::insertParallelRegion(Instruction *Spawn, Instruction *Work,
+                                       Instruction *Join) {
+  if (!Supported)
+    return;
+
+  Function *RDTSCPFn = getRDTSCP();
+  auto ReadCycles = [&](Instruction *InsertBefore) {
+    Builder.SetInsertPoint(InsertBefore);
+    return Builder.CreateExtractValue(Builder.CreateCall(RDTSCPFn), {0});
+  };
+  auto AddToCounter = [&](Value *CounterPtr, Value *Increment) {
+    Value *Counter = Builder.CreateLoad(CounterPtr, true);
+    Counter = Builder.CreateAdd(Counter, Increment);
+    Builder.CreateStore(Counter, CounterPtr, true);
+  };
+
+  // Only the master thread executes the instructions around the subfunction
+  // call, such that the start values can stay in registers.
+  Value *RegionStart = ReadCycles(Spawn);
+  Value *WorkStart = ReadCycles(Work);
+  Value *WorkEnd = ReadCycles(Join);
+  Value *RegionEnd = ReadCycles(Join->getNextNode());
+
+  AddToCounter(CyclesOfParallelWorkPtr, Builder.CreateSub(WorkEnd, WorkStart));
+  AddToCounter(CyclesInParallelRegionsPtr,
+               Builder.CreateSub(RegionEnd, RegionStart));
+  AddToCounter(ParallelRegionCountPtr, Builder.getInt64(1));
+}
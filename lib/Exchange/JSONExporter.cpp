@@ -16,6 +16,8 @@
 #include "polly/Options.h"
 #include "polly/ScopInfo.h"
 #include "polly/ScopPass.h"
+#include "polly/Support/ISLTools.h"
+#include "polly/Support/ScopHelper.h"
 #include "polly/Support/ScopLocation.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/RegionInfo.h"
@@ -28,6 +30,8 @@
 #include "isl/constraint.h"
 #include "isl/map.h"
 #include "isl/printer.h"
+#include "isl/schedule.h"
+#include "isl/schedule_node.h"
 #include "isl/set.h"
 #include "isl/union_map.h"
 #include <memory>
@@ -54,6 +58,12 @@ static cl::opt<std::string>
                   cl::Hidden, cl::value_desc("File postfix"), cl::ValueRequired,
                   cl::init(""), cl::cat(PollyCategory));
 
+static cl::opt<bool> ExportScheduleTree(
+    "polly-export-schedule-tree",
+    cl::desc("Export the complete schedule tree in addition to the "
+             "per-statement schedules"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 struct JSONExporter : public ScopPass {
   static char ID;
   explicit JSONExporter() : ScopPass(ID) {}
@@ -147,6 +157,14 @@ static json::Value getJSON(Scop &S) {
 
   root["arrays"] = exportArrays(S);
 
+  // The flat per-statement schedules lose the structure of the schedule tree,
+  // e.g. band coincidence, AST build options and marks. Export the complete
+  // tree as well if requested, such that it can be imported without losing
+  // them.
+  if (ExportScheduleTree)
+    if (isl::schedule ScheduleTree = S.getScheduleTree())
+      root["schedule"] = ScheduleTree.to_str();
+
   root["statements"];
 
   json::Array Statements;
@@ -254,6 +272,253 @@ static bool importContext(Scop &S, const json::Object &JScop) {
   return true;
 }
 
+/// Replaces the ids of objects read by the isl parser by the ids of a SCoP.
+///
+/// isl identifies an id by its name and its user pointer. The parser creates
+/// ids without user pointer, hence the statement tuples and parameters it
+/// creates are different from those in the SCoP, which carry pointers to the
+/// ScopStmt or the parameter's SCEV. This class maps them by name.
+class IslIdRemapper {
+  Scop &S;
+  StringMap<isl::id> StmtIds;
+  StringMap<isl::id> ParamIds;
+
+public:
+  explicit IslIdRemapper(Scop &S) : S(S) {
+    for (ScopStmt &Stmt : S) {
+      isl::id Id = Stmt.getDomainId();
+      StmtIds[Id.get_name()] = Id;
+    }
+
+    isl::space ParamSpace = S.getParamSpace();
+    for (unsigned i = 0; i < ParamSpace.dim(isl::dim::param); i++) {
+      isl::id Id = ParamSpace.get_dim_id(isl::dim::param, i);
+      ParamIds[Id.get_name()] = Id;
+    }
+  }
+
+  isl::map remap(isl::map Map) const {
+    for (unsigned i = 0; i < Map.dim(isl::dim::param); i++) {
+      auto It = ParamIds.find(Map.get_dim_name(isl::dim::param, i));
+      if (It != ParamIds.end())
+        Map = Map.set_dim_id(isl::dim::param, i, It->second);
+    }
+
+    if (Map.has_tuple_name(isl::dim::in)) {
+      auto It = StmtIds.find(Map.get_tuple_name(isl::dim::in));
+      if (It != StmtIds.end())
+        Map = Map.set_tuple_id(isl::dim::in, It->second);
+    }
+    return Map;
+  }
+
+  isl::set remap(isl::set Set) const {
+    for (unsigned i = 0; i < Set.dim(isl::dim::param); i++) {
+      auto It = ParamIds.find(Set.get_dim_name(isl::dim::param, i));
+      if (It != ParamIds.end())
+        Set = Set.set_dim_id(isl::dim::param, i, It->second);
+    }
+
+    if (Set.has_tuple_name()) {
+      auto It = StmtIds.find(Set.get_tuple_name());
+      if (It != StmtIds.end())
+        Set = Set.set_tuple_id(It->second);
+    }
+    return Set;
+  }
+
+  isl::union_map remap(isl::union_map UMap) const {
+    isl::union_map Result = isl::union_map::empty(S.getParamSpace());
+    for (isl::map Map : UMap.get_map_list())
+      Result = Result.add_map(remap(Map));
+    return Result;
+  }
+
+  isl::union_set remap(isl::union_set USet) const {
+    isl::union_set Result = isl::union_set::empty(S.getParamSpace());
+    for (isl::set Set : USet.get_set_list())
+      Result = Result.add_set(remap(Set));
+    return Result;
+  }
+
+  isl::multi_union_pw_aff remap(isl::multi_union_pw_aff MUPA) const {
+    return isl::multi_union_pw_aff::from_union_map(
+        remap(isl::union_map::from(MUPA)));
+  }
+};
+
+/// Rebuild the subtree of the imported schedule node @p Imported at the leaf
+/// @p Node of the new schedule tree.
+///
+/// @returns The node at the position of @p Node after the subtree has been
+///          inserted, or nullptr if the subtree cannot be imported.
+static isl::schedule_node importScheduleNode(const IslIdRemapper &Remapper,
+                                             isl::schedule_node Imported,
+                                             isl::schedule_node Node) {
+  switch (isl_schedule_node_get_type(Imported.get())) {
+  case isl_schedule_node_leaf:
+    return Node;
+
+  case isl_schedule_node_band: {
+    auto Partial = isl::manage(
+        isl_schedule_node_band_get_partial_schedule(Imported.get()));
+    Node = Node.insert_partial_schedule(Remapper.remap(Partial));
+
+    Node = isl::manage(isl_schedule_node_band_set_permutable(
+        Node.release(), isl_schedule_node_band_get_permutable(Imported.get())));
+    int NumMembers = isl_schedule_node_band_n_member(Imported.get());
+    for (int i = 0; i < NumMembers; i++) {
+      Node = Node.band_member_set_coincident(
+          i, Imported.band_member_get_coincident(i));
+      Node = isl::manage(isl_schedule_node_band_member_set_ast_loop_type(
+          Node.release(), i,
+          isl_schedule_node_band_member_get_ast_loop_type(Imported.get(), i)));
+    }
+    auto Options = isl::manage(
+        isl_schedule_node_band_get_ast_build_options(Imported.get()));
+    Node = Node.band_set_ast_build_options(Remapper.remap(Options));
+
+    Node = importScheduleNode(Remapper, Imported.child(0), Node.child(0));
+    return Node ? Node.parent() : nullptr;
+  }
+
+  case isl_schedule_node_sequence:
+  case isl_schedule_node_set: {
+    int NumChildren = Imported.n_children();
+    auto Filters = isl::union_set_list::alloc(Node.get_ctx(), NumChildren);
+    for (int i = 0; i < NumChildren; i++)
+      Filters = Filters.add(
+          Remapper.remap(Imported.child(i).filter_get_filter()));
+
+    if (isl_schedule_node_get_type(Imported.get()) ==
+        isl_schedule_node_sequence)
+      Node = Node.insert_sequence(Filters);
+    else
+      Node = Node.insert_set(Filters);
+
+    for (int i = 0; i < NumChildren; i++) {
+      Node = importScheduleNode(Remapper, Imported.child(i).child(0),
+                                Node.child(i).child(0));
+      if (!Node)
+        return nullptr;
+      Node = Node.parent().parent();
+    }
+    return Node;
+  }
+
+  case isl_schedule_node_filter:
+    Node = Node.insert_filter(Remapper.remap(Imported.filter_get_filter()));
+    Node = importScheduleNode(Remapper, Imported.child(0), Node.child(0));
+    return Node ? Node.parent() : nullptr;
+
+  case isl_schedule_node_context:
+    Node = Node.insert_context(Remapper.remap(Imported.context_get_context()));
+    Node = importScheduleNode(Remapper, Imported.child(0), Node.child(0));
+    return Node ? Node.parent() : nullptr;
+
+  case isl_schedule_node_guard:
+    Node = Node.insert_guard(Remapper.remap(Imported.guard_get_guard()));
+    Node = importScheduleNode(Remapper, Imported.child(0), Node.child(0));
+    return Node ? Node.parent() : nullptr;
+
+  case isl_schedule_node_mark: {
+    isl::id Mark = Imported.mark_get_id();
+    std::string MarkName = Mark.get_name();
+
+    // Marks that refer to IR objects through their user pointer cannot be
+    // restored from their name only; drop them.
+    if (isLoopAttr(Mark) || MarkName == "Inter iteration alias-free")
+      return importScheduleNode(Remapper, Imported.child(0), Node);
+
+    Node = Node.insert_mark(isl::id::alloc(Node.get_ctx(), MarkName, nullptr));
+    Node = importScheduleNode(Remapper, Imported.child(0), Node.child(0));
+    return Node ? Node.parent() : nullptr;
+  }
+
+  case isl_schedule_node_domain:
+  case isl_schedule_node_expansion:
+  case isl_schedule_node_extension:
+  case isl_schedule_node_error:
+    break;
+  }
+
+  errs() << "The schedule tree contains a node that cannot be imported.\n";
+  return nullptr;
+}
+
+/// Import a new schedule tree from JScop.
+///
+/// The tree must schedule exactly the statement instances of @p S and must
+/// preserve the existing data dependences. It replaces the schedule of @p S
+/// as-is, such that no further schedule optimization is applied to it.
+///
+/// @param S The scop to update.
+/// @param JScop The JScop file describing the new schedule tree.
+/// @param D The data dependences of the @p S.
+/// @param StmtSchedules The per-statement schedules of the JScop file, which
+///                      must agree with the tree.
+///
+/// @returns True if the import succeeded, otherwise False.
+static bool importScheduleTree(Scop &S, const json::Object &JScop,
+                               const Dependences &D,
+                               const StatementToIslMapTy &StmtSchedules) {
+  Optional<StringRef> ScheduleStr = JScop.getString("schedule");
+  if (!ScheduleStr) {
+    errs() << "The key 'schedule' must be a string.\n";
+    return false;
+  }
+
+  isl::schedule Imported = isl::manage(isl_schedule_read_from_str(
+      S.getIslCtx().get(), ScheduleStr.getValue().str().c_str()));
+  if (!Imported) {
+    errs() << "The schedule tree was not parsed successfully by ISL.\n";
+    return false;
+  }
+
+  IslIdRemapper Remapper(S);
+  isl::union_set Domain = S.getDomains();
+  if (!Remapper.remap(Imported.get_domain()).is_equal(Domain)) {
+    errs() << "The schedule tree does not schedule exactly the statement "
+              "instances of the SCoP.\n";
+    return false;
+  }
+
+  isl::schedule_node Root = Imported.get_root();
+  isl::schedule_node Node = isl::schedule::from_domain(Domain).get_root();
+  Node = importScheduleNode(Remapper, Root.child(0), Node.child(0));
+  if (!Node)
+    return false;
+  isl::schedule NewSchedule = Node.get_schedule();
+
+  // The per-statement schedules are edited by hand as well. Refuse to import
+  // a tree that would silently discard such edits. The exported schedules are
+  // gisted, hence both are compared on the statement domain only.
+  isl::union_map TreeMap = NewSchedule.get_map();
+  for (auto &StmtSchedule : StmtSchedules) {
+    ScopStmt *Stmt = StmtSchedule.first;
+    isl::set StmtDomain = Stmt->getDomain();
+    isl::union_map TreeStmtMap =
+        TreeMap.intersect_domain(isl::union_set(StmtDomain));
+    isl::map StmtMap = StmtSchedule.second.intersect_domain(StmtDomain);
+    if (!TreeStmtMap.is_equal(isl::union_map(StmtMap))) {
+      errs() << "The schedule of statement " << Stmt->getBaseName()
+             << " differs from the schedule tree. Remove the per-statement "
+                "schedules or the schedule tree.\n";
+      return false;
+    }
+  }
+
+  if (!D.isValidSchedule(S, NewSchedule)) {
+    errs() << "JScop file contains a schedule tree that changes the "
+           << "dependences. Use -disable-polly-legality to continue anyways\n";
+    return false;
+  }
+
+  S.setScheduleTree(NewSchedule);
+  S.markAsOptimized();
+  return true;
+}
+
 /// Import a new schedule from JScop.
 ///
 /// ... and verify that the new schedule does preserve existing data
@@ -282,10 +547,18 @@ static bool importSchedule(Scop &S, const json::Object &JScop,
     return false;
   }
 
+  // A complete schedule tree supersedes the per-statement schedules, which
+  // are optional then.
+  bool HasScheduleTree = JScop.get("schedule");
+
   int Index = 0;
   for (ScopStmt &Stmt : S) {
     // Check if key 'schedule' is present.
     if (!statements[Index].getAsObject()->get("schedule")) {
+      if (HasScheduleTree) {
+        Index++;
+        continue;
+      }
       errs() << "Statement " << Index << " has no 'schedule' key.\n";
       return false;
     }
@@ -318,6 +591,9 @@ static bool importSchedule(Scop &S, const json::Object &JScop,
     Index++;
   }
 
+  if (HasScheduleTree)
+    return importScheduleTree(S, JScop, D, NewSchedule);
+
   // Check whether the new schedule is valid or not.
   if (!D.isValidSchedule(S, NewSchedule)) {
     errs() << "JScop file contains a schedule that changes the "
@@ -809,11 +1085,7 @@ PreservedAnalyses JSONImportPass::run(Scop &S, ScopAnalysisManager &SAM,
     report_fatal_error("Tried to import a malformed jscop file.");
 
   // This invalidates all analyses on Scop.
-  PreservedAnalyses PA;
-  PA.preserveSet<AllAnalysesOn<Module>>();
-  PA.preserveSet<AllAnalysesOn<Function>>();
-  PA.preserveSet<AllAnalysesOn<Loop>>();
-  return PA;
+  return getScopPassPreservedAnalyses();
 }
 
 INITIALIZE_PASS_BEGIN(JSONExporter, "polly-export-jscop",
@@ -170,6 +170,13 @@ int isl_ctx_aborted(isl_ctx *ctx);
 void isl_ctx_set_max_operations(isl_ctx *ctx, unsigned long max_operations);
 unsigned long isl_ctx_get_max_operations(isl_ctx *ctx);
 void isl_ctx_reset_operations(isl_ctx *ctx);
+unsigned long isl_ctx_get_operations(isl_ctx *ctx);
+
+isl_stat isl_ctx_set_blk_allocator(isl_ctx *ctx,
+	void *(*alloc_fn)(void *user, size_t size),
+	void *(*realloc_fn)(void *user, void *ptr, size_t old_size,
+		size_t new_size),
+	void (*free_fn)(void *user, void *ptr, size_t size), void *user);
 
 #define ISL_ARG_CTX_DECL(prefix,st,args)				\
 st *isl_ctx_peek_ ## prefix(isl_ctx *ctx);
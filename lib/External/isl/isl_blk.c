@@ -43,9 +43,37 @@ static void isl_blk_free_force(struct isl_ctx *ctx, struct isl_blk block)
 {
 	int i;
 
+	if (!block.data)
+		return;
 	for (i = 0; i < block.size; ++i)
 		isl_int_clear(block.data[i]);
-	free(block.data);
+	ctx->blk_free(ctx->blk_user, block.data, block.size * sizeof(isl_int));
+	ctx->n_blk--;
+}
+
+/* Resize the memory of "block" to "new_n" integers using
+ * the allocation functions of "ctx", or allocate the memory
+ * if "block" does not have any yet.
+ * Return NULL and leave the memory of "block" untouched on failure.
+ */
+static isl_int *blk_realloc(struct isl_ctx *ctx, struct isl_blk block,
+	size_t new_n)
+{
+	isl_int *p;
+
+	if (isl_ctx_next_operation(ctx) < 0)
+		return NULL;
+	if (block.data)
+		p = ctx->blk_realloc(ctx->blk_user, block.data,
+			block.size * sizeof(isl_int), new_n * sizeof(isl_int));
+	else
+		p = ctx->blk_alloc(ctx->blk_user, new_n * sizeof(isl_int));
+	if (!p)
+		isl_die(ctx, isl_error_alloc, "allocation failure",
+			return NULL);
+	if (!block.data)
+		ctx->n_blk++;
+	return p;
 }
 
 static struct isl_blk extend(struct isl_ctx *ctx, struct isl_blk block,
@@ -57,7 +85,7 @@ static struct isl_blk extend(struct isl_ctx *ctx, struct isl_blk block,
 	if (block.size >= new_n)
 		return block;
 
-	p = isl_realloc_array(ctx, block.data, isl_int, new_n);
+	p = blk_realloc(ctx, block, new_n);
 	if (!p) {
 		isl_blk_free_force(ctx, block);
 		return isl_blk_error();
@@ -165,6 +165,25 @@ void *isl_ctx_peek_options(isl_ctx *ctx, struct isl_args *args)
 	return find_nested_options(ctx->user_args, ctx->user_opt, args);
 }
 
+/* The default allocation functions of the blocks of integers,
+ * which ignore the sizes of the memory that is resized or freed.
+ */
+static void *default_blk_alloc(void *user, size_t size)
+{
+	return malloc(size);
+}
+
+static void *default_blk_realloc(void *user, void *ptr, size_t old_size,
+	size_t new_size)
+{
+	return realloc(ptr, new_size);
+}
+
+static void default_blk_free(void *user, void *ptr, size_t size)
+{
+	free(ptr);
+}
+
 isl_ctx *isl_ctx_alloc_with_options(struct isl_args *args, void *user_opt)
 {
 	struct isl_ctx *ctx = NULL;
@@ -215,6 +234,11 @@ isl_ctx *isl_ctx_alloc_with_options(struct isl_args *args, void *user_opt)
 
 	ctx->n_cached = 0;
 	ctx->n_miss = 0;
+	ctx->n_blk = 0;
+	ctx->blk_alloc = &default_blk_alloc;
+	ctx->blk_realloc = &default_blk_realloc;
+	ctx->blk_free = &default_blk_free;
+	ctx->blk_user = NULL;
 
 	isl_ctx_reset_error(ctx);
 
@@ -371,6 +395,44 @@ unsigned long isl_ctx_get_max_operations(isl_ctx *ctx)
 	return ctx ? ctx->max_operations : 0;
 }
 
+/* Let the blocks of integers of "ctx" be allocated by "alloc_fn",
+ * resized by "realloc_fn" and freed by "free_fn", each of which is passed
+ * "user" and the sizes of the memory in bytes.
+ * These blocks hold the constraints of basic maps and the elements
+ * of matrices, vectors and tableaus, which take up most of the memory
+ * of a typical computation.  All other memory is still allocated
+ * using malloc.
+ * "realloc_fn" should return NULL and leave "ptr" untouched on failure.
+ *
+ * The functions can only be changed while no blocks are in use,
+ * typically right after "ctx" has been allocated.
+ * The blocks that are cached for reuse have been allocated
+ * by the previous functions, so they are freed first.
+ */
+isl_stat isl_ctx_set_blk_allocator(isl_ctx *ctx,
+	void *(*alloc_fn)(void *user, size_t size),
+	void *(*realloc_fn)(void *user, void *ptr, size_t old_size,
+		size_t new_size),
+	void (*free_fn)(void *user, void *ptr, size_t size), void *user)
+{
+	if (!ctx)
+		return isl_stat_error;
+	if (!alloc_fn || !realloc_fn || !free_fn)
+		isl_die(ctx, isl_error_invalid,
+			"all allocation functions need to be specified",
+			return isl_stat_error);
+	isl_blk_clear_cache(ctx);
+	if (ctx->n_blk != 0)
+		isl_die(ctx, isl_error_invalid,
+			"cannot change allocator while blocks are in use",
+			return isl_stat_error);
+	ctx->blk_alloc = alloc_fn;
+	ctx->blk_realloc = realloc_fn;
+	ctx->blk_free = free_fn;
+	ctx->blk_user = user;
+	return isl_stat_ok;
+}
+
 /* Reset the number of operations performed by "ctx".
  */
 void isl_ctx_reset_operations(isl_ctx *ctx)
@@ -379,3 +441,11 @@ void isl_ctx_reset_operations(isl_ctx *ctx)
 		return;
 	ctx->operations = 0;
 }
+
+/* Return the number of operations performed by "ctx" since it was created
+ * or since the last call to isl_ctx_reset_operations.
+ */
+unsigned long isl_ctx_get_operations(isl_ctx *ctx)
+{
+	return ctx ? ctx->operations : 0;
+}
@@ -1,7 +1,13 @@
 #include <isl/ctx.h>
 #include <isl_blk.h>
 
-/* "error" stores the last error that has occurred.
+/* "n_blk" is the number of blocks of integers that have been allocated
+ * and not yet freed, including those in "cache".
+ * "blk_alloc", "blk_realloc" and "blk_free" allocate, resize and free
+ * the memory of these blocks.  They are passed "blk_user" and
+ * the sizes of the memory in bytes.
+ *
+ * "error" stores the last error that has occurred.
  * It is reset to isl_error_none by isl_ctx_reset_error.
  * "error_msg" stores the error message of the last error,
  * while "error_file" and "error_line" specify where the last error occurred.
@@ -28,6 +34,13 @@ struct isl_ctx {
 	int			n_cached;
 	int			n_miss;
 	struct isl_blk		cache[ISL_BLK_CACHE_SIZE];
+	size_t			n_blk;
+	void			*(*blk_alloc)(void *user, size_t size);
+	void			*(*blk_realloc)(void *user, void *ptr,
+					size_t old_size, size_t new_size);
+	void			(*blk_free)(void *user, void *ptr,
+					size_t size);
+	void			*blk_user;
 	struct isl_hash_table	id_table;
 
 	enum isl_error		error;
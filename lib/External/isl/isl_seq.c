@@ -11,6 +11,153 @@
 #include <isl_ctx_private.h>
 #include <isl_seq.h>
 
+#ifdef USE_SMALL_INT_OPT
+/* Return the largest absolute value of the elements of "p" of length "len"
+ * if they are all in small representation and -1 otherwise.
+ * The loop does not branch on the elements, such that it can be vectorized.
+ */
+static int64_t small_abs_max(isl_int *p, unsigned len)
+{
+	int i;
+	isl_sioimath small = 1;
+	uint32_t max = 0;
+
+	for (i = 0; i < len; ++i) {
+		int32_t v = isl_sioimath_get_small(*p[i]);
+		uint32_t a = v < 0 ? -(uint32_t) v : (uint32_t) v;
+
+		small &= *p[i];
+		max = a > max ? a : max;
+	}
+	return isl_sioimath_is_small(small) ? (int64_t) max : -1;
+}
+
+/* Return the absolute value of "v", which is in small representation.
+ */
+static int64_t small_abs(isl_int v)
+{
+	int64_t a = isl_sioimath_get_small(*v);
+
+	return a < 0 ? -a : a;
+}
+
+/* Return whether "dst" can be overwritten by values in small representation,
+ * i.e., whether it does not hold any big integers that would be leaked.
+ * "src1" and "src2" of length "len" have already been checked
+ * to only hold small integers.
+ */
+static int small_dst(isl_int *dst, isl_int *src1, isl_int *src2,
+	unsigned len)
+{
+	if (dst == src1 || dst == src2)
+		return 1;
+	return small_abs_max(dst, len) >= 0;
+}
+
+/* Perform isl_seq_combine using native integer arithmetic if "m1", "m2" and
+ * all elements of "src1", "src2" and "dst" are in small representation and
+ * the result is guaranteed to be small as well, i.e., if
+ *
+ *	|m1| max_i |src1[i]| + |m2| max_i |src2[i]| <= ISL_SIOIMATH_SMALL_MAX
+ *
+ * Each product fits in 62 bits and the sum in 63 bits, so no intermediate
+ * result can overflow.
+ * Return 1 if the combination was performed and 0 otherwise.
+ */
+static int combine_small(isl_int *dst, isl_int m1, isl_int *src1,
+	isl_int m2, isl_int *src2, unsigned len)
+{
+	int i;
+	int64_t f1, f2, max1, max2;
+
+	if (isl_sioimath_is_big(*m1) || isl_sioimath_is_big(*m2))
+		return 0;
+	max1 = small_abs_max(src1, len);
+	if (max1 < 0)
+		return 0;
+	max2 = small_abs_max(src2, len);
+	if (max2 < 0)
+		return 0;
+	if (small_abs(m1) * max1 + small_abs(m2) * max2 > ISL_SIOIMATH_SMALL_MAX)
+		return 0;
+	if (!small_dst(dst, src1, src2, len))
+		return 0;
+
+	f1 = isl_sioimath_get_small(*m1);
+	f2 = isl_sioimath_get_small(*m2);
+	for (i = 0; i < len; ++i) {
+		int64_t v = f1 * isl_sioimath_get_small(*src1[i]) +
+			    f2 * isl_sioimath_get_small(*src2[i]);
+		*dst[i] = isl_sioimath_encode_small(v);
+	}
+	return 1;
+}
+
+/* Perform isl_seq_scale_down using native integer arithmetic if "m" and
+ * all elements of "src" and "dst" are in small representation.
+ * Since the division is exact, the results are no larger than the inputs.
+ * Return 1 if the division was performed and 0 otherwise.
+ */
+static int scale_down_small(isl_int *dst, isl_int *src, isl_int m,
+	unsigned len)
+{
+	int i;
+	int32_t f;
+
+	if (!isl_sioimath_decode_small(*m, &f))
+		return 0;
+	if (small_abs_max(src, len) < 0 || !small_dst(dst, src, src, len))
+		return 0;
+
+	for (i = 0; i < len; ++i)
+		*dst[i] = isl_sioimath_encode_small(
+				isl_sioimath_get_small(*src[i]) / f);
+	return 1;
+}
+
+/* Perform isl_seq_gcd using native integer arithmetic if all elements
+ * of "p" are in small representation.
+ * Return 1 if the gcd was computed and 0 otherwise.
+ */
+static int gcd_small(isl_int *p, unsigned len, isl_int *gcd)
+{
+	int i;
+	uint32_t g = 0;
+
+	if (small_abs_max(p, len) < 0)
+		return 0;
+
+	for (i = 0; g != 1 && i < len; ++i) {
+		uint32_t a = small_abs(p[i]);
+
+		while (a != 0) {
+			uint32_t t = g % a;
+			g = a;
+			a = t;
+		}
+	}
+	isl_int_set_si(*gcd, g);
+	return 1;
+}
+#else
+static int combine_small(isl_int *dst, isl_int m1, isl_int *src1,
+	isl_int m2, isl_int *src2, unsigned len)
+{
+	return 0;
+}
+
+static int scale_down_small(isl_int *dst, isl_int *src, isl_int m,
+	unsigned len)
+{
+	return 0;
+}
+
+static int gcd_small(isl_int *p, unsigned len, isl_int *gcd)
+{
+	return 0;
+}
+#endif
+
 void isl_seq_clr(isl_int *p, unsigned len)
 {
 	int i;
@@ -77,6 +224,9 @@ void isl_seq_scale(isl_int *dst, isl_int *src, isl_int m, unsigned len)
 void isl_seq_scale_down(isl_int *dst, isl_int *src, isl_int m, unsigned len)
 {
 	int i;
+
+	if (scale_down_small(dst, src, m, len))
+		return;
 	for (i = 0; i < len; ++i)
 		isl_int_divexact(dst[i], src[i], m);
 }
@@ -111,11 +261,16 @@ void isl_seq_combine(isl_int *dst, isl_int m1, isl_int *src1,
 	if (dst == src1 && isl_int_is_one(m1)) {
 		if (isl_int_is_zero(m2))
 			return;
+		if (combine_small(dst, m1, src1, m2, src2, len))
+			return;
 		for (i = 0; i < len; ++i)
 			isl_int_addmul(src1[i], m2, src2[i]);
 		return;
 	}
 
+	if (combine_small(dst, m1, src1, m2, src2, len))
+		return;
+
 	isl_int_init(tmp);
 	for (i = 0; i < len; ++i) {
 		isl_int_mul(tmp, m1, src1[i]);
@@ -237,8 +392,12 @@ int isl_seq_abs_min_non_zero(isl_int *p, unsigned len)
 
 void isl_seq_gcd(isl_int *p, unsigned len, isl_int *gcd)
 {
-	int i, min = isl_seq_abs_min_non_zero(p, len);
+	int i, min;
+
+	if (gcd_small(p, len, gcd))
+		return;
 
+	min = isl_seq_abs_min_non_zero(p, len);
 	if (min < 0) {
 		isl_int_set_si(*gcd, 0);
 		return;
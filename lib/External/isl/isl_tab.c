@@ -1121,12 +1121,18 @@ static void update_row_sign(struct isl_tab *tab, int row, int col, int row_sgn)
  * s(n_rc)d_r/|n_rc|		-s(n_rc)n_ri/|n_rc|
  * s(n_rc)d_r n_jc/(|n_rc| d_j)	(n_ji |n_rc| - s(n_rc)n_jc n_ri)/(|n_rc| d_j)
  *
+ * The last two steps are performed on all columns of row j
+ * (including the constant term, but excluding the denominator) at once
+ * by isl_seq_combine, which has a fast path for small integers.
+ * This also updates column c itself, which is then overwritten
+ * by s(n_rc)d_r n_jc computed from the original value of n_jc.
  */
 int isl_tab_pivot(struct isl_tab *tab, int row, int col)
 {
 	int i, j;
 	int sgn;
 	int t;
+	isl_int n_jc;
 	isl_ctx *ctx;
 	struct isl_mat *mat = tab->mat;
 	struct isl_tab_var *var;
@@ -1149,25 +1155,22 @@ int isl_tab_pivot(struct isl_tab *tab, int row, int col)
 		}
 	if (!isl_int_is_one(mat->row[row][0]))
 		isl_seq_normalize(mat->ctx, mat->row[row], off + tab->n_col);
+	isl_int_init(n_jc);
 	for (i = 0; i < tab->n_row; ++i) {
 		if (i == row)
 			continue;
 		if (isl_int_is_zero(mat->row[i][off + col]))
 			continue;
 		isl_int_mul(mat->row[i][0], mat->row[i][0], mat->row[row][0]);
-		for (j = 0; j < off - 1 + tab->n_col; ++j) {
-			if (j == off - 1 + col)
-				continue;
-			isl_int_mul(mat->row[i][1 + j],
-				    mat->row[i][1 + j], mat->row[row][0]);
-			isl_int_addmul(mat->row[i][1 + j],
-				    mat->row[i][off + col], mat->row[row][1 + j]);
-		}
-		isl_int_mul(mat->row[i][off + col],
-			    mat->row[i][off + col], mat->row[row][off + col]);
+		isl_int_set(n_jc, mat->row[i][off + col]);
+		isl_seq_combine(mat->row[i] + 1, mat->row[row][0],
+				mat->row[i] + 1, n_jc, mat->row[row] + 1,
+				off - 1 + tab->n_col);
+		isl_int_mul(mat->row[i][off + col], n_jc, mat->row[row][off + col]);
 		if (!isl_int_is_one(mat->row[i][0]))
 			isl_seq_normalize(mat->ctx, mat->row[i], off + tab->n_col);
 	}
+	isl_int_clear(n_jc);
 	t = tab->row_var[row];
 	tab->row_var[row] = tab->col_var[col];
 	tab->col_var[col] = t;
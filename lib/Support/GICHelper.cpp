@@ -10,8 +10,14 @@
 //
 //===----------------------------------------------------------------------===//
 #include "polly/Support/GICHelper.h"
+#include "polly/Options.h"
 #include "llvm/IR/Value.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "isl/aff.h"
+#include "isl/flow.h"
 #include "isl/map.h"
 #include "isl/schedule.h"
 #include "isl/set.h"
@@ -20,10 +26,18 @@
 #include "isl/union_set.h"
 #include "isl/val.h"
 
+#include <atomic>
 #include <climits>
 
 using namespace llvm;
 
+static cl::opt<std::string> CaptureIslInputs(
+    "polly-capture-isl-inputs",
+    cl::desc("Write the inputs of the dataflow analysis, the scheduler and the "
+             "AST generation to this directory, to replay them with "
+             "polly-isl-bench"),
+    cl::Hidden, cl::init(""), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 __isl_give isl_val *polly::isl_valFromAPInt(isl_ctx *Ctx, const APInt Int,
                                             bool IsSigned) {
   APInt Abs;
@@ -223,6 +237,53 @@ std::string polly::getIslCompatibleName(const std::string &Prefix,
   return getIslCompatibleName(Prefix, ValStr, Suffix);
 }
 
+/// Write @p Str to a new file with extension @p Extension in the directory
+/// given by -polly-capture-isl-inputs and free it.
+static void writeIslInput(const char *Extension, char *Str) {
+  static std::atomic<unsigned> NumCaptured(0);
+
+  if (!Str)
+    return;
+
+  SmallString<128> FileName(CaptureIslInputs);
+  sys::path::append(FileName, "polly-" +
+                                  std::to_string(sys::Process::getProcessId()) +
+                                  "-" + std::to_string(NumCaptured++) + "." +
+                                  Extension);
+  std::error_code EC;
+  raw_fd_ostream OS(FileName, EC, sys::fs::F_Text);
+  if (EC)
+    errs() << "Could not write isl input to " << FileName << ": "
+           << EC.message() << "\n";
+  else
+    OS << Str;
+  free(Str);
+}
+
+void polly::captureIslInput(__isl_keep isl_union_access_info *Access) {
+  if (!CaptureIslInputs.empty())
+    writeIslInput("ai", isl_union_access_info_to_str(Access));
+}
+
+void polly::captureIslInput(__isl_keep isl_schedule_constraints *Constraints) {
+  if (!CaptureIslInputs.empty())
+    writeIslInput("sc", isl_schedule_constraints_to_str(Constraints));
+}
+
+void polly::captureIslInput(__isl_keep isl_schedule *Schedule,
+                            __isl_keep isl_set *Context) {
+  if (CaptureIslInputs.empty())
+    return;
+
+  // The AST is generated for the parameter values in Context. A context node
+  // at the root constrains the zero-dimensional outer schedule space.
+  isl_schedule *WithContext =
+      isl_schedule_insert_context(isl_schedule_copy(Schedule),
+                                  isl_set_from_params(isl_set_copy(Context)));
+  writeIslInput("st", isl_schedule_to_str(WithContext));
+  isl_schedule_free(WithContext);
+}
+
 #if !defined(NDEBUG) || defined(LLVM_ENABLE_DUMP)
 /// To call a inline dump() method in a debugger, at it must have been
 /// instantiated in at least one translation unit. Because isl's dump() method
@@ -0,0 +1,124 @@
+//===------ IslArena.cpp ----------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An arena for the blocks of integers of an isl_ctx.
+//
+//===----------------------------------------------------------------------===//
+
+#include "polly/Support/IslArena.h"
+#include "llvm/Support/MathExtras.h"
+#include "isl/ctx.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+using namespace llvm;
+using namespace polly;
+
+unsigned IslArena::getSizeClass(size_t Size) {
+  assert(Size <= MaxSize && "Blocks of this size are not in a size class");
+  if (Size <= MinSize)
+    return 0;
+  return Log2_64_Ceil(Size) - Log2_64(MinSize);
+}
+
+void *IslArena::allocate(size_t Size) {
+  if (Size > MaxSize) {
+    void *Ptr = std::malloc(Size);
+    if (Ptr)
+      BytesInUse += Size;
+    return Ptr;
+  }
+
+  unsigned Class = getSizeClass(Size);
+  BytesInUse += Size;
+  if (void *Ptr = FreeLists[Class]) {
+    FreeLists[Class] = *static_cast<void **>(Ptr);
+    return Ptr;
+  }
+  return Slabs.Allocate(MinSize << Class, MinSize);
+}
+
+void *IslArena::reallocate(void *Ptr, size_t OldSize, size_t NewSize) {
+  // Blocks that stay within their size class do not move.
+  if (OldSize <= MaxSize && NewSize <= MaxSize &&
+      getSizeClass(OldSize) == getSizeClass(NewSize)) {
+    BytesInUse += NewSize;
+    BytesInUse -= OldSize;
+    return Ptr;
+  }
+
+  if (OldSize > MaxSize && NewSize > MaxSize) {
+    void *NewPtr = std::realloc(Ptr, NewSize);
+    if (NewPtr) {
+      BytesInUse += NewSize;
+      BytesInUse -= OldSize;
+    }
+    return NewPtr;
+  }
+
+  void *NewPtr = allocate(NewSize);
+  if (!NewPtr)
+    return nullptr;
+  std::memcpy(NewPtr, Ptr, std::min(OldSize, NewSize));
+  deallocate(Ptr, OldSize);
+  return NewPtr;
+}
+
+void IslArena::deallocate(void *Ptr, size_t Size) {
+  BytesInUse -= Size;
+  if (Size > MaxSize) {
+    std::free(Ptr);
+    return;
+  }
+
+  unsigned Class = getSizeClass(Size);
+  *static_cast<void **>(Ptr) = FreeLists[Class];
+  FreeLists[Class] = Ptr;
+}
+
+static void *allocateBlock(void *User, size_t Size) {
+  return static_cast<IslArena *>(User)->allocate(Size);
+}
+
+static void *reallocateBlock(void *User, void *Ptr, size_t OldSize,
+                             size_t NewSize) {
+  return static_cast<IslArena *>(User)->reallocate(Ptr, OldSize, NewSize);
+}
+
+static void deallocateBlock(void *User, void *Ptr, size_t Size) {
+  static_cast<IslArena *>(User)->deallocate(Ptr, Size);
+}
+
+namespace {
+/// Free an isl_ctx and then its arena.
+struct ArenaCtxDeleter {
+  IslArena *Arena;
+
+  void operator()(isl_ctx *Ctx) const {
+    // isl_ctx_free returns the cached blocks to the arena, so the arena must
+    // outlive it.
+    isl_ctx_free(Ctx);
+    delete Arena;
+  }
+};
+} // namespace
+
+std::shared_ptr<isl_ctx> polly::allocIslCtxWithArena() {
+  isl_ctx *Ctx = isl_ctx_alloc();
+  IslArena *Arena = new IslArena();
+  isl_ctx_set_blk_allocator(Ctx, allocateBlock, reallocateBlock,
+                            deallocateBlock, Arena);
+  return std::shared_ptr<isl_ctx>(Ctx, ArenaCtxDeleter{Arena});
+}
+
+const IslArena *polly::getIslArena(const std::shared_ptr<isl_ctx> &Ctx) {
+  if (auto *Deleter = std::get_deleter<ArenaCtxDeleter>(Ctx))
+    return Deleter->Arena;
+  return nullptr;
+}
@@ -0,0 +1,280 @@
+//===------ OptimizationProfile.cpp -----------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Per-function and per-SCoP overrides of Polly options.
+//
+//===----------------------------------------------------------------------===//
+
+#include "polly/Support/OptimizationProfile.h"
+#include "polly/Options.h"
+#include "polly/ScopInfo.h"
+#include "polly/Support/ScopHelper.h"
+#include "polly/Support/ScopLocation.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/RegionInfo.h"
+#include "llvm/IR/Function.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Regex.h"
+
+using namespace llvm;
+using namespace polly;
+
+#define DEBUG_TYPE "polly-profile"
+
+static cl::opt<std::string> ProfileFile(
+    "polly-optimization-profiles",
+    cl::desc("A JSON file with per-function/per-SCoP overrides of Polly "
+             "options"),
+    cl::value_desc("filename"), cl::init(""), cl::ZeroOrMore,
+    cl::cat(PollyCategory));
+
+/// The options that are read through getProfileOption and can therefore be
+/// overridden by a profile.
+static const char *const ProfileOptions[] = {
+    // Analysis.
+    "polly-analysis-computeout",
+    "polly-dependences-computeout",
+    // Schedule optimization.
+    "polly-opt-fusion",
+    "polly-opt-maximize-bands",
+    "polly-opt-outer-coincidence",
+    "polly-tiling",
+    "polly-default-tile-size",
+    "polly-tile-sizes",
+    "polly-2nd-level-tiling",
+    "polly-2nd-level-default-tile-size",
+    "polly-2nd-level-tile-sizes",
+    "polly-register-tiling",
+    "polly-register-tiling-default-tile-size",
+    "polly-register-tile-sizes",
+    "polly-prevect-width",
+    "polly-pattern-matching-based-opts",
+    "polly-pragma-based-opts",
+    // Code generation.
+    "polly-parallel",
+    "polly-vectorizer",
+};
+
+namespace {
+/// A profile together with the conditions under which it applies.
+struct ProfileEntry {
+  OptimizationProfile Profile;
+  std::string FunctionRegex;
+  std::string FileRegex;
+  unsigned LineBegin = 0;
+  unsigned LineEnd = ~0u;
+
+  bool matches(StringRef FunctionName, StringRef FileName, unsigned ScopBegin,
+               unsigned ScopEnd) const {
+    if (!FunctionRegex.empty() && !Regex(FunctionRegex).match(FunctionName))
+      return false;
+    if (!FileRegex.empty() && !Regex(FileRegex).match(FileName))
+      return false;
+
+    // Without debug info the SCoP has no lines; such SCoPs only match
+    // profiles that do not restrict the lines.
+    bool HasLineRange = LineBegin != 0 || LineEnd != ~0u;
+    if (HasLineRange && ScopBegin > ScopEnd)
+      return false;
+    return ScopBegin <= LineEnd && LineBegin <= ScopEnd;
+  }
+};
+} // namespace
+
+static void reportMalformedProfiles(const Twine &Msg) {
+  report_fatal_error("malformed optimization profiles file '" + ProfileFile +
+                         "': " + Msg,
+                     false);
+}
+
+static void checkRegex(StringRef RegexStr) {
+  std::string Err;
+  if (!Regex(RegexStr).isValid(Err))
+    reportMalformedProfiles("invalid regex '" + RegexStr + "': " + Err);
+}
+
+static ProfileEntry parseProfileEntry(const json::Value &Value,
+                                      unsigned Index) {
+  const json::Object *Obj = Value.getAsObject();
+  if (!Obj)
+    reportMalformedProfiles("profile " + Twine(Index) + " is not an object");
+
+  ProfileEntry Entry;
+  Entry.Profile.Name = Obj->getString("name")
+                           .getValueOr(("profile" + Twine(Index)).str())
+                           .str();
+
+  if (const json::Value *Function = Obj->get("function")) {
+    if (!Function->getAsString())
+      reportMalformedProfiles("'function' of profile '" + Entry.Profile.Name +
+                              "' must be a string");
+    Entry.FunctionRegex = Function->getAsString()->str();
+    checkRegex(Entry.FunctionRegex);
+  }
+
+  if (const json::Value *File = Obj->get("file")) {
+    if (!File->getAsString())
+      reportMalformedProfiles("'file' of profile '" + Entry.Profile.Name +
+                              "' must be a string");
+    Entry.FileRegex = File->getAsString()->str();
+    checkRegex(Entry.FileRegex);
+  }
+
+  if (const json::Value *Lines = Obj->get("lines")) {
+    const json::Array *Range = Lines->getAsArray();
+    if (!Range || Range->size() != 2 || !(*Range)[0].getAsInteger() ||
+        !(*Range)[1].getAsInteger())
+      reportMalformedProfiles("'lines' of profile '" + Entry.Profile.Name +
+                              "' must be a pair of line numbers");
+    Entry.LineBegin = *(*Range)[0].getAsInteger();
+    Entry.LineEnd = *(*Range)[1].getAsInteger();
+  }
+
+  const json::Object *Options = Obj->getObject("options");
+  if (!Options)
+    reportMalformedProfiles("profile '" + Entry.Profile.Name +
+                            "' has no 'options' object");
+
+  for (const auto &Option : *Options) {
+    StringRef Name = Option.first;
+    if (!is_contained(ProfileOptions, Name))
+      reportMalformedProfiles("option '" + Name +
+                              "' cannot be set by a profile");
+
+    // Allow booleans and numbers to be written without quotes.
+    std::string Value;
+    if (Optional<StringRef> Str = Option.second.getAsString())
+      Value = Str->str();
+    else if (Optional<bool> Bool = Option.second.getAsBoolean())
+      Value = *Bool ? "true" : "false";
+    else if (Optional<int64_t> Int = Option.second.getAsInteger())
+      Value = std::to_string(*Int);
+    else
+      reportMalformedProfiles("value of option '" + Name + "' in profile '" +
+                              Entry.Profile.Name +
+                              "' must be a string, boolean or integer");
+
+    Entry.Profile.Overrides[Name] = Value;
+  }
+
+  return Entry;
+}
+
+static std::vector<ProfileEntry> loadProfiles() {
+  std::vector<ProfileEntry> Profiles;
+  if (ProfileFile.empty())
+    return Profiles;
+
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer =
+      MemoryBuffer::getFile(ProfileFile);
+  if (std::error_code EC = Buffer.getError())
+    report_fatal_error(Twine("cannot read optimization profiles file '") +
+                           ProfileFile + "': " + EC.message(),
+                       false);
+
+  Expected<json::Value> ParseResult = json::parse(Buffer.get()->getBuffer());
+  if (Error E = ParseResult.takeError())
+    reportMalformedProfiles(toString(std::move(E)));
+
+  const json::Object *Root = ParseResult->getAsObject();
+  const json::Array *Entries = Root ? Root->getArray("profiles") : nullptr;
+  if (!Entries)
+    reportMalformedProfiles("expected an object with a 'profiles' array");
+
+  for (unsigned i = 0; i < Entries->size(); i++)
+    Profiles.push_back(parseProfileEntry((*Entries)[i], i));
+
+  return Profiles;
+}
+
+static const std::vector<ProfileEntry> &getProfiles() {
+  static const std::vector<ProfileEntry> Profiles = loadProfiles();
+  return Profiles;
+}
+
+const OptimizationProfile *
+polly::findOptimizationProfile(const Function &F, const Region &R) {
+  if (ProfileFile.empty())
+    return nullptr;
+
+  const std::vector<ProfileEntry> &Profiles = getProfiles();
+  if (Profiles.empty())
+    return nullptr;
+
+  unsigned LineBegin, LineEnd;
+  std::string FileName;
+  getDebugLocation(&R, LineBegin, LineEnd, FileName);
+
+  for (const ProfileEntry &Entry : Profiles)
+    if (Entry.matches(F.getName(), FileName, LineBegin, LineEnd))
+      return &Entry.Profile;
+  return nullptr;
+}
+
+const OptimizationProfile *polly::findOptimizationProfile(const Scop &S) {
+  return findOptimizationProfile(S.getFunction(), S.getRegion());
+}
+
+void polly::emitOptimizationProfileRemark(const OptimizationProfile &Profile,
+                                          const Region &R,
+                                          OptimizationRemarkEmitter &ORE) {
+  DebugLoc Beg, End;
+  auto P = getBBPairForRegion(&R);
+  getDebugLocations(P, Beg, End);
+
+  OptimizationRemarkAnalysis Remark(DEBUG_TYPE, "ProfileApplied", Beg,
+                                    P.first);
+  Remark << "Optimization profile '" << Profile.Name << "' applies:";
+
+  // Sort the overrides for a deterministic output.
+  SmallVector<StringRef, 8> Names;
+  for (const auto &Override : Profile.Overrides)
+    Names.push_back(Override.first());
+  llvm::sort(Names);
+  for (StringRef Name : Names)
+    Remark << " -" << Name << "=" << Profile.Overrides.lookup(Name);
+
+  ORE.emit(Remark);
+}
+
+/// The profile of the SCoP currently processed by this thread.
+static LLVM_THREAD_LOCAL const OptimizationProfile *ActiveProfile = nullptr;
+
+OptimizationProfileScope::OptimizationProfileScope(
+    const OptimizationProfile *Profile)
+    : Previous(ActiveProfile) {
+  ActiveProfile = Profile;
+}
+
+OptimizationProfileScope::OptimizationProfileScope(const Scop &S)
+    : OptimizationProfileScope(findOptimizationProfile(S)) {}
+
+OptimizationProfileScope::~OptimizationProfileScope() {
+  ActiveProfile = Previous;
+}
+
+Optional<StringRef> polly::getActiveProfileOverride(StringRef Name) {
+  if (!ActiveProfile)
+    return None;
+
+  auto It = ActiveProfile->Overrides.find(Name);
+  if (It == ActiveProfile->Overrides.end())
+    return None;
+  return StringRef(It->second);
+}
+
+void polly::reportInvalidProfileOverride(StringRef Name, StringRef Value) {
+  errs() << "warning: optimization profile '" << ActiveProfile->Name
+         << "' gives invalid value '" << Value << "' to option '" << Name
+         << "'; using the command line value\n";
+}
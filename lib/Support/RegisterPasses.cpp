@@ -25,18 +25,23 @@
 #include "polly/CodeGen/IslAst.h"
 #include "polly/CodeGen/PPCGCodeGeneration.h"
 #include "polly/CodePreparation.h"
+#include "polly/ConcurrentScopOptimizer.h"
 #include "polly/DeLICM.h"
 #include "polly/DependenceInfo.h"
+#include "polly/EarlyExitChunking.h"
 #include "polly/FlattenSchedule.h"
 #include "polly/ForwardOpTree.h"
 #include "polly/JSONExporter.h"
 #include "polly/LinkAllPasses.h"
 #include "polly/Options.h"
 #include "polly/PolyhedralInfo.h"
+#include "polly/PruneUnprofitable.h"
+#include "polly/ScheduleOptimizer.h"
 #include "polly/ScopDetection.h"
 #include "polly/ScopInfo.h"
 #include "polly/Simplify.h"
 #include "polly/Support/DumpModulePass.h"
+#include "polly/Support/OptimizationProfile.h"
 #include "llvm/Analysis/CFGPrinter.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Verifier.h"
@@ -117,7 +122,9 @@ static cl::opt<GPURuntime> GPURuntimeChoice(
     cl::values(clEnumValN(GPURuntime::CUDA, "libcudart",
                           "use the CUDA Runtime API"),
                clEnumValN(GPURuntime::OpenCL, "libopencl",
-                          "use the OpenCL Runtime API")),
+                          "use the OpenCL Runtime API"),
+               clEnumValN(GPURuntime::Host, "host",
+                          "emulate the CUDA Runtime API on the host")),
     cl::init(GPURuntime::CUDA), cl::ZeroOrMore, cl::cat(PollyCategory));
 
 static cl::opt<GPUArch>
@@ -145,6 +152,10 @@ static cl::opt<polly::VectorizerChoice, true> Vectorizer(
     cl::location(PollyVectorizerChoice), cl::init(polly::VECTORIZER_NONE),
     cl::ZeroOrMore, cl::cat(PollyCategory));
 
+VectorizerChoice polly::getVectorizerChoice() {
+  return getProfileOption(Vectorizer);
+}
+
 static cl::opt<bool> ImportJScop(
     "polly-import",
     cl::desc("Import the polyhedral description of the detected Scops"),
@@ -155,6 +166,18 @@ static cl::opt<bool> FullyIndexedStaticExpansion(
     cl::desc("Fully expand the memory accesses of the detected Scops"),
     cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
 
+static cl::opt<bool> EnableAoSToSoA(
+    "polly-enable-aos-to-soa",
+    cl::desc("Split arrays of structures that are local to the detected "
+             "Scops into one array per field"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+static cl::opt<bool> EnableArrayTransposition(
+    "polly-enable-array-transposition",
+    cl::desc("Permute the dimensions of arrays that are local to the detected "
+             "Scops to make accesses in the innermost loops stride-one"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 static cl::opt<bool> ExportJScop(
     "polly-export",
     cl::desc("Export the polyhedral description of the detected Scops"),
@@ -240,6 +263,18 @@ static cl::opt<bool> EnablePruneUnprofitable(
     cl::desc("Bail out on unprofitable SCoPs before rescheduling"), cl::Hidden,
     cl::init(true), cl::cat(PollyCategory));
 
+static cl::opt<bool> ConcurrentScops(
+    "polly-concurrent-scops",
+    cl::desc("Compute the dependences, schedules and ASTs of all SCoPs of a "
+             "function on a thread pool"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+static cl::opt<bool> EnableEarlyExitChunking(
+    "polly-enable-early-exit-chunking",
+    cl::desc("Evaluate the exits of early-exit loops in chunks of iterations "
+             "before detecting SCoPs"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 namespace polly {
 void initializePollyPasses(PassRegistry &Registry) {
   initializeCodeGenerationPass(Registry);
@@ -253,12 +288,16 @@ void initializePollyPasses(PassRegistry &Registry) {
   LLVMInitializeNVPTXAsmPrinter();
 #endif
   initializeCodePreparationPass(Registry);
+  initializeConcurrentScopOptimizerPass(Registry);
   initializeDeadCodeElimPass(Registry);
+  initializeEarlyExitChunkingPass(Registry);
   initializeDependenceInfoPass(Registry);
   initializeDependenceInfoWrapperPassPass(Registry);
   initializeJSONExporterPass(Registry);
   initializeJSONImporterPass(Registry);
   initializeMaximalStaticExpanderPass(Registry);
+  initializeAoSToSoAPass(Registry);
+  initializeArrayTranspositionPass(Registry);
   initializeIslAstInfoWrapperPassPass(Registry);
   initializeIslScheduleOptimizerPass(Registry);
   initializePollyCanonicalizePass(Registry);
@@ -277,52 +316,9 @@ void initializePollyPasses(PassRegistry &Registry) {
   initializePruneUnprofitablePass(Registry);
 }
 
-/// Register Polly passes such that they form a polyhedral optimizer.
-///
-/// The individual Polly passes are registered in the pass manager such that
-/// they form a full polyhedral optimizer. The flow of the optimizer starts with
-/// a set of preparing transformations that canonicalize the LLVM-IR such that
-/// the LLVM-IR is easier for us to understand and to optimizes. On the
-/// canonicalized LLVM-IR we first run the ScopDetection pass, which detects
-/// static control flow regions. Those regions are then translated by the
-/// ScopInfo pass into a polyhedral representation. As a next step, a scheduling
-/// optimizer is run on the polyhedral representation and finally the optimized
-/// polyhedral representation is code generated back to LLVM-IR.
-///
-/// Besides this core functionality, we optionally schedule passes that provide
-/// a graphical view of the scops (Polly[Only]Viewer, Polly[Only]Printer), that
-/// allow the export/import of the polyhedral representation
-/// (JSCON[Exporter|Importer]) or that show the cfg after code generation.
-///
-/// For certain parts of the Polly optimizer, several alternatives are provided:
-///
-/// As scheduling optimizer we support the isl scheduling optimizer
-/// (http://freecode.com/projects/isl).
-/// It is also possible to run Polly with no optimizer. This mode is mainly
-/// provided to analyze the run and compile time changes caused by the
-/// scheduling optimizer.
-///
-/// Polly supports the isl internal code generator.
-void registerPollyPasses(llvm::legacy::PassManagerBase &PM) {
-  if (DumpBefore)
-    PM.add(polly::createDumpModulePass("-before", true));
-  for (auto &Filename : DumpBeforeFile)
-    PM.add(polly::createDumpModulePass(Filename, false));
-
-  PM.add(polly::createScopDetectionWrapperPassPass());
-
-  if (PollyDetectOnly)
-    return;
-
-  if (PollyViewer)
-    PM.add(polly::createDOTViewerPass());
-  if (PollyOnlyViewer)
-    PM.add(polly::createDOTOnlyViewerPass());
-  if (PollyPrinter)
-    PM.add(polly::createDOTPrinterPass());
-  if (PollyOnlyPrinter)
-    PM.add(polly::createDOTOnlyPrinterPass());
-
+/// Register the region pass pipeline that builds, optimizes and generates code
+/// for one SCoP after another.
+static void registerScopPasses(llvm::legacy::PassManagerBase &PM) {
   PM.add(polly::createScopInfoRegionPassPass());
   if (EnablePolyhedralInfo)
     PM.add(polly::createPolyhedralInfoPass());
@@ -336,6 +332,9 @@ void registerPollyPasses(llvm::legacy::PassManagerBase &PM) {
   if (EnableSimplify)
     PM.add(polly::createSimplifyPass(1));
 
+  if (EnableAoSToSoA)
+    PM.add(polly::createAoSToSoAPass());
+
   if (ImportJScop)
     PM.add(polly::createJSONImporterPass());
 
@@ -366,6 +365,10 @@ void registerPollyPasses(llvm::legacy::PassManagerBase &PM) {
       break;
     }
 
+  // The cost model of the transposition needs the final schedule.
+  if (EnableArrayTransposition)
+    PM.add(polly::createArrayTranspositionPass());
+
   if (ExportJScop)
     PM.add(polly::createJSONExporterPass());
 
@@ -387,6 +390,77 @@ void registerPollyPasses(llvm::legacy::PassManagerBase &PM) {
     PM.add(polly::createManagedMemoryRewritePassPass());
   }
 #endif
+}
+
+/// Return true if the passes selected on the command line are all supported by
+/// the concurrent SCoP optimizer.
+static bool canOptimizeScopsConcurrently() {
+  return Target == TARGET_CPU && CodeGeneration == CODEGEN_FULL &&
+         !EnablePolyhedralInfo && !EnableAoSToSoA && !ImportJScop &&
+         !DeadCodeElim && !FullyIndexedStaticExpansion &&
+         !EnableArrayTransposition && !ExportJScop;
+}
+
+/// Register Polly passes such that they form a polyhedral optimizer.
+///
+/// The individual Polly passes are registered in the pass manager such that
+/// they form a full polyhedral optimizer. The flow of the optimizer starts with
+/// a set of preparing transformations that canonicalize the LLVM-IR such that
+/// the LLVM-IR is easier for us to understand and to optimizes. On the
+/// canonicalized LLVM-IR we first run the ScopDetection pass, which detects
+/// static control flow regions. Those regions are then translated by the
+/// ScopInfo pass into a polyhedral representation. As a next step, a scheduling
+/// optimizer is run on the polyhedral representation and finally the optimized
+/// polyhedral representation is code generated back to LLVM-IR.
+///
+/// Besides this core functionality, we optionally schedule passes that provide
+/// a graphical view of the scops (Polly[Only]Viewer, Polly[Only]Printer), that
+/// allow the export/import of the polyhedral representation
+/// (JSCON[Exporter|Importer]) or that show the cfg after code generation.
+///
+/// For certain parts of the Polly optimizer, several alternatives are provided:
+///
+/// As scheduling optimizer we support the isl scheduling optimizer
+/// (http://freecode.com/projects/isl).
+/// It is also possible to run Polly with no optimizer. This mode is mainly
+/// provided to analyze the run and compile time changes caused by the
+/// scheduling optimizer.
+///
+/// Polly supports the isl internal code generator.
+void registerPollyPasses(llvm::legacy::PassManagerBase &PM) {
+  if (DumpBefore)
+    PM.add(polly::createDumpModulePass("-before", true));
+  for (auto &Filename : DumpBeforeFile)
+    PM.add(polly::createDumpModulePass(Filename, false));
+
+  if (EnableEarlyExitChunking)
+    PM.add(polly::createEarlyExitChunkingPass());
+
+  PM.add(polly::createScopDetectionWrapperPassPass());
+
+  if (PollyDetectOnly)
+    return;
+
+  if (PollyViewer)
+    PM.add(polly::createDOTViewerPass());
+  if (PollyOnlyViewer)
+    PM.add(polly::createDOTOnlyViewerPass());
+  if (PollyPrinter)
+    PM.add(polly::createDOTPrinterPass());
+  if (PollyOnlyPrinter)
+    PM.add(polly::createDOTOnlyPrinterPass());
+
+  if (ConcurrentScops && canOptimizeScopsConcurrently()) {
+    ConcurrentScopPasses Passes;
+    Passes.Simplify = EnableSimplify;
+    Passes.ForwardOpTree = EnableForwardOpTree;
+    Passes.DeLICM = EnableDeLICM;
+    Passes.PruneUnprofitable = EnablePruneUnprofitable;
+    Passes.ScheduleOptimizer = Optimizer == OPTIMIZER_ISL;
+    PM.add(polly::createConcurrentScopOptimizerPass(Passes));
+  } else {
+    registerScopPasses(PM);
+  }
 
   // FIXME: This dummy ModulePass keeps some programs from miscompiling,
   // probably some not correctly preserved analyses. It acts as a barrier to
@@ -474,30 +548,45 @@ static void buildDefaultPollyPipeline(FunctionPassManager &PM,
   assert(!PollyPrinter && "This option is not implemented");
   assert(!PollyOnlyPrinter && "This option is not implemented");
   assert(!EnablePolyhedralInfo && "This option is not implemented");
-  assert(!EnableDeLICM && "This option is not implemented");
-  assert(!EnableSimplify && "This option is not implemented");
+  if (EnableSimplify)
+    SPM.addPass(SimplifyPass(0));
+  if (EnableForwardOpTree)
+    SPM.addPass(ForwardOpTreePass());
+  if (EnableDeLICM)
+    SPM.addPass(DeLICMPass());
+  if (EnableSimplify)
+    SPM.addPass(SimplifyPass(1));
+  assert(!EnableAoSToSoA && "This option is not implemented");
   if (ImportJScop)
     SPM.addPass(JSONImportPass());
   assert(!DeadCodeElim && "This option is not implemented");
-  assert(!EnablePruneUnprofitable && "This option is not implemented");
+  assert(!FullyIndexedStaticExpansion && "This option is not implemented");
+  if (EnablePruneUnprofitable)
+    SPM.addPass(PruneUnprofitablePass());
   if (Target == TARGET_CPU || Target == TARGET_HYBRID)
     switch (Optimizer) {
     case OPTIMIZER_NONE:
       break; /* Do nothing */
     case OPTIMIZER_ISL:
-      llvm_unreachable("ISL optimizer is not implemented");
+      SPM.addPass(IslScheduleOptimizerPass());
       break;
     }
 
-  assert(!ExportJScop && "This option is not implemented");
+  assert(!EnableArrayTransposition && "This option is not implemented");
+  if (ExportJScop)
+    SPM.addPass(JSONExportPass());
 
   if (Target == TARGET_CPU || Target == TARGET_HYBRID) {
     switch (CodeGeneration) {
+    case CODEGEN_AST:
+      SPM.addPass(RequireAnalysisPass<IslAstAnalysis, Scop, ScopAnalysisManager,
+                                      ScopStandardAnalysisResults &,
+                                      SPMUpdater &>());
+      break;
     case CODEGEN_FULL:
       SPM.addPass(polly::CodeGenerationPass());
       break;
-    case CODEGEN_AST:
-    default: // Does it actually make sense to distinguish IslAst codegen?
+    case CODEGEN_NONE:
       break;
     }
   }
@@ -507,6 +596,8 @@ static void buildDefaultPollyPipeline(FunctionPassManager &PM,
 #endif
 
   PM.addPass(CodePreparationPass());
+  if (EnableEarlyExitChunking)
+    PM.addPass(EarlyExitChunkingPass());
   PM.addPass(createFunctionToScopPassAdaptor(std::move(SPM)));
   PM.addPass(PB.buildFunctionSimplificationPipeline(
       Level, PassBuilder::ThinLTOPhase::None)); // Cleanup
@@ -24,6 +24,8 @@
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/LoopUtils.h"
+#include <cstring>
 
 using namespace llvm;
 using namespace polly;
@@ -551,6 +553,35 @@ bool polly::isIgnoredIntrinsic(const Value *V) {
   return false;
 }
 
+bool polly::isLocalToRegion(const AllocaInst *Alloca, const Region &R) {
+  if (!Alloca->isStaticAlloca())
+    return false;
+
+  SmallVector<const Value *, 8> Worklist = {Alloca};
+  while (!Worklist.empty()) {
+    const Value *V = Worklist.pop_back_val();
+    for (const User *U : V->users()) {
+      auto *Inst = cast<Instruction>(U);
+      if (isa<BitCastInst>(Inst) || isa<GetElementPtrInst>(Inst)) {
+        Worklist.push_back(Inst);
+        continue;
+      }
+      if (isIgnoredIntrinsic(Inst))
+        continue;
+      if (!R.contains(Inst))
+        return false;
+      if (auto *Load = dyn_cast<LoadInst>(Inst))
+        if (Load->getPointerOperand() == V)
+          continue;
+      if (auto *Store = dyn_cast<StoreInst>(Inst))
+        if (Store->getPointerOperand() == V && Store->getValueOperand() != V)
+          continue;
+      return false;
+    }
+  }
+  return true;
+}
+
 bool polly::canSynthesize(const Value *V, const Scop &S, ScalarEvolution *SE,
                           Loop *Scope) {
   if (!V || !SE->isSCEVable(V->getType()))
@@ -680,3 +711,83 @@ bool polly::hasDebugCall(ScopStmt *Stmt) {
 
   return false;
 }
+
+ScopInputBlocks::ScopInputBlocks(Region &R) : Exit(R.getExit()) {
+  SmallVector<Instruction *, 64> Worklist;
+  for (BasicBlock *BB : R.blocks()) {
+    Blocks.insert(BB);
+    for (Instruction &Inst : *BB)
+      Worklist.push_back(&Inst);
+  }
+
+  SmallPtrSet<Instruction *, 32> Visited;
+  while (!Worklist.empty()) {
+    Instruction *Inst = Worklist.pop_back_val();
+    for (Value *Op : Inst->operands()) {
+      auto *OpInst = dyn_cast<Instruction>(Op);
+      if (!OpInst || R.contains(OpInst) || !Visited.insert(OpInst).second)
+        continue;
+      DefiningBlocks.insert(OpInst->getParent());
+      Worklist.push_back(OpInst);
+    }
+  }
+}
+
+bool ScopInputBlocks::isAnyIn(
+    const SmallPtrSetImpl<BasicBlock *> &GeneratedBlocks) const {
+  // The entry block is one of the blocks of the region.
+  if (GeneratedBlocks.count(Exit))
+    return true;
+  for (BasicBlock *BB : Blocks)
+    if (GeneratedBlocks.count(BB))
+      return true;
+  for (BasicBlock *BB : DefiningBlocks)
+    if (GeneratedBlocks.count(BB))
+      return true;
+  return false;
+}
+
+void ScopInputBlocks::addGeneratedBlocks(
+    SmallPtrSetImpl<BasicBlock *> &GeneratedBlocks) const {
+  GeneratedBlocks.insert(Blocks.begin(), Blocks.end());
+  GeneratedBlocks.insert(Exit);
+}
+
+/// The name of the mark nodes that annotate bands with loop properties.
+static const char *const LoopAttrMarkName = "Loop with Metadata";
+
+bool polly::hasLoopTransformationMetadata(Loop *L) {
+  if (!L || !L->getLoopID())
+    return false;
+
+  return getBooleanLoopAttribute(L, "llvm.loop.interchange.enable") ||
+         getBooleanLoopAttribute(L, "llvm.loop.tile.enable") ||
+         getBooleanLoopAttribute(L, "llvm.loop.unroll_and_jam.enable") ||
+         getBooleanLoopAttribute(L, "llvm.loop.parallelize_thread.enable");
+}
+
+static void freeBandAttr(void *Ptr) { delete static_cast<BandAttr *>(Ptr); }
+
+isl::id polly::getIslLoopAttr(isl::ctx Ctx, Loop *L) {
+  BandAttr *Attr = new BandAttr();
+  Attr->Metadata = L->getLoopID();
+  Attr->OriginalLoop = L;
+
+  isl::id Result = isl::id::alloc(Ctx, LoopAttrMarkName, Attr);
+  return isl::manage(isl_id_set_free_user(Result.release(), freeBandAttr));
+}
+
+bool polly::isLoopAttr(const isl::id &Id) {
+  if (!Id)
+    return false;
+
+  const char *Name = isl_id_get_name(Id.get());
+  return Name && strcmp(Name, LoopAttrMarkName) == 0;
+}
+
+BandAttr *polly::getLoopAttr(const isl::id &Id) {
+  if (!isLoopAttr(Id))
+    return nullptr;
+
+  return static_cast<BandAttr *>(Id.get_user());
+}
@@ -215,6 +215,11 @@ addInstructionRoots(ScopStmt *Stmt,
   for (Instruction *Inst : Stmt->getInstructions())
     if (isRoot(Inst))
       RootInsts.emplace_back(Stmt, Inst);
+
+  // The exit condition of a dynamic-exit loop is evaluated by the terminator
+  // of its latch.
+  if (Stmt == Stmt->getParent()->getDynamicExitStmt())
+    RootInsts.emplace_back(Stmt, Stmt->getBasicBlock()->getTerminator());
 }
 
 /// Add non-removable memory accesses in @p Stmt to @p RootInsts.
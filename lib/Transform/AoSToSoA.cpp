@@ -0,0 +1,221 @@
+//===- AoSToSoA.cpp - Split arrays of structures --------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Split arrays of structures into one array per field (structure of arrays).
+//
+// Accessing the same field of consecutive structures is a strided access,
+// which wastes cache lines and prevents vectorization. After the split, such
+// accesses are to consecutive elements of the field's array.
+//
+// Only arrays on the stack whose memory is not accessed outside of the SCoP
+// are split, such that no copy-in and copy-out code is needed. The fields of
+// the structures must all have the element type of the array.
+//
+//===----------------------------------------------------------------------===//
+
+#include "polly/LinkAllPasses.h"
+#include "polly/ScopInfo.h"
+#include "polly/ScopPass.h"
+#include "polly/Support/ISLTools.h"
+#include "polly/Support/ScopHelper.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/Debug.h"
+#include "isl/isl-noexceptions.h"
+#include <string>
+#include <vector>
+
+using namespace llvm;
+using namespace polly;
+
+#define DEBUG_TYPE "polly-aos-to-soa"
+
+STATISTIC(ArraysSplit, "Number of arrays of structures split into fields");
+
+namespace {
+
+class AoSToSoA : public ScopPass {
+public:
+  static char ID;
+
+  explicit AoSToSoA() : ScopPass(ID) {}
+
+  /// Split the arrays of structures of the SCoP.
+  ///
+  /// @param S The SCoP whose arrays are split.
+  bool runOnScop(Scop &S) override;
+
+  /// Print the SCoP.
+  ///
+  /// @param OS The stream where to print.
+  /// @param S The SCop that must be printed.
+  void printScop(raw_ostream &OS, Scop &S) const override;
+
+  /// Register all analyses and transformations required.
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+};
+} // namespace
+
+char AoSToSoA::ID = 0;
+
+/// Return the number of fields of the structures stored in @p SAI, or 0 if
+/// @p SAI is not a local array of structures with fields of the element type
+/// of @p SAI.
+///
+/// @param S          The SCoP @p SAI belongs to.
+/// @param SAI        The array to check.
+/// @param NumStructs Set to the number of structures in the array.
+static unsigned getNumFields(Scop &S, const ScopArrayInfo *SAI,
+                             unsigned &NumStructs) {
+  if (!SAI->isArrayKind() || SAI->getNumberOfDimensions() != 1)
+    return 0;
+
+  auto *Alloca = dyn_cast_or_null<AllocaInst>(SAI->getBasePtr());
+  if (!Alloca || Alloca->isArrayAllocation() ||
+      !isLocalToRegion(Alloca, S.getRegion()))
+    return 0;
+
+  auto *ArrayTy = dyn_cast<ArrayType>(Alloca->getAllocatedType());
+  if (!ArrayTy)
+    return 0;
+  auto *StructTy = dyn_cast<StructType>(ArrayTy->getElementType());
+  if (!StructTy || StructTy->getNumElements() < 2)
+    return 0;
+
+  for (Type *FieldTy : StructTy->elements())
+    if (FieldTy != SAI->getElementType())
+      return 0;
+
+  // The fields must not be padded, such that the structure with index i
+  // consists of the elements [NumFields * i, NumFields * (i + 1)).
+  const DataLayout &DL = S.getFunction().getParent()->getDataLayout();
+  if (DL.getTypeAllocSize(StructTy) !=
+      StructTy->getNumElements() * SAI->getElemSizeInBytes())
+    return 0;
+
+  NumStructs = ArrayTy->getNumElements();
+  return StructTy->getNumElements();
+}
+
+/// Return the field @p MA accesses, or -1 if it may access different fields
+/// of structures with @p NumFields fields.
+static int getAccessedField(MemoryAccess *MA, unsigned NumFields) {
+  if (!MA->isAffine())
+    return -1;
+
+  isl::set Elements = MA->getLatestAccessRelation()
+                          .intersect_domain(MA->getStatement()->getDomain())
+                          .range();
+  if (Elements.is_empty())
+    return 0;
+
+  isl::ctx Ctx = Elements.get_ctx();
+  isl::local_space LS(Elements.get_space());
+  isl::aff Field = isl::aff::var_on_domain(LS, isl::dim::set, 0)
+                       .mod(isl::val(Ctx, NumFields));
+  isl::set Fields = Elements.apply(isl::map::from_aff(Field));
+
+  isl::val Min = getConstant(Fields.dim_min(0), false, true);
+  isl::val Max = getConstant(Fields.dim_max(0), true, false);
+  if (Min.is_null() || Min.is_nan() || Max.is_null() || Max.is_nan() ||
+      !Min.eq(Max))
+    return -1;
+  return Min.get_num_si();
+}
+
+/// Return the map from the elements of an array of structures with
+/// @p NumFields fields to the elements of the array @p FieldSAI.
+///
+/// @param Space { MemRef[] }
+///
+/// @return { MemRef[i] -> FieldSAI[floor(i / NumFields)] }
+static isl::map getFieldMap(isl::space Space, unsigned NumFields,
+                            const ScopArrayInfo *FieldSAI) {
+  isl::local_space LS(Space);
+  isl::aff Index = isl::aff::var_on_domain(LS, isl::dim::set, 0)
+                       .scale_down_ui(NumFields)
+                       .floor();
+  return isl::map::from_aff(Index).set_tuple_id(isl::dim::out,
+                                                FieldSAI->getBasePtrId());
+}
+
+bool AoSToSoA::runOnScop(Scop &S) {
+  SmallVector<ScopArrayInfo *, 4> CurrentSAI(S.arrays().begin(),
+                                             S.arrays().end());
+
+  for (ScopArrayInfo *SAI : CurrentSAI) {
+    unsigned NumStructs;
+    unsigned NumFields = getNumFields(S, SAI, NumStructs);
+    if (NumFields == 0)
+      continue;
+
+    // Collect the field of every access.
+    SmallVector<std::pair<MemoryAccess *, int>, 8> Accesses;
+    bool AllFieldsKnown = true;
+    for (ScopStmt &Stmt : S) {
+      for (MemoryAccess *MA : Stmt) {
+        if (MA->getLatestScopArrayInfo() != SAI)
+          continue;
+        int Field = getAccessedField(MA, NumFields);
+        if (Field < 0) {
+          LLVM_DEBUG(dbgs() << SAI->getName()
+                            << " is accessed at different fields by "
+                            << MA->getAccessRelationStr() << "\n");
+          AllFieldsKnown = false;
+          break;
+        }
+        Accesses.push_back({MA, Field});
+      }
+      if (!AllFieldsKnown)
+        break;
+    }
+
+    if (!AllFieldsKnown || Accesses.empty())
+      continue;
+
+    SmallVector<ScopArrayInfo *, 4> FieldSAIs;
+    std::vector<unsigned> Sizes = {NumStructs};
+    for (unsigned i = 0; i < NumFields; i++)
+      FieldSAIs.push_back(S.createScopArrayInfo(
+          SAI->getElementType(), SAI->getName() + "_field" + std::to_string(i),
+          Sizes));
+
+    for (auto &Access : Accesses) {
+      MemoryAccess *MA = Access.first;
+      isl::map AccRel = MA->getLatestAccessRelation();
+      isl::map FieldMap = getFieldMap(AccRel.get_space().range(), NumFields,
+                                      FieldSAIs[Access.second]);
+      MA->setNewAccessRelation(AccRel.apply_range(FieldMap));
+    }
+
+    LLVM_DEBUG(dbgs() << "Split " << SAI->getName() << " into " << NumFields
+                      << " fields\n");
+    ArraysSplit++;
+  }
+
+  return false;
+}
+
+void AoSToSoA::printScop(raw_ostream &OS, Scop &S) const {
+  S.print(OS, false);
+}
+
+void AoSToSoA::getAnalysisUsage(AnalysisUsage &AU) const {
+  ScopPass::getAnalysisUsage(AU);
+}
+
+Pass *polly::createAoSToSoAPass() { return new AoSToSoA(); }
+
+INITIALIZE_PASS_BEGIN(AoSToSoA, "polly-aos-to-soa",
+                      "Polly - Split arrays of structures", false, false);
+INITIALIZE_PASS_DEPENDENCY(ScopInfoRegionPass);
+INITIALIZE_PASS_END(AoSToSoA, "polly-aos-to-soa",
+                    "Polly - Split arrays of structures", false, false)
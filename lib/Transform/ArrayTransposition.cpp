@@ -0,0 +1,259 @@
+//===- ArrayTransposition.cpp - Permute array dimensions ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Permute the dimensions of arrays such that more accesses are stride-one in
+// the innermost loop of the final schedule.
+//
+// If no legal loop order makes an access like A[j][i] stride-one, e.g.
+// because i must be the innermost loop for the other arrays, storing A
+// transposed does. For every candidate array, this pass evaluates moving each
+// dimension to the innermost position. The permutation is applied if it
+// reduces the number of cache lines that the accesses touch per iteration of
+// the innermost loop.
+//
+// Only arrays on the stack whose memory is not accessed outside of the SCoP
+// are permuted, such that no copy-in and copy-out code is needed.
+//
+//===----------------------------------------------------------------------===//
+
+#include "polly/LinkAllPasses.h"
+#include "polly/Options.h"
+#include "polly/ScopInfo.h"
+#include "polly/ScopPass.h"
+#include "polly/Support/ISLTools.h"
+#include "polly/Support/ScopHelper.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "isl/isl-noexceptions.h"
+#include <string>
+#include <vector>
+
+using namespace llvm;
+using namespace polly;
+
+#define DEBUG_TYPE "polly-array-transposition"
+
+static cl::opt<unsigned> CacheLineSize(
+    "polly-transposition-cache-line-size",
+    cl::desc("The cache line size (in bytes) assumed by the cost model of the "
+             "array transposition"),
+    cl::Hidden, cl::init(64), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+STATISTIC(ArraysPermuted, "Number of arrays whose dimensions were permuted");
+
+namespace {
+
+class ArrayTransposition : public ScopPass {
+public:
+  static char ID;
+
+  explicit ArrayTransposition() : ScopPass(ID) {}
+
+  /// Permute the dimensions of the arrays of the SCoP.
+  ///
+  /// @param S The SCoP whose arrays are permuted.
+  bool runOnScop(Scop &S) override;
+
+  /// Print the SCoP.
+  ///
+  /// @param OS The stream where to print.
+  /// @param S The SCop that must be printed.
+  void printScop(raw_ostream &OS, Scop &S) const override;
+
+  /// Register all analyses and transformations required.
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+};
+} // namespace
+
+char ArrayTransposition::ID = 0;
+
+/// Return the sizes of the dimensions of the local array @p SAI, or an empty
+/// vector if @p SAI cannot be permuted.
+static std::vector<unsigned> getLocalArraySizes(Scop &S,
+                                                const ScopArrayInfo *SAI) {
+  if (!SAI->isArrayKind() || SAI->getNumberOfDimensions() < 2)
+    return {};
+
+  auto *Alloca = dyn_cast_or_null<AllocaInst>(SAI->getBasePtr());
+  if (!Alloca || Alloca->isArrayAllocation() ||
+      !isLocalToRegion(Alloca, S.getRegion()))
+    return {};
+
+  std::vector<unsigned> Sizes;
+  Type *Ty = Alloca->getAllocatedType();
+  while (auto *ArrayTy = dyn_cast<ArrayType>(Ty)) {
+    Sizes.push_back(ArrayTy->getNumElements());
+    Ty = ArrayTy->getElementType();
+  }
+
+  if (Ty != SAI->getElementType() ||
+      Sizes.size() != SAI->getNumberOfDimensions())
+    return {};
+  return Sizes;
+}
+
+/// Remove the trailing dimensions of @p Schedule that do not correspond to
+/// a loop, such that the innermost dimension is the innermost loop.
+static isl::map getInnermostLoopSchedule(isl::map Schedule) {
+  isl::set Range = Schedule.range();
+  unsigned Dims = Schedule.dim(isl::dim::out);
+  unsigned LoopDims = Dims;
+  while (LoopDims > 0) {
+    isl::val Min = getConstant(Range.dim_min(LoopDims - 1), false, true);
+    isl::val Max = getConstant(Range.dim_max(LoopDims - 1), true, false);
+    if (Min.is_null() || Min.is_nan() || Max.is_null() || Max.is_nan() ||
+        !Min.eq(Max))
+      break;
+    LoopDims--;
+  }
+  return Schedule.project_out(isl::dim::out, LoopDims, Dims - LoopDims);
+}
+
+/// Check whether @p AccessRelation accesses consecutive (or the same)
+/// elements in consecutive iterations of the innermost loop of @p Schedule.
+static bool isContiguous(isl::map AccessRelation, isl::map Schedule) {
+  isl::set Stride = MemoryAccess::getStride(AccessRelation, Schedule);
+  isl::set Contiguous = isl::set::universe(Stride.get_space());
+  unsigned Dims = Contiguous.dim(isl::dim::set);
+  for (unsigned i = 0; i + 1 < Dims; i++)
+    Contiguous = Contiguous.fix_si(isl::dim::set, i, 0);
+  Contiguous = Contiguous.lower_bound_si(isl::dim::set, Dims - 1, -1)
+                   .upper_bound_si(isl::dim::set, Dims - 1, 1);
+  return Stride.is_subset(Contiguous);
+}
+
+/// Return the map from the elements of @p Space to the elements of the
+/// array @p NewSAI whose dimensions are permuted by @p Permutation.
+///
+/// @param Space { MemRef[] }
+///
+/// @return { MemRef[i_0, ..., i_n] -> NewSAI[i_Permutation[0], ...] }
+static isl::map getPermutationMap(isl::space Space,
+                                  ArrayRef<unsigned> Permutation,
+                                  const ScopArrayInfo *NewSAI) {
+  isl::map Map = isl::map::universe(Space.map_from_set());
+  Map = Map.set_tuple_id(isl::dim::out, NewSAI->getBasePtrId());
+  for (unsigned i = 0; i < Permutation.size(); i++)
+    Map = Map.equate(isl::dim::in, Permutation[i], isl::dim::out, i);
+  return Map;
+}
+
+bool ArrayTransposition::runOnScop(Scop &S) {
+  SmallVector<ScopArrayInfo *, 4> CurrentSAI(S.arrays().begin(),
+                                             S.arrays().end());
+
+  for (ScopArrayInfo *SAI : CurrentSAI) {
+    std::vector<unsigned> Sizes = getLocalArraySizes(S, SAI);
+    if (Sizes.empty())
+      continue;
+
+    // Collect the accesses together with the schedule of their innermost
+    // loop.
+    SmallVector<std::pair<MemoryAccess *, isl::map>, 8> Accesses;
+    for (ScopStmt &Stmt : S) {
+      isl::map Schedule = Stmt.getSchedule();
+      for (MemoryAccess *MA : Stmt) {
+        if (MA->getLatestScopArrayInfo() != SAI)
+          continue;
+        if (Schedule.is_null()) {
+          Accesses.clear();
+          break;
+        }
+        Accesses.push_back({MA, getInnermostLoopSchedule(Schedule)});
+      }
+      if (Schedule.is_null())
+        break;
+    }
+    if (Accesses.empty())
+      continue;
+
+    // The number of cache lines touched per iteration of the innermost loop,
+    // scaled by the number of elements per cache line: a contiguous access
+    // touches a new cache line only every ElementsPerLine iterations, any
+    // other access every iteration.
+    unsigned NumDims = Sizes.size();
+    unsigned ElementsPerLine =
+        std::max(1u, CacheLineSize / SAI->getElemSizeInBytes());
+    auto getCost = [&](ArrayRef<unsigned> Permutation) {
+      isl::space Space = SAI->getSpace();
+      isl::map Permute = getPermutationMap(Space, Permutation, SAI);
+      unsigned Cost = 0;
+      for (auto &Access : Accesses) {
+        isl::map AccRel =
+            Access.first->getLatestAccessRelation().apply_range(Permute);
+        if (Access.second.dim(isl::dim::out) == 0)
+          continue;
+        Cost += isContiguous(AccRel, Access.second) ? 1 : ElementsPerLine;
+      }
+      return Cost;
+    };
+
+    // Try to move each dimension to the innermost position.
+    SmallVector<unsigned, 4> Identity;
+    for (unsigned i = 0; i < NumDims; i++)
+      Identity.push_back(i);
+
+    SmallVector<unsigned, 4> BestPermutation = Identity;
+    unsigned BestCost = getCost(Identity);
+    for (unsigned Inner = 0; Inner + 1 < NumDims; Inner++) {
+      SmallVector<unsigned, 4> Permutation;
+      for (unsigned i = 0; i < NumDims; i++)
+        if (i != Inner)
+          Permutation.push_back(i);
+      Permutation.push_back(Inner);
+
+      unsigned Cost = getCost(Permutation);
+      if (Cost < BestCost) {
+        BestCost = Cost;
+        BestPermutation = Permutation;
+      }
+    }
+
+    if (BestPermutation == Identity)
+      continue;
+
+    std::vector<unsigned> NewSizes;
+    for (unsigned Dim : BestPermutation)
+      NewSizes.push_back(Sizes[Dim]);
+    ScopArrayInfo *NewSAI = S.createScopArrayInfo(
+        SAI->getElementType(), SAI->getName() + "_transposed", NewSizes);
+
+    for (auto &Access : Accesses) {
+      MemoryAccess *MA = Access.first;
+      isl::map AccRel = MA->getLatestAccessRelation();
+      isl::map Permute = getPermutationMap(AccRel.get_space().range(),
+                                           BestPermutation, NewSAI);
+      MA->setNewAccessRelation(AccRel.apply_range(Permute));
+    }
+
+    LLVM_DEBUG(dbgs() << "Permuted the dimensions of " << SAI->getName()
+                      << "\n");
+    ArraysPermuted++;
+  }
+
+  return false;
+}
+
+void ArrayTransposition::printScop(raw_ostream &OS, Scop &S) const {
+  S.print(OS, false);
+}
+
+void ArrayTransposition::getAnalysisUsage(AnalysisUsage &AU) const {
+  ScopPass::getAnalysisUsage(AU);
+}
+
+Pass *polly::createArrayTranspositionPass() { return new ArrayTransposition(); }
+
+INITIALIZE_PASS_BEGIN(ArrayTransposition, "polly-array-transposition",
+                      "Polly - Permute array dimensions", false, false);
+INITIALIZE_PASS_DEPENDENCY(ScopInfoRegionPass);
+INITIALIZE_PASS_END(ArrayTransposition, "polly-array-transposition",
+                    "Polly - Permute array dimensions", false, false)
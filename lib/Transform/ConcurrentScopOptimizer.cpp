@@ -0,0 +1,272 @@
+//===- ConcurrentScopOptimizer.cpp - Optimize the SCoPs of a function -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Every SCoP has its own isl_ctx, such that the isl computations of different
+// SCoPs share no state. This pass runs the Polly pipeline on all SCoPs of a
+// function at once in three phases:
+//
+//   1. The SCoPs are built and simplified one after another (ScopInfo,
+//      Simplify, ForwardOpTree, DeLICM, PruneUnprofitable). These passes query
+//      ScalarEvolution, which is not thread-safe.
+//   2. The dependences, the schedule and the AST of every SCoP are computed on
+//      a thread pool. The few steps of the schedule optimizer that create
+//      ScalarEvolution expressions or emit remarks hold a lock.
+//   3. LLVM-IR is generated for one SCoP after another.
+//
+// Code generation changes the IR around a SCoP: values defined in the SCoP
+// that are used after it are replaced by the merge of their original and new
+// versions, and the blocks at its boundary are split. The SCoPs that use such
+// values or share a boundary block with a SCoP that was already code generated
+// are therefore rebuilt and optimized anew before their own code generation,
+// which is what the region pass pipeline does for every SCoP.
+//
+//===----------------------------------------------------------------------===//
+
+#include "polly/ConcurrentScopOptimizer.h"
+#include "polly/CodeGen/CodeGeneration.h"
+#include "polly/CodeGen/IslAst.h"
+#include "polly/DeLICM.h"
+#include "polly/DependenceInfo.h"
+#include "polly/ForwardOpTree.h"
+#include "polly/LinkAllPasses.h"
+#include "polly/Options.h"
+#include "polly/PruneUnprofitable.h"
+#include "polly/ScheduleOptimizer.h"
+#include "polly/ScopDetection.h"
+#include "polly/ScopInfo.h"
+#include "polly/Simplify.h"
+#include "polly/Support/GICHelper.h"
+#include "polly/Support/ScopHelper.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/RegionInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include <mutex>
+
+using namespace llvm;
+using namespace polly;
+
+#define DEBUG_TYPE "polly-concurrent-scops"
+
+STATISTIC(ScopsOptimizedConcurrently,
+          "Number of SCoPs whose isl phases ran on the thread pool");
+STATISTIC(ScopsRebuilt, "Number of SCoPs rebuilt after code generation of a "
+                        "SCoP they depend on");
+
+static cl::opt<unsigned> NumThreads(
+    "polly-concurrent-scops-threads",
+    cl::desc("The number of threads optimizing the SCoPs of a function with "
+             "-polly-concurrent-scops (0 = number of hardware threads)"),
+    cl::Hidden, cl::init(0), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+namespace {
+
+/// A SCoP of the function and what is needed to generate code for it.
+struct ScopState {
+  Region *R;
+  Scop *S = nullptr;
+  std::unique_ptr<Dependences> D;
+  std::unique_ptr<IslAstInfo> AI;
+
+  /// The blocks the SCoP was built from before any code was generated.
+  ScopInputBlocks Input;
+
+  explicit ScopState(Region *R) : R(R), Input(*R) {}
+};
+
+class ConcurrentScopOptimizer : public FunctionPass {
+public:
+  static char ID;
+
+  explicit ConcurrentScopOptimizer(ConcurrentScopPasses Passes = {})
+      : FunctionPass(ID), Passes(Passes) {}
+
+  bool runOnFunction(Function &F) override;
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  /// Run the passes that query ScalarEvolution on @p S.
+  void simplifyScop(Scop &S, LoopInfo &LI);
+
+  /// Compute the dependences, the schedule and the AST of @p State.
+  void optimizeScop(ScopState &State, const TargetTransformInfo *TTI,
+                    std::mutex *SharedStateLock);
+
+  /// Return the thread pool, creating it on first use.
+  ThreadPool &getThreadPool();
+
+  ConcurrentScopPasses Passes;
+
+  /// The threads are kept for all functions of the module.
+  std::unique_ptr<ThreadPool> Pool;
+};
+} // namespace
+
+char ConcurrentScopOptimizer::ID = 0;
+
+void ConcurrentScopOptimizer::simplifyScop(Scop &S, LoopInfo &LI) {
+  if (Passes.Simplify)
+    runSimplify(S, LI, 0);
+  if (Passes.ForwardOpTree)
+    runForwardOpTree(S, LI);
+  if (Passes.DeLICM)
+    runDeLICM(S, LI);
+  if (Passes.Simplify)
+    runSimplify(S, LI, 1);
+  if (Passes.PruneUnprofitable)
+    runPruneUnprofitable(S);
+}
+
+void ConcurrentScopOptimizer::optimizeScop(ScopState &State,
+                                           const TargetTransformInfo *TTI,
+                                           std::mutex *SharedStateLock) {
+  Scop &S = *State.S;
+  if (S.isToBeSkipped())
+    return;
+
+  auto GetDeps = [&]() -> const Dependences & {
+    if (!State.D)
+      State.D = computeDependences(S, Dependences::AL_Statement);
+    return *State.D;
+  };
+
+  // As in the pass pipeline, the AST is built with the dependences of the
+  // original schedule.
+  if (Passes.ScheduleOptimizer)
+    runIslScheduleOptimizer(S, GetDeps, TTI, SharedStateLock);
+  State.AI.reset(new IslAstInfo(S, GetDeps()));
+}
+
+ThreadPool &ConcurrentScopOptimizer::getThreadPool() {
+  if (!Pool) {
+    unsigned Threads = NumThreads ? NumThreads : hardware_concurrency();
+    Pool.reset(new ThreadPool(Threads));
+  }
+  return *Pool;
+}
+
+bool ConcurrentScopOptimizer::runOnFunction(Function &F) {
+  if (skipFunction(F))
+    return false;
+
+  ScopInfo &SI = *getAnalysis<ScopInfoWrapperPass>().getSI();
+  if (SI.empty())
+    return false;
+
+  auto &LI = getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+  auto &DT = getAnalysis<DominatorTreeWrapperPass>().getDomTree();
+  auto &SE = getAnalysis<ScalarEvolutionWrapperPass>().getSE();
+  auto &RI = getAnalysis<RegionInfoPass>().getRegionInfo();
+  auto *TTI = &getAnalysis<TargetTransformInfoWrapperPass>().getTTI(F);
+
+  // Phase 1: simplify the SCoPs and record the IR they depend on.
+  std::vector<ScopState> Scops;
+  for (auto &It : SI) {
+    if (!It.second)
+      continue;
+    Scops.emplace_back(It.first);
+    ScopState &State = Scops.back();
+    State.S = It.second.get();
+    simplifyScop(*State.S, LI);
+  }
+
+  // Phase 2: compute the dependences, schedules and ASTs.
+  std::mutex SharedStateLock;
+  bool Concurrent = Scops.size() > 1;
+#ifndef NDEBUG
+  // The debug output of the SCoPs would be interleaved.
+  if (DebugFlag)
+    Concurrent = false;
+#endif
+
+  if (Concurrent) {
+    ThreadPool &TP = getThreadPool();
+    for (ScopState &State : Scops)
+      TP.async([this, &State, TTI, &SharedStateLock]() {
+        optimizeScop(State, TTI, &SharedStateLock);
+      });
+    TP.wait();
+    ScopsOptimizedConcurrently += Scops.size();
+  } else {
+    for (ScopState &State : Scops)
+      optimizeScop(State, TTI, nullptr);
+  }
+
+  // Phase 3: generate code, rebuilding the SCoPs that depend on code generated
+  // before them.
+  SmallPtrSet<BasicBlock *, 32> GeneratedBlocks;
+  bool Changed = false;
+  for (ScopState &State : Scops) {
+    if (State.Input.isAnyIn(GeneratedBlocks)) {
+      LLVM_DEBUG(dbgs() << "Rebuilding SCoP " << State.R->getNameStr()
+                        << " after code generation of a SCoP it uses\n");
+      State.AI.reset();
+      State.D.reset();
+      State.S = SI.recompute(State.R);
+      if (!State.S)
+        continue;
+      ScopsRebuilt++;
+      simplifyScop(*State.S, LI);
+      optimizeScop(State, TTI, nullptr);
+    }
+
+    if (!State.AI)
+      continue;
+
+    if (generateCode(*State.S, *State.AI, LI, DT, SE, RI)) {
+      Changed = true;
+      State.Input.addGeneratedBlocks(GeneratedBlocks);
+    }
+    State.AI.reset();
+    State.D.reset();
+  }
+
+  return Changed;
+}
+
+void ConcurrentScopOptimizer::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<DominatorTreeWrapperPass>();
+  AU.addRequired<LoopInfoWrapperPass>();
+  AU.addRequired<RegionInfoPass>();
+  AU.addRequired<ScalarEvolutionWrapperPass>();
+  AU.addRequired<ScopDetectionWrapperPass>();
+  AU.addRequired<ScopInfoWrapperPass>();
+  AU.addRequired<TargetTransformInfoWrapperPass>();
+
+  AU.addPreserved<DominatorTreeWrapperPass>();
+  AU.addPreserved<LoopInfoWrapperPass>();
+  AU.addPreserved<RegionInfoPass>();
+  AU.addPreserved<ScalarEvolutionWrapperPass>();
+  AU.addPreserved<ScopDetectionWrapperPass>();
+}
+
+Pass *polly::createConcurrentScopOptimizerPass(ConcurrentScopPasses Passes) {
+  return new ConcurrentScopOptimizer(Passes);
+}
+
+INITIALIZE_PASS_BEGIN(ConcurrentScopOptimizer, "polly-concurrent-scop-opt",
+                      "Polly - Optimize the SCoPs of a function concurrently",
+                      false, false);
+INITIALIZE_PASS_DEPENDENCY(DominatorTreeWrapperPass);
+INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass);
+INITIALIZE_PASS_DEPENDENCY(RegionInfoPass);
+INITIALIZE_PASS_DEPENDENCY(ScalarEvolutionWrapperPass);
+INITIALIZE_PASS_DEPENDENCY(ScopDetectionWrapperPass);
+INITIALIZE_PASS_DEPENDENCY(ScopInfoWrapperPass);
+INITIALIZE_PASS_DEPENDENCY(TargetTransformInfoWrapperPass);
+INITIALIZE_PASS_END(ConcurrentScopOptimizer, "polly-concurrent-scop-opt",
+                    "Polly - Optimize the SCoPs of a function concurrently",
+                    false, false)
@@ -1170,12 +1170,12 @@ private:
     OS.indent(Indent) << "}\n";
   }
 
-  /// Return whether at least one transformation been applied.
-  bool isModified() const { return NumberOfTargetsMapped > 0; }
-
 public:
   DeLICMImpl(Scop *S, LoopInfo *LI) : ZoneAlgorithm("polly-delicm", S, LI) {}
 
+  /// Return whether at least one transformation been applied.
+  bool isModified() const { return NumberOfTargetsMapped > 0; }
+
   /// Calculate the lifetime (definition to last use) of every array element.
   ///
   /// @return True if the computed lifetimes (#Zone) is usable.
@@ -1344,23 +1344,16 @@ public:
   }
 };
 
-class DeLICM : public ScopPass {
-private:
-  DeLICM(const DeLICM &) = delete;
-  const DeLICM &operator=(const DeLICM &) = delete;
-
-  /// The pass implementation, also holding per-scop data.
-  std::unique_ptr<DeLICMImpl> Impl;
-
-  void collapseToUnused(Scop &S) {
-    auto &LI = getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
-    Impl = make_unique<DeLICMImpl>(&S, &LI);
-
-    if (!Impl->computeZone()) {
-      LLVM_DEBUG(dbgs() << "Abort because cannot reliably compute lifetimes\n");
-      return;
-    }
+/// Collapse the scalars of @p S to unused array elements and update the
+/// statistics.
+///
+/// @return The implementation object holding the results, for printing.
+static std::unique_ptr<DeLICMImpl> runDeLICMImpl(Scop &S, LoopInfo &LI) {
+  auto Impl = make_unique<DeLICMImpl>(&S, &LI);
 
+  if (!Impl->computeZone()) {
+    LLVM_DEBUG(dbgs() << "Abort because cannot reliably compute lifetimes\n");
+  } else {
     LLVM_DEBUG(dbgs() << "Collapsing scalars to unused array elements...\n");
     Impl->greedyCollapse();
 
@@ -1368,6 +1361,25 @@ private:
     LLVM_DEBUG(dbgs() << S);
   }
 
+  auto ScopStats = S.getStatistics();
+  NumValueWrites += ScopStats.NumValueWrites;
+  NumValueWritesInLoops += ScopStats.NumValueWritesInLoops;
+  NumPHIWrites += ScopStats.NumPHIWrites;
+  NumPHIWritesInLoops += ScopStats.NumPHIWritesInLoops;
+  NumSingletonWrites += ScopStats.NumSingletonWrites;
+  NumSingletonWritesInLoops += ScopStats.NumSingletonWritesInLoops;
+
+  return Impl;
+}
+
+class DeLICM : public ScopPass {
+private:
+  DeLICM(const DeLICM &) = delete;
+  const DeLICM &operator=(const DeLICM &) = delete;
+
+  /// The pass implementation, also holding per-scop data.
+  std::unique_ptr<DeLICMImpl> Impl;
+
 public:
   static char ID;
   explicit DeLICM() : ScopPass(ID) {}
@@ -1382,16 +1394,8 @@ public:
     // Free resources for previous scop's computation, if not yet done.
     releaseMemory();
 
-    collapseToUnused(S);
-
-    auto ScopStats = S.getStatistics();
-    NumValueWrites += ScopStats.NumValueWrites;
-    NumValueWritesInLoops += ScopStats.NumValueWritesInLoops;
-    NumPHIWrites += ScopStats.NumPHIWrites;
-    NumPHIWritesInLoops += ScopStats.NumPHIWritesInLoops;
-    NumSingletonWrites += ScopStats.NumSingletonWrites;
-    NumSingletonWritesInLoops += ScopStats.NumSingletonWritesInLoops;
-
+    auto &LI = getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+    Impl = runDeLICMImpl(S, LI);
     return false;
   }
 
@@ -1412,6 +1416,18 @@ char DeLICM::ID;
 
 Pass *polly::createDeLICMPass() { return new DeLICM(); }
 
+bool polly::runDeLICM(Scop &S, LoopInfo &LI) {
+  return runDeLICMImpl(S, LI)->isModified();
+}
+
+PreservedAnalyses DeLICMPass::run(Scop &S, ScopAnalysisManager &SAM,
+                                  ScopStandardAnalysisResults &AR,
+                                  SPMUpdater &U) {
+  if (!runDeLICM(S, AR.LI))
+    return PreservedAnalyses::all();
+  return getScopPassPreservedAnalyses();
+}
+
 INITIALIZE_PASS_BEGIN(DeLICM, "polly-delicm", "Polly - DeLICM/DePRE", false,
                       false)
 INITIALIZE_PASS_DEPENDENCY(ScopInfoWrapperPass)
@@ -83,7 +83,8 @@ char DeadCodeElim::ID = 0;
 
 // To compute the live outs, we compute for the data-locations that are
 // must-written to the last statement that touches these locations. On top of
-// this we add all statements that perform may-write accesses.
+// this we add all statements that perform may-write accesses and all
+// statements with calls of unknown side effects.
 //
 // We could be more precise by removing may-write accesses for which we know
 // that they are overwritten by a must-write after. However, at the moment the
@@ -104,6 +105,11 @@ isl::union_set DeadCodeElim::getLiveOut(Scop &S) {
   isl::union_set Live = LastWriteIterations.range();
   isl::union_map MayWrites = S.getMayWrites();
   Live = Live.unite(MayWrites.domain());
+
+  // Calls with unknown side effects are always live.
+  for (ScopStmt &Stmt : S)
+    if (S.hasBookkeepingCall(Stmt))
+      Live = Live.unite(isl::union_set(Stmt.getDomain()));
   return Live.coalesce();
 }
 
@@ -0,0 +1,517 @@
+//===- EarlyExitChunking.cpp - Evaluate early exits in chunks ---*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// A search loop such as
+//
+//   for (long i = 0; i < n; i++)
+//     if (A[i] == x)
+//       break;
+//
+// executes at most the iterations of its affine bound, but leaves earlier
+// under a data-dependent condition. Neither the loop vectorizer nor Polly can
+// handle the early exit. If all instructions of the loop can be executed
+// speculatively, and its loads are known to be dereferenceable for at least
+// a chunk of iterations, this pass evaluates its exit conditions in chunks of
+// iterations by a loop without early exits that computes the first exiting
+// iteration of the chunk as a minimum reduction:
+//
+//   long i = 0;
+//   if (n - 1 >= C)
+//     for (long c = 0;; c += C) {
+//       long first = -1;
+//       for (long k = c; k < c + C; k++)
+//         if (A[k] == x)
+//           first = min(first, k);
+//       if (first != -1) {
+//         i = first;
+//         break;
+//       }
+//       if (n - 1 - (c + C) < C) {
+//         i = c + C;
+//         break;
+//       }
+//     }
+//   for (; i < n; i++)
+//     if (A[i] == x)
+//       break;
+//
+// The evaluation stops after the first chunk with an exiting iteration, and
+// the original loop is resumed at this iteration, such that the exit is taken
+// with the values of the original loop. If no chunk exits, it is resumed for
+// the remaining iterations after the last chunk.
+//
+// The bound n - 1 of the chunks is further limited to the iterations whose
+// loads are known to be dereferenceable, e.g. by the size of a global array or
+// a dereferenceable argument. Beyond them, only the original loop reads
+// memory, as a string or sentinel search may rely on an earlier exit.
+//
+// Like the original loop, the chunks are sequential, but the loop evaluating
+// a chunk can be vectorized and modeled by Polly. The loop itself can be
+// modeled by Polly with -polly-allow-early-exit-loops.
+//
+//===----------------------------------------------------------------------===//
+
+#include "polly/EarlyExitChunking.h"
+#include "polly/LinkAllPasses.h"
+#include "polly/Options.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/Loads.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpander.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+using namespace llvm;
+using namespace polly;
+
+#define DEBUG_TYPE "polly-early-exit-chunking"
+
+STATISTIC(NumChunkedLoops, "Number of early-exit loops evaluated in chunks");
+
+static cl::opt<unsigned> ChunkSize(
+    "polly-early-exit-chunk-size",
+    cl::desc("The number of iterations of an early-exit loop whose exit "
+             "conditions are evaluated without early exits"),
+    cl::Hidden, cl::init(256), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+namespace {
+
+/// An induction variable of an early-exit loop.
+struct InductionVariable {
+  PHINode *Phi;
+
+  /// The value of the first iteration and the increment of every iteration,
+  /// expanded in the preheader.
+  Value *Start = nullptr;
+  Value *Step = nullptr;
+};
+
+/// An early-exit loop and the loop-invariant values needed to chunk it.
+struct EarlyExitLoop {
+  Loop *L;
+
+  /// The exiting blocks other than the latch.
+  SmallVector<BasicBlock *, 4> EarlyExits;
+
+  /// The header PHIs, which are all affine induction variables.
+  SmallVector<InductionVariable, 4> IVs;
+
+  /// The number of iterations whose loads are known to be dereferenceable.
+  /// Chunks are evaluated only within these iterations; the original loop
+  /// executes the remaining ones.
+  uint64_t DereferenceableIterations = UINT64_MAX;
+
+  /// The number of times the backedge is taken unless an early exit is, at
+  /// most DereferenceableIterations, expanded in the preheader.
+  Value *MaxBackedgeCount = nullptr;
+};
+
+class EarlyExitChunking : public FunctionPass {
+public:
+  static char ID;
+
+  explicit EarlyExitChunking() : FunctionPass(ID) {}
+
+  bool runOnFunction(Function &F) override;
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+};
+} // namespace
+
+/// Return the number of iterations of @p L, counted from the first one, for
+/// which @p Load is known to access dereferenceable and aligned memory.
+///
+/// The loads of a chunk are executed for all its iterations, including those
+/// after an exit that may guard them, e.g. a sentinel or a null check. Hence
+/// only the size of the accessed object tells how far they can be executed.
+///
+/// @return The number of iterations, UINT64_MAX if the address does not
+///         depend on the iteration, or 0 if nothing is known.
+static uint64_t getDereferenceableIterations(LoadInst *Load, Loop *L,
+                                             ScalarEvolution &SE,
+                                             DominatorTree &DT) {
+  if (!Load->isSimple())
+    return 0;
+
+  const SCEV *Ptr = SE.getSCEV(Load->getPointerOperand());
+  auto *Base = dyn_cast<SCEVUnknown>(SE.getPointerBase(Ptr));
+  if (!Base || !SE.isLoopInvariant(Base, L))
+    return 0;
+
+  // The accessed addresses are Base + Start + i * Stride.
+  const SCEV *Offset = SE.getMinusSCEV(Ptr, Base);
+  const SCEV *Step = SE.getZero(Offset->getType());
+  if (auto *AR = dyn_cast<SCEVAddRecExpr>(Offset)) {
+    if (AR->getLoop() != L || !AR->isAffine())
+      return 0;
+    Offset = AR->getStart();
+    Step = AR->getStepRecurrence(SE);
+  }
+  auto *StartConst = dyn_cast<SCEVConstant>(Offset);
+  auto *StrideConst = dyn_cast<SCEVConstant>(Step);
+  if (!StartConst || !StrideConst || StartConst->getAPInt().isNegative() ||
+      StrideConst->getAPInt().isNegative())
+    return 0;
+  uint64_t Start = StartConst->getAPInt().getLimitedValue();
+  uint64_t Stride = StrideConst->getAPInt().getLimitedValue();
+
+  const DataLayout &DL = Load->getModule()->getDataLayout();
+  unsigned Align = Load->getAlignment();
+  if (!Align)
+    Align = DL.getABITypeAlignment(Load->getType());
+  if (Start % Align != 0 || Stride % Align != 0)
+    return 0;
+
+  // The bytes dereferenceable from the base, which must also hold before the
+  // loop, where the chunks are entered.
+  Value *BaseVal = Base->getValue();
+  bool CanBeNull;
+  uint64_t Bytes = BaseVal->getPointerDereferenceableBytes(DL, CanBeNull);
+  uint64_t LoadSize = DL.getTypeStoreSize(Load->getType());
+  if (Bytes < LoadSize || Start > Bytes - LoadSize)
+    return 0;
+  APInt Size(DL.getIndexTypeSizeInBits(BaseVal->getType()), Bytes);
+  if (!isDereferenceableAndAlignedPointer(
+          BaseVal, Align, Size, DL, L->getLoopPreheader()->getTerminator(),
+          &DT))
+    return 0;
+
+  if (Stride == 0)
+    return UINT64_MAX;
+  return (Bytes - LoadSize - Start) / Stride + 1;
+}
+
+/// Check whether the iterations of @p L can be evaluated in chunks and
+/// collect its early exits and induction variables in @p EEL.
+static bool analyzeLoop(Loop *L, ScalarEvolution &SE, DominatorTree &DT,
+                        EarlyExitLoop &EEL) {
+  BasicBlock *Latch = L->getLoopLatch();
+  if (!L->empty() || !L->getLoopPreheader() || !Latch ||
+      !L->isLoopExiting(Latch))
+    return false;
+
+  auto *LatchBranch = dyn_cast<BranchInst>(Latch->getTerminator());
+  if (!LatchBranch || !LatchBranch->isConditional())
+    return false;
+
+  // The latch bounds the number of iterations.
+  const SCEV *MaxBackedgeCount = SE.getExitCount(L, Latch);
+  if (isa<SCEVCouldNotCompute>(MaxBackedgeCount) ||
+      !isUIntN(MaxBackedgeCount->getType()->getIntegerBitWidth(), ChunkSize))
+    return false;
+
+  SCEVExpander Expander(SE, L->getHeader()->getModule()->getDataLayout(),
+                        "polly.early_exit");
+  Instruction *InsertPt = L->getLoopPreheader()->getTerminator();
+  if (Expander.isHighCostExpansion(MaxBackedgeCount, L, InsertPt))
+    return false;
+
+  bool HasDataDependentExit = false;
+  SmallVector<BasicBlock *, 4> ExitingBlocks;
+  L->getExitingBlocks(ExitingBlocks);
+  for (BasicBlock *BB : ExitingBlocks) {
+    if (BB == Latch)
+      continue;
+
+    // Every iteration that is not left earlier evaluates the exit condition,
+    // and continues in the loop if it does not hold.
+    auto *Branch = dyn_cast<BranchInst>(BB->getTerminator());
+    if (!Branch || !Branch->isConditional() || !DT.dominates(BB, Latch) ||
+        L->contains(Branch->getSuccessor(0)) ==
+            L->contains(Branch->getSuccessor(1)))
+      return false;
+
+    HasDataDependentExit |= isa<SCEVCouldNotCompute>(SE.getExitCount(L, BB));
+    EEL.EarlyExits.push_back(BB);
+  }
+
+  // Loops with affine exits only are handled by Polly as they are.
+  if (!HasDataDependentExit)
+    return false;
+
+  // The values of an iteration must not depend on the previous iterations,
+  // except through induction variables.
+  for (PHINode &Phi : L->getHeader()->phis()) {
+    if (!Phi.getType()->isIntegerTy())
+      return false;
+    auto *AR = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(&Phi));
+    if (!AR || AR->getLoop() != L || !AR->isAffine())
+      return false;
+    EEL.IVs.push_back({&Phi});
+  }
+
+  // The iterations of a chunk after the exiting one, and the parts of an
+  // iteration after its exit, are executed speculatively.
+  for (BasicBlock *BB : L->blocks())
+    for (Instruction &Inst : *BB) {
+      if (isa<PHINode>(Inst) || Inst.isTerminator() ||
+          isa<DbgInfoIntrinsic>(Inst))
+        continue;
+      if (auto *Load = dyn_cast<LoadInst>(&Inst)) {
+        EEL.DereferenceableIterations =
+            std::min(EEL.DereferenceableIterations,
+                     getDereferenceableIterations(Load, L, SE, DT));
+        if (EEL.DereferenceableIterations < ChunkSize)
+          return false;
+        continue;
+      }
+      if (!isSafeToSpeculativelyExecute(&Inst))
+        return false;
+    }
+
+  EEL.L = L;
+  return true;
+}
+
+/// Expand the loop-invariant values of @p EEL in the preheader of its loop.
+static void expandInvariants(EarlyExitLoop &EEL, ScalarEvolution &SE) {
+  Loop *L = EEL.L;
+  SCEVExpander Expander(SE, L->getHeader()->getModule()->getDataLayout(),
+                        "polly.early_exit");
+  Instruction *InsertPt = L->getLoopPreheader()->getTerminator();
+
+  const SCEV *MaxBackedgeCount = SE.getExitCount(L, L->getLoopLatch());
+  Type *CountTy = MaxBackedgeCount->getType();
+  if (isUIntN(CountTy->getIntegerBitWidth(), EEL.DereferenceableIterations))
+    MaxBackedgeCount = SE.getUMinExpr(
+        MaxBackedgeCount,
+        SE.getConstant(CountTy, EEL.DereferenceableIterations));
+  EEL.MaxBackedgeCount = Expander.expandCodeFor(
+      MaxBackedgeCount, MaxBackedgeCount->getType(), InsertPt);
+
+  for (InductionVariable &IV : EEL.IVs) {
+    auto *AR = cast<SCEVAddRecExpr>(SE.getSCEV(IV.Phi));
+    Type *Ty = IV.Phi->getType();
+    IV.Start = Expander.expandCodeFor(AR->getStart(), Ty, InsertPt);
+    IV.Step = Expander.expandCodeFor(AR->getStepRecurrence(SE), Ty, InsertPt);
+  }
+}
+
+/// Return the value of @p IV in the iteration @p Iteration.
+static Value *getIterationValue(IRBuilder<> &Builder,
+                                const InductionVariable &IV,
+                                Value *Iteration) {
+  Value *Result = Builder.CreateZExtOrTrunc(Iteration, IV.Phi->getType());
+  auto *Step = dyn_cast<ConstantInt>(IV.Step);
+  if (!Step || !Step->isOne())
+    Result = Builder.CreateMul(Result, IV.Step);
+  auto *Start = dyn_cast<ConstantInt>(IV.Start);
+  if (!Start || !Start->isZero())
+    Result = Builder.CreateAdd(IV.Start, Result);
+  return Result;
+}
+
+/// Evaluate the exit conditions of @p EEL in chunks of iterations before its
+/// loop is executed.
+static void chunkLoop(EarlyExitLoop &EEL) {
+  Loop *L = EEL.L;
+  BasicBlock *Preheader = L->getLoopPreheader();
+  BasicBlock *Header = L->getHeader();
+  BasicBlock *Latch = L->getLoopLatch();
+  Function *F = Header->getParent();
+  LLVMContext &Ctx = F->getContext();
+
+  Value *MaxBackedgeCount = EEL.MaxBackedgeCount;
+  auto *IterationTy = cast<IntegerType>(MaxBackedgeCount->getType());
+  Constant *Zero = ConstantInt::get(IterationTy, 0);
+  Constant *One = ConstantInt::get(IterationTy, 1);
+  Constant *Size = ConstantInt::get(IterationTy, ChunkSize);
+  // No iteration of a chunk is the last iteration of the loop, hence the
+  // largest iteration number means that the chunk has no exiting iteration.
+  Constant *NoIteration = Constant::getAllOnesValue(IterationTy);
+
+  IRBuilder<> Builder(Ctx);
+  auto *ChunkHeader =
+      BasicBlock::Create(Ctx, "polly.early_exit.chunk", F, Header);
+  Builder.SetInsertPoint(ChunkHeader);
+  PHINode *ChunkStart =
+      Builder.CreatePHI(IterationTy, 2, "polly.early_exit.chunk.start");
+  Value *ChunkEnd =
+      Builder.CreateAdd(ChunkStart, Size, "polly.early_exit.chunk.end");
+
+  // The loop evaluating a chunk is a copy of the original loop.
+  ValueToValueMapTy VMap;
+  SmallVector<BasicBlock *, 8> Blocks;
+  for (BasicBlock *BB : L->blocks()) {
+    BasicBlock *Clone = CloneBasicBlock(BB, VMap, ".chunk", F);
+    Clone->moveBefore(Header);
+    VMap[BB] = Clone;
+    Blocks.push_back(Clone);
+  }
+  auto *EvalHeader = cast<BasicBlock>(VMap[Header]);
+  auto *EvalLatch = cast<BasicBlock>(VMap[Latch]);
+  Builder.CreateBr(EvalHeader);
+
+  // Compute the induction variables from the iteration number. The copies of
+  // the header PHIs are not used yet, as the copies are not remapped yet.
+  for (InductionVariable &IV : EEL.IVs)
+    cast<PHINode>(VMap[IV.Phi])->eraseFromParent();
+  Builder.SetInsertPoint(&*EvalHeader->begin());
+  PHINode *Iteration =
+      Builder.CreatePHI(IterationTy, 2, "polly.early_exit.iteration");
+  PHINode *First = Builder.CreatePHI(IterationTy, 2, "polly.early_exit.first");
+  Builder.SetInsertPoint(&*EvalHeader->getFirstInsertionPt());
+  for (InductionVariable &IV : EEL.IVs)
+    VMap[IV.Phi] = getIterationValue(Builder, IV, Iteration);
+  remapInstructionsInBlocks(Blocks, VMap);
+
+  // Continue in the loop where the original one leaves it early, and
+  // remember whether it would have left it.
+  SmallVector<Value *, 4> Exits;
+  for (BasicBlock *BB : EEL.EarlyExits) {
+    auto *Clone = cast<BasicBlock>(VMap[BB]);
+    auto *Branch = cast<BranchInst>(Clone->getTerminator());
+    bool ExitOnTrue = !L->contains(BB->getTerminator()->getSuccessor(0));
+    Builder.SetInsertPoint(Branch);
+    Value *Exit = Branch->getCondition();
+    if (!ExitOnTrue)
+      Exit = Builder.CreateNot(Exit, "polly.early_exit.exit");
+    Builder.CreateBr(Branch->getSuccessor(ExitOnTrue ? 1 : 0));
+    Branch->eraseFromParent();
+    Exits.push_back(Exit);
+  }
+
+  // The first exiting iteration is the minimum of the exiting iterations.
+  auto *ChunkExit =
+      BasicBlock::Create(Ctx, "polly.early_exit.chunk.exit", F, Header);
+  Instruction *LatchBranch = EvalLatch->getTerminator();
+  Builder.SetInsertPoint(LatchBranch);
+  Value *Exit = Exits[0];
+  for (Value *OtherExit : makeArrayRef(Exits).drop_front())
+    Exit = Builder.CreateOr(Exit, OtherExit);
+  Value *ExitIteration = Builder.CreateSelect(Exit, Iteration, NoIteration);
+  Value *IsFirst = Builder.CreateICmpULT(ExitIteration, First);
+  Value *NextFirst = Builder.CreateSelect(IsFirst, ExitIteration, First,
+                                          "polly.early_exit.first.next");
+  Value *NextIteration =
+      Builder.CreateAdd(Iteration, One, "polly.early_exit.iteration.next");
+  Builder.CreateCondBr(Builder.CreateICmpNE(NextIteration, ChunkEnd),
+                       EvalHeader, ChunkExit);
+  LatchBranch->eraseFromParent();
+
+  Iteration->addIncoming(ChunkStart, ChunkHeader);
+  Iteration->addIncoming(NextIteration, EvalLatch);
+  First->addIncoming(NoIteration, ChunkHeader);
+  First->addIncoming(NextFirst, EvalLatch);
+
+  // Stop at the first chunk with an exiting iteration, or when no full chunk
+  // is left before the last iteration.
+  auto *ChunkLatch =
+      BasicBlock::Create(Ctx, "polly.early_exit.chunk.next", F, Header);
+  auto *Resume = BasicBlock::Create(Ctx, "polly.early_exit.resume", F, Header);
+  Builder.SetInsertPoint(ChunkExit);
+  Builder.CreateCondBr(Builder.CreateICmpNE(NextFirst, NoIteration), Resume,
+                       ChunkLatch);
+
+  Builder.SetInsertPoint(ChunkLatch);
+  Value *Remaining = Builder.CreateSub(MaxBackedgeCount, ChunkEnd);
+  Builder.CreateCondBr(Builder.CreateICmpUGE(Remaining, Size), ChunkHeader,
+                       Resume);
+
+  Instruction *PreheaderBranch = Preheader->getTerminator();
+  Builder.SetInsertPoint(PreheaderBranch);
+  Builder.CreateCondBr(Builder.CreateICmpUGE(MaxBackedgeCount, Size),
+                       ChunkHeader, Resume);
+  PreheaderBranch->eraseFromParent();
+
+  ChunkStart->addIncoming(Zero, Preheader);
+  ChunkStart->addIncoming(ChunkEnd, ChunkLatch);
+
+  // Resume the original loop at the first exiting iteration, or after the
+  // last chunk.
+  Builder.SetInsertPoint(Resume);
+  PHINode *ResumeIteration =
+      Builder.CreatePHI(IterationTy, 3, "polly.early_exit.resume.iteration");
+  ResumeIteration->addIncoming(Zero, Preheader);
+  ResumeIteration->addIncoming(NextFirst, ChunkExit);
+  ResumeIteration->addIncoming(ChunkEnd, ChunkLatch);
+  for (InductionVariable &IV : EEL.IVs) {
+    int Idx = IV.Phi->getBasicBlockIndex(Preheader);
+    IV.Phi->setIncomingValue(Idx,
+                             getIterationValue(Builder, IV, ResumeIteration));
+    IV.Phi->setIncomingBlock(Idx, Resume);
+  }
+  Builder.CreateBr(Header);
+
+  LLVM_DEBUG(dbgs() << "Evaluating the exits of loop " << Header->getName()
+                    << " in chunks of " << ChunkSize << " iterations\n");
+  NumChunkedLoops++;
+}
+
+/// Evaluate the exit conditions of the early-exit loops of @p F in chunks.
+static bool chunkEarlyExitLoops(LoopInfo &LI, DominatorTree &DT,
+                                ScalarEvolution &SE) {
+  if (ChunkSize < 2)
+    return false;
+
+  SmallVector<EarlyExitLoop, 4> Loops;
+  for (Loop *L : LI.getLoopsInPreorder()) {
+    EarlyExitLoop EEL;
+    if (analyzeLoop(L, SE, DT, EEL))
+      Loops.push_back(std::move(EEL));
+  }
+
+  // ScalarEvolution and the dominator tree are not updated for the new
+  // blocks, hence all values are expanded before the first loop is changed.
+  for (EarlyExitLoop &EEL : Loops)
+    expandInvariants(EEL, SE);
+  for (EarlyExitLoop &EEL : Loops)
+    chunkLoop(EEL);
+
+  return !Loops.empty();
+}
+
+bool EarlyExitChunking::runOnFunction(Function &F) {
+  if (skipFunction(F))
+    return false;
+
+  auto &LI = getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+  auto &DT = getAnalysis<DominatorTreeWrapperPass>().getDomTree();
+  auto &SE = getAnalysis<ScalarEvolutionWrapperPass>().getSE();
+  return chunkEarlyExitLoops(LI, DT, SE);
+}
+
+void EarlyExitChunking::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<DominatorTreeWrapperPass>();
+  AU.addRequired<LoopInfoWrapperPass>();
+  AU.addRequired<ScalarEvolutionWrapperPass>();
+}
+
+PreservedAnalyses EarlyExitChunkingPass::run(Function &F,
+                                             FunctionAnalysisManager &FAM) {
+  auto &LI = FAM.getResult<LoopAnalysis>(F);
+  auto &DT = FAM.getResult<DominatorTreeAnalysis>(F);
+  auto &SE = FAM.getResult<ScalarEvolutionAnalysis>(F);
+  if (!chunkEarlyExitLoops(LI, DT, SE))
+    return PreservedAnalyses::all();
+  return PreservedAnalyses::none();
+}
+
+char EarlyExitChunking::ID = 0;
+
+Pass *polly::createEarlyExitChunkingPass() { return new EarlyExitChunking(); }
+
+INITIALIZE_PASS_BEGIN(EarlyExitChunking, "polly-early-exit-chunking",
+                      "Polly - Evaluate the exits of early-exit loops in "
+                      "chunks",
+                      false, false)
+INITIALIZE_PASS_DEPENDENCY(DominatorTreeWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(ScalarEvolutionWrapperPass)
+INITIALIZE_PASS_END(EarlyExitChunking, "polly-early-exit-chunking",
+                    "Polly - Evaluate the exits of early-exit loops in "
+                    "chunks",
+                    false, false)
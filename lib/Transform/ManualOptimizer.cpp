@@ -0,0 +1,381 @@
+//===------ ManualOptimizer.cpp -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Handle pragma/metadata-directed transformations.
+//
+// Loops annotated with '#pragma clang loop' transformation directives are
+// represented by a "Loop with Metadata" mark node above their band in the
+// schedule tree. The directives are applied as schedule tree transformations
+// in the following order:
+//
+//  - interchange with the directly nested loop
+//  - tiling of the loop and (llvm.loop.tile.depth - 1) nested loops
+//  - unroll-and-jam
+//  - thread parallelization
+//
+// Each transformation is checked against the data dependences. Directives that
+// cannot be applied legally are ignored with a warning.
+//
+//===----------------------------------------------------------------------===//
+
+#include "polly/ManualOptimizer.h"
+#include "polly/DependenceInfo.h"
+#include "polly/Options.h"
+#include "polly/ScopInfo.h"
+#include "polly/Support/ScopHelper.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DiagnosticInfo.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "isl/options.h"
+#include "isl/schedule_node.h"
+
+#define DEBUG_TYPE "polly-opt-manual"
+
+using namespace polly;
+using namespace llvm;
+
+static cl::opt<int> DefaultTileSize(
+    "polly-pragma-default-tile-size",
+    cl::desc("The tile size used for '#pragma clang loop tile' if no size is "
+             "given explicitly"),
+    cl::Hidden, cl::init(32), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+static cl::opt<int> DefaultUnrollAndJamCount(
+    "polly-pragma-default-unroll-and-jam-count",
+    cl::desc("The unroll factor used for '#pragma unroll_and_jam' if no count "
+             "is given explicitly"),
+    cl::Hidden, cl::init(4), cl::ZeroOrMore, cl::cat(PollyCategory));
+
+STATISTIC(ManualInterchanges, "Number of user-directed loop interchanges");
+STATISTIC(ManualTilings, "Number of user-directed loop tilings");
+STATISTIC(ManualUnrollAndJams, "Number of user-directed unroll-and-jams");
+STATISTIC(ManualParallelizations,
+          "Number of user-directed thread parallelizations");
+STATISTIC(ManualRejected,
+          "Number of loop transformation directives that were not applied");
+
+namespace {
+
+/// Return whether the boolean loop property @p Name is set in @p LoopID.
+bool getBooleanDirective(MDNode *LoopID, StringRef Name) {
+  MDNode *MD = findOptionMDForLoopID(LoopID, Name);
+  if (!MD)
+    return false;
+
+  if (MD->getNumOperands() == 1)
+    return true;
+
+  if (auto *Val = mdconst::dyn_extract<ConstantInt>(MD->getOperand(1)))
+    return Val->getZExtValue();
+  return true;
+}
+
+/// Return the integer loop property @p Name of @p LoopID, if present.
+Optional<int> getIntDirective(MDNode *LoopID, StringRef Name) {
+  MDNode *MD = findOptionMDForLoopID(LoopID, Name);
+  if (!MD || MD->getNumOperands() != 2)
+    return None;
+
+  if (auto *Val = mdconst::dyn_extract<ConstantInt>(MD->getOperand(1)))
+    return Val->getSExtValue();
+  return None;
+}
+
+/// Find the top-most "Loop with Metadata" mark in the subtree of @p Node.
+isl::schedule_node findLoopAttrMark(isl::schedule_node Node) {
+  isl::schedule_node Result;
+  isl_schedule_node_foreach_descendant_top_down(
+      Node.get(),
+      [](__isl_keep isl_schedule_node *NodePtr, void *User) -> isl_bool {
+        isl::schedule_node *Result = static_cast<isl::schedule_node *>(User);
+        if (*Result)
+          return isl_bool_false;
+
+        if (isl_schedule_node_get_type(NodePtr) == isl_schedule_node_mark &&
+            isLoopAttr(isl::manage(isl_schedule_node_mark_get_id(NodePtr)))) {
+          *Result = isl::manage_copy(NodePtr);
+          return isl_bool_false;
+        }
+        return isl_bool_true;
+      },
+      &Result);
+  return Result;
+}
+
+/// Return the partial schedule of the band node @p Band.
+isl::multi_union_pw_aff getPartialSchedule(const isl::schedule_node &Band) {
+  return isl::manage(isl_schedule_node_band_get_partial_schedule(Band.get()));
+}
+
+bool isBand(const isl::schedule_node &Node) {
+  return isl_schedule_node_get_type(Node.get()) == isl_schedule_node_band;
+}
+
+/// Remove the node @p Node and return the node that takes its place.
+isl::schedule_node deleteNode(isl::schedule_node Node) {
+  return isl::manage(isl_schedule_node_delete(Node.release()));
+}
+
+/// Check whether the outermost member of @p Band carries no dependence.
+bool isParallelBand(const Dependences &D, isl::schedule_node Band) {
+  isl::union_set Domain = Band.get_domain();
+  isl::union_map Schedule = Band.child(0).get_prefix_schedule_union_map();
+  isl::union_map Deps =
+      D.getDependences(Dependences::TYPE_RAW | Dependences::TYPE_WAR |
+                       Dependences::TYPE_WAW | Dependences::TYPE_RED);
+  Deps = Deps.intersect_domain(Domain).intersect_range(Domain);
+  return D.isParallel(Schedule.get(), Deps.release());
+}
+
+/// Collect @p Depth perfectly nested bands starting at @p Band.
+///
+/// @return True if there are at least @p Depth perfectly nested bands.
+bool collectPerfectlyNestedBands(isl::schedule_node Band, int Depth,
+                                 SmallVectorImpl<isl::schedule_node> &Bands) {
+  for (int i = 0; i < Depth; i += 1) {
+    if (!isBand(Band))
+      return false;
+    Bands.push_back(Band);
+    Band = Band.child(0);
+  }
+  return true;
+}
+
+/// Swap the band @p Band with its directly nested band.
+isl::schedule_node interchangeBands(isl::schedule_node Band) {
+  isl::multi_union_pw_aff Outer = getPartialSchedule(Band);
+  isl::multi_union_pw_aff Inner = getPartialSchedule(Band.child(0));
+
+  Band = deleteNode(deleteNode(Band));
+  Band = Band.insert_partial_schedule(Outer);
+  return Band.insert_partial_schedule(Inner);
+}
+
+/// Combine @p Depth perfectly nested bands starting at @p Band and tile the
+/// result with @p TileSize in each dimension.
+isl::schedule_node tileBands(isl::schedule_node Band, int Depth,
+                             int TileSize) {
+  isl::multi_union_pw_aff Combined = getPartialSchedule(Band);
+  isl::schedule_node Child = Band.child(0);
+  for (int i = 1; i < Depth; i += 1) {
+    Combined = Combined.flat_range_product(getPartialSchedule(Child));
+    Child = Child.child(0);
+  }
+
+  for (int i = 0; i < Depth; i += 1)
+    Band = deleteNode(Band);
+  Band = Band.insert_partial_schedule(Combined);
+
+  auto Space = isl::manage(isl_schedule_node_band_get_space(Band.get()));
+  auto Sizes = isl::multi_val::zero(Space);
+  for (unsigned i = 0; i < Space.dim(isl::dim::set); i += 1)
+    Sizes = Sizes.set_val(i, isl::val(Band.get_ctx(), TileSize));
+  return isl::manage(
+      isl_schedule_node_band_tile(Band.release(), Sizes.release()));
+}
+
+/// Strip-mine @p Band by @p Factor, move the point loop to the innermost level
+/// and unroll it.
+isl::schedule_node unrollAndJamBand(isl::schedule_node Band, int Factor) {
+  auto Space = isl::manage(isl_schedule_node_band_get_space(Band.get()));
+  auto Sizes = isl::multi_val::zero(Space);
+  for (unsigned i = 0; i < Space.dim(isl::dim::set); i += 1)
+    Sizes = Sizes.set_val(i, isl::val(Band.get_ctx(), Factor));
+  Band =
+      isl::manage(isl_schedule_node_band_tile(Band.release(), Sizes.release()));
+
+  isl::schedule_node Point = Band.child(0);
+  Point = Point.band_set_ast_build_options(
+      isl::union_set(Point.get_ctx(), "{ unroll[x] }"));
+  Point = isl::manage(isl_schedule_node_band_sink(Point.release()));
+  return Point.parent();
+}
+
+/// Applies the transformation directives of a single loop.
+class LoopDirectiveApplicator {
+  Scop &S;
+  const Dependences &D;
+  OptimizationRemarkEmitter *ORE;
+  Loop *L;
+  MDNode *LoopID;
+
+  /// Was any of the directives applied?
+  bool Changed = false;
+
+  void reportRejection(StringRef RemarkName, const Twine &Msg) {
+    ManualRejected++;
+    LLVM_DEBUG(dbgs() << Msg << "\n");
+    if (!ORE)
+      return;
+
+    ORE->emit(DiagnosticInfoOptimizationFailure(DEBUG_TYPE, RemarkName,
+                                                L->getStartLoc(),
+                                                L->getHeader())
+              << Msg.str());
+  }
+
+  void reportSuccess(StringRef RemarkName, const Twine &Msg) {
+    Changed = true;
+    if (!ORE)
+      return;
+
+    ORE->emit(OptimizationRemark(DEBUG_TYPE, RemarkName, L->getStartLoc(),
+                                 L->getHeader())
+              << Msg.str());
+  }
+
+  isl::schedule_node applyInterchange(isl::schedule_node Band) {
+    SmallVector<isl::schedule_node, 2> Bands;
+    if (!collectPerfectlyNestedBands(Band, 2, Bands)) {
+      reportRejection("InterchangeNotPerfectlyNested",
+                      "loop not interchanged: the loop must directly contain "
+                      "a perfectly nested loop without directives of its own");
+      return Band;
+    }
+
+    isl::schedule_node Transformed = interchangeBands(Band);
+    if (!D.isValidSchedule(S, Transformed.get_schedule())) {
+      reportRejection("InterchangeIllegal",
+                      "loop not interchanged: interchange would violate data "
+                      "dependences");
+      return Band;
+    }
+
+    ManualInterchanges++;
+    reportSuccess("Interchanged", "loop interchanged with its nested loop");
+    return Transformed;
+  }
+
+  isl::schedule_node applyTiling(isl::schedule_node Band) {
+    int Depth = getIntDirective(LoopID, "llvm.loop.tile.depth").getValueOr(1);
+    int TileSize = getIntDirective(LoopID, "llvm.loop.tile.size")
+                       .getValueOr(DefaultTileSize);
+    if (Depth < 1 || TileSize < 1) {
+      reportRejection("TileInvalidArgument",
+                      "loop not tiled: tile size and depth must be positive");
+      return Band;
+    }
+
+    SmallVector<isl::schedule_node, 4> Bands;
+    if (!collectPerfectlyNestedBands(Band, Depth, Bands)) {
+      reportRejection("TileNotPerfectlyNested",
+                      "loop not tiled: fewer than " + Twine(Depth) +
+                          " perfectly nested loops");
+      return Band;
+    }
+
+    isl::schedule_node Transformed = tileBands(Band, Depth, TileSize);
+    if (!D.isValidSchedule(S, Transformed.get_schedule())) {
+      reportRejection("TileIllegal",
+                      "loop not tiled: tiling would violate data dependences");
+      return Band;
+    }
+
+    ManualTilings++;
+    reportSuccess("Tiled", "loop nest of depth " + Twine(Depth) +
+                               " tiled with tile size " + Twine(TileSize));
+    return Transformed;
+  }
+
+  isl::schedule_node applyUnrollAndJam(isl::schedule_node Band) {
+    int Factor = getIntDirective(LoopID, "llvm.loop.unroll_and_jam.count")
+                     .getValueOr(DefaultUnrollAndJamCount);
+    if (Factor <= 1) {
+      reportRejection("UnrollAndJamInvalidArgument",
+                      "loop not unroll-and-jammed: count must be larger than 1");
+      return Band;
+    }
+
+    isl::schedule_node Transformed = unrollAndJamBand(Band, Factor);
+    if (!D.isValidSchedule(S, Transformed.get_schedule())) {
+      reportRejection("UnrollAndJamIllegal",
+                      "loop not unroll-and-jammed: unroll-and-jam would "
+                      "violate data dependences");
+      return Band;
+    }
+
+    ManualUnrollAndJams++;
+    reportSuccess("UnrollAndJammed",
+                  "loop unroll-and-jammed by a factor of " + Twine(Factor));
+    return Transformed;
+  }
+
+  isl::schedule_node applyParallelization(isl::schedule_node Band) {
+    if (isl_schedule_node_band_n_member(Band.get()) > 1)
+      Band = isl::manage(isl_schedule_node_band_split(Band.release(), 1));
+
+    if (!isParallelBand(D, Band)) {
+      reportRejection("ParallelizeIllegal",
+                      "loop not parallelized: the loop carries a data "
+                      "dependence");
+      return Band;
+    }
+
+    ManualParallelizations++;
+    reportSuccess("Parallelized", "loop will be executed in parallel");
+    Band = Band.band_member_set_coincident(0, true);
+    return Band.insert_mark(
+        isl::id::alloc(Band.get_ctx(), "Parallelize Thread", nullptr));
+  }
+
+public:
+  LoopDirectiveApplicator(Scop &S, const Dependences &D,
+                          OptimizationRemarkEmitter *ORE, BandAttr *Attr)
+      : S(S), D(D), ORE(ORE), L(Attr->OriginalLoop), LoopID(Attr->Metadata) {}
+
+  /// Apply all directives to @p Band and return the node at the same
+  /// position in the transformed tree.
+  isl::schedule_node apply(isl::schedule_node Band) {
+    if (getBooleanDirective(LoopID, "llvm.loop.interchange.enable"))
+      Band = applyInterchange(Band);
+
+    if (getBooleanDirective(LoopID, "llvm.loop.tile.enable"))
+      Band = applyTiling(Band);
+
+    if (getBooleanDirective(LoopID, "llvm.loop.unroll_and_jam.enable"))
+      Band = applyUnrollAndJam(Band);
+
+    if (getBooleanDirective(LoopID, "llvm.loop.parallelize_thread.enable"))
+      Band = applyParallelization(Band);
+
+    return Band;
+  }
+
+  bool isChanged() const { return Changed; }
+};
+} // namespace
+
+isl::schedule polly::applyManualTransformations(Scop *S, isl::schedule Sched,
+                                                const Dependences &D,
+                                                OptimizationRemarkEmitter *ORE) {
+  isl_options_set_tile_scale_tile_loops(Sched.get_ctx().get(), 0);
+
+  bool Changed = false;
+  isl::schedule_node Node = Sched.get_root();
+  while (isl::schedule_node Mark = findLoopAttrMark(Node)) {
+    // Keep the id, which owns the BandAttr, alive while applying it.
+    isl::id MarkId = Mark.mark_get_id();
+    BandAttr *Attr = getLoopAttr(MarkId);
+
+    isl::schedule_node Band = deleteNode(Mark);
+    LoopDirectiveApplicator Applicator(*S, D, ORE, Attr);
+    Band = Applicator.apply(Band);
+    Changed |= Applicator.isChanged();
+    Node = Band.root();
+  }
+
+  if (!Changed)
+    return nullptr;
+  return Node.get_schedule();
+}
@@ -9,10 +9,15 @@
 // This pass fully expand the memory accesses of a Scop to get rid of
 // dependencies.
 //
+// With -polly-mse-bounded, dimensions along which values are read a bounded
+// number of iterations after they are written are expanded modulo that
+// distance only (rolling buffers), which keeps the memory overhead constant.
+//
 //===----------------------------------------------------------------------===//
 
 #include "polly/DependenceInfo.h"
 #include "polly/LinkAllPasses.h"
+#include "polly/Options.h"
 #include "polly/ScopInfo.h"
 #include "polly/ScopPass.h"
 #include "polly/Support/GICHelper.h"
@@ -21,6 +26,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
 #include "isl/isl-noexceptions.h"
 #include "isl/union_map.h"
 #include <cassert>
@@ -33,6 +39,12 @@ using namespace polly;
 
 #define DEBUG_TYPE "polly-mse"
 
+static cl::opt<bool> BoundedExpansion(
+    "polly-mse-bounded",
+    cl::desc("Expand dimensions that carry dependences only modulo the "
+             "maximal dependence distance"),
+    cl::Hidden, cl::init(false), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 namespace {
 
 class MaximalStaticExpander : public ScopPass {
@@ -80,7 +92,37 @@ private:
   ///
   /// @param S The SCop in which the memory access appears in.
   /// @param MA The memory access that need to be expanded.
-  ScopArrayInfo *expandAccess(Scop &S, MemoryAccess *MA);
+  /// @param Moduli For each dimension of the domain, the number of elements
+  ///               of the rolling buffer or 0 if the dimension is fully
+  ///               expanded.
+  ScopArrayInfo *expandAccess(Scop &S, MemoryAccess *MA,
+                              ArrayRef<unsigned> Moduli = {});
+
+  /// Compute the modulo to expand each dimension of the domain of @p Write
+  /// with, such that every value is still available when @p Reads read it.
+  ///
+  /// @param S The SCop in which the memory accesses appear in.
+  /// @param Write The write access that will be expanded.
+  /// @param Reads The read accesses that read the values of @p Write.
+  /// @param Dependences The RAW dependences of the SCop.
+  ///
+  /// @return The moduli of the dimensions, 0 for fully expanded dimensions.
+  SmallVector<unsigned, 4>
+  computeModuli(Scop &S, MemoryAccess *Write,
+                SmallPtrSetImpl<MemoryAccess *> &Reads,
+                const isl::union_map &Dependences);
+
+  /// Check that no value written by @p Write is overwritten before all of
+  /// @p Reads read it, if the location of each value is given by @p Folding.
+  ///
+  /// @param S The SCop in which the memory accesses appear in.
+  /// @param Write The write access that will be expanded.
+  /// @param Folding The location of the value written by each instance.
+  /// @param Reads The read accesses that read the values of @p Write.
+  /// @param Dependences The RAW dependences of the SCop.
+  bool isFoldingValid(Scop &S, MemoryAccess *Write, isl::map Folding,
+                      SmallPtrSetImpl<MemoryAccess *> &Reads,
+                      const isl::union_map &Dependences);
 
   /// Filter the dependences to have only one related to current memory access.
   ///
@@ -97,11 +139,12 @@ private:
   /// @param The SCop in which the memory access appears in.
   /// @param The memory access that need to be expanded.
   /// @param Dependences The RAW dependences of the SCop.
-  /// @param ExpandedSAI The expanded SAI created during write expansion.
+  /// @param ExpandedAccess The expanded access relation created during write
+  /// expansion.
   /// @param Reverse if true, the Dependences union_map is reversed before
   /// intersection.
   void mapAccess(Scop &S, SmallPtrSetImpl<MemoryAccess *> &Accesses,
-                 const isl::union_map &Dependences, ScopArrayInfo *ExpandedSAI,
+                 const isl::union_map &Dependences, isl::map ExpandedAccess,
                  bool Reverse);
 
   /// Expand PHI memory accesses.
@@ -114,7 +157,6 @@ private:
 };
 } // namespace
 
-#ifndef NDEBUG
 /// Whether a dimension of a set is bounded (lower and upper) by a constant,
 /// i.e. there are two constants Min and Max, such that every value x of the
 /// chosen dimensions is Min <= x <= Max.
@@ -126,7 +168,62 @@ static bool isDimBoundedByConstant(isl::set Set, unsigned dim) {
   Set = Set.project_out(isl::dim::set, 1, SetDims - 1);
   return bool(Set.is_bounded());
 }
-#endif
+
+/// Whether the array expanding @p Domain has a constant size, i.e. all
+/// dimensions not expanded modulo @p Moduli are bounded by constants.
+static bool hasConstantExpansionSize(isl::set Domain,
+                                     ArrayRef<unsigned> Moduli) {
+  for (unsigned i = 0; i < Domain.dim(isl::dim::set); i++) {
+    if (i < Moduli.size() && Moduli[i] != 0)
+      continue;
+    if (!isDimBoundedByConstant(Domain, i))
+      return false;
+  }
+  return true;
+}
+
+/// Return the map from the instances of @p Space to the location of their
+/// value in the expanded array, i.e. each dimension modulo @p Moduli.
+///
+/// @param Space  { Domain[] }
+///
+/// @return { Domain[] -> Domain[] }
+static isl::map getExpansionMap(isl::space Space, ArrayRef<unsigned> Moduli) {
+  isl::multi_aff Expansion = isl::multi_aff::identity(Space.map_from_set());
+  for (unsigned i = 0; i < Moduli.size(); i++) {
+    if (Moduli[i] == 0)
+      continue;
+    isl::val Modulo(Space.get_ctx(), Moduli[i]);
+    Expansion = Expansion.set_aff(i, Expansion.get_aff(i).mod(Modulo));
+  }
+  return isl::map::from_multi_aff(Expansion);
+}
+
+/// Return the maximal distance between the iterations of dimension @p Dim
+/// of a write and the reads depending on it, or NaN if it is not bounded by
+/// a constant.
+///
+/// @param ReadToWrite { Read[] -> Write[] }
+static isl::val getMaxDependenceDistance(isl::map ReadToWrite, unsigned Dim) {
+  unsigned ReadDims = ReadToWrite.dim(isl::dim::in);
+  unsigned WriteDims = ReadToWrite.dim(isl::dim::out);
+  if (Dim >= ReadDims || Dim >= WriteDims)
+    return isl::val::nan(ReadToWrite.get_ctx());
+
+  // { Write[w_Dim] -> Read[r_Dim] }
+  isl::map Dist = ReadToWrite.reverse();
+  Dist = Dist.project_out(isl::dim::in, Dim + 1, WriteDims - Dim - 1);
+  Dist = Dist.project_out(isl::dim::in, 0, Dim);
+  Dist = Dist.project_out(isl::dim::out, Dim + 1, ReadDims - Dim - 1);
+  Dist = Dist.project_out(isl::dim::out, 0, Dim);
+  Dist = Dist.reset_tuple_id(isl::dim::in).reset_tuple_id(isl::dim::out);
+
+  // { [r_Dim - w_Dim] }
+  isl::set Deltas = Dist.deltas();
+  if (Deltas.is_empty())
+    return isl::val::nan(ReadToWrite.get_ctx());
+  return getConstant(Deltas.dim_max(0), true, false);
+}
 
 char MaximalStaticExpander::ID = 0;
 
@@ -315,8 +412,7 @@ bool MaximalStaticExpander::isExpandable(
 void MaximalStaticExpander::mapAccess(Scop &S,
                                       SmallPtrSetImpl<MemoryAccess *> &Accesses,
                                       const isl::union_map &Dependences,
-                                      ScopArrayInfo *ExpandedSAI,
-                                      bool Reverse) {
+                                      isl::map ExpandedAccess, bool Reverse) {
   for (auto MA : Accesses) {
     // Get the current AM.
     auto CurrentAccessMap = MA->getAccessRelation();
@@ -337,17 +433,104 @@ void MaximalStaticExpander::mapAccess(Scop &S,
            "There are more than one RAW dependencies in the union map.");
     auto NewAccessMap = isl::map::from_union_map(MapDependences);
 
-    auto Id = ExpandedSAI->getBasePtrId();
-
-    // Replace the out tuple id with the one of the access array.
-    NewAccessMap = NewAccessMap.set_tuple_id(isl::dim::out, Id);
+    // Access the element the depending instance of the expanded access
+    // accesses.
+    NewAccessMap = NewAccessMap.apply_range(ExpandedAccess);
 
     // Set the new access relation.
     MA->setNewAccessRelation(NewAccessMap);
   }
 }
 
-ScopArrayInfo *MaximalStaticExpander::expandAccess(Scop &S, MemoryAccess *MA) {
+SmallVector<unsigned, 4>
+MaximalStaticExpander::computeModuli(Scop &S, MemoryAccess *Write,
+                                     SmallPtrSetImpl<MemoryAccess *> &Reads,
+                                     const isl::union_map &Dependences) {
+  unsigned Dims = Write->getAccessRelation().dim(isl::dim::in);
+  SmallVector<unsigned, 4> Moduli(Dims, 0);
+  if (Reads.empty())
+    return Moduli;
+
+  SmallVector<isl::map, 4> ReadToWrite;
+  for (MemoryAccess *Read : Reads) {
+    isl::union_map MapDependences =
+        filterDependences(S, Dependences.reverse(), Read);
+    if (MapDependences.is_empty())
+      continue;
+    ReadToWrite.push_back(isl::map::from_union_map(MapDependences));
+  }
+
+  // Dimensions along which every value is read in the iteration it is
+  // written in are not folded; they are the ones expansion makes parallel.
+  for (unsigned i = 0; i < Dims; i++) {
+    long MaxDistance = 0;
+    for (isl::map Deps : ReadToWrite) {
+      isl::val Distance = getMaxDependenceDistance(Deps, i);
+      if (Distance.is_null() || Distance.is_nan() ||
+          Distance.gt(isl::val(Distance.get_ctx(),
+                               std::numeric_limits<int>::max() - 1))) {
+        MaxDistance = 0;
+        break;
+      }
+      MaxDistance = std::max(MaxDistance, Distance.get_num_si());
+    }
+    if (MaxDistance > 0)
+      Moduli[i] = MaxDistance + 1;
+  }
+
+  if (llvm::all_of(Moduli, [](unsigned M) { return M == 0; }))
+    return Moduli;
+
+  // Folding dimensions independently may still overwrite a value before it
+  // is read; fall back to a full expansion in this case.
+  isl::map Folding =
+      getExpansionMap(Write->getAccessRelation().get_space().domain(), Moduli);
+  if (!isFoldingValid(S, Write, Folding, Reads, Dependences)) {
+    emitRemark(Write->getLatestScopArrayInfo()->getName() +
+                   " cannot be expanded modulo the dependence distances.",
+               Write->getAccessInstruction());
+    return SmallVector<unsigned, 4>(Dims, 0);
+  }
+
+  return Moduli;
+}
+
+bool MaximalStaticExpander::isFoldingValid(
+    Scop &S, MemoryAccess *Write, isl::map Folding,
+    SmallPtrSetImpl<MemoryAccess *> &Reads,
+    const isl::union_map &Dependences) {
+  isl::union_map Schedule = S.getSchedule();
+  isl::union_map WriteSchedule = Schedule.intersect_domain(
+      isl::union_set(Write->getStatement()->getDomain()));
+
+  // { Write[] -> Write[] }: distinct instances writing to the same location,
+  // the second one after the first.
+  isl::union_map SameLocation =
+      isl::union_map(Folding.apply_range(Folding.reverse()));
+  SameLocation = SameLocation.intersect(
+      WriteSchedule.lex_lt_union_map(WriteSchedule));
+
+  for (MemoryAccess *Read : Reads) {
+    // { Read[] -> Write[] }
+    isl::union_map ReadToWrite =
+        filterDependences(S, Dependences.reverse(), Read);
+
+    // { Read[] -> Write[] }: writes overwriting the value before it is read.
+    isl::union_map ReadSchedule = Schedule.intersect_domain(
+        isl::union_set(Read->getStatement()->getDomain()));
+    isl::union_map Overwrites = ReadToWrite.apply_range(SameLocation);
+    Overwrites =
+        Overwrites.intersect(ReadSchedule.lex_gt_union_map(WriteSchedule));
+
+    if (!Overwrites.is_empty())
+      return false;
+  }
+
+  return true;
+}
+
+ScopArrayInfo *MaximalStaticExpander::expandAccess(Scop &S, MemoryAccess *MA,
+                                                   ArrayRef<unsigned> Moduli) {
   // Get the current AM.
   auto CurrentAccessMap = MA->getAccessRelation();
 
@@ -356,27 +539,21 @@ ScopArrayInfo *MaximalStaticExpander::expandAccess(Scop &S, MemoryAccess *MA) {
   // Get domain from the current AM.
   auto Domain = CurrentAccessMap.domain();
 
-  // Create a new AM from the domain.
-  auto NewAccessMap = isl::map::from_domain(Domain);
-
-  // Add dimensions to the new AM according to the current in_dim.
-  NewAccessMap = NewAccessMap.add_dims(isl::dim::out, in_dimensions);
-
   // Create the string representing the name of the new SAI.
   // One new SAI for each statement so that each write go to a different memory
   // cell.
   auto CurrentStmtDomain = MA->getStatement()->getDomain();
   auto CurrentStmtName = CurrentStmtDomain.get_tuple_name();
-  auto CurrentOutId = CurrentAccessMap.get_tuple_id(isl::dim::out);
   std::string CurrentOutIdString =
       MA->getScopArrayInfo()->getName() + "_" + CurrentStmtName + "_expanded";
 
-  // Set the tuple id for the out dimension.
-  NewAccessMap = NewAccessMap.set_tuple_id(isl::dim::out, CurrentOutId);
-
   // Create the size vector.
   std::vector<unsigned> Sizes;
   for (unsigned i = 0; i < in_dimensions; i++) {
+    if (i < Moduli.size() && Moduli[i] != 0) {
+      Sizes.push_back(Moduli[i]);
+      continue;
+    }
     assert(isDimBoundedByConstant(CurrentStmtDomain, i) &&
            "Domain boundary are not constant.");
     auto UpperBound = getConstant(CurrentStmtDomain.dim_max(i), true, false);
@@ -400,15 +577,11 @@ ScopArrayInfo *MaximalStaticExpander::expandAccess(Scop &S, MemoryAccess *MA) {
   // Get the out Id of the expanded Array.
   auto NewOutId = ExpandedSAI->getBasePtrId();
 
-  // Set the out id of the new AM to the new SAI id.
+  // Map each statement instance to its element of the expanded array, modulo
+  // the size of folded dimensions.
+  auto NewAccessMap = getExpansionMap(Domain.get_space(), Moduli);
   NewAccessMap = NewAccessMap.set_tuple_id(isl::dim::out, NewOutId);
 
-  // Add constraints to linked output with input id.
-  auto SpaceMap = NewAccessMap.get_space();
-  auto ConstraintBasicMap =
-      isl::basic_map::equal(SpaceMap, SpaceMap.dim(isl::dim::in));
-  NewAccessMap = isl::map(ConstraintBasicMap);
-
   // Set the new access relation map.
   MA->setNewAccessRelation(NewAccessMap);
 
@@ -421,9 +594,9 @@ void MaximalStaticExpander::expandPhi(Scop &S, const ScopArrayInfo *SAI,
   for (auto MA : S.getPHIIncomings(SAI))
     Writes.insert(MA);
   auto Read = S.getPHIRead(SAI);
-  auto ExpandedSAI = expandAccess(S, Read);
+  expandAccess(S, Read);
 
-  mapAccess(S, Writes, Dependences, ExpandedSAI, false);
+  mapAccess(S, Writes, Dependences, Read->getAccessRelation(), false);
 }
 
 void MaximalStaticExpander::emitRemark(StringRef Msg, Instruction *Inst) {
@@ -453,10 +626,30 @@ bool MaximalStaticExpander::runOnScop(Scop &S) {
       assert(AllWrites.size() == 1 || SAI->isValueKind());
 
       auto TheWrite = *(AllWrites.begin());
-      ScopArrayInfo *ExpandedArray = expandAccess(S, TheWrite);
+      SmallVector<unsigned, 4> Moduli;
+      if (BoundedExpansion)
+        Moduli = computeModuli(S, TheWrite, AllReads, Dependences);
+
+      if (!hasConstantExpansionSize(TheWrite->getStatement()->getDomain(),
+                                    Moduli)) {
+        emitRemark(SAI->getName() + " is written in a domain that is not "
+                                    "bounded by constants.",
+                   TheWrite->getAccessInstruction());
+        continue;
+      }
+
+      expandAccess(S, TheWrite, Moduli);
 
-      mapAccess(S, AllReads, Dependences, ExpandedArray, true);
+      mapAccess(S, AllReads, Dependences, TheWrite->getAccessRelation(), true);
     } else if (SAI->isPHIKind()) {
+      auto Read = S.getPHIRead(SAI);
+      if (!hasConstantExpansionSize(Read->getStatement()->getDomain(), {})) {
+        emitRemark(SAI->getName() + " is read in a domain that is not "
+                                    "bounded by constants.",
+                   Read->getAccessInstruction());
+        continue;
+      }
+
       expandPhi(S, SAI, Dependences);
     }
   }
@@ -47,15 +47,19 @@
 
 #include "polly/ScheduleOptimizer.h"
 #include "polly/CodeGen/CodeGeneration.h"
+#include "polly/CodeGen/IslAst.h"
 #include "polly/DependenceInfo.h"
 #include "polly/LinkAllPasses.h"
+#include "polly/ManualOptimizer.h"
 #include "polly/Options.h"
 #include "polly/ScopInfo.h"
 #include "polly/ScopPass.h"
 #include "polly/Simplify.h"
 #include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
+#include "polly/Support/OptimizationProfile.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/IR/Function.h"
 #include "llvm/Pass.h"
@@ -264,6 +268,12 @@ static cl::opt<bool>
                 cl::desc("Perform optimizations based on pattern matching"),
                 cl::init(true), cl::ZeroOrMore, cl::cat(PollyCategory));
 
+static cl::opt<bool> PragmaBasedOpts(
+    "polly-pragma-based-opts",
+    cl::desc("Apply user-directed transformations from '#pragma clang loop' "
+             "metadata instead of the automatic optimizations"),
+    cl::init(true), cl::ZeroOrMore, cl::cat(PollyCategory));
+
 static cl::opt<bool> OptimizedScops(
     "polly-optimized-scops",
     cl::desc("Polly - Dump polyhedral description of Scops optimized with "
@@ -274,6 +284,8 @@ static cl::opt<bool> OptimizedScops(
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
+STATISTIC(NumIslOperations,
+          "Number of isl operations performed by the scheduler");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
 STATISTIC(NumBoxedLoopsOptimized, "Number of boxed loops optimized");
@@ -515,25 +527,27 @@ bool ScheduleTreeOptimizer::isTileableBandNode(isl::schedule_node Node) {
 
 __isl_give isl::schedule_node
 ScheduleTreeOptimizer::standardBandOpts(isl::schedule_node Node, void *User) {
-  if (FirstLevelTiling) {
-    Node = tileNode(Node, "1st level tiling", FirstLevelTileSizes,
-                    FirstLevelDefaultTileSize);
+  if (getProfileOption(FirstLevelTiling)) {
+    Node = tileNode(Node, "1st level tiling",
+                    getProfileOption(FirstLevelTileSizes),
+                    getProfileOption(FirstLevelDefaultTileSize));
     FirstLevelTileOpts++;
   }
 
-  if (SecondLevelTiling) {
-    Node = tileNode(Node, "2nd level tiling", SecondLevelTileSizes,
-                    SecondLevelDefaultTileSize);
+  if (getProfileOption(SecondLevelTiling)) {
+    Node = tileNode(Node, "2nd level tiling",
+                    getProfileOption(SecondLevelTileSizes),
+                    getProfileOption(SecondLevelDefaultTileSize));
     SecondLevelTileOpts++;
   }
 
-  if (RegisterTiling) {
-    Node =
-        applyRegisterTiling(Node, RegisterTileSizes, RegisterDefaultTileSize);
+  if (getProfileOption(RegisterTiling)) {
+    Node = applyRegisterTiling(Node, getProfileOption(RegisterTileSizes),
+                               getProfileOption(RegisterDefaultTileSize));
     RegisterTileOpts++;
   }
 
-  if (PollyVectorizerChoice == VECTORIZER_NONE)
+  if (getVectorizerChoice() == VECTORIZER_NONE)
     return Node;
 
   auto Space = isl::manage(isl_schedule_node_band_get_space(Node.get()));
@@ -541,7 +555,7 @@ ScheduleTreeOptimizer::standardBandOpts(isl::schedule_node Node, void *User) {
 
   for (int i = Dims - 1; i >= 0; i--)
     if (Node.band_member_get_coincident(i)) {
-      Node = prevectSchedBand(Node, i, PrevectorWidth);
+      Node = prevectSchedBand(Node, i, getProfileOption(PrevectorWidth));
       break;
     }
 
@@ -1324,6 +1338,13 @@ bool ScheduleTreeOptimizer::isMatrMultPattern(isl::schedule_node Node,
   return false;
 }
 
+/// Lock @p Lock, if given.
+static std::unique_lock<std::mutex> lockIfShared(std::mutex *Lock) {
+  if (!Lock)
+    return std::unique_lock<std::mutex>();
+  return std::unique_lock<std::mutex>(*Lock);
+}
+
 __isl_give isl_schedule_node *
 ScheduleTreeOptimizer::optimizeBand(__isl_take isl_schedule_node *Node,
                                     void *User) {
@@ -1334,10 +1355,13 @@ ScheduleTreeOptimizer::optimizeBand(__isl_take isl_schedule_node *Node,
       static_cast<const OptimizerAdditionalInfoTy *>(User);
 
   MatMulInfoTy MMI;
-  if (PMBasedOpts && User &&
+  if (getProfileOption(PMBasedOpts) && User &&
       isMatrMultPattern(isl::manage_copy(Node), OAI->D, MMI)) {
     LLVM_DEBUG(dbgs() << "The matrix multiplication pattern was detected\n");
     MatMulOpts++;
+    // The optimization of matrix multiplications creates arrays, whose sizes
+    // are ScalarEvolution expressions.
+    auto Lock = lockIfShared(OAI->SharedStateLock);
     return optimizeMatMulPattern(isl::manage(Node), OAI->TTI, MMI).release();
   }
 
@@ -1466,9 +1490,12 @@ static void walkScheduleTreeForStatistics(isl::schedule Schedule, int Version) {
       &Version);
 }
 
-bool IslScheduleOptimizer::runOnScop(Scop &S) {
-  // Skip SCoPs in case they're already optimised by PPCGCodeGeneration
-  if (S.isToBeSkipped())
+bool polly::runIslScheduleOptimizer(
+    Scop &S, function_ref<const Dependences &()> GetDeps,
+    const TargetTransformInfo *TTI, std::mutex *SharedStateLock) {
+  // Keep schedule trees that were already optimized, e.g. imported from a
+  // JScop file.
+  if (S.isOptimized())
     return false;
 
   // Skip empty SCoPs but still allow code generation as it will delete the
@@ -1478,8 +1505,7 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
     return false;
   }
 
-  const Dependences &D =
-      getAnalysis<DependenceInfo>().getDependences(Dependences::AL_Statement);
+  const Dependences &D = GetDeps();
 
   if (D.getSharedIslCtx() != S.getSharedIslCtx()) {
     LLVM_DEBUG(dbgs() << "DependenceInfo for another SCoP/isl_ctx\n");
@@ -1489,8 +1515,8 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
   if (!D.hasValidDependences())
     return false;
 
-  isl_schedule_free(LastSchedule);
-  LastSchedule = nullptr;
+  OptimizationProfileScope ProfileScope(S);
+  IslOperationsCounter OpsCounter(S.getIslCtx().get(), NumIslOperations);
 
   // Build input data.
   int ValidityKinds =
@@ -1517,6 +1543,28 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
   ScopsProcessed++;
   walkScheduleTreeForStatistics(S.getScheduleTree(), 0);
 
+  // Transformations requested by the user take precedence over the automatic
+  // optimizations, which would otherwise discard them.
+  if (getProfileOption(PragmaBasedOpts)) {
+    // The remarks are emitted to the LLVMContext shared by all SCoPs.
+    auto Lock = lockIfShared(SharedStateLock);
+    OptimizationRemarkEmitter ORE(&S.getFunction());
+    isl::schedule ManuallyTransformed =
+        applyManualTransformations(&S, S.getScheduleTree(), D, &ORE);
+    if (ManuallyTransformed) {
+      walkScheduleTreeForStatistics(ManuallyTransformed, 2);
+      ScopsOptimized++;
+      S.setScheduleTree(ManuallyTransformed);
+      S.markAsOptimized();
+      S.compact();
+
+      if (OptimizedScops)
+        errs() << S;
+
+      return true;
+    }
+  }
+
   isl::union_map Validity = D.getDependences(ValidityKinds);
   isl::union_map Proximity = D.getDependences(ProximityKinds);
 
@@ -1544,9 +1592,10 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
 
   unsigned IslSerializeSCCs;
 
-  if (FusionStrategy == "max") {
+  std::string Fusion = getProfileOption(FusionStrategy);
+  if (Fusion == "max") {
     IslSerializeSCCs = 0;
-  } else if (FusionStrategy == "min") {
+  } else if (Fusion == "min") {
     IslSerializeSCCs = 1;
   } else {
     errs() << "warning: Unknown fusion strategy. Falling back to maximal "
@@ -1556,9 +1605,10 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
 
   int IslMaximizeBands;
 
-  if (MaximizeBandDepth == "yes") {
+  std::string MaximizeBands = getProfileOption(MaximizeBandDepth);
+  if (MaximizeBands == "yes") {
     IslMaximizeBands = 1;
-  } else if (MaximizeBandDepth == "no") {
+  } else if (MaximizeBands == "no") {
     IslMaximizeBands = 0;
   } else {
     errs() << "warning: Option -polly-opt-maximize-bands should either be 'yes'"
@@ -1568,9 +1618,10 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
 
   int IslOuterCoincidence;
 
-  if (OuterCoincidence == "yes") {
+  std::string Coincidence = getProfileOption(OuterCoincidence);
+  if (Coincidence == "yes") {
     IslOuterCoincidence = 1;
-  } else if (OuterCoincidence == "no") {
+  } else if (Coincidence == "no") {
     IslOuterCoincidence = 0;
   } else {
     errs() << "warning: Option -polly-opt-outer-coincidence should either be "
@@ -1594,6 +1645,7 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
   SC = SC.set_proximity(Proximity);
   SC = SC.set_validity(Validity);
   SC = SC.set_coincidence(Validity);
+  captureIslInput(SC.get());
   auto Schedule = SC.compute_schedule();
   isl_options_set_on_error(Ctx, OnErrorStatus);
 
@@ -1616,9 +1668,8 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
     isl_printer_free(P);
   });
 
-  Function &F = S.getFunction();
-  auto *TTI = &getAnalysis<TargetTransformInfoWrapperPass>().getTTI(F);
-  const OptimizerAdditionalInfoTy OAI = {TTI, const_cast<Dependences *>(&D)};
+  const OptimizerAdditionalInfoTy OAI = {TTI, const_cast<Dependences *>(&D),
+                                         SharedStateLock};
   auto NewSchedule = ScheduleTreeOptimizer::optimizeSchedule(Schedule, &OAI);
   walkScheduleTreeForStatistics(NewSchedule, 2);
 
@@ -1633,12 +1684,57 @@ bool IslScheduleOptimizer::runOnScop(Scop &S) {
   S.setScheduleTree(NewSchedule);
   S.markAsOptimized();
 
-  if (OptimizedScops)
+  // The optimization of matrix multiplications adds statements and accesses.
+  S.compact();
+
+  if (OptimizedScops) {
+    auto Lock = lockIfShared(SharedStateLock);
     errs() << S;
+  }
 
+  return true;
+}
+
+bool IslScheduleOptimizer::runOnScop(Scop &S) {
+  // Skip SCoPs in case they're already optimised by PPCGCodeGeneration
+  if (S.isToBeSkipped())
+    return false;
+
+  isl_schedule_free(LastSchedule);
+  LastSchedule = nullptr;
+
+  auto GetDeps = [this]() -> const Dependences & {
+    return getAnalysis<DependenceInfo>().getDependences(
+        Dependences::AL_Statement);
+  };
+  Function &F = S.getFunction();
+  auto *TTI = &getAnalysis<TargetTransformInfoWrapperPass>().getTTI(F);
+  runIslScheduleOptimizer(S, GetDeps, TTI);
   return false;
 }
 
+PreservedAnalyses IslScheduleOptimizerPass::run(Scop &S,
+                                                ScopAnalysisManager &SAM,
+                                                ScopStandardAnalysisResults &AR,
+                                                SPMUpdater &U) {
+  // Skip SCoPs in case they're already optimised by PPCGCodeGeneration
+  if (S.isToBeSkipped())
+    return PreservedAnalyses::all();
+
+  auto GetDeps = [&]() -> const Dependences & {
+    return SAM.getResult<DependenceAnalysis>(S, AR).getDependences(
+        Dependences::AL_Statement);
+  };
+  if (!runIslScheduleOptimizer(S, GetDeps, &AR.TTI))
+    return PreservedAnalyses::all();
+
+  // The dependences are expressed on the statement instances and do not
+  // change with the schedule; only the AST must be built anew.
+  PreservedAnalyses PA = PreservedAnalyses::all();
+  PA.abandon<IslAstAnalysis>();
+  return PA;
+}
+
 void IslScheduleOptimizer::printScop(raw_ostream &OS, Scop &) const {
   isl_printer *p;
   char *ScheduleStr;
@@ -624,6 +624,15 @@ public:
   }
 
   virtual bool runOnScop(Scop &S) override {
+    simplifyScop(S, &getAnalysis<LoopInfoWrapperPass>().getLoopInfo());
+    return false;
+  }
+
+  /// Simplify @p S, using @p LI to determine which instructions are used
+  /// outside of the SCoP.
+  ///
+  /// @return Whether @p S was modified.
+  bool simplifyScop(Scop &S, LoopInfo *LI) {
     // Reset statistics of last processed SCoP.
     releaseMemory();
     assert(!isModified());
@@ -645,7 +654,6 @@ public:
     removeRedundantWrites();
 
     LLVM_DEBUG(dbgs() << "Cleanup unused accesses...\n");
-    LoopInfo *LI = &getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
     markAndSweep(LI);
 
     LLVM_DEBUG(dbgs() << "Removing statements without side effects...\n");
@@ -663,8 +671,7 @@ public:
     NumPHIWritesInLoops[CallNo] += ScopStats.NumPHIWritesInLoops;
     NumSingletonWrites[CallNo] += ScopStats.NumSingletonWrites;
     NumSingletonWritesInLoops[CallNo] += ScopStats.NumSingletonWritesInLoops;
-
-    return false;
+    return isModified();
   }
 
   virtual void printScop(raw_ostream &OS, Scop &S) const override {
@@ -695,6 +702,19 @@ public:
 char Simplify::ID;
 } // anonymous namespace
 
+bool polly::runSimplify(Scop &S, LoopInfo &LI, int CallNo) {
+  Simplify Impl(CallNo);
+  return Impl.simplifyScop(S, &LI);
+}
+
+PreservedAnalyses SimplifyPass::run(Scop &S, ScopAnalysisManager &SAM,
+                                    ScopStandardAnalysisResults &AR,
+                                    SPMUpdater &U) {
+  if (!runSimplify(S, AR.LI, CallNo))
+    return PreservedAnalyses::all();
+  return getScopPassPreservedAnalyses();
+}
+
 namespace polly {
 SmallVector<MemoryAccess *, 32> getAccessesInOrder(ScopStmt &Stmt) {
 
@@ -0,0 +1,130 @@
+; Medium: two chained matrix multiplications.
+;
+;    void f(long n, double *restrict A, double *restrict B, double *restrict C,
+;           double *restrict D, double *restrict T) {
+;      for (long i = 0; i < n; i++)
+;        for (long j = 0; j < n; j++)
+;          for (long k = 0; k < n; k++)
+;            T[i * n + j] += A[i * n + k] * B[k * n + j];
+;      for (long i = 0; i < n; i++)
+;        for (long j = 0; j < n; j++)
+;          for (long k = 0; k < n; k++)
+;            D[i * n + j] += T[i * n + k] * C[k * n + j];
+;    }
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(i64 %n, double* noalias %A, double* noalias %B, double* noalias %C, double* noalias %D, double* noalias %T) {
+entry:
+  br label %mm1.l0
+
+mm1.l0:
+  %mm1.i0 = phi i64 [ 0, %entry ], [ %mm1.i0.next, %mm1.l0.inc ]
+  %mm1.i0.cmp = icmp slt i64 %mm1.i0, %n
+  br i1 %mm1.i0.cmp, label %mm1.l0.body, label %mm1.exit
+
+mm1.l0.body:
+  br label %mm1.l1
+
+mm1.l1:
+  %mm1.i1 = phi i64 [ 0, %mm1.l0.body ], [ %mm1.i1.next, %mm1.l1.inc ]
+  %mm1.i1.cmp = icmp slt i64 %mm1.i1, %n
+  br i1 %mm1.i1.cmp, label %mm1.l1.body, label %mm1.l0.inc
+
+mm1.l1.body:
+  br label %mm1.l2
+
+mm1.l2:
+  %mm1.i2 = phi i64 [ 0, %mm1.l1.body ], [ %mm1.i2.next, %mm1.l2.inc ]
+  %mm1.i2.cmp = icmp slt i64 %mm1.i2, %n
+  br i1 %mm1.i2.cmp, label %mm1.l2.body, label %mm1.l1.inc
+
+mm1.l2.body:
+  %x1 = mul nsw i64 %mm1.i0, %n
+  %x2 = add nsw i64 %x1, %mm1.i2
+  %gep3 = getelementptr inbounds double, double* %A, i64 %x2
+  %ld4 = load double, double* %gep3
+  %x5 = mul nsw i64 %mm1.i2, %n
+  %x6 = add nsw i64 %x5, %mm1.i1
+  %gep7 = getelementptr inbounds double, double* %B, i64 %x6
+  %ld8 = load double, double* %gep7
+  %x9 = mul nsw i64 %mm1.i0, %n
+  %x10 = add nsw i64 %x9, %mm1.i1
+  %gep11 = getelementptr inbounds double, double* %T, i64 %x10
+  %ld12 = load double, double* %gep11
+  %f13 = fmul double %ld4, %ld8
+  %f14 = fadd double %ld12, %f13
+  %gep15 = getelementptr inbounds double, double* %T, i64 %x10
+  store double %f14, double* %gep15
+  br label %mm1.l2.inc
+
+mm1.l2.inc:
+  %mm1.i2.next = add nuw nsw i64 %mm1.i2, 1
+  br label %mm1.l2
+
+mm1.l1.inc:
+  %mm1.i1.next = add nuw nsw i64 %mm1.i1, 1
+  br label %mm1.l1
+
+mm1.l0.inc:
+  %mm1.i0.next = add nuw nsw i64 %mm1.i0, 1
+  br label %mm1.l0
+
+mm1.exit:
+  br label %mm2.l0
+
+mm2.l0:
+  %mm2.i0 = phi i64 [ 0, %mm1.exit ], [ %mm2.i0.next, %mm2.l0.inc ]
+  %mm2.i0.cmp = icmp slt i64 %mm2.i0, %n
+  br i1 %mm2.i0.cmp, label %mm2.l0.body, label %mm2.exit
+
+mm2.l0.body:
+  br label %mm2.l1
+
+mm2.l1:
+  %mm2.i1 = phi i64 [ 0, %mm2.l0.body ], [ %mm2.i1.next, %mm2.l1.inc ]
+  %mm2.i1.cmp = icmp slt i64 %mm2.i1, %n
+  br i1 %mm2.i1.cmp, label %mm2.l1.body, label %mm2.l0.inc
+
+mm2.l1.body:
+  br label %mm2.l2
+
+mm2.l2:
+  %mm2.i2 = phi i64 [ 0, %mm2.l1.body ], [ %mm2.i2.next, %mm2.l2.inc ]
+  %mm2.i2.cmp = icmp slt i64 %mm2.i2, %n
+  br i1 %mm2.i2.cmp, label %mm2.l2.body, label %mm2.l1.inc
+
+mm2.l2.body:
+  %x16 = mul nsw i64 %mm2.i0, %n
+  %x17 = add nsw i64 %x16, %mm2.i2
+  %gep18 = getelementptr inbounds double, double* %T, i64 %x17
+  %ld19 = load double, double* %gep18
+  %x20 = mul nsw i64 %mm2.i2, %n
+  %x21 = add nsw i64 %x20, %mm2.i1
+  %gep22 = getelementptr inbounds double, double* %C, i64 %x21
+  %ld23 = load double, double* %gep22
+  %x24 = mul nsw i64 %mm2.i0, %n
+  %x25 = add nsw i64 %x24, %mm2.i1
+  %gep26 = getelementptr inbounds double, double* %D, i64 %x25
+  %ld27 = load double, double* %gep26
+  %f28 = fmul double %ld19, %ld23
+  %f29 = fadd double %ld27, %f28
+  %gep30 = getelementptr inbounds double, double* %D, i64 %x25
+  store double %f29, double* %gep30
+  br label %mm2.l2.inc
+
+mm2.l2.inc:
+  %mm2.i2.next = add nuw nsw i64 %mm2.i2, 1
+  br label %mm2.l2
+
+mm2.l1.inc:
+  %mm2.i1.next = add nuw nsw i64 %mm2.i1, 1
+  br label %mm2.l1
+
+mm2.l0.inc:
+  %mm2.i0.next = add nuw nsw i64 %mm2.i0, 1
+  br label %mm2.l0
+
+mm2.exit:
+  ret void
+}
@@ -0,0 +1,86 @@
+; Medium: five-point stencil inside a time loop.
+;
+;    void f(long tsteps, long n, double *restrict A, double *restrict B) {
+;      for (long t = 0; t < tsteps; t++)
+;        for (long i = 0; i < n - 2; i++)
+;          for (long j = 0; j < n - 2; j++)
+;            B[(i + 1) * n + j + 1] = 0.2 * (A[(i + 1) * n + j + 1] +
+;                A[(i + 1) * n + j] + A[(i + 1) * n + j + 2] +
+;                A[i * n + j + 1] + A[(i + 2) * n + j + 1]);
+;    }
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(i64 %tsteps, i64 %n, double* noalias %A, double* noalias %B) {
+entry:
+  %m = add nsw i64 %n, -2
+  br label %jac.l0
+
+jac.l0:
+  %jac.i0 = phi i64 [ 0, %entry ], [ %jac.i0.next, %jac.l0.inc ]
+  %jac.i0.cmp = icmp slt i64 %jac.i0, %tsteps
+  br i1 %jac.i0.cmp, label %jac.l0.body, label %jac.exit
+
+jac.l0.body:
+  br label %jac.l1
+
+jac.l1:
+  %jac.i1 = phi i64 [ 0, %jac.l0.body ], [ %jac.i1.next, %jac.l1.inc ]
+  %jac.i1.cmp = icmp slt i64 %jac.i1, %m
+  br i1 %jac.i1.cmp, label %jac.l1.body, label %jac.l0.inc
+
+jac.l1.body:
+  br label %jac.l2
+
+jac.l2:
+  %jac.i2 = phi i64 [ 0, %jac.l1.body ], [ %jac.i2.next, %jac.l2.inc ]
+  %jac.i2.cmp = icmp slt i64 %jac.i2, %m
+  br i1 %jac.i2.cmp, label %jac.l2.body, label %jac.l1.inc
+
+jac.l2.body:
+  %a1 = add nsw i64 %jac.i1, 1
+  %a2 = add nsw i64 %jac.i2, 1
+  %x3 = mul nsw i64 %a1, %n
+  %x4 = add nsw i64 %x3, %a2
+  %gep5 = getelementptr inbounds double, double* %A, i64 %x4
+  %ld6 = load double, double* %gep5
+  %x7 = mul nsw i64 %a1, %n
+  %x8 = add nsw i64 %x7, %a2
+  %x9 = add nsw i64 %x8, -1
+  %gep10 = getelementptr inbounds double, double* %A, i64 %x9
+  %ld11 = load double, double* %gep10
+  %f12 = fadd double %ld6, %ld11
+  %x13 = mul nsw i64 %a1, %n
+  %x14 = add nsw i64 %x13, %a2
+  %x15 = add nsw i64 %x14, 1
+  %gep16 = getelementptr inbounds double, double* %A, i64 %x15
+  %ld17 = load double, double* %gep16
+  %f18 = fadd double %f12, %ld17
+  %x19 = sub nsw i64 %x4, %n
+  %gep20 = getelementptr inbounds double, double* %A, i64 %x19
+  %ld21 = load double, double* %gep20
+  %f22 = fadd double %f18, %ld21
+  %x23 = add nsw i64 %x4, %n
+  %gep24 = getelementptr inbounds double, double* %A, i64 %x23
+  %ld25 = load double, double* %gep24
+  %f26 = fadd double %f22, %ld25
+  %f27 = fmul double %f26, 2.000000e-01
+  %gep28 = getelementptr inbounds double, double* %B, i64 %x4
+  store double %f27, double* %gep28
+  br label %jac.l2.inc
+
+jac.l2.inc:
+  %jac.i2.next = add nuw nsw i64 %jac.i2, 1
+  br label %jac.l2
+
+jac.l1.inc:
+  %jac.i1.next = add nuw nsw i64 %jac.i1, 1
+  br label %jac.l1
+
+jac.l0.inc:
+  %jac.i0.next = add nuw nsw i64 %jac.i0, 1
+  br label %jac.l0
+
+jac.exit:
+  ret void
+}
@@ -0,0 +1,143 @@
+; Pathological: a loop nest of depth 8 with parametric bounds and skewed
+; accesses. Stresses the scheduler and the AST generation.
+;
+;    void f(long n0, ..., long n7, double *restrict A, double *restrict B) {
+;      for (long i0 = 0; i0 < n0; i0++)
+;        ...
+;          for (long i7 = 0; i7 < n7; i7++)
+;            A[i0 + ... + i7] += B[i0 + 2 * i1 + ... + 8 * i7];
+;    }
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(i64 %n0, i64 %n1, i64 %n2, i64 %n3, i64 %n4, i64 %n5, i64 %n6, i64 %n7, double* noalias %A, double* noalias %B) {
+entry:
+  br label %deep.l0
+
+deep.l0:
+  %deep.i0 = phi i64 [ 0, %entry ], [ %deep.i0.next, %deep.l0.inc ]
+  %deep.i0.cmp = icmp slt i64 %deep.i0, %n0
+  br i1 %deep.i0.cmp, label %deep.l0.body, label %deep.exit
+
+deep.l0.body:
+  br label %deep.l1
+
+deep.l1:
+  %deep.i1 = phi i64 [ 0, %deep.l0.body ], [ %deep.i1.next, %deep.l1.inc ]
+  %deep.i1.cmp = icmp slt i64 %deep.i1, %n1
+  br i1 %deep.i1.cmp, label %deep.l1.body, label %deep.l0.inc
+
+deep.l1.body:
+  br label %deep.l2
+
+deep.l2:
+  %deep.i2 = phi i64 [ 0, %deep.l1.body ], [ %deep.i2.next, %deep.l2.inc ]
+  %deep.i2.cmp = icmp slt i64 %deep.i2, %n2
+  br i1 %deep.i2.cmp, label %deep.l2.body, label %deep.l1.inc
+
+deep.l2.body:
+  br label %deep.l3
+
+deep.l3:
+  %deep.i3 = phi i64 [ 0, %deep.l2.body ], [ %deep.i3.next, %deep.l3.inc ]
+  %deep.i3.cmp = icmp slt i64 %deep.i3, %n3
+  br i1 %deep.i3.cmp, label %deep.l3.body, label %deep.l2.inc
+
+deep.l3.body:
+  br label %deep.l4
+
+deep.l4:
+  %deep.i4 = phi i64 [ 0, %deep.l3.body ], [ %deep.i4.next, %deep.l4.inc ]
+  %deep.i4.cmp = icmp slt i64 %deep.i4, %n4
+  br i1 %deep.i4.cmp, label %deep.l4.body, label %deep.l3.inc
+
+deep.l4.body:
+  br label %deep.l5
+
+deep.l5:
+  %deep.i5 = phi i64 [ 0, %deep.l4.body ], [ %deep.i5.next, %deep.l5.inc ]
+  %deep.i5.cmp = icmp slt i64 %deep.i5, %n5
+  br i1 %deep.i5.cmp, label %deep.l5.body, label %deep.l4.inc
+
+deep.l5.body:
+  br label %deep.l6
+
+deep.l6:
+  %deep.i6 = phi i64 [ 0, %deep.l5.body ], [ %deep.i6.next, %deep.l6.inc ]
+  %deep.i6.cmp = icmp slt i64 %deep.i6, %n6
+  br i1 %deep.i6.cmp, label %deep.l6.body, label %deep.l5.inc
+
+deep.l6.body:
+  br label %deep.l7
+
+deep.l7:
+  %deep.i7 = phi i64 [ 0, %deep.l6.body ], [ %deep.i7.next, %deep.l7.inc ]
+  %deep.i7.cmp = icmp slt i64 %deep.i7, %n7
+  br i1 %deep.i7.cmp, label %deep.l7.body, label %deep.l6.inc
+
+deep.l7.body:
+  %a1 = add nsw i64 %deep.i0, %deep.i1
+  %a2 = add nsw i64 %a1, %deep.i2
+  %a3 = add nsw i64 %a2, %deep.i3
+  %a4 = add nsw i64 %a3, %deep.i4
+  %a5 = add nsw i64 %a4, %deep.i5
+  %a6 = add nsw i64 %a5, %deep.i6
+  %a7 = add nsw i64 %a6, %deep.i7
+  %m8 = mul nsw i64 %deep.i1, 2
+  %a9 = add nsw i64 %deep.i0, %m8
+  %m10 = mul nsw i64 %deep.i2, 3
+  %a11 = add nsw i64 %a9, %m10
+  %m12 = mul nsw i64 %deep.i3, 4
+  %a13 = add nsw i64 %a11, %m12
+  %m14 = mul nsw i64 %deep.i4, 5
+  %a15 = add nsw i64 %a13, %m14
+  %m16 = mul nsw i64 %deep.i5, 6
+  %a17 = add nsw i64 %a15, %m16
+  %m18 = mul nsw i64 %deep.i6, 7
+  %a19 = add nsw i64 %a17, %m18
+  %m20 = mul nsw i64 %deep.i7, 8
+  %a21 = add nsw i64 %a19, %m20
+  %gep22 = getelementptr inbounds double, double* %A, i64 %a7
+  %ld23 = load double, double* %gep22
+  %gep24 = getelementptr inbounds double, double* %B, i64 %a21
+  %ld25 = load double, double* %gep24
+  %f26 = fadd double %ld23, %ld25
+  %gep27 = getelementptr inbounds double, double* %A, i64 %a7
+  store double %f26, double* %gep27
+  br label %deep.l7.inc
+
+deep.l7.inc:
+  %deep.i7.next = add nuw nsw i64 %deep.i7, 1
+  br label %deep.l7
+
+deep.l6.inc:
+  %deep.i6.next = add nuw nsw i64 %deep.i6, 1
+  br label %deep.l6
+
+deep.l5.inc:
+  %deep.i5.next = add nuw nsw i64 %deep.i5, 1
+  br label %deep.l5
+
+deep.l4.inc:
+  %deep.i4.next = add nuw nsw i64 %deep.i4, 1
+  br label %deep.l4
+
+deep.l3.inc:
+  %deep.i3.next = add nuw nsw i64 %deep.i3, 1
+  br label %deep.l3
+
+deep.l2.inc:
+  %deep.i2.next = add nuw nsw i64 %deep.i2, 1
+  br label %deep.l2
+
+deep.l1.inc:
+  %deep.i1.next = add nuw nsw i64 %deep.i1, 1
+  br label %deep.l1
+
+deep.l0.inc:
+  %deep.i0.next = add nuw nsw i64 %deep.i0, 1
+  br label %deep.l0
+
+deep.exit:
+  ret void
+}
@@ -0,0 +1,88 @@
+; Pathological: 16 arrays that may alias each other. Stresses the alias
+; groups and the run-time alias checks (Scop::buildAliasGroups).
+;
+;    void f(long n, double *A0, ..., double *A15) {
+;      for (long i = 0; i < n; i++) {
+;        A1[i] = A0[i] + A3[i];
+;        A3[i] = A2[i] + A5[i];
+;        ...
+;      }
+;    }
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(i64 %n, double* %A0, double* %A1, double* %A2, double* %A3, double* %A4, double* %A5, double* %A6, double* %A7, double* %A8, double* %A9, double* %A10, double* %A11, double* %A12, double* %A13, double* %A14, double* %A15) {
+entry:
+  br label %arr.l0
+
+arr.l0:
+  %arr.i0 = phi i64 [ 0, %entry ], [ %arr.i0.next, %arr.l0.inc ]
+  %arr.i0.cmp = icmp slt i64 %arr.i0, %n
+  br i1 %arr.i0.cmp, label %arr.l0.body, label %arr.exit
+
+arr.l0.body:
+  %gep1 = getelementptr inbounds double, double* %A0, i64 %arr.i0
+  %ld2 = load double, double* %gep1
+  %gep3 = getelementptr inbounds double, double* %A3, i64 %arr.i0
+  %ld4 = load double, double* %gep3
+  %f5 = fadd double %ld2, %ld4
+  %gep6 = getelementptr inbounds double, double* %A1, i64 %arr.i0
+  store double %f5, double* %gep6
+  %gep7 = getelementptr inbounds double, double* %A2, i64 %arr.i0
+  %ld8 = load double, double* %gep7
+  %gep9 = getelementptr inbounds double, double* %A5, i64 %arr.i0
+  %ld10 = load double, double* %gep9
+  %f11 = fadd double %ld8, %ld10
+  %gep12 = getelementptr inbounds double, double* %A3, i64 %arr.i0
+  store double %f11, double* %gep12
+  %gep13 = getelementptr inbounds double, double* %A4, i64 %arr.i0
+  %ld14 = load double, double* %gep13
+  %gep15 = getelementptr inbounds double, double* %A7, i64 %arr.i0
+  %ld16 = load double, double* %gep15
+  %f17 = fadd double %ld14, %ld16
+  %gep18 = getelementptr inbounds double, double* %A5, i64 %arr.i0
+  store double %f17, double* %gep18
+  %gep19 = getelementptr inbounds double, double* %A6, i64 %arr.i0
+  %ld20 = load double, double* %gep19
+  %gep21 = getelementptr inbounds double, double* %A9, i64 %arr.i0
+  %ld22 = load double, double* %gep21
+  %f23 = fadd double %ld20, %ld22
+  %gep24 = getelementptr inbounds double, double* %A7, i64 %arr.i0
+  store double %f23, double* %gep24
+  %gep25 = getelementptr inbounds double, double* %A8, i64 %arr.i0
+  %ld26 = load double, double* %gep25
+  %gep27 = getelementptr inbounds double, double* %A11, i64 %arr.i0
+  %ld28 = load double, double* %gep27
+  %f29 = fadd double %ld26, %ld28
+  %gep30 = getelementptr inbounds double, double* %A9, i64 %arr.i0
+  store double %f29, double* %gep30
+  %gep31 = getelementptr inbounds double, double* %A10, i64 %arr.i0
+  %ld32 = load double, double* %gep31
+  %gep33 = getelementptr inbounds double, double* %A13, i64 %arr.i0
+  %ld34 = load double, double* %gep33
+  %f35 = fadd double %ld32, %ld34
+  %gep36 = getelementptr inbounds double, double* %A11, i64 %arr.i0
+  store double %f35, double* %gep36
+  %gep37 = getelementptr inbounds double, double* %A12, i64 %arr.i0
+  %ld38 = load double, double* %gep37
+  %gep39 = getelementptr inbounds double, double* %A15, i64 %arr.i0
+  %ld40 = load double, double* %gep39
+  %f41 = fadd double %ld38, %ld40
+  %gep42 = getelementptr inbounds double, double* %A13, i64 %arr.i0
+  store double %f41, double* %gep42
+  %gep43 = getelementptr inbounds double, double* %A14, i64 %arr.i0
+  %ld44 = load double, double* %gep43
+  %gep45 = getelementptr inbounds double, double* %A1, i64 %arr.i0
+  %ld46 = load double, double* %gep45
+  %f47 = fadd double %ld44, %ld46
+  %gep48 = getelementptr inbounds double, double* %A15, i64 %arr.i0
+  store double %f47, double* %gep48
+  br label %arr.l0.inc
+
+arr.l0.inc:
+  %arr.i0.next = add nuw nsw i64 %arr.i0, 1
+  br label %arr.l0
+
+arr.exit:
+  ret void
+}
@@ -0,0 +1,182 @@
+; Pathological: accesses with 24 parameter offsets. Stresses the context,
+; the assumptions and the run-time checks, which are all parametric.
+;
+;    void f(long n, long p0, ..., long p23, long q0, ..., long q3,
+;           double *restrict A, double *restrict B) {
+;      for (long s = 0; s < 4; s++)
+;        for (long i = 0; i < n; i++)
+;          B[i + q[s]] = A[i + p[6 * s]] + ... + A[i + p[6 * s + 5]];
+;    }
+;
+; with the outer loop over s unrolled.
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(i64 %n, i64 %p0, i64 %p1, i64 %p2, i64 %p3, i64 %p4, i64 %p5, i64 %p6, i64 %p7, i64 %p8, i64 %p9, i64 %p10, i64 %p11, i64 %p12, i64 %p13, i64 %p14, i64 %p15, i64 %p16, i64 %p17, i64 %p18, i64 %p19, i64 %p20, i64 %p21, i64 %p22, i64 %p23, i64 %q0, i64 %q1, i64 %q2, i64 %q3, double* noalias %A, double* noalias %B) {
+entry:
+  br label %s0.l0
+
+s0.l0:
+  %s0.i0 = phi i64 [ 0, %entry ], [ %s0.i0.next, %s0.l0.inc ]
+  %s0.i0.cmp = icmp slt i64 %s0.i0, %n
+  br i1 %s0.i0.cmp, label %s0.l0.body, label %s0.exit
+
+s0.l0.body:
+  %a1 = add nsw i64 %s0.i0, %p0
+  %gep2 = getelementptr inbounds double, double* %A, i64 %a1
+  %ld3 = load double, double* %gep2
+  %a4 = add nsw i64 %s0.i0, %p1
+  %gep5 = getelementptr inbounds double, double* %A, i64 %a4
+  %ld6 = load double, double* %gep5
+  %f7 = fadd double %ld3, %ld6
+  %a8 = add nsw i64 %s0.i0, %p2
+  %gep9 = getelementptr inbounds double, double* %A, i64 %a8
+  %ld10 = load double, double* %gep9
+  %f11 = fadd double %f7, %ld10
+  %a12 = add nsw i64 %s0.i0, %p3
+  %gep13 = getelementptr inbounds double, double* %A, i64 %a12
+  %ld14 = load double, double* %gep13
+  %f15 = fadd double %f11, %ld14
+  %a16 = add nsw i64 %s0.i0, %p4
+  %gep17 = getelementptr inbounds double, double* %A, i64 %a16
+  %ld18 = load double, double* %gep17
+  %f19 = fadd double %f15, %ld18
+  %a20 = add nsw i64 %s0.i0, %p5
+  %gep21 = getelementptr inbounds double, double* %A, i64 %a20
+  %ld22 = load double, double* %gep21
+  %f23 = fadd double %f19, %ld22
+  %a24 = add nsw i64 %s0.i0, %q0
+  %gep25 = getelementptr inbounds double, double* %B, i64 %a24
+  store double %f23, double* %gep25
+  br label %s0.l0.inc
+
+s0.l0.inc:
+  %s0.i0.next = add nuw nsw i64 %s0.i0, 1
+  br label %s0.l0
+
+s0.exit:
+  br label %s1.l0
+
+s1.l0:
+  %s1.i0 = phi i64 [ 0, %s0.exit ], [ %s1.i0.next, %s1.l0.inc ]
+  %s1.i0.cmp = icmp slt i64 %s1.i0, %n
+  br i1 %s1.i0.cmp, label %s1.l0.body, label %s1.exit
+
+s1.l0.body:
+  %a26 = add nsw i64 %s1.i0, %p6
+  %gep27 = getelementptr inbounds double, double* %A, i64 %a26
+  %ld28 = load double, double* %gep27
+  %a29 = add nsw i64 %s1.i0, %p7
+  %gep30 = getelementptr inbounds double, double* %A, i64 %a29
+  %ld31 = load double, double* %gep30
+  %f32 = fadd double %ld28, %ld31
+  %a33 = add nsw i64 %s1.i0, %p8
+  %gep34 = getelementptr inbounds double, double* %A, i64 %a33
+  %ld35 = load double, double* %gep34
+  %f36 = fadd double %f32, %ld35
+  %a37 = add nsw i64 %s1.i0, %p9
+  %gep38 = getelementptr inbounds double, double* %A, i64 %a37
+  %ld39 = load double, double* %gep38
+  %f40 = fadd double %f36, %ld39
+  %a41 = add nsw i64 %s1.i0, %p10
+  %gep42 = getelementptr inbounds double, double* %A, i64 %a41
+  %ld43 = load double, double* %gep42
+  %f44 = fadd double %f40, %ld43
+  %a45 = add nsw i64 %s1.i0, %p11
+  %gep46 = getelementptr inbounds double, double* %A, i64 %a45
+  %ld47 = load double, double* %gep46
+  %f48 = fadd double %f44, %ld47
+  %a49 = add nsw i64 %s1.i0, %q1
+  %gep50 = getelementptr inbounds double, double* %B, i64 %a49
+  store double %f48, double* %gep50
+  br label %s1.l0.inc
+
+s1.l0.inc:
+  %s1.i0.next = add nuw nsw i64 %s1.i0, 1
+  br label %s1.l0
+
+s1.exit:
+  br label %s2.l0
+
+s2.l0:
+  %s2.i0 = phi i64 [ 0, %s1.exit ], [ %s2.i0.next, %s2.l0.inc ]
+  %s2.i0.cmp = icmp slt i64 %s2.i0, %n
+  br i1 %s2.i0.cmp, label %s2.l0.body, label %s2.exit
+
+s2.l0.body:
+  %a51 = add nsw i64 %s2.i0, %p12
+  %gep52 = getelementptr inbounds double, double* %A, i64 %a51
+  %ld53 = load double, double* %gep52
+  %a54 = add nsw i64 %s2.i0, %p13
+  %gep55 = getelementptr inbounds double, double* %A, i64 %a54
+  %ld56 = load double, double* %gep55
+  %f57 = fadd double %ld53, %ld56
+  %a58 = add nsw i64 %s2.i0, %p14
+  %gep59 = getelementptr inbounds double, double* %A, i64 %a58
+  %ld60 = load double, double* %gep59
+  %f61 = fadd double %f57, %ld60
+  %a62 = add nsw i64 %s2.i0, %p15
+  %gep63 = getelementptr inbounds double, double* %A, i64 %a62
+  %ld64 = load double, double* %gep63
+  %f65 = fadd double %f61, %ld64
+  %a66 = add nsw i64 %s2.i0, %p16
+  %gep67 = getelementptr inbounds double, double* %A, i64 %a66
+  %ld68 = load double, double* %gep67
+  %f69 = fadd double %f65, %ld68
+  %a70 = add nsw i64 %s2.i0, %p17
+  %gep71 = getelementptr inbounds double, double* %A, i64 %a70
+  %ld72 = load double, double* %gep71
+  %f73 = fadd double %f69, %ld72
+  %a74 = add nsw i64 %s2.i0, %q2
+  %gep75 = getelementptr inbounds double, double* %B, i64 %a74
+  store double %f73, double* %gep75
+  br label %s2.l0.inc
+
+s2.l0.inc:
+  %s2.i0.next = add nuw nsw i64 %s2.i0, 1
+  br label %s2.l0
+
+s2.exit:
+  br label %s3.l0
+
+s3.l0:
+  %s3.i0 = phi i64 [ 0, %s2.exit ], [ %s3.i0.next, %s3.l0.inc ]
+  %s3.i0.cmp = icmp slt i64 %s3.i0, %n
+  br i1 %s3.i0.cmp, label %s3.l0.body, label %s3.exit
+
+s3.l0.body:
+  %a76 = add nsw i64 %s3.i0, %p18
+  %gep77 = getelementptr inbounds double, double* %A, i64 %a76
+  %ld78 = load double, double* %gep77
+  %a79 = add nsw i64 %s3.i0, %p19
+  %gep80 = getelementptr inbounds double, double* %A, i64 %a79
+  %ld81 = load double, double* %gep80
+  %f82 = fadd double %ld78, %ld81
+  %a83 = add nsw i64 %s3.i0, %p20
+  %gep84 = getelementptr inbounds double, double* %A, i64 %a83
+  %ld85 = load double, double* %gep84
+  %f86 = fadd double %f82, %ld85
+  %a87 = add nsw i64 %s3.i0, %p21
+  %gep88 = getelementptr inbounds double, double* %A, i64 %a87
+  %ld89 = load double, double* %gep88
+  %f90 = fadd double %f86, %ld89
+  %a91 = add nsw i64 %s3.i0, %p22
+  %gep92 = getelementptr inbounds double, double* %A, i64 %a91
+  %ld93 = load double, double* %gep92
+  %f94 = fadd double %f90, %ld93
+  %a95 = add nsw i64 %s3.i0, %p23
+  %gep96 = getelementptr inbounds double, double* %A, i64 %a95
+  %ld97 = load double, double* %gep96
+  %f98 = fadd double %f94, %ld97
+  %a99 = add nsw i64 %s3.i0, %q3
+  %gep100 = getelementptr inbounds double, double* %B, i64 %a99
+  store double %f98, double* %gep100
+  br label %s3.l0.inc
+
+s3.l0.inc:
+  %s3.i0.next = add nuw nsw i64 %s3.i0, 1
+  br label %s3.l0
+
+s3.exit:
+  ret void
+}
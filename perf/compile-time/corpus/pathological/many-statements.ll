@@ -0,0 +1,1491 @@
+; Pathological: 64 loops over eight arrays, each reading values written by
+; earlier loops. Stresses the dependence analysis and the scheduler.
+;
+;    void f(long n, double *restrict A0, ..., double *restrict A7) {
+;      for (long i = 0; i < n; i++)
+;        A0[i] = A7[i] + A3[i + 1];
+;      for (long i = 0; i < n; i++)
+;        A1[i] = A0[i] + A4[i + 1];
+;      ...
+;      for (long i = 0; i < n; i++)
+;        A[s % 8][i] = A[(s + 7) % 8][i] + A[(s + 3) % 8][i + 1];
+;    }
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(i64 %n, double* noalias %A0, double* noalias %A1, double* noalias %A2, double* noalias %A3, double* noalias %A4, double* noalias %A5, double* noalias %A6, double* noalias %A7) {
+entry:
+  br label %s0.l0
+
+s0.l0:
+  %s0.i0 = phi i64 [ 0, %entry ], [ %s0.i0.next, %s0.l0.inc ]
+  %s0.i0.cmp = icmp slt i64 %s0.i0, %n
+  br i1 %s0.i0.cmp, label %s0.l0.body, label %s0.exit
+
+s0.l0.body:
+  %gep1 = getelementptr inbounds double, double* %A7, i64 %s0.i0
+  %ld2 = load double, double* %gep1
+  %a3 = add nsw i64 %s0.i0, 1
+  %gep4 = getelementptr inbounds double, double* %A3, i64 %a3
+  %ld5 = load double, double* %gep4
+  %f6 = fadd double %ld2, %ld5
+  %gep7 = getelementptr inbounds double, double* %A0, i64 %s0.i0
+  store double %f6, double* %gep7
+  br label %s0.l0.inc
+
+s0.l0.inc:
+  %s0.i0.next = add nuw nsw i64 %s0.i0, 1
+  br label %s0.l0
+
+s0.exit:
+  br label %s1.l0
+
+s1.l0:
+  %s1.i0 = phi i64 [ 0, %s0.exit ], [ %s1.i0.next, %s1.l0.inc ]
+  %s1.i0.cmp = icmp slt i64 %s1.i0, %n
+  br i1 %s1.i0.cmp, label %s1.l0.body, label %s1.exit
+
+s1.l0.body:
+  %gep8 = getelementptr inbounds double, double* %A0, i64 %s1.i0
+  %ld9 = load double, double* %gep8
+  %a10 = add nsw i64 %s1.i0, 1
+  %gep11 = getelementptr inbounds double, double* %A4, i64 %a10
+  %ld12 = load double, double* %gep11
+  %f13 = fadd double %ld9, %ld12
+  %gep14 = getelementptr inbounds double, double* %A1, i64 %s1.i0
+  store double %f13, double* %gep14
+  br label %s1.l0.inc
+
+s1.l0.inc:
+  %s1.i0.next = add nuw nsw i64 %s1.i0, 1
+  br label %s1.l0
+
+s1.exit:
+  br label %s2.l0
+
+s2.l0:
+  %s2.i0 = phi i64 [ 0, %s1.exit ], [ %s2.i0.next, %s2.l0.inc ]
+  %s2.i0.cmp = icmp slt i64 %s2.i0, %n
+  br i1 %s2.i0.cmp, label %s2.l0.body, label %s2.exit
+
+s2.l0.body:
+  %gep15 = getelementptr inbounds double, double* %A1, i64 %s2.i0
+  %ld16 = load double, double* %gep15
+  %a17 = add nsw i64 %s2.i0, 1
+  %gep18 = getelementptr inbounds double, double* %A5, i64 %a17
+  %ld19 = load double, double* %gep18
+  %f20 = fadd double %ld16, %ld19
+  %gep21 = getelementptr inbounds double, double* %A2, i64 %s2.i0
+  store double %f20, double* %gep21
+  br label %s2.l0.inc
+
+s2.l0.inc:
+  %s2.i0.next = add nuw nsw i64 %s2.i0, 1
+  br label %s2.l0
+
+s2.exit:
+  br label %s3.l0
+
+s3.l0:
+  %s3.i0 = phi i64 [ 0, %s2.exit ], [ %s3.i0.next, %s3.l0.inc ]
+  %s3.i0.cmp = icmp slt i64 %s3.i0, %n
+  br i1 %s3.i0.cmp, label %s3.l0.body, label %s3.exit
+
+s3.l0.body:
+  %gep22 = getelementptr inbounds double, double* %A2, i64 %s3.i0
+  %ld23 = load double, double* %gep22
+  %a24 = add nsw i64 %s3.i0, 1
+  %gep25 = getelementptr inbounds double, double* %A6, i64 %a24
+  %ld26 = load double, double* %gep25
+  %f27 = fadd double %ld23, %ld26
+  %gep28 = getelementptr inbounds double, double* %A3, i64 %s3.i0
+  store double %f27, double* %gep28
+  br label %s3.l0.inc
+
+s3.l0.inc:
+  %s3.i0.next = add nuw nsw i64 %s3.i0, 1
+  br label %s3.l0
+
+s3.exit:
+  br label %s4.l0
+
+s4.l0:
+  %s4.i0 = phi i64 [ 0, %s3.exit ], [ %s4.i0.next, %s4.l0.inc ]
+  %s4.i0.cmp = icmp slt i64 %s4.i0, %n
+  br i1 %s4.i0.cmp, label %s4.l0.body, label %s4.exit
+
+s4.l0.body:
+  %gep29 = getelementptr inbounds double, double* %A3, i64 %s4.i0
+  %ld30 = load double, double* %gep29
+  %a31 = add nsw i64 %s4.i0, 1
+  %gep32 = getelementptr inbounds double, double* %A7, i64 %a31
+  %ld33 = load double, double* %gep32
+  %f34 = fadd double %ld30, %ld33
+  %gep35 = getelementptr inbounds double, double* %A4, i64 %s4.i0
+  store double %f34, double* %gep35
+  br label %s4.l0.inc
+
+s4.l0.inc:
+  %s4.i0.next = add nuw nsw i64 %s4.i0, 1
+  br label %s4.l0
+
+s4.exit:
+  br label %s5.l0
+
+s5.l0:
+  %s5.i0 = phi i64 [ 0, %s4.exit ], [ %s5.i0.next, %s5.l0.inc ]
+  %s5.i0.cmp = icmp slt i64 %s5.i0, %n
+  br i1 %s5.i0.cmp, label %s5.l0.body, label %s5.exit
+
+s5.l0.body:
+  %gep36 = getelementptr inbounds double, double* %A4, i64 %s5.i0
+  %ld37 = load double, double* %gep36
+  %a38 = add nsw i64 %s5.i0, 1
+  %gep39 = getelementptr inbounds double, double* %A0, i64 %a38
+  %ld40 = load double, double* %gep39
+  %f41 = fadd double %ld37, %ld40
+  %gep42 = getelementptr inbounds double, double* %A5, i64 %s5.i0
+  store double %f41, double* %gep42
+  br label %s5.l0.inc
+
+s5.l0.inc:
+  %s5.i0.next = add nuw nsw i64 %s5.i0, 1
+  br label %s5.l0
+
+s5.exit:
+  br label %s6.l0
+
+s6.l0:
+  %s6.i0 = phi i64 [ 0, %s5.exit ], [ %s6.i0.next, %s6.l0.inc ]
+  %s6.i0.cmp = icmp slt i64 %s6.i0, %n
+  br i1 %s6.i0.cmp, label %s6.l0.body, label %s6.exit
+
+s6.l0.body:
+  %gep43 = getelementptr inbounds double, double* %A5, i64 %s6.i0
+  %ld44 = load double, double* %gep43
+  %a45 = add nsw i64 %s6.i0, 1
+  %gep46 = getelementptr inbounds double, double* %A1, i64 %a45
+  %ld47 = load double, double* %gep46
+  %f48 = fadd double %ld44, %ld47
+  %gep49 = getelementptr inbounds double, double* %A6, i64 %s6.i0
+  store double %f48, double* %gep49
+  br label %s6.l0.inc
+
+s6.l0.inc:
+  %s6.i0.next = add nuw nsw i64 %s6.i0, 1
+  br label %s6.l0
+
+s6.exit:
+  br label %s7.l0
+
+s7.l0:
+  %s7.i0 = phi i64 [ 0, %s6.exit ], [ %s7.i0.next, %s7.l0.inc ]
+  %s7.i0.cmp = icmp slt i64 %s7.i0, %n
+  br i1 %s7.i0.cmp, label %s7.l0.body, label %s7.exit
+
+s7.l0.body:
+  %gep50 = getelementptr inbounds double, double* %A6, i64 %s7.i0
+  %ld51 = load double, double* %gep50
+  %a52 = add nsw i64 %s7.i0, 1
+  %gep53 = getelementptr inbounds double, double* %A2, i64 %a52
+  %ld54 = load double, double* %gep53
+  %f55 = fadd double %ld51, %ld54
+  %gep56 = getelementptr inbounds double, double* %A7, i64 %s7.i0
+  store double %f55, double* %gep56
+  br label %s7.l0.inc
+
+s7.l0.inc:
+  %s7.i0.next = add nuw nsw i64 %s7.i0, 1
+  br label %s7.l0
+
+s7.exit:
+  br label %s8.l0
+
+s8.l0:
+  %s8.i0 = phi i64 [ 0, %s7.exit ], [ %s8.i0.next, %s8.l0.inc ]
+  %s8.i0.cmp = icmp slt i64 %s8.i0, %n
+  br i1 %s8.i0.cmp, label %s8.l0.body, label %s8.exit
+
+s8.l0.body:
+  %gep57 = getelementptr inbounds double, double* %A7, i64 %s8.i0
+  %ld58 = load double, double* %gep57
+  %a59 = add nsw i64 %s8.i0, 1
+  %gep60 = getelementptr inbounds double, double* %A3, i64 %a59
+  %ld61 = load double, double* %gep60
+  %f62 = fadd double %ld58, %ld61
+  %gep63 = getelementptr inbounds double, double* %A0, i64 %s8.i0
+  store double %f62, double* %gep63
+  br label %s8.l0.inc
+
+s8.l0.inc:
+  %s8.i0.next = add nuw nsw i64 %s8.i0, 1
+  br label %s8.l0
+
+s8.exit:
+  br label %s9.l0
+
+s9.l0:
+  %s9.i0 = phi i64 [ 0, %s8.exit ], [ %s9.i0.next, %s9.l0.inc ]
+  %s9.i0.cmp = icmp slt i64 %s9.i0, %n
+  br i1 %s9.i0.cmp, label %s9.l0.body, label %s9.exit
+
+s9.l0.body:
+  %gep64 = getelementptr inbounds double, double* %A0, i64 %s9.i0
+  %ld65 = load double, double* %gep64
+  %a66 = add nsw i64 %s9.i0, 1
+  %gep67 = getelementptr inbounds double, double* %A4, i64 %a66
+  %ld68 = load double, double* %gep67
+  %f69 = fadd double %ld65, %ld68
+  %gep70 = getelementptr inbounds double, double* %A1, i64 %s9.i0
+  store double %f69, double* %gep70
+  br label %s9.l0.inc
+
+s9.l0.inc:
+  %s9.i0.next = add nuw nsw i64 %s9.i0, 1
+  br label %s9.l0
+
+s9.exit:
+  br label %s10.l0
+
+s10.l0:
+  %s10.i0 = phi i64 [ 0, %s9.exit ], [ %s10.i0.next, %s10.l0.inc ]
+  %s10.i0.cmp = icmp slt i64 %s10.i0, %n
+  br i1 %s10.i0.cmp, label %s10.l0.body, label %s10.exit
+
+s10.l0.body:
+  %gep71 = getelementptr inbounds double, double* %A1, i64 %s10.i0
+  %ld72 = load double, double* %gep71
+  %a73 = add nsw i64 %s10.i0, 1
+  %gep74 = getelementptr inbounds double, double* %A5, i64 %a73
+  %ld75 = load double, double* %gep74
+  %f76 = fadd double %ld72, %ld75
+  %gep77 = getelementptr inbounds double, double* %A2, i64 %s10.i0
+  store double %f76, double* %gep77
+  br label %s10.l0.inc
+
+s10.l0.inc:
+  %s10.i0.next = add nuw nsw i64 %s10.i0, 1
+  br label %s10.l0
+
+s10.exit:
+  br label %s11.l0
+
+s11.l0:
+  %s11.i0 = phi i64 [ 0, %s10.exit ], [ %s11.i0.next, %s11.l0.inc ]
+  %s11.i0.cmp = icmp slt i64 %s11.i0, %n
+  br i1 %s11.i0.cmp, label %s11.l0.body, label %s11.exit
+
+s11.l0.body:
+  %gep78 = getelementptr inbounds double, double* %A2, i64 %s11.i0
+  %ld79 = load double, double* %gep78
+  %a80 = add nsw i64 %s11.i0, 1
+  %gep81 = getelementptr inbounds double, double* %A6, i64 %a80
+  %ld82 = load double, double* %gep81
+  %f83 = fadd double %ld79, %ld82
+  %gep84 = getelementptr inbounds double, double* %A3, i64 %s11.i0
+  store double %f83, double* %gep84
+  br label %s11.l0.inc
+
+s11.l0.inc:
+  %s11.i0.next = add nuw nsw i64 %s11.i0, 1
+  br label %s11.l0
+
+s11.exit:
+  br label %s12.l0
+
+s12.l0:
+  %s12.i0 = phi i64 [ 0, %s11.exit ], [ %s12.i0.next, %s12.l0.inc ]
+  %s12.i0.cmp = icmp slt i64 %s12.i0, %n
+  br i1 %s12.i0.cmp, label %s12.l0.body, label %s12.exit
+
+s12.l0.body:
+  %gep85 = getelementptr inbounds double, double* %A3, i64 %s12.i0
+  %ld86 = load double, double* %gep85
+  %a87 = add nsw i64 %s12.i0, 1
+  %gep88 = getelementptr inbounds double, double* %A7, i64 %a87
+  %ld89 = load double, double* %gep88
+  %f90 = fadd double %ld86, %ld89
+  %gep91 = getelementptr inbounds double, double* %A4, i64 %s12.i0
+  store double %f90, double* %gep91
+  br label %s12.l0.inc
+
+s12.l0.inc:
+  %s12.i0.next = add nuw nsw i64 %s12.i0, 1
+  br label %s12.l0
+
+s12.exit:
+  br label %s13.l0
+
+s13.l0:
+  %s13.i0 = phi i64 [ 0, %s12.exit ], [ %s13.i0.next, %s13.l0.inc ]
+  %s13.i0.cmp = icmp slt i64 %s13.i0, %n
+  br i1 %s13.i0.cmp, label %s13.l0.body, label %s13.exit
+
+s13.l0.body:
+  %gep92 = getelementptr inbounds double, double* %A4, i64 %s13.i0
+  %ld93 = load double, double* %gep92
+  %a94 = add nsw i64 %s13.i0, 1
+  %gep95 = getelementptr inbounds double, double* %A0, i64 %a94
+  %ld96 = load double, double* %gep95
+  %f97 = fadd double %ld93, %ld96
+  %gep98 = getelementptr inbounds double, double* %A5, i64 %s13.i0
+  store double %f97, double* %gep98
+  br label %s13.l0.inc
+
+s13.l0.inc:
+  %s13.i0.next = add nuw nsw i64 %s13.i0, 1
+  br label %s13.l0
+
+s13.exit:
+  br label %s14.l0
+
+s14.l0:
+  %s14.i0 = phi i64 [ 0, %s13.exit ], [ %s14.i0.next, %s14.l0.inc ]
+  %s14.i0.cmp = icmp slt i64 %s14.i0, %n
+  br i1 %s14.i0.cmp, label %s14.l0.body, label %s14.exit
+
+s14.l0.body:
+  %gep99 = getelementptr inbounds double, double* %A5, i64 %s14.i0
+  %ld100 = load double, double* %gep99
+  %a101 = add nsw i64 %s14.i0, 1
+  %gep102 = getelementptr inbounds double, double* %A1, i64 %a101
+  %ld103 = load double, double* %gep102
+  %f104 = fadd double %ld100, %ld103
+  %gep105 = getelementptr inbounds double, double* %A6, i64 %s14.i0
+  store double %f104, double* %gep105
+  br label %s14.l0.inc
+
+s14.l0.inc:
+  %s14.i0.next = add nuw nsw i64 %s14.i0, 1
+  br label %s14.l0
+
+s14.exit:
+  br label %s15.l0
+
+s15.l0:
+  %s15.i0 = phi i64 [ 0, %s14.exit ], [ %s15.i0.next, %s15.l0.inc ]
+  %s15.i0.cmp = icmp slt i64 %s15.i0, %n
+  br i1 %s15.i0.cmp, label %s15.l0.body, label %s15.exit
+
+s15.l0.body:
+  %gep106 = getelementptr inbounds double, double* %A6, i64 %s15.i0
+  %ld107 = load double, double* %gep106
+  %a108 = add nsw i64 %s15.i0, 1
+  %gep109 = getelementptr inbounds double, double* %A2, i64 %a108
+  %ld110 = load double, double* %gep109
+  %f111 = fadd double %ld107, %ld110
+  %gep112 = getelementptr inbounds double, double* %A7, i64 %s15.i0
+  store double %f111, double* %gep112
+  br label %s15.l0.inc
+
+s15.l0.inc:
+  %s15.i0.next = add nuw nsw i64 %s15.i0, 1
+  br label %s15.l0
+
+s15.exit:
+  br label %s16.l0
+
+s16.l0:
+  %s16.i0 = phi i64 [ 0, %s15.exit ], [ %s16.i0.next, %s16.l0.inc ]
+  %s16.i0.cmp = icmp slt i64 %s16.i0, %n
+  br i1 %s16.i0.cmp, label %s16.l0.body, label %s16.exit
+
+s16.l0.body:
+  %gep113 = getelementptr inbounds double, double* %A7, i64 %s16.i0
+  %ld114 = load double, double* %gep113
+  %a115 = add nsw i64 %s16.i0, 1
+  %gep116 = getelementptr inbounds double, double* %A3, i64 %a115
+  %ld117 = load double, double* %gep116
+  %f118 = fadd double %ld114, %ld117
+  %gep119 = getelementptr inbounds double, double* %A0, i64 %s16.i0
+  store double %f118, double* %gep119
+  br label %s16.l0.inc
+
+s16.l0.inc:
+  %s16.i0.next = add nuw nsw i64 %s16.i0, 1
+  br label %s16.l0
+
+s16.exit:
+  br label %s17.l0
+
+s17.l0:
+  %s17.i0 = phi i64 [ 0, %s16.exit ], [ %s17.i0.next, %s17.l0.inc ]
+  %s17.i0.cmp = icmp slt i64 %s17.i0, %n
+  br i1 %s17.i0.cmp, label %s17.l0.body, label %s17.exit
+
+s17.l0.body:
+  %gep120 = getelementptr inbounds double, double* %A0, i64 %s17.i0
+  %ld121 = load double, double* %gep120
+  %a122 = add nsw i64 %s17.i0, 1
+  %gep123 = getelementptr inbounds double, double* %A4, i64 %a122
+  %ld124 = load double, double* %gep123
+  %f125 = fadd double %ld121, %ld124
+  %gep126 = getelementptr inbounds double, double* %A1, i64 %s17.i0
+  store double %f125, double* %gep126
+  br label %s17.l0.inc
+
+s17.l0.inc:
+  %s17.i0.next = add nuw nsw i64 %s17.i0, 1
+  br label %s17.l0
+
+s17.exit:
+  br label %s18.l0
+
+s18.l0:
+  %s18.i0 = phi i64 [ 0, %s17.exit ], [ %s18.i0.next, %s18.l0.inc ]
+  %s18.i0.cmp = icmp slt i64 %s18.i0, %n
+  br i1 %s18.i0.cmp, label %s18.l0.body, label %s18.exit
+
+s18.l0.body:
+  %gep127 = getelementptr inbounds double, double* %A1, i64 %s18.i0
+  %ld128 = load double, double* %gep127
+  %a129 = add nsw i64 %s18.i0, 1
+  %gep130 = getelementptr inbounds double, double* %A5, i64 %a129
+  %ld131 = load double, double* %gep130
+  %f132 = fadd double %ld128, %ld131
+  %gep133 = getelementptr inbounds double, double* %A2, i64 %s18.i0
+  store double %f132, double* %gep133
+  br label %s18.l0.inc
+
+s18.l0.inc:
+  %s18.i0.next = add nuw nsw i64 %s18.i0, 1
+  br label %s18.l0
+
+s18.exit:
+  br label %s19.l0
+
+s19.l0:
+  %s19.i0 = phi i64 [ 0, %s18.exit ], [ %s19.i0.next, %s19.l0.inc ]
+  %s19.i0.cmp = icmp slt i64 %s19.i0, %n
+  br i1 %s19.i0.cmp, label %s19.l0.body, label %s19.exit
+
+s19.l0.body:
+  %gep134 = getelementptr inbounds double, double* %A2, i64 %s19.i0
+  %ld135 = load double, double* %gep134
+  %a136 = add nsw i64 %s19.i0, 1
+  %gep137 = getelementptr inbounds double, double* %A6, i64 %a136
+  %ld138 = load double, double* %gep137
+  %f139 = fadd double %ld135, %ld138
+  %gep140 = getelementptr inbounds double, double* %A3, i64 %s19.i0
+  store double %f139, double* %gep140
+  br label %s19.l0.inc
+
+s19.l0.inc:
+  %s19.i0.next = add nuw nsw i64 %s19.i0, 1
+  br label %s19.l0
+
+s19.exit:
+  br label %s20.l0
+
+s20.l0:
+  %s20.i0 = phi i64 [ 0, %s19.exit ], [ %s20.i0.next, %s20.l0.inc ]
+  %s20.i0.cmp = icmp slt i64 %s20.i0, %n
+  br i1 %s20.i0.cmp, label %s20.l0.body, label %s20.exit
+
+s20.l0.body:
+  %gep141 = getelementptr inbounds double, double* %A3, i64 %s20.i0
+  %ld142 = load double, double* %gep141
+  %a143 = add nsw i64 %s20.i0, 1
+  %gep144 = getelementptr inbounds double, double* %A7, i64 %a143
+  %ld145 = load double, double* %gep144
+  %f146 = fadd double %ld142, %ld145
+  %gep147 = getelementptr inbounds double, double* %A4, i64 %s20.i0
+  store double %f146, double* %gep147
+  br label %s20.l0.inc
+
+s20.l0.inc:
+  %s20.i0.next = add nuw nsw i64 %s20.i0, 1
+  br label %s20.l0
+
+s20.exit:
+  br label %s21.l0
+
+s21.l0:
+  %s21.i0 = phi i64 [ 0, %s20.exit ], [ %s21.i0.next, %s21.l0.inc ]
+  %s21.i0.cmp = icmp slt i64 %s21.i0, %n
+  br i1 %s21.i0.cmp, label %s21.l0.body, label %s21.exit
+
+s21.l0.body:
+  %gep148 = getelementptr inbounds double, double* %A4, i64 %s21.i0
+  %ld149 = load double, double* %gep148
+  %a150 = add nsw i64 %s21.i0, 1
+  %gep151 = getelementptr inbounds double, double* %A0, i64 %a150
+  %ld152 = load double, double* %gep151
+  %f153 = fadd double %ld149, %ld152
+  %gep154 = getelementptr inbounds double, double* %A5, i64 %s21.i0
+  store double %f153, double* %gep154
+  br label %s21.l0.inc
+
+s21.l0.inc:
+  %s21.i0.next = add nuw nsw i64 %s21.i0, 1
+  br label %s21.l0
+
+s21.exit:
+  br label %s22.l0
+
+s22.l0:
+  %s22.i0 = phi i64 [ 0, %s21.exit ], [ %s22.i0.next, %s22.l0.inc ]
+  %s22.i0.cmp = icmp slt i64 %s22.i0, %n
+  br i1 %s22.i0.cmp, label %s22.l0.body, label %s22.exit
+
+s22.l0.body:
+  %gep155 = getelementptr inbounds double, double* %A5, i64 %s22.i0
+  %ld156 = load double, double* %gep155
+  %a157 = add nsw i64 %s22.i0, 1
+  %gep158 = getelementptr inbounds double, double* %A1, i64 %a157
+  %ld159 = load double, double* %gep158
+  %f160 = fadd double %ld156, %ld159
+  %gep161 = getelementptr inbounds double, double* %A6, i64 %s22.i0
+  store double %f160, double* %gep161
+  br label %s22.l0.inc
+
+s22.l0.inc:
+  %s22.i0.next = add nuw nsw i64 %s22.i0, 1
+  br label %s22.l0
+
+s22.exit:
+  br label %s23.l0
+
+s23.l0:
+  %s23.i0 = phi i64 [ 0, %s22.exit ], [ %s23.i0.next, %s23.l0.inc ]
+  %s23.i0.cmp = icmp slt i64 %s23.i0, %n
+  br i1 %s23.i0.cmp, label %s23.l0.body, label %s23.exit
+
+s23.l0.body:
+  %gep162 = getelementptr inbounds double, double* %A6, i64 %s23.i0
+  %ld163 = load double, double* %gep162
+  %a164 = add nsw i64 %s23.i0, 1
+  %gep165 = getelementptr inbounds double, double* %A2, i64 %a164
+  %ld166 = load double, double* %gep165
+  %f167 = fadd double %ld163, %ld166
+  %gep168 = getelementptr inbounds double, double* %A7, i64 %s23.i0
+  store double %f167, double* %gep168
+  br label %s23.l0.inc
+
+s23.l0.inc:
+  %s23.i0.next = add nuw nsw i64 %s23.i0, 1
+  br label %s23.l0
+
+s23.exit:
+  br label %s24.l0
+
+s24.l0:
+  %s24.i0 = phi i64 [ 0, %s23.exit ], [ %s24.i0.next, %s24.l0.inc ]
+  %s24.i0.cmp = icmp slt i64 %s24.i0, %n
+  br i1 %s24.i0.cmp, label %s24.l0.body, label %s24.exit
+
+s24.l0.body:
+  %gep169 = getelementptr inbounds double, double* %A7, i64 %s24.i0
+  %ld170 = load double, double* %gep169
+  %a171 = add nsw i64 %s24.i0, 1
+  %gep172 = getelementptr inbounds double, double* %A3, i64 %a171
+  %ld173 = load double, double* %gep172
+  %f174 = fadd double %ld170, %ld173
+  %gep175 = getelementptr inbounds double, double* %A0, i64 %s24.i0
+  store double %f174, double* %gep175
+  br label %s24.l0.inc
+
+s24.l0.inc:
+  %s24.i0.next = add nuw nsw i64 %s24.i0, 1
+  br label %s24.l0
+
+s24.exit:
+  br label %s25.l0
+
+s25.l0:
+  %s25.i0 = phi i64 [ 0, %s24.exit ], [ %s25.i0.next, %s25.l0.inc ]
+  %s25.i0.cmp = icmp slt i64 %s25.i0, %n
+  br i1 %s25.i0.cmp, label %s25.l0.body, label %s25.exit
+
+s25.l0.body:
+  %gep176 = getelementptr inbounds double, double* %A0, i64 %s25.i0
+  %ld177 = load double, double* %gep176
+  %a178 = add nsw i64 %s25.i0, 1
+  %gep179 = getelementptr inbounds double, double* %A4, i64 %a178
+  %ld180 = load double, double* %gep179
+  %f181 = fadd double %ld177, %ld180
+  %gep182 = getelementptr inbounds double, double* %A1, i64 %s25.i0
+  store double %f181, double* %gep182
+  br label %s25.l0.inc
+
+s25.l0.inc:
+  %s25.i0.next = add nuw nsw i64 %s25.i0, 1
+  br label %s25.l0
+
+s25.exit:
+  br label %s26.l0
+
+s26.l0:
+  %s26.i0 = phi i64 [ 0, %s25.exit ], [ %s26.i0.next, %s26.l0.inc ]
+  %s26.i0.cmp = icmp slt i64 %s26.i0, %n
+  br i1 %s26.i0.cmp, label %s26.l0.body, label %s26.exit
+
+s26.l0.body:
+  %gep183 = getelementptr inbounds double, double* %A1, i64 %s26.i0
+  %ld184 = load double, double* %gep183
+  %a185 = add nsw i64 %s26.i0, 1
+  %gep186 = getelementptr inbounds double, double* %A5, i64 %a185
+  %ld187 = load double, double* %gep186
+  %f188 = fadd double %ld184, %ld187
+  %gep189 = getelementptr inbounds double, double* %A2, i64 %s26.i0
+  store double %f188, double* %gep189
+  br label %s26.l0.inc
+
+s26.l0.inc:
+  %s26.i0.next = add nuw nsw i64 %s26.i0, 1
+  br label %s26.l0
+
+s26.exit:
+  br label %s27.l0
+
+s27.l0:
+  %s27.i0 = phi i64 [ 0, %s26.exit ], [ %s27.i0.next, %s27.l0.inc ]
+  %s27.i0.cmp = icmp slt i64 %s27.i0, %n
+  br i1 %s27.i0.cmp, label %s27.l0.body, label %s27.exit
+
+s27.l0.body:
+  %gep190 = getelementptr inbounds double, double* %A2, i64 %s27.i0
+  %ld191 = load double, double* %gep190
+  %a192 = add nsw i64 %s27.i0, 1
+  %gep193 = getelementptr inbounds double, double* %A6, i64 %a192
+  %ld194 = load double, double* %gep193
+  %f195 = fadd double %ld191, %ld194
+  %gep196 = getelementptr inbounds double, double* %A3, i64 %s27.i0
+  store double %f195, double* %gep196
+  br label %s27.l0.inc
+
+s27.l0.inc:
+  %s27.i0.next = add nuw nsw i64 %s27.i0, 1
+  br label %s27.l0
+
+s27.exit:
+  br label %s28.l0
+
+s28.l0:
+  %s28.i0 = phi i64 [ 0, %s27.exit ], [ %s28.i0.next, %s28.l0.inc ]
+  %s28.i0.cmp = icmp slt i64 %s28.i0, %n
+  br i1 %s28.i0.cmp, label %s28.l0.body, label %s28.exit
+
+s28.l0.body:
+  %gep197 = getelementptr inbounds double, double* %A3, i64 %s28.i0
+  %ld198 = load double, double* %gep197
+  %a199 = add nsw i64 %s28.i0, 1
+  %gep200 = getelementptr inbounds double, double* %A7, i64 %a199
+  %ld201 = load double, double* %gep200
+  %f202 = fadd double %ld198, %ld201
+  %gep203 = getelementptr inbounds double, double* %A4, i64 %s28.i0
+  store double %f202, double* %gep203
+  br label %s28.l0.inc
+
+s28.l0.inc:
+  %s28.i0.next = add nuw nsw i64 %s28.i0, 1
+  br label %s28.l0
+
+s28.exit:
+  br label %s29.l0
+
+s29.l0:
+  %s29.i0 = phi i64 [ 0, %s28.exit ], [ %s29.i0.next, %s29.l0.inc ]
+  %s29.i0.cmp = icmp slt i64 %s29.i0, %n
+  br i1 %s29.i0.cmp, label %s29.l0.body, label %s29.exit
+
+s29.l0.body:
+  %gep204 = getelementptr inbounds double, double* %A4, i64 %s29.i0
+  %ld205 = load double, double* %gep204
+  %a206 = add nsw i64 %s29.i0, 1
+  %gep207 = getelementptr inbounds double, double* %A0, i64 %a206
+  %ld208 = load double, double* %gep207
+  %f209 = fadd double %ld205, %ld208
+  %gep210 = getelementptr inbounds double, double* %A5, i64 %s29.i0
+  store double %f209, double* %gep210
+  br label %s29.l0.inc
+
+s29.l0.inc:
+  %s29.i0.next = add nuw nsw i64 %s29.i0, 1
+  br label %s29.l0
+
+s29.exit:
+  br label %s30.l0
+
+s30.l0:
+  %s30.i0 = phi i64 [ 0, %s29.exit ], [ %s30.i0.next, %s30.l0.inc ]
+  %s30.i0.cmp = icmp slt i64 %s30.i0, %n
+  br i1 %s30.i0.cmp, label %s30.l0.body, label %s30.exit
+
+s30.l0.body:
+  %gep211 = getelementptr inbounds double, double* %A5, i64 %s30.i0
+  %ld212 = load double, double* %gep211
+  %a213 = add nsw i64 %s30.i0, 1
+  %gep214 = getelementptr inbounds double, double* %A1, i64 %a213
+  %ld215 = load double, double* %gep214
+  %f216 = fadd double %ld212, %ld215
+  %gep217 = getelementptr inbounds double, double* %A6, i64 %s30.i0
+  store double %f216, double* %gep217
+  br label %s30.l0.inc
+
+s30.l0.inc:
+  %s30.i0.next = add nuw nsw i64 %s30.i0, 1
+  br label %s30.l0
+
+s30.exit:
+  br label %s31.l0
+
+s31.l0:
+  %s31.i0 = phi i64 [ 0, %s30.exit ], [ %s31.i0.next, %s31.l0.inc ]
+  %s31.i0.cmp = icmp slt i64 %s31.i0, %n
+  br i1 %s31.i0.cmp, label %s31.l0.body, label %s31.exit
+
+s31.l0.body:
+  %gep218 = getelementptr inbounds double, double* %A6, i64 %s31.i0
+  %ld219 = load double, double* %gep218
+  %a220 = add nsw i64 %s31.i0, 1
+  %gep221 = getelementptr inbounds double, double* %A2, i64 %a220
+  %ld222 = load double, double* %gep221
+  %f223 = fadd double %ld219, %ld222
+  %gep224 = getelementptr inbounds double, double* %A7, i64 %s31.i0
+  store double %f223, double* %gep224
+  br label %s31.l0.inc
+
+s31.l0.inc:
+  %s31.i0.next = add nuw nsw i64 %s31.i0, 1
+  br label %s31.l0
+
+s31.exit:
+  br label %s32.l0
+
+s32.l0:
+  %s32.i0 = phi i64 [ 0, %s31.exit ], [ %s32.i0.next, %s32.l0.inc ]
+  %s32.i0.cmp = icmp slt i64 %s32.i0, %n
+  br i1 %s32.i0.cmp, label %s32.l0.body, label %s32.exit
+
+s32.l0.body:
+  %gep225 = getelementptr inbounds double, double* %A7, i64 %s32.i0
+  %ld226 = load double, double* %gep225
+  %a227 = add nsw i64 %s32.i0, 1
+  %gep228 = getelementptr inbounds double, double* %A3, i64 %a227
+  %ld229 = load double, double* %gep228
+  %f230 = fadd double %ld226, %ld229
+  %gep231 = getelementptr inbounds double, double* %A0, i64 %s32.i0
+  store double %f230, double* %gep231
+  br label %s32.l0.inc
+
+s32.l0.inc:
+  %s32.i0.next = add nuw nsw i64 %s32.i0, 1
+  br label %s32.l0
+
+s32.exit:
+  br label %s33.l0
+
+s33.l0:
+  %s33.i0 = phi i64 [ 0, %s32.exit ], [ %s33.i0.next, %s33.l0.inc ]
+  %s33.i0.cmp = icmp slt i64 %s33.i0, %n
+  br i1 %s33.i0.cmp, label %s33.l0.body, label %s33.exit
+
+s33.l0.body:
+  %gep232 = getelementptr inbounds double, double* %A0, i64 %s33.i0
+  %ld233 = load double, double* %gep232
+  %a234 = add nsw i64 %s33.i0, 1
+  %gep235 = getelementptr inbounds double, double* %A4, i64 %a234
+  %ld236 = load double, double* %gep235
+  %f237 = fadd double %ld233, %ld236
+  %gep238 = getelementptr inbounds double, double* %A1, i64 %s33.i0
+  store double %f237, double* %gep238
+  br label %s33.l0.inc
+
+s33.l0.inc:
+  %s33.i0.next = add nuw nsw i64 %s33.i0, 1
+  br label %s33.l0
+
+s33.exit:
+  br label %s34.l0
+
+s34.l0:
+  %s34.i0 = phi i64 [ 0, %s33.exit ], [ %s34.i0.next, %s34.l0.inc ]
+  %s34.i0.cmp = icmp slt i64 %s34.i0, %n
+  br i1 %s34.i0.cmp, label %s34.l0.body, label %s34.exit
+
+s34.l0.body:
+  %gep239 = getelementptr inbounds double, double* %A1, i64 %s34.i0
+  %ld240 = load double, double* %gep239
+  %a241 = add nsw i64 %s34.i0, 1
+  %gep242 = getelementptr inbounds double, double* %A5, i64 %a241
+  %ld243 = load double, double* %gep242
+  %f244 = fadd double %ld240, %ld243
+  %gep245 = getelementptr inbounds double, double* %A2, i64 %s34.i0
+  store double %f244, double* %gep245
+  br label %s34.l0.inc
+
+s34.l0.inc:
+  %s34.i0.next = add nuw nsw i64 %s34.i0, 1
+  br label %s34.l0
+
+s34.exit:
+  br label %s35.l0
+
+s35.l0:
+  %s35.i0 = phi i64 [ 0, %s34.exit ], [ %s35.i0.next, %s35.l0.inc ]
+  %s35.i0.cmp = icmp slt i64 %s35.i0, %n
+  br i1 %s35.i0.cmp, label %s35.l0.body, label %s35.exit
+
+s35.l0.body:
+  %gep246 = getelementptr inbounds double, double* %A2, i64 %s35.i0
+  %ld247 = load double, double* %gep246
+  %a248 = add nsw i64 %s35.i0, 1
+  %gep249 = getelementptr inbounds double, double* %A6, i64 %a248
+  %ld250 = load double, double* %gep249
+  %f251 = fadd double %ld247, %ld250
+  %gep252 = getelementptr inbounds double, double* %A3, i64 %s35.i0
+  store double %f251, double* %gep252
+  br label %s35.l0.inc
+
+s35.l0.inc:
+  %s35.i0.next = add nuw nsw i64 %s35.i0, 1
+  br label %s35.l0
+
+s35.exit:
+  br label %s36.l0
+
+s36.l0:
+  %s36.i0 = phi i64 [ 0, %s35.exit ], [ %s36.i0.next, %s36.l0.inc ]
+  %s36.i0.cmp = icmp slt i64 %s36.i0, %n
+  br i1 %s36.i0.cmp, label %s36.l0.body, label %s36.exit
+
+s36.l0.body:
+  %gep253 = getelementptr inbounds double, double* %A3, i64 %s36.i0
+  %ld254 = load double, double* %gep253
+  %a255 = add nsw i64 %s36.i0, 1
+  %gep256 = getelementptr inbounds double, double* %A7, i64 %a255
+  %ld257 = load double, double* %gep256
+  %f258 = fadd double %ld254, %ld257
+  %gep259 = getelementptr inbounds double, double* %A4, i64 %s36.i0
+  store double %f258, double* %gep259
+  br label %s36.l0.inc
+
+s36.l0.inc:
+  %s36.i0.next = add nuw nsw i64 %s36.i0, 1
+  br label %s36.l0
+
+s36.exit:
+  br label %s37.l0
+
+s37.l0:
+  %s37.i0 = phi i64 [ 0, %s36.exit ], [ %s37.i0.next, %s37.l0.inc ]
+  %s37.i0.cmp = icmp slt i64 %s37.i0, %n
+  br i1 %s37.i0.cmp, label %s37.l0.body, label %s37.exit
+
+s37.l0.body:
+  %gep260 = getelementptr inbounds double, double* %A4, i64 %s37.i0
+  %ld261 = load double, double* %gep260
+  %a262 = add nsw i64 %s37.i0, 1
+  %gep263 = getelementptr inbounds double, double* %A0, i64 %a262
+  %ld264 = load double, double* %gep263
+  %f265 = fadd double %ld261, %ld264
+  %gep266 = getelementptr inbounds double, double* %A5, i64 %s37.i0
+  store double %f265, double* %gep266
+  br label %s37.l0.inc
+
+s37.l0.inc:
+  %s37.i0.next = add nuw nsw i64 %s37.i0, 1
+  br label %s37.l0
+
+s37.exit:
+  br label %s38.l0
+
+s38.l0:
+  %s38.i0 = phi i64 [ 0, %s37.exit ], [ %s38.i0.next, %s38.l0.inc ]
+  %s38.i0.cmp = icmp slt i64 %s38.i0, %n
+  br i1 %s38.i0.cmp, label %s38.l0.body, label %s38.exit
+
+s38.l0.body:
+  %gep267 = getelementptr inbounds double, double* %A5, i64 %s38.i0
+  %ld268 = load double, double* %gep267
+  %a269 = add nsw i64 %s38.i0, 1
+  %gep270 = getelementptr inbounds double, double* %A1, i64 %a269
+  %ld271 = load double, double* %gep270
+  %f272 = fadd double %ld268, %ld271
+  %gep273 = getelementptr inbounds double, double* %A6, i64 %s38.i0
+  store double %f272, double* %gep273
+  br label %s38.l0.inc
+
+s38.l0.inc:
+  %s38.i0.next = add nuw nsw i64 %s38.i0, 1
+  br label %s38.l0
+
+s38.exit:
+  br label %s39.l0
+
+s39.l0:
+  %s39.i0 = phi i64 [ 0, %s38.exit ], [ %s39.i0.next, %s39.l0.inc ]
+  %s39.i0.cmp = icmp slt i64 %s39.i0, %n
+  br i1 %s39.i0.cmp, label %s39.l0.body, label %s39.exit
+
+s39.l0.body:
+  %gep274 = getelementptr inbounds double, double* %A6, i64 %s39.i0
+  %ld275 = load double, double* %gep274
+  %a276 = add nsw i64 %s39.i0, 1
+  %gep277 = getelementptr inbounds double, double* %A2, i64 %a276
+  %ld278 = load double, double* %gep277
+  %f279 = fadd double %ld275, %ld278
+  %gep280 = getelementptr inbounds double, double* %A7, i64 %s39.i0
+  store double %f279, double* %gep280
+  br label %s39.l0.inc
+
+s39.l0.inc:
+  %s39.i0.next = add nuw nsw i64 %s39.i0, 1
+  br label %s39.l0
+
+s39.exit:
+  br label %s40.l0
+
+s40.l0:
+  %s40.i0 = phi i64 [ 0, %s39.exit ], [ %s40.i0.next, %s40.l0.inc ]
+  %s40.i0.cmp = icmp slt i64 %s40.i0, %n
+  br i1 %s40.i0.cmp, label %s40.l0.body, label %s40.exit
+
+s40.l0.body:
+  %gep281 = getelementptr inbounds double, double* %A7, i64 %s40.i0
+  %ld282 = load double, double* %gep281
+  %a283 = add nsw i64 %s40.i0, 1
+  %gep284 = getelementptr inbounds double, double* %A3, i64 %a283
+  %ld285 = load double, double* %gep284
+  %f286 = fadd double %ld282, %ld285
+  %gep287 = getelementptr inbounds double, double* %A0, i64 %s40.i0
+  store double %f286, double* %gep287
+  br label %s40.l0.inc
+
+s40.l0.inc:
+  %s40.i0.next = add nuw nsw i64 %s40.i0, 1
+  br label %s40.l0
+
+s40.exit:
+  br label %s41.l0
+
+s41.l0:
+  %s41.i0 = phi i64 [ 0, %s40.exit ], [ %s41.i0.next, %s41.l0.inc ]
+  %s41.i0.cmp = icmp slt i64 %s41.i0, %n
+  br i1 %s41.i0.cmp, label %s41.l0.body, label %s41.exit
+
+s41.l0.body:
+  %gep288 = getelementptr inbounds double, double* %A0, i64 %s41.i0
+  %ld289 = load double, double* %gep288
+  %a290 = add nsw i64 %s41.i0, 1
+  %gep291 = getelementptr inbounds double, double* %A4, i64 %a290
+  %ld292 = load double, double* %gep291
+  %f293 = fadd double %ld289, %ld292
+  %gep294 = getelementptr inbounds double, double* %A1, i64 %s41.i0
+  store double %f293, double* %gep294
+  br label %s41.l0.inc
+
+s41.l0.inc:
+  %s41.i0.next = add nuw nsw i64 %s41.i0, 1
+  br label %s41.l0
+
+s41.exit:
+  br label %s42.l0
+
+s42.l0:
+  %s42.i0 = phi i64 [ 0, %s41.exit ], [ %s42.i0.next, %s42.l0.inc ]
+  %s42.i0.cmp = icmp slt i64 %s42.i0, %n
+  br i1 %s42.i0.cmp, label %s42.l0.body, label %s42.exit
+
+s42.l0.body:
+  %gep295 = getelementptr inbounds double, double* %A1, i64 %s42.i0
+  %ld296 = load double, double* %gep295
+  %a297 = add nsw i64 %s42.i0, 1
+  %gep298 = getelementptr inbounds double, double* %A5, i64 %a297
+  %ld299 = load double, double* %gep298
+  %f300 = fadd double %ld296, %ld299
+  %gep301 = getelementptr inbounds double, double* %A2, i64 %s42.i0
+  store double %f300, double* %gep301
+  br label %s42.l0.inc
+
+s42.l0.inc:
+  %s42.i0.next = add nuw nsw i64 %s42.i0, 1
+  br label %s42.l0
+
+s42.exit:
+  br label %s43.l0
+
+s43.l0:
+  %s43.i0 = phi i64 [ 0, %s42.exit ], [ %s43.i0.next, %s43.l0.inc ]
+  %s43.i0.cmp = icmp slt i64 %s43.i0, %n
+  br i1 %s43.i0.cmp, label %s43.l0.body, label %s43.exit
+
+s43.l0.body:
+  %gep302 = getelementptr inbounds double, double* %A2, i64 %s43.i0
+  %ld303 = load double, double* %gep302
+  %a304 = add nsw i64 %s43.i0, 1
+  %gep305 = getelementptr inbounds double, double* %A6, i64 %a304
+  %ld306 = load double, double* %gep305
+  %f307 = fadd double %ld303, %ld306
+  %gep308 = getelementptr inbounds double, double* %A3, i64 %s43.i0
+  store double %f307, double* %gep308
+  br label %s43.l0.inc
+
+s43.l0.inc:
+  %s43.i0.next = add nuw nsw i64 %s43.i0, 1
+  br label %s43.l0
+
+s43.exit:
+  br label %s44.l0
+
+s44.l0:
+  %s44.i0 = phi i64 [ 0, %s43.exit ], [ %s44.i0.next, %s44.l0.inc ]
+  %s44.i0.cmp = icmp slt i64 %s44.i0, %n
+  br i1 %s44.i0.cmp, label %s44.l0.body, label %s44.exit
+
+s44.l0.body:
+  %gep309 = getelementptr inbounds double, double* %A3, i64 %s44.i0
+  %ld310 = load double, double* %gep309
+  %a311 = add nsw i64 %s44.i0, 1
+  %gep312 = getelementptr inbounds double, double* %A7, i64 %a311
+  %ld313 = load double, double* %gep312
+  %f314 = fadd double %ld310, %ld313
+  %gep315 = getelementptr inbounds double, double* %A4, i64 %s44.i0
+  store double %f314, double* %gep315
+  br label %s44.l0.inc
+
+s44.l0.inc:
+  %s44.i0.next = add nuw nsw i64 %s44.i0, 1
+  br label %s44.l0
+
+s44.exit:
+  br label %s45.l0
+
+s45.l0:
+  %s45.i0 = phi i64 [ 0, %s44.exit ], [ %s45.i0.next, %s45.l0.inc ]
+  %s45.i0.cmp = icmp slt i64 %s45.i0, %n
+  br i1 %s45.i0.cmp, label %s45.l0.body, label %s45.exit
+
+s45.l0.body:
+  %gep316 = getelementptr inbounds double, double* %A4, i64 %s45.i0
+  %ld317 = load double, double* %gep316
+  %a318 = add nsw i64 %s45.i0, 1
+  %gep319 = getelementptr inbounds double, double* %A0, i64 %a318
+  %ld320 = load double, double* %gep319
+  %f321 = fadd double %ld317, %ld320
+  %gep322 = getelementptr inbounds double, double* %A5, i64 %s45.i0
+  store double %f321, double* %gep322
+  br label %s45.l0.inc
+
+s45.l0.inc:
+  %s45.i0.next = add nuw nsw i64 %s45.i0, 1
+  br label %s45.l0
+
+s45.exit:
+  br label %s46.l0
+
+s46.l0:
+  %s46.i0 = phi i64 [ 0, %s45.exit ], [ %s46.i0.next, %s46.l0.inc ]
+  %s46.i0.cmp = icmp slt i64 %s46.i0, %n
+  br i1 %s46.i0.cmp, label %s46.l0.body, label %s46.exit
+
+s46.l0.body:
+  %gep323 = getelementptr inbounds double, double* %A5, i64 %s46.i0
+  %ld324 = load double, double* %gep323
+  %a325 = add nsw i64 %s46.i0, 1
+  %gep326 = getelementptr inbounds double, double* %A1, i64 %a325
+  %ld327 = load double, double* %gep326
+  %f328 = fadd double %ld324, %ld327
+  %gep329 = getelementptr inbounds double, double* %A6, i64 %s46.i0
+  store double %f328, double* %gep329
+  br label %s46.l0.inc
+
+s46.l0.inc:
+  %s46.i0.next = add nuw nsw i64 %s46.i0, 1
+  br label %s46.l0
+
+s46.exit:
+  br label %s47.l0
+
+s47.l0:
+  %s47.i0 = phi i64 [ 0, %s46.exit ], [ %s47.i0.next, %s47.l0.inc ]
+  %s47.i0.cmp = icmp slt i64 %s47.i0, %n
+  br i1 %s47.i0.cmp, label %s47.l0.body, label %s47.exit
+
+s47.l0.body:
+  %gep330 = getelementptr inbounds double, double* %A6, i64 %s47.i0
+  %ld331 = load double, double* %gep330
+  %a332 = add nsw i64 %s47.i0, 1
+  %gep333 = getelementptr inbounds double, double* %A2, i64 %a332
+  %ld334 = load double, double* %gep333
+  %f335 = fadd double %ld331, %ld334
+  %gep336 = getelementptr inbounds double, double* %A7, i64 %s47.i0
+  store double %f335, double* %gep336
+  br label %s47.l0.inc
+
+s47.l0.inc:
+  %s47.i0.next = add nuw nsw i64 %s47.i0, 1
+  br label %s47.l0
+
+s47.exit:
+  br label %s48.l0
+
+s48.l0:
+  %s48.i0 = phi i64 [ 0, %s47.exit ], [ %s48.i0.next, %s48.l0.inc ]
+  %s48.i0.cmp = icmp slt i64 %s48.i0, %n
+  br i1 %s48.i0.cmp, label %s48.l0.body, label %s48.exit
+
+s48.l0.body:
+  %gep337 = getelementptr inbounds double, double* %A7, i64 %s48.i0
+  %ld338 = load double, double* %gep337
+  %a339 = add nsw i64 %s48.i0, 1
+  %gep340 = getelementptr inbounds double, double* %A3, i64 %a339
+  %ld341 = load double, double* %gep340
+  %f342 = fadd double %ld338, %ld341
+  %gep343 = getelementptr inbounds double, double* %A0, i64 %s48.i0
+  store double %f342, double* %gep343
+  br label %s48.l0.inc
+
+s48.l0.inc:
+  %s48.i0.next = add nuw nsw i64 %s48.i0, 1
+  br label %s48.l0
+
+s48.exit:
+  br label %s49.l0
+
+s49.l0:
+  %s49.i0 = phi i64 [ 0, %s48.exit ], [ %s49.i0.next, %s49.l0.inc ]
+  %s49.i0.cmp = icmp slt i64 %s49.i0, %n
+  br i1 %s49.i0.cmp, label %s49.l0.body, label %s49.exit
+
+s49.l0.body:
+  %gep344 = getelementptr inbounds double, double* %A0, i64 %s49.i0
+  %ld345 = load double, double* %gep344
+  %a346 = add nsw i64 %s49.i0, 1
+  %gep347 = getelementptr inbounds double, double* %A4, i64 %a346
+  %ld348 = load double, double* %gep347
+  %f349 = fadd double %ld345, %ld348
+  %gep350 = getelementptr inbounds double, double* %A1, i64 %s49.i0
+  store double %f349, double* %gep350
+  br label %s49.l0.inc
+
+s49.l0.inc:
+  %s49.i0.next = add nuw nsw i64 %s49.i0, 1
+  br label %s49.l0
+
+s49.exit:
+  br label %s50.l0
+
+s50.l0:
+  %s50.i0 = phi i64 [ 0, %s49.exit ], [ %s50.i0.next, %s50.l0.inc ]
+  %s50.i0.cmp = icmp slt i64 %s50.i0, %n
+  br i1 %s50.i0.cmp, label %s50.l0.body, label %s50.exit
+
+s50.l0.body:
+  %gep351 = getelementptr inbounds double, double* %A1, i64 %s50.i0
+  %ld352 = load double, double* %gep351
+  %a353 = add nsw i64 %s50.i0, 1
+  %gep354 = getelementptr inbounds double, double* %A5, i64 %a353
+  %ld355 = load double, double* %gep354
+  %f356 = fadd double %ld352, %ld355
+  %gep357 = getelementptr inbounds double, double* %A2, i64 %s50.i0
+  store double %f356, double* %gep357
+  br label %s50.l0.inc
+
+s50.l0.inc:
+  %s50.i0.next = add nuw nsw i64 %s50.i0, 1
+  br label %s50.l0
+
+s50.exit:
+  br label %s51.l0
+
+s51.l0:
+  %s51.i0 = phi i64 [ 0, %s50.exit ], [ %s51.i0.next, %s51.l0.inc ]
+  %s51.i0.cmp = icmp slt i64 %s51.i0, %n
+  br i1 %s51.i0.cmp, label %s51.l0.body, label %s51.exit
+
+s51.l0.body:
+  %gep358 = getelementptr inbounds double, double* %A2, i64 %s51.i0
+  %ld359 = load double, double* %gep358
+  %a360 = add nsw i64 %s51.i0, 1
+  %gep361 = getelementptr inbounds double, double* %A6, i64 %a360
+  %ld362 = load double, double* %gep361
+  %f363 = fadd double %ld359, %ld362
+  %gep364 = getelementptr inbounds double, double* %A3, i64 %s51.i0
+  store double %f363, double* %gep364
+  br label %s51.l0.inc
+
+s51.l0.inc:
+  %s51.i0.next = add nuw nsw i64 %s51.i0, 1
+  br label %s51.l0
+
+s51.exit:
+  br label %s52.l0
+
+s52.l0:
+  %s52.i0 = phi i64 [ 0, %s51.exit ], [ %s52.i0.next, %s52.l0.inc ]
+  %s52.i0.cmp = icmp slt i64 %s52.i0, %n
+  br i1 %s52.i0.cmp, label %s52.l0.body, label %s52.exit
+
+s52.l0.body:
+  %gep365 = getelementptr inbounds double, double* %A3, i64 %s52.i0
+  %ld366 = load double, double* %gep365
+  %a367 = add nsw i64 %s52.i0, 1
+  %gep368 = getelementptr inbounds double, double* %A7, i64 %a367
+  %ld369 = load double, double* %gep368
+  %f370 = fadd double %ld366, %ld369
+  %gep371 = getelementptr inbounds double, double* %A4, i64 %s52.i0
+  store double %f370, double* %gep371
+  br label %s52.l0.inc
+
+s52.l0.inc:
+  %s52.i0.next = add nuw nsw i64 %s52.i0, 1
+  br label %s52.l0
+
+s52.exit:
+  br label %s53.l0
+
+s53.l0:
+  %s53.i0 = phi i64 [ 0, %s52.exit ], [ %s53.i0.next, %s53.l0.inc ]
+  %s53.i0.cmp = icmp slt i64 %s53.i0, %n
+  br i1 %s53.i0.cmp, label %s53.l0.body, label %s53.exit
+
+s53.l0.body:
+  %gep372 = getelementptr inbounds double, double* %A4, i64 %s53.i0
+  %ld373 = load double, double* %gep372
+  %a374 = add nsw i64 %s53.i0, 1
+  %gep375 = getelementptr inbounds double, double* %A0, i64 %a374
+  %ld376 = load double, double* %gep375
+  %f377 = fadd double %ld373, %ld376
+  %gep378 = getelementptr inbounds double, double* %A5, i64 %s53.i0
+  store double %f377, double* %gep378
+  br label %s53.l0.inc
+
+s53.l0.inc:
+  %s53.i0.next = add nuw nsw i64 %s53.i0, 1
+  br label %s53.l0
+
+s53.exit:
+  br label %s54.l0
+
+s54.l0:
+  %s54.i0 = phi i64 [ 0, %s53.exit ], [ %s54.i0.next, %s54.l0.inc ]
+  %s54.i0.cmp = icmp slt i64 %s54.i0, %n
+  br i1 %s54.i0.cmp, label %s54.l0.body, label %s54.exit
+
+s54.l0.body:
+  %gep379 = getelementptr inbounds double, double* %A5, i64 %s54.i0
+  %ld380 = load double, double* %gep379
+  %a381 = add nsw i64 %s54.i0, 1
+  %gep382 = getelementptr inbounds double, double* %A1, i64 %a381
+  %ld383 = load double, double* %gep382
+  %f384 = fadd double %ld380, %ld383
+  %gep385 = getelementptr inbounds double, double* %A6, i64 %s54.i0
+  store double %f384, double* %gep385
+  br label %s54.l0.inc
+
+s54.l0.inc:
+  %s54.i0.next = add nuw nsw i64 %s54.i0, 1
+  br label %s54.l0
+
+s54.exit:
+  br label %s55.l0
+
+s55.l0:
+  %s55.i0 = phi i64 [ 0, %s54.exit ], [ %s55.i0.next, %s55.l0.inc ]
+  %s55.i0.cmp = icmp slt i64 %s55.i0, %n
+  br i1 %s55.i0.cmp, label %s55.l0.body, label %s55.exit
+
+s55.l0.body:
+  %gep386 = getelementptr inbounds double, double* %A6, i64 %s55.i0
+  %ld387 = load double, double* %gep386
+  %a388 = add nsw i64 %s55.i0, 1
+  %gep389 = getelementptr inbounds double, double* %A2, i64 %a388
+  %ld390 = load double, double* %gep389
+  %f391 = fadd double %ld387, %ld390
+  %gep392 = getelementptr inbounds double, double* %A7, i64 %s55.i0
+  store double %f391, double* %gep392
+  br label %s55.l0.inc
+
+s55.l0.inc:
+  %s55.i0.next = add nuw nsw i64 %s55.i0, 1
+  br label %s55.l0
+
+s55.exit:
+  br label %s56.l0
+
+s56.l0:
+  %s56.i0 = phi i64 [ 0, %s55.exit ], [ %s56.i0.next, %s56.l0.inc ]
+  %s56.i0.cmp = icmp slt i64 %s56.i0, %n
+  br i1 %s56.i0.cmp, label %s56.l0.body, label %s56.exit
+
+s56.l0.body:
+  %gep393 = getelementptr inbounds double, double* %A7, i64 %s56.i0
+  %ld394 = load double, double* %gep393
+  %a395 = add nsw i64 %s56.i0, 1
+  %gep396 = getelementptr inbounds double, double* %A3, i64 %a395
+  %ld397 = load double, double* %gep396
+  %f398 = fadd double %ld394, %ld397
+  %gep399 = getelementptr inbounds double, double* %A0, i64 %s56.i0
+  store double %f398, double* %gep399
+  br label %s56.l0.inc
+
+s56.l0.inc:
+  %s56.i0.next = add nuw nsw i64 %s56.i0, 1
+  br label %s56.l0
+
+s56.exit:
+  br label %s57.l0
+
+s57.l0:
+  %s57.i0 = phi i64 [ 0, %s56.exit ], [ %s57.i0.next, %s57.l0.inc ]
+  %s57.i0.cmp = icmp slt i64 %s57.i0, %n
+  br i1 %s57.i0.cmp, label %s57.l0.body, label %s57.exit
+
+s57.l0.body:
+  %gep400 = getelementptr inbounds double, double* %A0, i64 %s57.i0
+  %ld401 = load double, double* %gep400
+  %a402 = add nsw i64 %s57.i0, 1
+  %gep403 = getelementptr inbounds double, double* %A4, i64 %a402
+  %ld404 = load double, double* %gep403
+  %f405 = fadd double %ld401, %ld404
+  %gep406 = getelementptr inbounds double, double* %A1, i64 %s57.i0
+  store double %f405, double* %gep406
+  br label %s57.l0.inc
+
+s57.l0.inc:
+  %s57.i0.next = add nuw nsw i64 %s57.i0, 1
+  br label %s57.l0
+
+s57.exit:
+  br label %s58.l0
+
+s58.l0:
+  %s58.i0 = phi i64 [ 0, %s57.exit ], [ %s58.i0.next, %s58.l0.inc ]
+  %s58.i0.cmp = icmp slt i64 %s58.i0, %n
+  br i1 %s58.i0.cmp, label %s58.l0.body, label %s58.exit
+
+s58.l0.body:
+  %gep407 = getelementptr inbounds double, double* %A1, i64 %s58.i0
+  %ld408 = load double, double* %gep407
+  %a409 = add nsw i64 %s58.i0, 1
+  %gep410 = getelementptr inbounds double, double* %A5, i64 %a409
+  %ld411 = load double, double* %gep410
+  %f412 = fadd double %ld408, %ld411
+  %gep413 = getelementptr inbounds double, double* %A2, i64 %s58.i0
+  store double %f412, double* %gep413
+  br label %s58.l0.inc
+
+s58.l0.inc:
+  %s58.i0.next = add nuw nsw i64 %s58.i0, 1
+  br label %s58.l0
+
+s58.exit:
+  br label %s59.l0
+
+s59.l0:
+  %s59.i0 = phi i64 [ 0, %s58.exit ], [ %s59.i0.next, %s59.l0.inc ]
+  %s59.i0.cmp = icmp slt i64 %s59.i0, %n
+  br i1 %s59.i0.cmp, label %s59.l0.body, label %s59.exit
+
+s59.l0.body:
+  %gep414 = getelementptr inbounds double, double* %A2, i64 %s59.i0
+  %ld415 = load double, double* %gep414
+  %a416 = add nsw i64 %s59.i0, 1
+  %gep417 = getelementptr inbounds double, double* %A6, i64 %a416
+  %ld418 = load double, double* %gep417
+  %f419 = fadd double %ld415, %ld418
+  %gep420 = getelementptr inbounds double, double* %A3, i64 %s59.i0
+  store double %f419, double* %gep420
+  br label %s59.l0.inc
+
+s59.l0.inc:
+  %s59.i0.next = add nuw nsw i64 %s59.i0, 1
+  br label %s59.l0
+
+s59.exit:
+  br label %s60.l0
+
+s60.l0:
+  %s60.i0 = phi i64 [ 0, %s59.exit ], [ %s60.i0.next, %s60.l0.inc ]
+  %s60.i0.cmp = icmp slt i64 %s60.i0, %n
+  br i1 %s60.i0.cmp, label %s60.l0.body, label %s60.exit
+
+s60.l0.body:
+  %gep421 = getelementptr inbounds double, double* %A3, i64 %s60.i0
+  %ld422 = load double, double* %gep421
+  %a423 = add nsw i64 %s60.i0, 1
+  %gep424 = getelementptr inbounds double, double* %A7, i64 %a423
+  %ld425 = load double, double* %gep424
+  %f426 = fadd double %ld422, %ld425
+  %gep427 = getelementptr inbounds double, double* %A4, i64 %s60.i0
+  store double %f426, double* %gep427
+  br label %s60.l0.inc
+
+s60.l0.inc:
+  %s60.i0.next = add nuw nsw i64 %s60.i0, 1
+  br label %s60.l0
+
+s60.exit:
+  br label %s61.l0
+
+s61.l0:
+  %s61.i0 = phi i64 [ 0, %s60.exit ], [ %s61.i0.next, %s61.l0.inc ]
+  %s61.i0.cmp = icmp slt i64 %s61.i0, %n
+  br i1 %s61.i0.cmp, label %s61.l0.body, label %s61.exit
+
+s61.l0.body:
+  %gep428 = getelementptr inbounds double, double* %A4, i64 %s61.i0
+  %ld429 = load double, double* %gep428
+  %a430 = add nsw i64 %s61.i0, 1
+  %gep431 = getelementptr inbounds double, double* %A0, i64 %a430
+  %ld432 = load double, double* %gep431
+  %f433 = fadd double %ld429, %ld432
+  %gep434 = getelementptr inbounds double, double* %A5, i64 %s61.i0
+  store double %f433, double* %gep434
+  br label %s61.l0.inc
+
+s61.l0.inc:
+  %s61.i0.next = add nuw nsw i64 %s61.i0, 1
+  br label %s61.l0
+
+s61.exit:
+  br label %s62.l0
+
+s62.l0:
+  %s62.i0 = phi i64 [ 0, %s61.exit ], [ %s62.i0.next, %s62.l0.inc ]
+  %s62.i0.cmp = icmp slt i64 %s62.i0, %n
+  br i1 %s62.i0.cmp, label %s62.l0.body, label %s62.exit
+
+s62.l0.body:
+  %gep435 = getelementptr inbounds double, double* %A5, i64 %s62.i0
+  %ld436 = load double, double* %gep435
+  %a437 = add nsw i64 %s62.i0, 1
+  %gep438 = getelementptr inbounds double, double* %A1, i64 %a437
+  %ld439 = load double, double* %gep438
+  %f440 = fadd double %ld436, %ld439
+  %gep441 = getelementptr inbounds double, double* %A6, i64 %s62.i0
+  store double %f440, double* %gep441
+  br label %s62.l0.inc
+
+s62.l0.inc:
+  %s62.i0.next = add nuw nsw i64 %s62.i0, 1
+  br label %s62.l0
+
+s62.exit:
+  br label %s63.l0
+
+s63.l0:
+  %s63.i0 = phi i64 [ 0, %s62.exit ], [ %s63.i0.next, %s63.l0.inc ]
+  %s63.i0.cmp = icmp slt i64 %s63.i0, %n
+  br i1 %s63.i0.cmp, label %s63.l0.body, label %s63.exit
+
+s63.l0.body:
+  %gep442 = getelementptr inbounds double, double* %A6, i64 %s63.i0
+  %ld443 = load double, double* %gep442
+  %a444 = add nsw i64 %s63.i0, 1
+  %gep445 = getelementptr inbounds double, double* %A2, i64 %a444
+  %ld446 = load double, double* %gep445
+  %f447 = fadd double %ld443, %ld446
+  %gep448 = getelementptr inbounds double, double* %A7, i64 %s63.i0
+  store double %f447, double* %gep448
+  br label %s63.l0.inc
+
+s63.l0.inc:
+  %s63.i0.next = add nuw nsw i64 %s63.i0, 1
+  br label %s63.l0
+
+s63.exit:
+  ret void
+}
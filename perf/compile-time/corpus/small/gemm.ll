@@ -0,0 +1,71 @@
+; Small: matrix multiplication with parametric sizes.
+;
+;    void gemm(long n, double *restrict A, double *restrict B,
+;              double *restrict C) {
+;      for (long i = 0; i < n; i++)
+;        for (long j = 0; j < n; j++)
+;          for (long k = 0; k < n; k++)
+;            C[i * n + j] += A[i * n + k] * B[k * n + j];
+;    }
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @gemm(i64 %n, double* noalias %A, double* noalias %B, double* noalias %C) {
+entry:
+  br label %gemm.l0
+
+gemm.l0:
+  %gemm.i0 = phi i64 [ 0, %entry ], [ %gemm.i0.next, %gemm.l0.inc ]
+  %gemm.i0.cmp = icmp slt i64 %gemm.i0, %n
+  br i1 %gemm.i0.cmp, label %gemm.l0.body, label %gemm.exit
+
+gemm.l0.body:
+  br label %gemm.l1
+
+gemm.l1:
+  %gemm.i1 = phi i64 [ 0, %gemm.l0.body ], [ %gemm.i1.next, %gemm.l1.inc ]
+  %gemm.i1.cmp = icmp slt i64 %gemm.i1, %n
+  br i1 %gemm.i1.cmp, label %gemm.l1.body, label %gemm.l0.inc
+
+gemm.l1.body:
+  br label %gemm.l2
+
+gemm.l2:
+  %gemm.i2 = phi i64 [ 0, %gemm.l1.body ], [ %gemm.i2.next, %gemm.l2.inc ]
+  %gemm.i2.cmp = icmp slt i64 %gemm.i2, %n
+  br i1 %gemm.i2.cmp, label %gemm.l2.body, label %gemm.l1.inc
+
+gemm.l2.body:
+  %x1 = mul nsw i64 %gemm.i0, %n
+  %x2 = add nsw i64 %x1, %gemm.i1
+  %x3 = mul nsw i64 %gemm.i0, %n
+  %x4 = add nsw i64 %x3, %gemm.i2
+  %x5 = mul nsw i64 %gemm.i2, %n
+  %x6 = add nsw i64 %x5, %gemm.i1
+  %gep7 = getelementptr inbounds double, double* %A, i64 %x4
+  %ld8 = load double, double* %gep7
+  %gep9 = getelementptr inbounds double, double* %B, i64 %x6
+  %ld10 = load double, double* %gep9
+  %gep11 = getelementptr inbounds double, double* %C, i64 %x2
+  %ld12 = load double, double* %gep11
+  %f13 = fmul double %ld8, %ld10
+  %f14 = fadd double %ld12, %f13
+  %gep15 = getelementptr inbounds double, double* %C, i64 %x2
+  store double %f14, double* %gep15
+  br label %gemm.l2.inc
+
+gemm.l2.inc:
+  %gemm.i2.next = add nuw nsw i64 %gemm.i2, 1
+  br label %gemm.l2
+
+gemm.l1.inc:
+  %gemm.i1.next = add nuw nsw i64 %gemm.i1, 1
+  br label %gemm.l1
+
+gemm.l0.inc:
+  %gemm.i0.next = add nuw nsw i64 %gemm.i0, 1
+  br label %gemm.l0
+
+gemm.exit:
+  ret void
+}
@@ -0,0 +1,36 @@
+; Small: a single loop without loop-carried dependences.
+;
+;    void saxpy(long n, double a, double *restrict X, double *restrict Y) {
+;      for (long i = 0; i < n; i++)
+;        Y[i] += a * X[i];
+;    }
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @saxpy(i64 %n, double %a, double* noalias %X, double* noalias %Y) {
+entry:
+  br label %saxpy.l0
+
+saxpy.l0:
+  %saxpy.i0 = phi i64 [ 0, %entry ], [ %saxpy.i0.next, %saxpy.l0.inc ]
+  %saxpy.i0.cmp = icmp slt i64 %saxpy.i0, %n
+  br i1 %saxpy.i0.cmp, label %saxpy.l0.body, label %saxpy.exit
+
+saxpy.l0.body:
+  %gep1 = getelementptr inbounds double, double* %X, i64 %saxpy.i0
+  %ld2 = load double, double* %gep1
+  %gep3 = getelementptr inbounds double, double* %Y, i64 %saxpy.i0
+  %ld4 = load double, double* %gep3
+  %f5 = fmul double %ld2, %a
+  %f6 = fadd double %ld4, %f5
+  %gep7 = getelementptr inbounds double, double* %Y, i64 %saxpy.i0
+  store double %f6, double* %gep7
+  br label %saxpy.l0.inc
+
+saxpy.l0.inc:
+  %saxpy.i0.next = add nuw nsw i64 %saxpy.i0, 1
+  br label %saxpy.l0
+
+saxpy.exit:
+  ret void
+}
@@ -0,0 +1,208 @@
+#! /usr/bin/env python3
+# -*- coding: UTF-8 -*-
+
+# Polly/LLVM run-compile-time.py
+# Run every file of the corpus through the Polly passes and record the wall
+# time and the number of isl operations of every phase as JSON. If a baseline
+# JSON file is given, report the phases that became slower or perform more
+# isl operations than in the baseline.
+#
+# The isl operation counts are read from -stats, which requires an LLVM built
+# with assertions or with LLVM_FORCE_ENABLE_STATS.
+
+import argparse
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+
+script_dir = os.path.dirname(os.path.abspath(__file__))
+corpus_dir = os.path.join(script_dir, 'corpus')
+
+# The phases in pipeline order: the name of the phase, the argument and the
+# description of its pass and the DEBUG_TYPE of its isl operations statistic.
+phases = [
+    ('ScopDetection', 'polly-detect',
+     'Polly - Detect static control parts (SCoPs)', None),
+    ('ScopInfo', 'polly-scops',
+     'Polly - Create polyhedral description of Scops', 'polly-scops'),
+    ('DependenceInfo', 'polly-dependences',
+     'Polly - Calculate dependences', 'polly-dependence'),
+    ('Scheduler', 'polly-opt-isl',
+     'Polly - Optimize schedule of SCoP', 'polly-opt-isl'),
+    ('IslAst', 'polly-ast',
+     'Polly - Generate an AST of the SCoP (isl)', 'polly-ast'),
+    ('CodeGeneration', 'polly-codegen',
+     'Polly - Create LLVM-IR from SCoPs', 'polly-codegen'),
+]
+
+# A line of the -time-passes report: user, system, user+system and wall time,
+# each followed by its percentage, and the description of the pass. Passes
+# that run more than once are suffixed by " #<n>".
+timer_re = re.compile(r'^\s*(?:[\d.]+ \(\s*[\d.]+%\)\s+){3}'
+                      r'(?P<wall>[\d.]+) \(\s*[\d.]+%\)\s+'
+                      r'(?P<pass>.*?)(?: #\d+)?\s*$')
+
+# A line of the -stats report.
+stat_re = re.compile(r'^\s*(?P<value>\d+) (?P<debug_type>\S+)\s+- '
+                     r'(?P<desc>.*)$')
+
+
+def find_corpus(dirs):
+    files = []
+    for d in dirs:
+        for root, _, names in os.walk(d):
+            files += [os.path.join(root, n) for n in names if n.endswith('.ll')]
+    return sorted(files)
+
+
+def run_opt(opt, polly_flags, filename, extra_flags=[]):
+    """Run the Polly passes on @filename.
+
+    Return the wall time and isl operations of every phase and the peak
+    memory usage of opt."""
+    fd, info = tempfile.mkstemp(suffix='.txt')
+    os.close(fd)
+    cmd = [opt] + shlex.split(polly_flags) + [
+        '-polly-process-unprofitable', '-basicaa'] + [
+        '-' + p[1] for p in phases] + extra_flags + [
+        '-disable-output', '-time-passes', '-stats',
+        '-info-output-file=' + info, filename]
+    proc = subprocess.Popen(cmd)
+    _, status, rusage = os.wait4(proc.pid, 0)
+    proc.returncode = status
+    if status != 0:
+        os.remove(info)
+        raise subprocess.CalledProcessError(status, cmd)
+
+    with open(info) as f:
+        report = f.read().splitlines()
+    os.remove(info)
+
+    walls = {}
+    ops = {}
+    for line in report:
+        m = timer_re.match(line)
+        if m:
+            walls[m.group('pass')] = (walls.get(m.group('pass'), 0) +
+                                      float(m.group('wall')))
+            continue
+        m = stat_re.match(line)
+        if m and m.group('desc').startswith('Number of isl operations'):
+            ops[m.group('debug_type')] = int(m.group('value'))
+    stats_enabled = any('Statistics Collected' in line for line in report)
+
+    result = {}
+    for name, _, desc, debug_type in phases:
+        isl_operations = None
+        # Statistics that are zero are not printed.
+        if debug_type is not None and stats_enabled:
+            isl_operations = ops.get(debug_type, 0)
+        result[name] = {'wall': walls.get(desc, 0.0),
+                        'isl_operations': isl_operations}
+    # ru_maxrss is in kilobytes on Linux.
+    return result, rusage.ru_maxrss
+
+
+def run(args):
+    results = {}
+    for filename in find_corpus(args.corpus):
+        best = None
+        for _ in range(args.reps):
+            phase_results, max_rss = run_opt(args.opt, args.polly_flags,
+                                             filename)
+            if best is None:
+                best = {'phases': phase_results, 'max_rss_kb': max_rss}
+                continue
+            for name in phase_results:
+                best['phases'][name]['wall'] = min(
+                    best['phases'][name]['wall'], phase_results[name]['wall'])
+            best['max_rss_kb'] = min(best['max_rss_kb'], max_rss)
+
+        name = os.path.relpath(filename, corpus_dir)
+        results[name] = best
+        print(name)
+        for phase, _, _, _ in phases:
+            r = best['phases'][phase]
+            print('  %-16s %10.6fs %14s isl operations' %
+                  (phase, r['wall'], r['isl_operations']
+                   if r['isl_operations'] is not None else '-'))
+        sys.stdout.flush()
+    return results
+
+
+def check_regressions(results, baseline, time_threshold, ops_threshold,
+                      min_time):
+    regressions = []
+    for name, r in sorted(results.items()):
+        b = baseline['files'].get(name)
+        if b is None:
+            continue
+        for phase, _, _, _ in phases:
+            new = r['phases'][phase]
+            old = b['phases'].get(phase)
+            if old is None:
+                continue
+            # Times below min_time are dominated by noise.
+            if (max(new['wall'], old['wall']) >= min_time and
+                    new['wall'] > old['wall'] * (1 + time_threshold)):
+                regressions.append('%s %s: %.6fs, baseline %.6fs' %
+                                   (name, phase, new['wall'], old['wall']))
+            if (new['isl_operations'] is not None and
+                    old['isl_operations'] is not None and
+                    new['isl_operations'] >
+                    old['isl_operations'] * (1 + ops_threshold)):
+                regressions.append('%s %s: %d isl operations, baseline %d' %
+                                   (name, phase, new['isl_operations'],
+                                    old['isl_operations']))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measure the compile time of the Polly phases')
+    parser.add_argument('--opt', default='opt', help='the opt to run')
+    parser.add_argument('--polly-flags', default='',
+                        help='the flags to load Polly into opt, if it is not '
+                        'linked into it')
+    parser.add_argument('--corpus', nargs='+', default=[corpus_dir],
+                        help='the directories or files to run')
+    parser.add_argument('--reps', type=int, default=3,
+                        help='the number of runs of which the fastest counts')
+    parser.add_argument('--time-threshold', type=float, default=0.10,
+                        help='the relative slowdown of a phase reported as a '
+                        'regression')
+    parser.add_argument('--ops-threshold', type=float, default=0.01,
+                        help='the relative increase of the isl operations of '
+                        'a phase reported as a regression')
+    parser.add_argument('--min-time', type=float, default=0.01,
+                        help='phases faster than this (in seconds) are not '
+                        'checked for time regressions')
+    parser.add_argument('--baseline',
+                        help='a JSON file written by a previous run')
+    parser.add_argument('-o', '--output', default='polly-compile-time.json',
+                        help='the JSON file to write the results to')
+    args = parser.parse_args()
+
+    results = run(args)
+    with open(args.output, 'w') as f:
+        json.dump({'opt': args.opt, 'files': results}, f, indent=2,
+                  sort_keys=True)
+    print('Results written to ' + args.output)
+
+    if not args.baseline:
+        return 0
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    regressions = check_regressions(results, baseline, args.time_threshold,
+                                    args.ops_threshold, args.min_time)
+    for regression in regressions:
+        print('REGRESSION: ' + regression)
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,180 @@
+#! /usr/bin/env python3
+# -*- coding: UTF-8 -*-
+
+# Polly/LLVM run-scaling.py
+# Generate SCoPs with utils/generate-scop.py that grow along one dimension
+# (statements, arrays, parameters, ...) while the others stay fixed, run them
+# through the Polly passes and report the compile time of every phase and the
+# peak memory usage of opt against the size. Phases whose time grows faster
+# than the given polynomial degree are reported, and with --plot the results
+# are plotted (requires matplotlib).
+
+import argparse
+import importlib.machinery
+import json
+import math
+import os
+import subprocess
+import sys
+import tempfile
+
+script_dir = os.path.dirname(os.path.abspath(__file__))
+generator = os.path.join(script_dir, '..', '..', 'utils', 'generate-scop.py')
+compile_time = importlib.machinery.SourceFileLoader(
+    'compile_time', os.path.join(script_dir, 'run-compile-time.py')
+).load_module()
+
+# The dimensions that can be scaled and the sizes they are scaled through by
+# default.
+dimensions = {
+    'statements': [1, 2, 4, 8, 16, 32, 64, 128],
+    'arrays': [1, 2, 4, 8, 16, 32, 64],
+    'parameters': [1, 2, 4, 8, 16, 32],
+    'depth': [1, 2, 3, 4, 5, 6, 7, 8],
+    'conditionals': [0, 1, 2, 4, 8, 16],
+    'reads': [1, 2, 4, 8, 16, 32],
+    'terms': [1, 2, 3, 4, 5, 6],
+}
+
+# The generator arguments of the dimensions that are not scaled.
+defaults = {
+    'statements': 8,
+    'arrays': 4,
+    'parameters': 4,
+    'depth': 2,
+    'conditionals': 0,
+    'reads': 2,
+    'terms': 1,
+}
+
+
+def generator_args(dimension, size, args):
+    gen_args = dict(defaults)
+    gen_args[dimension] = size
+    # Conditionals and access complexity need something to apply to.
+    if dimension == 'conditionals':
+        gen_args['statements'] = max(gen_args['statements'], size)
+    if dimension == 'terms':
+        gen_args['depth'] = max(gen_args['depth'], size)
+    result = []
+    for name, value in sorted(gen_args.items()):
+        result += ['--' + name, str(value)]
+    if args.may_alias:
+        result.append('--may-alias')
+    return result
+
+
+def scale(dimension, sizes, args):
+    points = []
+    for size in sizes:
+        fd, filename = tempfile.mkstemp(suffix='.ll')
+        os.close(fd)
+        subprocess.check_call([sys.executable, generator] +
+                              generator_args(dimension, size, args) +
+                              ['-o', filename])
+        phases, max_rss = compile_time.run_opt(args.opt, args.polly_flags,
+                                               filename)
+        os.remove(filename)
+
+        total = sum(p['wall'] for p in phases.values())
+        print('%-12s %5d %10.4fs %10d KiB' % (dimension, size, total, max_rss))
+        sys.stdout.flush()
+        points.append({'size': size, 'phases': phases, 'max_rss_kb': max_rss})
+    return points
+
+
+def find_cliffs(dimension, points, max_degree, min_time):
+    """Report phases whose time grows faster than size**max_degree between
+    two consecutive sizes."""
+    cliffs = []
+    for phase, _, _, _ in compile_time.phases:
+        for a, b in zip(points, points[1:]):
+            ta = a['phases'][phase]['wall']
+            tb = b['phases'][phase]['wall']
+            # Shift the sizes by one such that size 0 can be used.
+            sa = a['size'] + 1
+            sb = b['size'] + 1
+            if tb < min_time or ta <= 0:
+                continue
+            degree = math.log(tb / ta) / math.log(float(sb) / sa)
+            if degree > max_degree:
+                cliffs.append('%s: %s grows with degree %.1f from %d to %d '
+                              '(%.4fs to %.4fs)' %
+                              (dimension, phase, degree, a['size'], b['size'],
+                               ta, tb))
+    return cliffs
+
+
+def plot(results, filename):
+    import matplotlib
+    matplotlib.use('Agg')
+    import matplotlib.pyplot as plt
+
+    fig, axes = plt.subplots(len(results), 2, squeeze=False,
+                             figsize=(12, 4 * len(results)))
+    for row, (dimension, points) in enumerate(sorted(results.items())):
+        sizes = [p['size'] for p in points]
+        for phase, _, _, _ in compile_time.phases:
+            axes[row][0].plot(sizes, [p['phases'][phase]['wall']
+                                      for p in points],
+                              marker='o', label=phase)
+        axes[row][0].set_xlabel(dimension)
+        axes[row][0].set_ylabel('wall time (s)')
+        axes[row][0].legend(fontsize='small')
+        axes[row][1].plot(sizes, [p['max_rss_kb'] / 1024.0 for p in points],
+                          marker='o')
+        axes[row][1].set_xlabel(dimension)
+        axes[row][1].set_ylabel('peak memory (MiB)')
+    fig.tight_layout()
+    fig.savefig(filename)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measure how the compile time of Polly scales with the '
+        'size of SCoPs')
+    parser.add_argument('--opt', default='opt', help='the opt to run')
+    parser.add_argument('--polly-flags', default='',
+                        help='the flags to load Polly into opt, if it is not '
+                        'linked into it')
+    parser.add_argument('--dimensions', nargs='+', default=sorted(dimensions),
+                        choices=sorted(dimensions),
+                        help='the dimensions to scale, one at a time')
+    parser.add_argument('--sizes', nargs='+', type=int,
+                        help='the sizes to scale through, instead of the '
+                        'defaults of each dimension')
+    parser.add_argument('--may-alias', action='store_true',
+                        help='generate arrays that may alias each other')
+    parser.add_argument('--max-degree', type=float, default=2.0,
+                        help='report phases growing faster than '
+                        'size**MAX_DEGREE')
+    parser.add_argument('--min-time', type=float, default=0.05,
+                        help='ignore phases faster than this (in seconds)')
+    parser.add_argument('--plot', help='the image file to plot the results to')
+    parser.add_argument('-o', '--output', default='polly-scaling.json',
+                        help='the JSON file to write the results to')
+    args = parser.parse_args()
+
+    results = {}
+    cliffs = []
+    for dimension in args.dimensions:
+        points = scale(dimension, args.sizes or dimensions[dimension], args)
+        results[dimension] = points
+        cliffs += find_cliffs(dimension, points, args.max_degree,
+                              args.min_time)
+
+    with open(args.output, 'w') as f:
+        json.dump({'opt': args.opt, 'defaults': defaults,
+                   'results': results}, f, indent=2, sort_keys=True)
+    print('Results written to ' + args.output)
+    if args.plot:
+        plot(results, args.plot)
+        print('Plot written to ' + args.plot)
+
+    for cliff in cliffs:
+        print('SUPERLINEAR: ' + cliff)
+    return 1 if cliffs else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
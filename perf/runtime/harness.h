@@ -0,0 +1,65 @@
+/*===- harness.h - Timing harness for the runtime benchmarks --------------===*
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ *===----------------------------------------------------------------------===*
+ *
+ * Every kernel is compiled with -DN=<problem size> and defines
+ *
+ *   static void init(void);      initialize the arrays
+ *   static void kernel(void);    the timed computation
+ *   static double checksum(void); a value summarizing the result
+ *
+ * before including this file, which provides main(). The kernel is run
+ * POLLY_PERF_REPS times (re-initializing the arrays each time) and the
+ * fastest run is reported, together with the checksum of the last run:
+ *
+ *   time: <seconds>
+ *   checksum: <value>
+ *
+ *===----------------------------------------------------------------------===*/
+
+#ifndef POLLY_PERF_HARNESS_H
+#define POLLY_PERF_HARNESS_H
+
+#include <stdio.h>
+#include <time.h>
+
+#ifndef N
+#error "The problem size N must be defined"
+#endif
+
+#ifndef POLLY_PERF_REPS
+#define POLLY_PERF_REPS 5
+#endif
+
+static double polly_perf_now(void) {
+  struct timespec TS;
+  clock_gettime(CLOCK_MONOTONIC, &TS);
+  return TS.tv_sec + TS.tv_nsec * 1e-9;
+}
+
+/* Keep the kernel out of main, such that it is optimized the same way
+ * whatever the harness does around it. */
+static void init(void) __attribute__((noinline));
+static void kernel(void) __attribute__((noinline));
+static double checksum(void) __attribute__((noinline));
+
+int main(void) {
+  double Best = -1;
+  for (int Rep = 0; Rep < POLLY_PERF_REPS; Rep++) {
+    init();
+    double Start = polly_perf_now();
+    kernel();
+    double Time = polly_perf_now() - Start;
+    if (Best < 0 || Time < Best)
+      Best = Time;
+  }
+  printf("time: %.9f\n", Best);
+  printf("checksum: %.17g\n", checksum());
+  return 0;
+}
+
+#endif /* POLLY_PERF_HARNESS_H */
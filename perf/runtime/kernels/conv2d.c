@@ -0,0 +1,35 @@
+/* Two-dimensional convolution with a K x K filter. */
+
+#include "../harness.h"
+
+#define K 5
+
+static double In[N + K - 1][N + K - 1], Filter[K][K], Out[N][N];
+
+static void init(void) {
+  for (int i = 0; i < N + K - 1; i++)
+    for (int j = 0; j < N + K - 1; j++)
+      In[i][j] = (double)((i * 7 + j * 3) % 17) / 17;
+  for (int i = 0; i < K; i++)
+    for (int j = 0; j < K; j++)
+      Filter[i][j] = (double)(i + j + 1) / (K * K);
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      Out[i][j] = 0;
+}
+
+static void kernel(void) {
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      for (int p = 0; p < K; p++)
+        for (int q = 0; q < K; q++)
+          Out[i][j] += In[i + p][j + q] * Filter[p][q];
+}
+
+static double checksum(void) {
+  double Sum = 0;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      Sum += Out[i][j];
+  return Sum;
+}
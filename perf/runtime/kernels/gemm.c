@@ -0,0 +1,29 @@
+/* C := C + A * B */
+
+#include "../harness.h"
+
+static double A[N][N], B[N][N], C[N][N];
+
+static void init(void) {
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++) {
+      A[i][j] = (double)((i * j + 1) % N) / N;
+      B[i][j] = (double)((i * (j + 1) + 2) % N) / N;
+      C[i][j] = 0;
+    }
+}
+
+static void kernel(void) {
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      for (int k = 0; k < N; k++)
+        C[i][j] += A[i][k] * B[k][j];
+}
+
+static double checksum(void) {
+  double Sum = 0;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      Sum += C[i][j];
+  return Sum;
+}
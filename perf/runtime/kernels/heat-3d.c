@@ -0,0 +1,48 @@
+/* Seven-point heat equation stencil in three dimensions, TSTEPS time steps. */
+
+#include "../harness.h"
+
+#define TSTEPS 10
+
+static double A[N][N][N], B[N][N][N];
+
+static void init(void) {
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      for (int k = 0; k < N; k++)
+        A[i][j][k] = B[i][j][k] = (double)(i + j + (N - k)) * 10 / N;
+}
+
+static void kernel(void) {
+  for (int t = 0; t < TSTEPS; t++) {
+    for (int i = 1; i < N - 1; i++)
+      for (int j = 1; j < N - 1; j++)
+        for (int k = 1; k < N - 1; k++)
+          B[i][j][k] = 0.125 * (A[i + 1][j][k] - 2 * A[i][j][k] +
+                                A[i - 1][j][k]) +
+                       0.125 * (A[i][j + 1][k] - 2 * A[i][j][k] +
+                                A[i][j - 1][k]) +
+                       0.125 * (A[i][j][k + 1] - 2 * A[i][j][k] +
+                                A[i][j][k - 1]) +
+                       A[i][j][k];
+    for (int i = 1; i < N - 1; i++)
+      for (int j = 1; j < N - 1; j++)
+        for (int k = 1; k < N - 1; k++)
+          A[i][j][k] = 0.125 * (B[i + 1][j][k] - 2 * B[i][j][k] +
+                                B[i - 1][j][k]) +
+                       0.125 * (B[i][j + 1][k] - 2 * B[i][j][k] +
+                                B[i][j - 1][k]) +
+                       0.125 * (B[i][j][k + 1] - 2 * B[i][j][k] +
+                                B[i][j][k - 1]) +
+                       B[i][j][k];
+  }
+}
+
+static double checksum(void) {
+  double Sum = 0;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      for (int k = 0; k < N; k++)
+        Sum += A[i][j][k];
+  return Sum;
+}
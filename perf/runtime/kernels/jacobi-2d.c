@@ -0,0 +1,36 @@
+/* Five-point Jacobi stencil, TSTEPS time steps. */
+
+#include "../harness.h"
+
+#define TSTEPS 20
+
+static double A[N][N], B[N][N];
+
+static void init(void) {
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++) {
+      A[i][j] = ((double)i * (j + 2) + 2) / N;
+      B[i][j] = ((double)i * (j + 3) + 3) / N;
+    }
+}
+
+static void kernel(void) {
+  for (int t = 0; t < TSTEPS; t++) {
+    for (int i = 1; i < N - 1; i++)
+      for (int j = 1; j < N - 1; j++)
+        B[i][j] = 0.2 * (A[i][j] + A[i][j - 1] + A[i][j + 1] + A[i + 1][j] +
+                         A[i - 1][j]);
+    for (int i = 1; i < N - 1; i++)
+      for (int j = 1; j < N - 1; j++)
+        A[i][j] = 0.2 * (B[i][j] + B[i][j - 1] + B[i][j + 1] + B[i + 1][j] +
+                         B[i - 1][j]);
+  }
+}
+
+static double checksum(void) {
+  double Sum = 0;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      Sum += A[i][j];
+  return Sum;
+}
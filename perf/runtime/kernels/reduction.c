@@ -0,0 +1,30 @@
+/* Row and column sums: y := A * x and z := A^T * x. */
+
+#include "../harness.h"
+
+static double A[N][N], x[N], y[N], z[N];
+
+static void init(void) {
+  for (int i = 0; i < N; i++) {
+    x[i] = 1 + (double)i / N;
+    y[i] = z[i] = 0;
+    for (int j = 0; j < N; j++)
+      A[i][j] = (double)((i + j) % N) / (5 * N);
+  }
+}
+
+static void kernel(void) {
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      y[i] += A[i][j] * x[j];
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      z[j] += A[i][j] * x[i];
+}
+
+static double checksum(void) {
+  double Sum = 0;
+  for (int i = 0; i < N; i++)
+    Sum += y[i] + z[i];
+  return Sum;
+}
@@ -0,0 +1,27 @@
+/* B := A^T + B, the access to A is column-wise. */
+
+#include "../harness.h"
+
+static double A[N][N], B[N][N];
+
+static void init(void) {
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++) {
+      A[i][j] = (double)(i * N + j) / (N * N);
+      B[i][j] = (double)(j * N + i) / (N * N);
+    }
+}
+
+static void kernel(void) {
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      B[i][j] += A[j][i];
+}
+
+static double checksum(void) {
+  double Sum = 0;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      Sum += B[i][j] * (i + 1);
+  return Sum;
+}
@@ -0,0 +1,30 @@
+/* Solve L * X = B for N right-hand sides, L lower triangular. */
+
+#include "../harness.h"
+
+static double L[N][N], B[N][N];
+
+static void init(void) {
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++) {
+      L[i][j] = j < i ? (double)(i + N - j + 1) * 2 / (N * N) : 0;
+      B[i][j] = (double)((i + j) % N) / N;
+    }
+  for (int i = 0; i < N; i++)
+    L[i][i] = 1;
+}
+
+static void kernel(void) {
+  for (int i = 0; i < N; i++)
+    for (int k = 0; k < i; k++)
+      for (int j = 0; j < N; j++)
+        B[i][j] -= L[i][k] * B[k][j];
+}
+
+static double checksum(void) {
+  double Sum = 0;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      Sum += B[i][j];
+  return Sum;
+}
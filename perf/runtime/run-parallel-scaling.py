@@ -0,0 +1,234 @@
+#! /usr/bin/env python3
+# -*- coding: UTF-8 -*-
+
+# Polly/LLVM run-parallel-scaling.py
+# Build the kernels in kernels/ with -polly-parallel and the run-time
+# performance monitor, run them with 1 up to all cores at several problem
+# sizes and report the speedup and parallel efficiency relative to one thread,
+# together with the fork/join overhead per parallel region measured by the
+# performance monitor. The results are written as JSON; if a baseline JSON
+# file is given, the runs whose time or efficiency became worse than the
+# baseline by more than the threshold are reported.
+
+import argparse
+import importlib.machinery
+import json
+import os
+import platform
+import shlex
+import subprocess
+import sys
+import tempfile
+
+script_dir = os.path.dirname(os.path.abspath(__file__))
+runtime = importlib.machinery.SourceFileLoader(
+    'runtime', os.path.join(script_dir, 'run-runtime.py')).load_module()
+
+# The function of the harness that contains the timed SCoPs.
+kernel_function = 'kernel'
+
+
+def default_threads():
+    """1, 2, 4, ... up to and including the number of cores."""
+    cores = os.cpu_count() or 1
+    threads = []
+    t = 1
+    while t < cores:
+        threads.append(t)
+        t *= 2
+    return threads + [cores]
+
+
+def compile_kernel(args, kernel, size, threads, exe):
+    cmd = [args.cc, '-O3', '-march=native', '-DN=%d' % size,
+           '-DPOLLY_PERF_REPS=%d' % args.reps]
+    cmd += shlex.split(args.polly_flags) + runtime.configs['polly-parallel']
+    cmd += ['-mllvm', '-polly-codegen-perf-monitoring']
+    if threads is not None:
+        cmd += ['-mllvm', '-polly-num-threads=%d' % threads]
+    cmd += [os.path.join(runtime.kernel_dir, kernel + '.c'), '-o', exe]
+    subprocess.check_call(cmd)
+
+
+def parse_output(out):
+    """Return the time and checksum printed by the harness and the counters
+    of the parallel regions of the kernel printed by the performance
+    monitor."""
+    result = {'time': None, 'checksum': None, 'scop_cycles': 0,
+              'parallel_cycles': 0, 'parallel_work_cycles': 0,
+              'parallel_regions': 0}
+    in_scops = False
+    for line in out.splitlines():
+        if line.startswith('time:'):
+            result['time'] = float(line.split(':', 1)[1])
+        elif line.startswith('checksum:'):
+            result['checksum'] = float(line.split(':', 1)[1])
+        elif line.startswith('scop function,'):
+            in_scops = True
+        elif in_scops and line.strip():
+            # function, entry, exit, cycles, trip count, parallel cycles,
+            # parallel work cycles, parallel regions
+            fields = [f.strip() for f in line.split(',')]
+            if len(fields) != 8 or fields[0] != kernel_function:
+                continue
+            result['scop_cycles'] += int(fields[3])
+            result['parallel_cycles'] += int(fields[5])
+            result['parallel_work_cycles'] += int(fields[6])
+            result['parallel_regions'] += int(fields[7])
+    return result
+
+
+def run_kernel(exe, threads):
+    env = dict(os.environ)
+    env['OMP_NUM_THREADS'] = str(threads)
+    out = subprocess.check_output([exe], env=env, universal_newlines=True)
+    return parse_output(out)
+
+
+def summarize(kernel, size, threads, r, base):
+    entry = {'kernel': kernel, 'size': size, 'threads': threads,
+             'time': r['time'], 'checksum': r['checksum'],
+             'speedup': base['time'] / r['time'],
+             'efficiency': base['time'] / r['time'] / threads,
+             'parallel_regions': r['parallel_regions'],
+             'overhead_cycles_per_region': None,
+             'overhead_fraction': None}
+    if r['parallel_regions'] > 0:
+        overhead = r['parallel_cycles'] - r['parallel_work_cycles']
+        entry['overhead_cycles_per_region'] = (
+            float(overhead) / r['parallel_regions'])
+        entry['overhead_fraction'] = (float(overhead) /
+                                      max(r['scop_cycles'], 1))
+    return entry
+
+
+def run(args):
+    results = []
+    tmpdir = tempfile.mkdtemp(prefix='polly-scaling-')
+    for kernel in args.kernels:
+        for size in runtime.sizes[kernel][:args.num_sizes]:
+            exe = os.path.join(tmpdir, '%s-%d' % (kernel, size))
+            if not args.num_threads_flag:
+                compile_kernel(args, kernel, size, None, exe)
+            base = None
+            for t in args.threads:
+                if args.num_threads_flag:
+                    compile_kernel(args, kernel, size, t, exe)
+                r = run_kernel(exe, t)
+                if base is None:
+                    base = r
+                entry = summarize(kernel, size, t, r, base)
+                if r['parallel_regions'] == 0:
+                    print('%s N=%d: no parallel regions were executed' %
+                          (kernel, size))
+                print('%-10s N=%-5d threads=%-3d %10.6fs speedup %6.2f '
+                      'efficiency %5.1f%% overhead %s cycles/region' %
+                      (kernel, size, t, entry['time'], entry['speedup'],
+                       100 * entry['efficiency'],
+                       '%.0f' % entry['overhead_cycles_per_region']
+                       if entry['overhead_cycles_per_region'] is not None
+                       else '-'))
+                sys.stdout.flush()
+                results.append(entry)
+            os.remove(exe)
+    os.rmdir(tmpdir)
+    return results
+
+
+def key(r):
+    return (r['kernel'], r['size'], r['threads'])
+
+
+def check_checksums(results, tolerance):
+    """Compare the checksums of all thread counts to the one of the first."""
+    reference = {}
+    failures = []
+    for r in results:
+        ref = reference.setdefault((r['kernel'], r['size']), r['checksum'])
+        if abs(r['checksum'] - ref) > tolerance * max(abs(ref), 1.0):
+            failures.append('%s N=%d threads=%d: checksum %.17g, expected '
+                            '%.17g' % (key(r) + (r['checksum'], ref)))
+    return failures
+
+
+def check_regressions(results, baseline, threshold):
+    """Report the runs that are slower or scale worse than in @baseline by
+    more than @threshold.
+
+    Entries of the baseline may set their own threshold for noisy runs."""
+    base = {key(r): r for r in baseline['results']}
+    regressions = []
+    for r in results:
+        b = base.get(key(r))
+        if b is None:
+            continue
+        limit = b.get('threshold', threshold)
+        if r['time'] > b['time'] * (1 + limit):
+            regressions.append('%s N=%d threads=%d: %.6fs, baseline %.6fs' %
+                               (key(r) + (r['time'], b['time'])))
+        if r['efficiency'] < b['efficiency'] * (1 - limit):
+            regressions.append('%s N=%d threads=%d: efficiency %.1f%%, '
+                               'baseline %.1f%%' %
+                               (key(r) + (100 * r['efficiency'],
+                                          100 * b['efficiency'])))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measure how the kernels parallelized by Polly scale with '
+        'the number of threads')
+    parser.add_argument('--cc', default='clang',
+                        help='the compiler to build the kernels with')
+    parser.add_argument('--polly-flags', default='',
+                        help='the flags to load Polly into the compiler, if '
+                        'it is not linked into it')
+    parser.add_argument('--kernels', nargs='+', default=sorted(runtime.sizes),
+                        choices=sorted(runtime.sizes))
+    parser.add_argument('--threads', nargs='+', type=int,
+                        default=default_threads(),
+                        help='the thread counts to run with; the first one '
+                        'is the reference of the speedup (default: 1, 2, 4, '
+                        '... up to the number of cores)')
+    parser.add_argument('--num-threads-flag', action='store_true',
+                        help='set the thread count with -polly-num-threads '
+                        'at compile time instead of OMP_NUM_THREADS')
+    parser.add_argument('--num-sizes', type=int, default=3,
+                        help='run only the smallest NUM_SIZES sizes')
+    parser.add_argument('--reps', type=int, default=5,
+                        help='the number of runs of which the fastest counts')
+    parser.add_argument('--threshold', type=float, default=0.10,
+                        help='the relative slowdown or loss of efficiency '
+                        'reported as a regression')
+    parser.add_argument('--checksum-tolerance', type=float, default=1e-6,
+                        help='the relative difference to the checksum of the '
+                        'first thread count reported as a miscompile')
+    parser.add_argument('--baseline',
+                        help='a JSON file written by a previous run')
+    parser.add_argument('-o', '--output',
+                        default='polly-parallel-scaling.json',
+                        help='the JSON file to write the results to')
+    args = parser.parse_args()
+
+    results = run(args)
+    with open(args.output, 'w') as f:
+        json.dump({'machine': platform.node(), 'cc': args.cc,
+                   'cores': os.cpu_count(), 'threshold': args.threshold,
+                   'results': results}, f, indent=2, sort_keys=True)
+    print('Results written to ' + args.output)
+
+    failed = False
+    for failure in check_checksums(results, args.checksum_tolerance):
+        print('MISCOMPILE: ' + failure)
+        failed = True
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        for regression in check_regressions(results, baseline, args.threshold):
+            print('REGRESSION: ' + regression)
+            failed = True
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
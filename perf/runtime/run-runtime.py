@@ -0,0 +1,179 @@
+#! /usr/bin/env python3
+# -*- coding: UTF-8 -*-
+
+# Polly/LLVM run-runtime.py
+# Build every kernel in kernels/ with plain -O3 and with Polly in several
+# configurations, time them over several problem sizes and thread counts and
+# write the results as JSON. If a baseline JSON file is given, report the
+# runs that became slower than the baseline by more than the threshold.
+
+import argparse
+import json
+import os
+import platform
+import shlex
+import subprocess
+import sys
+import tempfile
+
+script_dir = os.path.dirname(os.path.abspath(__file__))
+kernel_dir = os.path.join(script_dir, 'kernels')
+
+# The problem sizes of every kernel, from a size that fits into the L2 cache
+# to one that does not fit into the last level cache of current machines.
+sizes = {
+    'gemm': [256, 512, 1024],
+    'jacobi-2d': [256, 1024, 2048],
+    'heat-3d': [32, 64, 128],
+    'reduction': [512, 2048, 4096],
+    'trisolv': [256, 512, 1024],
+    'transpose': [512, 2048, 4096],
+    'conv2d': [256, 1024, 2048],
+}
+
+# The compiler flags of every configuration, in addition to the -O3 and the
+# flags loading Polly. Only the parallel configuration is run with more than
+# one thread.
+configs = {
+    'O3': None,
+    'polly': ['-mllvm', '-polly'],
+    'polly-parallel': ['-mllvm', '-polly', '-mllvm', '-polly-parallel',
+                       '-fopenmp'],
+    'polly-vector': ['-mllvm', '-polly', '-mllvm',
+                     '-polly-vectorizer=stripmine'],
+}
+
+
+def compile_kernel(args, kernel, config, size, exe):
+    cmd = [args.cc, '-O3', '-march=native', '-DN=%d' % size,
+           '-DPOLLY_PERF_REPS=%d' % args.reps]
+    if configs[config] is not None:
+        cmd += shlex.split(args.polly_flags) + configs[config]
+    cmd += [os.path.join(kernel_dir, kernel + '.c'), '-o', exe]
+    subprocess.check_call(cmd)
+
+
+def run_kernel(exe, threads):
+    env = dict(os.environ)
+    env['OMP_NUM_THREADS'] = str(threads)
+    out = subprocess.check_output([exe], env=env, universal_newlines=True)
+    result = {}
+    for line in out.splitlines():
+        key, _, value = line.partition(':')
+        result[key.strip()] = float(value)
+    return result
+
+
+def run(args):
+    results = []
+    tmpdir = tempfile.mkdtemp(prefix='polly-perf-')
+    for kernel in args.kernels:
+        for size in sizes[kernel][:args.num_sizes]:
+            for config in args.configs:
+                exe = os.path.join(tmpdir, '%s-%s-%d' % (kernel, config, size))
+                compile_kernel(args, kernel, config, size, exe)
+                threads = args.threads if config == 'polly-parallel' else [1]
+                for t in threads:
+                    r = run_kernel(exe, t)
+                    print('%-10s %-15s N=%-5d threads=%-3d %10.6fs' %
+                          (kernel, config, size, t, r['time']))
+                    sys.stdout.flush()
+                    results.append({'kernel': kernel, 'config': config,
+                                    'size': size, 'threads': t,
+                                    'time': r['time'],
+                                    'checksum': r['checksum']})
+                os.remove(exe)
+    os.rmdir(tmpdir)
+    return results
+
+
+def key(r):
+    return (r['kernel'], r['config'], r['size'], r['threads'])
+
+
+def check_checksums(results, tolerance):
+    """Compare the checksums of the Polly configurations to plain -O3."""
+    reference = {(r['kernel'], r['size']): r['checksum']
+                 for r in results if r['config'] == 'O3'}
+    failures = []
+    for r in results:
+        ref = reference.get((r['kernel'], r['size']))
+        if ref is None:
+            continue
+        if abs(r['checksum'] - ref) > tolerance * max(abs(ref), 1.0):
+            failures.append('%s %s N=%d threads=%d: checksum %.17g, expected '
+                            '%.17g' % (key(r) + (r['checksum'], ref)))
+    return failures
+
+
+def check_regressions(results, baseline, threshold):
+    """Report the runs slower than in @baseline by more than @threshold.
+
+    Entries of the baseline may set their own threshold for noisy runs."""
+    base = {key(r): r for r in baseline['results']}
+    regressions = []
+    for r in results:
+        b = base.get(key(r))
+        if b is None:
+            continue
+        limit = b['time'] * (1 + b.get('threshold', threshold))
+        if r['time'] > limit:
+            regressions.append('%s %s N=%d threads=%d: %.6fs, baseline %.6fs '
+                               '(+%.1f%%)' %
+                               (key(r) + (r['time'], b['time'],
+                                          100 * (r['time'] / b['time'] - 1))))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Time the runtime benchmark kernels with and without Polly")
+    parser.add_argument('--cc', default='clang',
+                        help='the compiler to build the kernels with')
+    parser.add_argument('--polly-flags', default='',
+                        help='the flags to load Polly into the compiler, if '
+                        'it is not linked into it')
+    parser.add_argument('--kernels', nargs='+', default=sorted(sizes),
+                        choices=sorted(sizes))
+    parser.add_argument('--configs', nargs='+', default=sorted(configs),
+                        choices=sorted(configs))
+    parser.add_argument('--threads', nargs='+', type=int, default=[1, 2, 4],
+                        help='the thread counts of the parallel '
+                        'configuration')
+    parser.add_argument('--num-sizes', type=int, default=3,
+                        help='run only the smallest NUM_SIZES sizes')
+    parser.add_argument('--reps', type=int, default=5,
+                        help='the number of runs of which the fastest counts')
+    parser.add_argument('--threshold', type=float, default=0.05,
+                        help='the relative slowdown reported as a regression')
+    parser.add_argument('--checksum-tolerance', type=float, default=1e-6,
+                        help='the relative difference to the checksum of -O3 '
+                        'reported as a miscompile')
+    parser.add_argument('--baseline',
+                        help='a JSON file written by a previous run')
+    parser.add_argument('-o', '--output', default='polly-perf.json',
+                        help='the JSON file to write the results to')
+    args = parser.parse_args()
+
+    results = run(args)
+    with open(args.output, 'w') as f:
+        json.dump({'machine': platform.node(), 'cc': args.cc,
+                   'threshold': args.threshold, 'results': results},
+                  f, indent=2, sort_keys=True)
+    print('Results written to ' + args.output)
+
+    failed = False
+    for failure in check_checksums(results, args.checksum_tolerance):
+        print('MISCOMPILE: ' + failure)
+        failed = True
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        for regression in check_regressions(results, baseline, args.threshold):
+            print('REGRESSION: ' + regression)
+            failed = True
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,72 @@
+; RUN: opt %loadPolly -polly-aos-to-soa -analyze < %s | FileCheck %s
+;
+; Verify that the local array of structures Tmp is split into one array per
+; field, such that the loops access consecutive elements.
+;
+;    struct P { double x, y; };
+;
+;    void f(double *restrict A, double *restrict B) {
+;      struct P Tmp[1024];
+;      for (long i = 0; i < 1024; i++) {
+;        Tmp[i].x = A[i];
+;        Tmp[i].y = A[i];
+;      }
+;      for (long i = 0; i < 1024; i++)
+;        B[i] = Tmp[i].x + Tmp[i].y;
+;    }
+;
+; CHECK:      double MemRef_Tmp_field0[1024]; // Element size 8
+; CHECK-NEXT: double MemRef_Tmp_field1[1024]; // Element size 8
+;
+; CHECK:      Stmt_write
+; CHECK:          MustWriteAccess :=  [Reduction Type: NONE] [Scalar: 0]
+; CHECK-NEXT:         { Stmt_write[i0] -> MemRef_Tmp[2i0] };
+; CHECK-NEXT:    new: { Stmt_write[i0] -> MemRef_Tmp_field0[i0] };
+; CHECK-NEXT:     MustWriteAccess :=  [Reduction Type: NONE] [Scalar: 0]
+; CHECK-NEXT:         { Stmt_write[i0] -> MemRef_Tmp[1 + 2i0] };
+; CHECK-NEXT:    new: { Stmt_write[i0] -> MemRef_Tmp_field1[i0] };
+; CHECK:      Stmt_read
+; CHECK:          ReadAccess :=       [Reduction Type: NONE] [Scalar: 0]
+; CHECK-NEXT:         { Stmt_read[i0] -> MemRef_Tmp[2i0] };
+; CHECK-NEXT:    new: { Stmt_read[i0] -> MemRef_Tmp_field0[i0] };
+; CHECK-NEXT:     ReadAccess :=       [Reduction Type: NONE] [Scalar: 0]
+; CHECK-NEXT:         { Stmt_read[i0] -> MemRef_Tmp[1 + 2i0] };
+; CHECK-NEXT:    new: { Stmt_read[i0] -> MemRef_Tmp_field1[i0] };
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+%struct.P = type { double, double }
+
+define void @f(double* noalias %A, double* noalias %B) {
+entry:
+  %Tmp = alloca [1024 x %struct.P]
+  br label %write
+
+write:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %write ]
+  %A.idx = getelementptr inbounds double, double* %A, i64 %i
+  %A.val = load double, double* %A.idx
+  %x.idx = getelementptr inbounds [1024 x %struct.P], [1024 x %struct.P]* %Tmp, i64 0, i64 %i, i32 0
+  store double %A.val, double* %x.idx
+  %y.idx = getelementptr inbounds [1024 x %struct.P], [1024 x %struct.P]* %Tmp, i64 0, i64 %i, i32 1
+  store double %A.val, double* %y.idx
+  %i.next = add nuw nsw i64 %i, 1
+  %i.cond = icmp slt i64 %i.next, 1024
+  br i1 %i.cond, label %write, label %read
+
+read:
+  %j = phi i64 [ 0, %write ], [ %j.next, %read ]
+  %x.idx2 = getelementptr inbounds [1024 x %struct.P], [1024 x %struct.P]* %Tmp, i64 0, i64 %j, i32 0
+  %x = load double, double* %x.idx2
+  %y.idx2 = getelementptr inbounds [1024 x %struct.P], [1024 x %struct.P]* %Tmp, i64 0, i64 %j, i32 1
+  %y = load double, double* %y.idx2
+  %sum = fadd double %x, %y
+  %B.idx = getelementptr inbounds double, double* %B, i64 %j
+  store double %sum, double* %B.idx
+  %j.next = add nuw nsw i64 %j, 1
+  %j.cond = icmp slt i64 %j.next, 1024
+  br i1 %j.cond, label %read, label %exit
+
+exit:
+  ret void
+}
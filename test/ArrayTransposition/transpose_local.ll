@@ -0,0 +1,75 @@
+; RUN: opt %loadPolly -polly-array-transposition -analyze < %s | FileCheck %s
+;
+; Verify that the local array T, which both loop nests access column-wise,
+; is stored transposed, such that the innermost loops access consecutive
+; elements of it.
+;
+;    void f(double A[restrict 64][64], double B[restrict 64][64]) {
+;      double T[64][64];
+;      for (long i = 0; i < 64; i++)
+;        for (long j = 0; j < 64; j++)
+;          T[j][i] = A[i][j];
+;      for (long i = 0; i < 64; i++)
+;        for (long j = 0; j < 64; j++)
+;          B[i][j] = T[j][i];
+;    }
+;
+; CHECK:      double MemRef_T_transposed[64][64]; // Element size 8
+;
+; CHECK:      Stmt_write
+; CHECK:          MustWriteAccess :=  [Reduction Type: NONE] [Scalar: 0]
+; CHECK-NEXT:         { Stmt_write[i0, i1] -> MemRef_T[i1, i0] };
+; CHECK-NEXT:    new: { Stmt_write[i0, i1] -> MemRef_T_transposed[i0, i1] };
+; CHECK:      Stmt_read
+; CHECK:          ReadAccess :=       [Reduction Type: NONE] [Scalar: 0]
+; CHECK-NEXT:         { Stmt_read[i0, i1] -> MemRef_T[i1, i0] };
+; CHECK-NEXT:    new: { Stmt_read[i0, i1] -> MemRef_T_transposed[i0, i1] };
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f([64 x double]* noalias %A, [64 x double]* noalias %B) {
+entry:
+  %T = alloca [64 x [64 x double]]
+  br label %outer1
+
+outer1:
+  %i1 = phi i64 [ 0, %entry ], [ %i1.next, %outer1.inc ]
+  br label %write
+
+write:
+  %j1 = phi i64 [ 0, %outer1 ], [ %j1.next, %write ]
+  %A.idx = getelementptr inbounds [64 x double], [64 x double]* %A, i64 %i1, i64 %j1
+  %A.val = load double, double* %A.idx
+  %T.idx1 = getelementptr inbounds [64 x [64 x double]], [64 x [64 x double]]* %T, i64 0, i64 %j1, i64 %i1
+  store double %A.val, double* %T.idx1
+  %j1.next = add nuw nsw i64 %j1, 1
+  %j1.cond = icmp slt i64 %j1.next, 64
+  br i1 %j1.cond, label %write, label %outer1.inc
+
+outer1.inc:
+  %i1.next = add nuw nsw i64 %i1, 1
+  %i1.cond = icmp slt i64 %i1.next, 64
+  br i1 %i1.cond, label %outer1, label %outer2
+
+outer2:
+  %i2 = phi i64 [ 0, %outer1.inc ], [ %i2.next, %outer2.inc ]
+  br label %read
+
+read:
+  %j2 = phi i64 [ 0, %outer2 ], [ %j2.next, %read ]
+  %T.idx2 = getelementptr inbounds [64 x [64 x double]], [64 x [64 x double]]* %T, i64 0, i64 %j2, i64 %i2
+  %T.val = load double, double* %T.idx2
+  %B.idx = getelementptr inbounds [64 x double], [64 x double]* %B, i64 %i2, i64 %j2
+  store double %T.val, double* %B.idx
+  %j2.next = add nuw nsw i64 %j2, 1
+  %j2.cond = icmp slt i64 %j2.next, 64
+  br i1 %j2.cond, label %read, label %outer2.inc
+
+outer2.inc:
+  %i2.next = add nuw nsw i64 %i2, 1
+  %i2.cond = icmp slt i64 %i2.next, 64
+  br i1 %i2.cond, label %outer2, label %exit
+
+exit:
+  ret void
+}
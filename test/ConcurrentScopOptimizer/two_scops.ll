@@ -0,0 +1,59 @@
+; RUN: opt %loadPolly -polly-concurrent-scop-opt \
+; RUN:   -polly-concurrent-scops-threads=2 -polly-process-unprofitable -S < %s \
+; RUN:   | FileCheck %s
+;
+; Verify that both SCoPs of the function, which are separated by a call that
+; is not part of any SCoP, are code generated by the concurrent SCoP
+; optimizer. The second SCoP reads the array written by the first one, which
+; must not keep it from being optimized.
+;
+;    void f(double A[restrict 1024], double B[restrict 1024]) {
+;      for (long i = 0; i < 1024; i++)
+;        A[i] = i;
+;      g();
+;      for (long i = 0; i < 1024; i++)
+;        B[i] = A[i] + 1;
+;    }
+;
+; CHECK-LABEL: define void @f(
+; CHECK:       polly.split_new_and_old:
+; CHECK:       polly.stmt.first:
+; CHECK:       call void @g()
+; CHECK:       polly.split_new_and_old{{[0-9]+}}:
+; CHECK:       polly.stmt.second:
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+declare void @g()
+
+define void @f(double* noalias %A, double* noalias %B) {
+entry:
+  br label %first
+
+first:
+  %i1 = phi i64 [ 0, %entry ], [ %i1.next, %first ]
+  %conv = sitofp i64 %i1 to double
+  %A.i1 = getelementptr inbounds double, double* %A, i64 %i1
+  store double %conv, double* %A.i1
+  %i1.next = add nuw nsw i64 %i1, 1
+  %cond1 = icmp slt i64 %i1.next, 1024
+  br i1 %cond1, label %first, label %middle
+
+middle:
+  call void @g()
+  br label %second
+
+second:
+  %i2 = phi i64 [ 0, %middle ], [ %i2.next, %second ]
+  %A.i2 = getelementptr inbounds double, double* %A, i64 %i2
+  %val = load double, double* %A.i2
+  %add = fadd double %val, 1.0
+  %B.i2 = getelementptr inbounds double, double* %B, i64 %i2
+  store double %add, double* %B.i2
+  %i2.next = add nuw nsw i64 %i2, 1
+  %cond2 = icmp slt i64 %i2.next, 1024
+  br i1 %cond2, label %second, label %exit
+
+exit:
+  ret void
+}
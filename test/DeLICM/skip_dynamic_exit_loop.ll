@@ -0,0 +1,40 @@
+; RUN: opt %loadPolly -polly-process-unprofitable \
+; RUN:   -polly-allow-dynamic-exit-loops -polly-delicm -analyze \
+; RUN:   -pass-remarks-missed=polly-delicm < %s 2>&1 | FileCheck %s
+;
+; The domain of the loop is over-approximated because its exit condition is
+; data-dependent. The store to A[0] of the last executed iteration is never
+; overwritten by the store of a "next" iteration, hence y must not be mapped
+; to A[0] between the iterations, which would leave y + 1 instead of 2 * y in
+; A[0] after the loop.
+;
+;    void func(double *A, double c) {
+;      double y = 0.0;
+;      do {
+;        A[0] = 2 * y;
+;        y = y + 1;
+;      } while (A[0] < c);
+;    }
+;
+; CHECK: Skipped possible mapping target because it is not an unconditional overwrite
+; CHECK: No modification has been made
+
+define void @func(double* noalias nonnull %A, double %c) {
+entry:
+  br label %header
+
+header:
+  %y = phi double [ 0.0, %entry ], [ %y.next, %latch ]
+  %v = fmul double %y, 2.0
+  store double %v, double* %A
+  %y.next = fadd double %y, 1.0
+  br label %latch
+
+latch:
+  %a = load double, double* %A
+  %again = fcmp olt double %a, %c
+  br i1 %again, label %header, label %exit
+
+exit:
+  ret void
+}
@@ -0,0 +1,145 @@
+; RUN: opt %loadPolly -polly-early-exit-chunking -S < %s | FileCheck %s
+;
+; Do not evaluate the exits of loops in chunks if the loads of the iterations
+; after an exit may access memory that is not dereferenceable.
+;
+; A string search relies on the sentinel to stop before the end of s; its
+; bound n only limits the search.
+;
+;    long find_end(const char *s, long n) {
+;      long i;
+;      for (i = 0; i < n; i++)
+;        if (s[i] == 0)
+;          break;
+;      return i;
+;    }
+;
+; CHECK-LABEL: define i64 @find_end(
+; CHECK-NOT:   polly.early_exit
+; CHECK:       ret i64
+;
+; The elements of p are only accessed if p is not null.
+;
+;    long search_or_null(int *p, long n, int x) {
+;      long i;
+;      for (i = 0; i < n; i++) {
+;        if (!p)
+;          break;
+;        if (p[i] == x)
+;          break;
+;      }
+;      return i;
+;    }
+;
+; CHECK-LABEL: define i64 @search_or_null(
+; CHECK-NOT:   polly.early_exit
+; CHECK:       ret i64
+;
+; A is known to have 16 elements only, less than a chunk.
+;
+;    long search_small(int A[static 16], long n, int x) {
+;      long i;
+;      for (i = 0; i < n; i++)
+;        if (A[i] == x)
+;          break;
+;      return i;
+;    }
+;
+; CHECK-LABEL: define i64 @search_small(
+; CHECK-NOT:   polly.early_exit
+; CHECK:       ret i64
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define i64 @find_end(i8* %s, i64 %n) {
+entry:
+  %guard = icmp sgt i64 %n, 0
+  br i1 %guard, label %for.body.preheader, label %exit
+
+for.body.preheader:
+  br label %for.body
+
+for.body:
+  %i = phi i64 [ 0, %for.body.preheader ], [ %i.next, %for.inc ]
+  %s.i = getelementptr inbounds i8, i8* %s, i64 %i
+  %c = load i8, i8* %s.i
+  %end = icmp eq i8 %c, 0
+  br i1 %end, label %exit.loopexit, label %for.inc
+
+for.inc:
+  %i.next = add nuw nsw i64 %i, 1
+  %cond = icmp slt i64 %i.next, %n
+  br i1 %cond, label %for.body, label %exit.loopexit
+
+exit.loopexit:
+  %i.lcssa = phi i64 [ %i, %for.body ], [ %n, %for.inc ]
+  br label %exit
+
+exit:
+  %res = phi i64 [ 0, %entry ], [ %i.lcssa, %exit.loopexit ]
+  ret i64 %res
+}
+
+define i64 @search_or_null(i32* align 4 dereferenceable_or_null(4096) %p,
+                           i64 %n, i32 %x) {
+entry:
+  %guard = icmp sgt i64 %n, 0
+  br i1 %guard, label %for.body.preheader, label %exit
+
+for.body.preheader:
+  br label %for.body
+
+for.body:
+  %i = phi i64 [ 0, %for.body.preheader ], [ %i.next, %for.inc ]
+  %isnull = icmp eq i32* %p, null
+  br i1 %isnull, label %exit.loopexit, label %for.check
+
+for.check:
+  %p.i = getelementptr inbounds i32, i32* %p, i64 %i
+  %val = load i32, i32* %p.i
+  %match = icmp eq i32 %val, %x
+  br i1 %match, label %exit.loopexit, label %for.inc
+
+for.inc:
+  %i.next = add nuw nsw i64 %i, 1
+  %cond = icmp slt i64 %i.next, %n
+  br i1 %cond, label %for.body, label %exit.loopexit
+
+exit.loopexit:
+  %i.lcssa = phi i64 [ %i, %for.body ], [ %i, %for.check ], [ %n, %for.inc ]
+  br label %exit
+
+exit:
+  %res = phi i64 [ 0, %entry ], [ %i.lcssa, %exit.loopexit ]
+  ret i64 %res
+}
+
+define i64 @search_small(i32* align 4 dereferenceable(64) %A, i64 %n,
+                         i32 %x) {
+entry:
+  %guard = icmp sgt i64 %n, 0
+  br i1 %guard, label %for.body.preheader, label %exit
+
+for.body.preheader:
+  br label %for.body
+
+for.body:
+  %i = phi i64 [ 0, %for.body.preheader ], [ %i.next, %for.inc ]
+  %A.i = getelementptr inbounds i32, i32* %A, i64 %i
+  %val = load i32, i32* %A.i
+  %match = icmp eq i32 %val, %x
+  br i1 %match, label %exit.loopexit, label %for.inc
+
+for.inc:
+  %i.next = add nuw nsw i64 %i, 1
+  %cond = icmp slt i64 %i.next, %n
+  br i1 %cond, label %for.body, label %exit.loopexit
+
+exit.loopexit:
+  %i.lcssa = phi i64 [ %i, %for.body ], [ %n, %for.inc ]
+  br label %exit
+
+exit:
+  %res = phi i64 [ 0, %entry ], [ %i.lcssa, %exit.loopexit ]
+  ret i64 %res
+}
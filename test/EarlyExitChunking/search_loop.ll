@@ -0,0 +1,89 @@
+; RUN: opt %loadPolly -polly-early-exit-chunking -S < %s | FileCheck %s
+; RUN: opt %loadPolly -passes=polly-early-exit-chunking -S < %s | FileCheck %s
+;
+; Evaluate the exit condition of a search loop in chunks of 256 iterations by
+; a loop without early exit, and resume the search loop at the first matching
+; iteration. A has 1024 dereferenceable elements, so the chunks are limited to
+; the first 1024 iterations.
+;
+;    long search(int A[static 1024], long n, int x) {
+;      long i;
+;      for (i = 0; i < n; i++)
+;        if (A[i] == x)
+;          break;
+;      return i;
+;    }
+;
+; CHECK-LABEL: define i64 @search(
+; CHECK:       for.body.preheader:
+; CHECK:         %[[BOUND:.+]] = select i1 %{{.+}}, i64 %{{.+}}, i64 1024
+; CHECK-NEXT:    %[[ENTER:.+]] = icmp uge i64 %[[BOUND]], 256
+; CHECK-NEXT:    br i1 %[[ENTER]], label %polly.early_exit.chunk, label %polly.early_exit.resume
+;
+; CHECK:       polly.early_exit.chunk:
+; CHECK-NEXT:    %polly.early_exit.chunk.start = phi i64 [ 0, %for.body.preheader ], [ %polly.early_exit.chunk.end, %polly.early_exit.chunk.next ]
+; CHECK-NEXT:    %polly.early_exit.chunk.end = add i64 %polly.early_exit.chunk.start, 256
+; CHECK-NEXT:    br label %for.body.chunk
+;
+; CHECK:       for.body.chunk:
+; CHECK-NEXT:    %polly.early_exit.iteration = phi i64 [ %polly.early_exit.chunk.start, %polly.early_exit.chunk ], [ %polly.early_exit.iteration.next, %for.inc.chunk ]
+; CHECK-NEXT:    %polly.early_exit.first = phi i64 [ -1, %polly.early_exit.chunk ], [ %polly.early_exit.first.next, %for.inc.chunk ]
+; CHECK-NEXT:    %A.i.chunk = getelementptr inbounds i32, i32* %A, i64 %polly.early_exit.iteration
+; CHECK-NEXT:    %val.chunk = load i32, i32* %A.i.chunk
+; CHECK-NEXT:    %match.chunk = icmp eq i32 %val.chunk, %x
+; CHECK-NEXT:    br label %for.inc.chunk
+;
+; CHECK:       for.inc.chunk:
+; CHECK:         %[[EXIT:.+]] = select i1 %match.chunk, i64 %polly.early_exit.iteration, i64 -1
+; CHECK-NEXT:    %[[ISFIRST:.+]] = icmp ult i64 %[[EXIT]], %polly.early_exit.first
+; CHECK-NEXT:    %polly.early_exit.first.next = select i1 %[[ISFIRST]], i64 %[[EXIT]], i64 %polly.early_exit.first
+; CHECK-NEXT:    %polly.early_exit.iteration.next = add i64 %polly.early_exit.iteration, 1
+; CHECK-NEXT:    %[[CONT:.+]] = icmp ne i64 %polly.early_exit.iteration.next, %polly.early_exit.chunk.end
+; CHECK-NEXT:    br i1 %[[CONT]], label %for.body.chunk, label %polly.early_exit.chunk.exit
+;
+; CHECK:       polly.early_exit.chunk.exit:
+; CHECK-NEXT:    %[[FOUND:.+]] = icmp ne i64 %polly.early_exit.first.next, -1
+; CHECK-NEXT:    br i1 %[[FOUND]], label %polly.early_exit.resume, label %polly.early_exit.chunk.next
+;
+; CHECK:       polly.early_exit.chunk.next:
+; CHECK-NEXT:    %[[REMAINING:.+]] = sub i64 %[[BOUND]], %polly.early_exit.chunk.end
+; CHECK-NEXT:    %[[FULL:.+]] = icmp uge i64 %[[REMAINING]], 256
+; CHECK-NEXT:    br i1 %[[FULL]], label %polly.early_exit.chunk, label %polly.early_exit.resume
+;
+; CHECK:       polly.early_exit.resume:
+; CHECK-NEXT:    %polly.early_exit.resume.iteration = phi i64 [ 0, %for.body.preheader ], [ %polly.early_exit.first.next, %polly.early_exit.chunk.exit ], [ %polly.early_exit.chunk.end, %polly.early_exit.chunk.next ]
+; CHECK-NEXT:    br label %for.body
+;
+; CHECK:       for.body:
+; CHECK-NEXT:    %i = phi i64 [ %polly.early_exit.resume.iteration, %polly.early_exit.resume ], [ %i.next, %for.inc ]
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define i64 @search(i32* align 4 dereferenceable(4096) %A, i64 %n, i32 %x) {
+entry:
+  %guard = icmp sgt i64 %n, 0
+  br i1 %guard, label %for.body.preheader, label %exit
+
+for.body.preheader:
+  br label %for.body
+
+for.body:
+  %i = phi i64 [ 0, %for.body.preheader ], [ %i.next, %for.inc ]
+  %A.i = getelementptr inbounds i32, i32* %A, i64 %i
+  %val = load i32, i32* %A.i
+  %match = icmp eq i32 %val, %x
+  br i1 %match, label %exit.loopexit, label %for.inc
+
+for.inc:
+  %i.next = add nuw nsw i64 %i, 1
+  %cond = icmp slt i64 %i.next, %n
+  br i1 %cond, label %for.body, label %exit.loopexit
+
+exit.loopexit:
+  %i.lcssa = phi i64 [ %i, %for.body ], [ %n, %for.inc ]
+  br label %exit
+
+exit:
+  %res = phi i64 [ 0, %entry ], [ %i.lcssa, %exit.loopexit ]
+  ret i64 %res
+}
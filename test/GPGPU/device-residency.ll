@@ -0,0 +1,46 @@
+; RUN: opt %loadPolly -polly-codegen-ppcg -polly-acc-device-residency -S < %s \
+; RUN: | FileCheck %s
+
+; REQUIRES: pollyacc
+
+; With -polly-acc-device-residency the device arrays are acquired for the host
+; data they mirror and released, instead of allocated and freed, such that the
+; runtime can skip the transfer of host data that is still valid on the device
+; in later scops. B is only read by the kernel, hence its device copy stays
+; valid after the scop.
+;
+;    void f(double A[1024], double B[1024]) {
+;      for (long i = 0; i < 1024; i++)
+;        A[i] = B[i] + 1;
+;    }
+
+; CHECK-DAG:  %p_dev_array_MemRef_A = call i8* @polly_acquireDeviceMemory(i8* %{{.*}}, i64 8192)
+; CHECK-DAG:  %p_dev_array_MemRef_B = call i8* @polly_acquireDeviceMemory(i8* %{{.*}}, i64 8192)
+; CHECK:      call void @polly_copyFromHostToDevice(i8* %{{.*}}, i8* %p_dev_array_MemRef_B, i64 8192)
+; CHECK:      call void @polly_launchKernel(
+; CHECK:      call void @polly_copyFromDeviceToHost(i8* %p_dev_array_MemRef_A, i8* %{{.*}}, i64 8192)
+; CHECK-DAG:  call void @polly_releaseDeviceMemory(i8* %p_dev_array_MemRef_A, i32 1)
+; CHECK-DAG:  call void @polly_releaseDeviceMemory(i8* %p_dev_array_MemRef_B, i32 0)
+; CHECK-NOT:  @polly_freeDeviceMemory
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @f(double* %A, double* %B) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %B.i = getelementptr inbounds double, double* %B, i64 %i
+  %val = load double, double* %B.i
+  %add = fadd double %val, 1.000000e+00
+  %A.i = getelementptr inbounds double, double* %A, i64 %i
+  store double %add, double* %A.i
+  %i.next = add nuw nsw i64 %i, 1
+  %cond = icmp slt i64 %i.next, 1024
+  br i1 %cond, label %loop, label %exit
+
+exit:
+  ret void
+}
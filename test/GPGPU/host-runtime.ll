@@ -0,0 +1,42 @@
+; RUN: opt %loadPolly -O3 -polly -polly-target=gpu \
+; RUN: -polly-gpu-runtime=host -polly-process-unprofitable -S < %s | \
+; RUN: FileCheck %s
+
+; REQUIRES: pollyacc
+
+; Generate code for the host emulation of the GPU runtime. The kernel is still
+; compiled for the device; only the runtime context differs from the CUDA
+; runtime.
+;
+;    void f(double A[1024]) {
+;      for (long i = 0; i < 1024; i++)
+;        A[i] += 1;
+;    }
+
+; CHECK:      call i8* @polly_initContextHost()
+; CHECK:      call i8* @polly_allocateMemoryForDevice(
+; CHECK:      call void @polly_copyFromHostToDevice(
+; CHECK:      call i8* @polly_getKernel(i8* getelementptr inbounds ({{.*}}@FUNC_f_SCOP_0_KERNEL_0
+; CHECK:      call void @polly_launchKernel(
+; CHECK:      call void @polly_copyFromDeviceToHost(
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @f(double* %A) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %A.i = getelementptr inbounds double, double* %A, i64 %i
+  %val = load double, double* %A.i
+  %add = fadd double %val, 1.000000e+00
+  store double %add, double* %A.i
+  %i.next = add nuw nsw i64 %i, 1
+  %cond = icmp slt i64 %i.next, 1024
+  br i1 %cond, label %loop, label %exit
+
+exit:
+  ret void
+}
@@ -1,5 +1,6 @@
 ; RUN: opt %loadPolly -polly-stmt-granularity=bb -polly-scops -analyze -polly-import-jscop -polly-import-jscop-postfix=transformed < %s | FileCheck %s
 ; RUN: opt %loadPolly -polly-stmt-granularity=bb -polly-import-jscop -polly-import-jscop-postfix=transformed -polly-codegen -S < %s | FileCheck %s --check-prefix=CODEGEN
+; RUN: opt %loadPolly -polly-stmt-granularity=bb -polly-import-jscop -polly-import-jscop-postfix=transformed -polly-codegen -polly-reuse-heap-arrays -S < %s | FileCheck %s --check-prefix=ARENA
 ;
 ; #define Ni 1056
 ; #define Nj 1056
@@ -48,6 +49,32 @@
 ; CODEGEN: %14 = bitcast i64* %F to i8*
 ; CODEGEN: tail call void @free(i8* %14)
 ;
+; With -polly-reuse-heap-arrays the buffers are kept in thread-local slots.
+; D is larger than 2 MiB, hence its buffer is over-allocated by 2 MiB - 1 bytes
+; to align it to a huge page. The buffers are freed at program exit and, via
+; a pthread key, at the exit of the threads that allocated them.
+; ARENA: @D.arena = internal thread_local global i8* null
+; ARENA: @llvm.global_dtors = appending global {{.*}} @polly.arena.cleanup
+; ARENA: @polly.arena.key = internal global i32 0
+; ARENA: @polly.arena.keyed = internal global i1 false
+; ARENA: @llvm.global_ctors = appending global {{.*}} @polly.arena.init
+; ARENA: polly.start:
+; ARENA: %D.buffer = call i8* @polly.arena.acquire(i8** @D.arena, i64 4259839)
+; ARENA: polly.exiting:
+; ARENA: call void @polly.arena.release(i8** @D.arena, i8* %D.buffer)
+; ARENA-NOT: @free
+; ARENA: define internal void @polly.arena.cleanup()
+; ARENA: load i8*, i8** @D.arena
+; ARENA: call void @free(
+; ARENA: define internal void @polly.arena.thread_exit(i8*)
+; ARENA: call void @polly.arena.cleanup()
+; ARENA: define internal void @polly.arena.init()
+; ARENA: call i32 @pthread_key_create(i32* @polly.arena.key, void (i8*)* @polly.arena.thread_exit)
+; ARENA: declare extern_weak i32 @pthread_key_create(i32*, void (i8*)*)
+; ARENA: define internal i8* @polly.arena.acquire(i8**, i64)
+; ARENA: %keyed = load i1, i1* @polly.arena.keyed
+; ARENA: call i32 @pthread_setspecific(i32 %key, i8* %
+;
 ; Check if the new access for array E is present.
 ; CODEGEN: %polly.access.mul.E = mul nsw i64 %polly.indvar, 200000
 ; CODEGEN: %polly.access.add.E = add nsw i64 %polly.access.mul.E, %
@@ -0,0 +1,70 @@
+; RUN: opt %loadPolly -polly-parallel -polly-parallel-force -polly-codegen \
+; RUN:   -polly-codegen-perf-monitoring -S < %s | FileCheck %s
+
+; Check that the parallel regions are measured: the cycles from spawning to
+; joining the threads, the cycles of the master thread in the subfunction and
+; the number of parallel regions executed.
+
+; #define N 1024
+; float A[N];
+;
+; void single_parallel_loop(void) {
+;   for (long i = 0; i < N; i++)
+;     A[i] = 1;
+; }
+
+; CHECK: @"[[SCOP:__polly_perf_in_single_parallel_loop_from__.*]]_parallel_cycles" = weak thread_local(initialexec) constant i64 0
+; CHECK: @"[[SCOP]]_parallel_work_cycles" = weak thread_local(initialexec) constant i64 0
+; CHECK: @"[[SCOP]]_parallel_regions" = weak thread_local(initialexec) constant i64 0
+
+; CHECK-LABEL: polly.parallel.for:
+; CHECK:         %[[RS:[0-9]+]] = call { i64, i32 } @llvm.x86.rdtscp()
+; CHECK-NEXT:    %[[REGIONSTART:[0-9]+]] = extractvalue { i64, i32 } %[[RS]], 0
+; CHECK-NEXT:    call void @GOMP_parallel_loop_runtime_start(
+; CHECK-NEXT:    %[[WS:[0-9]+]] = call { i64, i32 } @llvm.x86.rdtscp()
+; CHECK-NEXT:    %[[WORKSTART:[0-9]+]] = extractvalue { i64, i32 } %[[WS]], 0
+; CHECK-NEXT:    call void @single_parallel_loop_polly_subfn(
+; CHECK-NEXT:    %[[WE:[0-9]+]] = call { i64, i32 } @llvm.x86.rdtscp()
+; CHECK-NEXT:    %[[WORKEND:[0-9]+]] = extractvalue { i64, i32 } %[[WE]], 0
+; CHECK-NEXT:    call void @GOMP_parallel_end()
+; CHECK-NEXT:    %[[RE:[0-9]+]] = call { i64, i32 } @llvm.x86.rdtscp()
+; CHECK-NEXT:    %[[REGIONEND:[0-9]+]] = extractvalue { i64, i32 } %[[RE]], 0
+; CHECK-NEXT:    %[[WORK:[0-9]+]] = sub i64 %[[WORKEND]], %[[WORKSTART]]
+; CHECK-NEXT:    %[[W0:[0-9]+]] = load volatile i64, i64* @"[[SCOP]]_parallel_work_cycles"
+; CHECK-NEXT:    %[[W1:[0-9]+]] = add i64 %[[W0]], %[[WORK]]
+; CHECK-NEXT:    store volatile i64 %[[W1]], i64* @"[[SCOP]]_parallel_work_cycles"
+; CHECK-NEXT:    %[[REGION:[0-9]+]] = sub i64 %[[REGIONEND]], %[[REGIONSTART]]
+; CHECK-NEXT:    %[[R0:[0-9]+]] = load volatile i64, i64* @"[[SCOP]]_parallel_cycles"
+; CHECK-NEXT:    %[[R1:[0-9]+]] = add i64 %[[R0]], %[[REGION]]
+; CHECK-NEXT:    store volatile i64 %[[R1]], i64* @"[[SCOP]]_parallel_cycles"
+; CHECK-NEXT:    %[[C0:[0-9]+]] = load volatile i64, i64* @"[[SCOP]]_parallel_regions"
+; CHECK-NEXT:    %[[C1:[0-9]+]] = add i64 %[[C0]], 1
+; CHECK-NEXT:    store volatile i64 %[[C1]], i64* @"[[SCOP]]_parallel_regions"
+; CHECK-NEXT:    br label %polly.exiting
+
+target datalayout = "e-p:64:64:64-i1:8:8-i8:8:8-i16:16:16-i32:32:32-i64:64:64-f32:32:32-f64:64:64-v64:64:64-v128:128:128-a0:0:64-s0:64:64-f80:128:128-n8:16:32:64"
+target triple = "x86_64-unknown-linux-gnu"
+
+@A = common global [1024 x float] zeroinitializer, align 16
+
+define void @single_parallel_loop() nounwind {
+entry:
+  br label %for.i
+
+for.i:
+  %indvar = phi i64 [ %indvar.next, %for.inc], [ 0, %entry ]
+  %scevgep = getelementptr [1024 x float], [1024 x float]* @A, i64 0, i64 %indvar
+  %exitcond = icmp ne i64 %indvar, 1024
+  br i1 %exitcond, label %S, label %exit
+
+S:
+  store float 1.0, float* %scevgep
+  br label %for.inc
+
+for.inc:
+  %indvar.next = add i64 %indvar, 1
+  br label %for.i
+
+exit:
+  ret void
+}
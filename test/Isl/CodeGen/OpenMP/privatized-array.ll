@@ -0,0 +1,69 @@
+; RUN: opt %loadPolly -basicaa -polly-parallel -polly-privatize-arrays \
+; RUN:   -polly-ast -analyze < %s | FileCheck %s -check-prefix=AST
+; RUN: opt %loadPolly -basicaa -polly-parallel -polly-privatize-arrays \
+; RUN:   -polly-codegen -S -verify-dom-info < %s | FileCheck %s -check-prefix=IR
+; RUN: opt %loadPolly -basicaa -polly-parallel -polly-ast -analyze < %s \
+; RUN:   | FileCheck %s -check-prefix=NOPRIV
+;
+; The outer loop carries dependences on the temporary array tmp only. Each
+; iteration writes tmp before reading it, hence the loop is parallel if every
+; thread uses its own copy of tmp.
+;
+;    void f(double A[1024][1024], double B[1024][1024]) {
+;      double tmp[1024];
+;      for (long i = 0; i < 1024; i++) {
+;        for (long j = 0; j < 1024; j++)
+;          tmp[j] = A[i][j];
+;        for (long j = 0; j < 1024; j++)
+;          B[i][j] = tmp[j];
+;      }
+;    }
+;
+; AST:      #pragma omp parallel for private(MemRef_tmp)
+; AST-NEXT: for (int c0 = 0; c0 <= 1023; c0 += 1) {
+;
+; NOPRIV-NOT: #pragma omp parallel for
+;
+; IR-LABEL: define internal void @f_polly_subfn
+; IR:         %MemRef_tmp.private = alloca [1024 x double]
+; IR:         = {{.*}}%MemRef_tmp.private
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f([1024 x double]* noalias %A, [1024 x double]* noalias %B) {
+entry:
+  %tmp = alloca [1024 x double]
+  br label %for.i
+
+for.i:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for.i.inc ]
+  br label %for.j1
+
+for.j1:
+  %j1 = phi i64 [ 0, %for.i ], [ %j1.next, %for.j1 ]
+  %A.idx = getelementptr inbounds [1024 x double], [1024 x double]* %A, i64 %i, i64 %j1
+  %A.val = load double, double* %A.idx
+  %tmp.idx1 = getelementptr inbounds [1024 x double], [1024 x double]* %tmp, i64 0, i64 %j1
+  store double %A.val, double* %tmp.idx1
+  %j1.next = add nuw nsw i64 %j1, 1
+  %j1.cond = icmp slt i64 %j1.next, 1024
+  br i1 %j1.cond, label %for.j1, label %for.j2
+
+for.j2:
+  %j2 = phi i64 [ 0, %for.j1 ], [ %j2.next, %for.j2 ]
+  %tmp.idx2 = getelementptr inbounds [1024 x double], [1024 x double]* %tmp, i64 0, i64 %j2
+  %tmp.val = load double, double* %tmp.idx2
+  %B.idx = getelementptr inbounds [1024 x double], [1024 x double]* %B, i64 %i, i64 %j2
+  store double %tmp.val, double* %B.idx
+  %j2.next = add nuw nsw i64 %j2, 1
+  %j2.cond = icmp slt i64 %j2.next, 1024
+  br i1 %j2.cond, label %for.j2, label %for.i.inc
+
+for.i.inc:
+  %i.next = add nuw nsw i64 %i, 1
+  %i.cond = icmp slt i64 %i.next, 1024
+  br i1 %i.cond, label %for.i, label %exit
+
+exit:
+  ret void
+}
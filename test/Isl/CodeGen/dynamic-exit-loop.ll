@@ -0,0 +1,62 @@
+; RUN: opt %loadPolly -polly-process-unprofitable \
+; RUN:   -polly-allow-dynamic-exit-loops -polly-codegen -S < %s | FileCheck %s
+;
+; The generated code evaluates the exit condition of the dynamic-exit loop
+; after the copy of its latch, and leaves the optimized region as soon as the
+; original loop would have been left.
+;
+;    void f(double A[restrict 1024], double B[restrict 1024]) {
+;      do {
+;        for (long i = 0; i < 1024; i++)
+;          B[i] = A[i] * 0.5;
+;        for (long i = 0; i < 1024; i++)
+;          A[i] = B[i];
+;      } while (A[0] > 1.0);
+;    }
+;
+; CHECK:      polly.stmt.latch:
+; CHECK:        %p_notconverged = fcmp ogt double %{{.*}}, 1.000000e+00
+; CHECK-NEXT:   %polly.dynamic_exit.cond = xor i1 %p_notconverged, true
+; CHECK-NEXT:   br i1 %polly.dynamic_exit.cond, label %polly.exiting, label %polly.stmt.latch.cont
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(double* noalias %A, double* noalias %B) {
+entry:
+  br label %header
+
+header:
+  br label %loop1
+
+loop1:
+  %i = phi i64 [ 0, %header ], [ %i.next, %loop1 ]
+  %A.i = getelementptr inbounds double, double* %A, i64 %i
+  %a = load double, double* %A.i
+  %half = fmul double %a, 5.000000e-01
+  %B.i = getelementptr inbounds double, double* %B, i64 %i
+  store double %half, double* %B.i
+  %i.next = add nuw nsw i64 %i, 1
+  %cond1 = icmp slt i64 %i.next, 1024
+  br i1 %cond1, label %loop1, label %mid
+
+mid:
+  br label %loop2
+
+loop2:
+  %k = phi i64 [ 0, %mid ], [ %k.next, %loop2 ]
+  %B.k = getelementptr inbounds double, double* %B, i64 %k
+  %b = load double, double* %B.k
+  %A.k = getelementptr inbounds double, double* %A, i64 %k
+  store double %b, double* %A.k
+  %k.next = add nuw nsw i64 %k, 1
+  %cond2 = icmp slt i64 %k.next, 1024
+  br i1 %cond2, label %loop2, label %latch
+
+latch:
+  %a0 = load double, double* %A
+  %notconverged = fcmp ogt double %a0, 1.000000e+00
+  br i1 %notconverged, label %header, label %exit
+
+exit:
+  ret void
+}
@@ -0,0 +1,52 @@
+; RUN: rm -rf %t && mkdir -p %t
+; RUN: opt %loadPolly -polly-export-jscop -polly-export-schedule-tree \
+; RUN:   -polly-import-jscop-dir=%t -disable-output < %s
+; RUN: opt %loadPolly -polly-import-jscop -polly-import-jscop-dir=%t \
+; RUN:   -polly-ast -analyze < %s | FileCheck %s
+;
+; Re-import an untouched export that contains both the schedule tree and the
+; per-statement schedules. The exported statement schedules are gisted with
+; respect to the parametric statement domains, hence they are not equal to the
+; restriction of the tree to the domains, but must not be reported as edits.
+;
+;    void f(long n, double A[][n]) {
+;      for (long i = 0; i < n; i++)
+;        for (long j = 0; j < n; j++)
+;    S:    A[i][j] = i + j;
+;    }
+;
+; CHECK:      for (int c0 = 0; c0 < n; c0 += 1)
+; CHECK-NEXT:   for (int c1 = 0; c1 < n; c1 += 1)
+; CHECK-NEXT:     Stmt_S(c0, c1);
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(i64 %n, double* %A) {
+entry:
+  %guard = icmp sgt i64 %n, 0
+  br i1 %guard, label %outer, label %exit
+
+outer:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %outer.inc ]
+  br label %S
+
+S:
+  %j = phi i64 [ 0, %outer ], [ %j.next, %S ]
+  %sum = add nsw i64 %i, %j
+  %val = sitofp i64 %sum to double
+  %row = mul nsw i64 %i, %n
+  %idx = add nsw i64 %row, %j
+  %arrayidx = getelementptr inbounds double, double* %A, i64 %idx
+  store double %val, double* %arrayidx
+  %j.next = add nuw nsw i64 %j, 1
+  %inner.cond = icmp slt i64 %j.next, %n
+  br i1 %inner.cond, label %S, label %outer.inc
+
+outer.inc:
+  %i.next = add nuw nsw i64 %i, 1
+  %outer.cond = icmp slt i64 %i.next, %n
+  br i1 %outer.cond, label %outer, label %exit
+
+exit:
+  ret void
+}
@@ -0,0 +1,86 @@
+; RUN: rm -rf %t && mkdir -p %t
+;
+; Without -polly-export-schedule-tree only the per-statement schedules are
+; exported, and an edited statement schedule is imported.
+;
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-export-jscop \
+; RUN:   -polly-import-jscop-dir=%t -disable-output < %s
+; RUN: cat %t/*.jscop | FileCheck %s -check-prefix=FLAT
+; RUN: sed -i -e 's/\[0, i0\]/[2, i0]/' %t/*.jscop
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-import-jscop \
+; RUN:   -polly-import-jscop-dir=%t -polly-ast -analyze < %s \
+; RUN:   | FileCheck %s -check-prefix=EDITED
+;
+; With -polly-export-schedule-tree the schedule tree is exported as well and
+; imported unchanged. Editing only a statement schedule is reported.
+;
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-export-jscop \
+; RUN:   -polly-export-schedule-tree -polly-import-jscop-dir=%t \
+; RUN:   -disable-output < %s
+; RUN: cat %t/*.jscop | FileCheck %s -check-prefix=TREE
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-import-jscop \
+; RUN:   -polly-import-jscop-dir=%t -polly-opt-isl -polly-ast -analyze < %s \
+; RUN:   | FileCheck %s -check-prefix=UNCHANGED
+; RUN: sed -i -e 's/\[0, i0\]/[2, i0]/' %t/*.jscop
+; RUN: not opt %loadPolly -polly-process-unprofitable -polly-import-jscop \
+; RUN:   -polly-import-jscop-dir=%t -polly-ast -analyze < %s 2>&1 >/dev/null \
+; RUN:   | FileCheck %s -check-prefix=CONFLICT
+;
+;    void rt(int A[1024], int B[1024]) {
+;      for (int i = 0; i < 1024; i++)
+; S0:    A[i] = i;
+;      for (int i = 0; i < 1024; i++)
+; S1:    B[i] = i;
+;    }
+;
+; FLAT-NOT: domain:
+; FLAT:     Stmt_S0[i0] -> [0, i0]
+;
+; EDITED:      for (int c0 = 0; c0 <= 1023; c0 += 1)
+; EDITED-NEXT:   Stmt_S1(c0);
+; EDITED-NEXT: for (int c0 = 0; c0 <= 1023; c0 += 1)
+; EDITED-NEXT:   Stmt_S0(c0);
+;
+; TREE: { domain:
+;
+; UNCHANGED:      for (int c0 = 0; c0 <= 1023; c0 += 1)
+; UNCHANGED-NEXT:   Stmt_S0(c0);
+; UNCHANGED-NEXT: for (int c0 = 0; c0 <= 1023; c0 += 1)
+; UNCHANGED-NEXT:   Stmt_S1(c0);
+;
+; CONFLICT: The schedule of statement Stmt_S0 differs from the schedule tree.
+;
+target datalayout = "e-m:e-p:32:32-i64:64-v128:64:128-n32-S64"
+
+define void @rt(i32* %A, i32* %B) {
+entry:
+  br label %loop0
+
+loop0:                                            ; preds = %S0, %entry
+  %i.0 = phi i32 [ 0, %entry ], [ %inc, %S0 ]
+  br label %S0
+
+S0:                                               ; preds = %loop0
+  %arrayidx = getelementptr inbounds i32, i32* %A, i32 %i.0
+  store i32 %i.0, i32* %arrayidx, align 4
+  %inc = add nsw i32 %i.0, 1
+  %cmp = icmp slt i32 %inc, 1024
+  br i1 %cmp, label %loop0, label %loop1.preheader
+
+loop1.preheader:                                  ; preds = %S0
+  br label %loop1
+
+loop1:                                            ; preds = %S1, %loop1.preheader
+  %j.0 = phi i32 [ 0, %loop1.preheader ], [ %inc1, %S1 ]
+  br label %S1
+
+S1:                                               ; preds = %loop1
+  %arrayidx1 = getelementptr inbounds i32, i32* %B, i32 %j.0
+  store i32 %j.0, i32* %arrayidx1, align 4
+  %inc1 = add nsw i32 %j.0, 1
+  %cmp1 = icmp slt i32 %inc1, 1024
+  br i1 %cmp1, label %loop1, label %exit
+
+exit:                                             ; preds = %S1
+  ret void
+}
@@ -0,0 +1,64 @@
+; RUN: opt %loadPolly -polly-mse -polly-mse-bounded -analyze < %s \
+; RUN:   | FileCheck %s
+; RUN: opt %loadPolly -polly-mse -analyze < %s \
+; RUN:   | FileCheck %s --check-prefix=FULL
+;
+; Verify that B, whose values are read one iteration of the outer loop after
+; they are written, is expanded modulo 2 along the outer loop only.
+;
+;    void f(double *B, double C[100][1000]) {
+;      for (long t = 0; t < 100; t++)
+;        for (long i = 0; i < 1000; i++) {
+;          if (t > 0)
+;            C[t][i] = B[i];
+;          B[i] = t;
+;        }
+;    }
+;
+; CHECK: double MemRef_B_Stmt_write_expanded[2][1000]; // Element size 8
+; CHECK: new: { Stmt_read[i0, i1] -> MemRef_B_Stmt_write_expanded[o0, i1] :{{.*}}
+; CHECK: new: { Stmt_write[i0, i1] -> MemRef_B_Stmt_write_expanded[o0, i1] :{{.*}}
+;
+; FULL: double MemRef_B_Stmt_write_expanded[100][1000]; // Element size 8
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(double* noalias %B, [1000 x double]* noalias %C) {
+entry:
+  br label %entry.split
+
+entry.split:
+  br label %for.t
+
+for.t:
+  %t = phi i64 [ 0, %entry.split ], [ %t.next, %for.t.inc ]
+  br label %for.i
+
+for.i:
+  %i = phi i64 [ 0, %for.t ], [ %i.next, %write ]
+  %cmp = icmp sgt i64 %t, 0
+  br i1 %cmp, label %read, label %write
+
+read:
+  %B.idx = getelementptr inbounds double, double* %B, i64 %i
+  %val = load double, double* %B.idx
+  %C.idx = getelementptr inbounds [1000 x double], [1000 x double]* %C, i64 %t, i64 %i
+  store double %val, double* %C.idx
+  br label %write
+
+write:
+  %conv = sitofp i64 %t to double
+  %B.idx2 = getelementptr inbounds double, double* %B, i64 %i
+  store double %conv, double* %B.idx2
+  %i.next = add nuw nsw i64 %i, 1
+  %i.cond = icmp slt i64 %i.next, 1000
+  br i1 %i.cond, label %for.i, label %for.t.inc
+
+for.t.inc:
+  %t.next = add nuw nsw i64 %t, 1
+  %t.cond = icmp slt i64 %t.next, 100
+  br i1 %t.cond, label %for.t, label %exit
+
+exit:
+  ret void
+}
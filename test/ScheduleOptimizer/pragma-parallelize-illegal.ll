@@ -0,0 +1,39 @@
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-opt-isl -analyze \
+; RUN:   -polly-ast < %s 2>&1 | FileCheck %s
+;
+;    void prefix(int A[1024]) {
+;      #pragma clang loop parallelize_thread(enable)
+;      for (int i = 1; i < 1024; i++)
+;        A[i] = A[i - 1] + 1;
+;    }
+;
+; Each iteration depends on the previous one. Verify that the directive is
+; rejected with a warning and the loop is not executed in parallel.
+
+; CHECK:     warning: {{.*}}loop not parallelized: the loop carries a data dependence
+; CHECK-NOT: #pragma omp parallel for
+
+target datalayout = "e-m:e-p:32:32-i64:64-v128:64:128-n32-S64"
+
+define void @prefix(i32* %A) {
+entry:
+  br label %for.body
+
+for.body:                                         ; preds = %for.body, %entry
+  %i.0 = phi i32 [ 1, %entry ], [ %inc, %for.body ]
+  %sub = add nsw i32 %i.0, -1
+  %arrayidx = getelementptr inbounds i32, i32* %A, i32 %sub
+  %val = load i32, i32* %arrayidx, align 4
+  %add = add nsw i32 %val, 1
+  %arrayidx1 = getelementptr inbounds i32, i32* %A, i32 %i.0
+  store i32 %add, i32* %arrayidx1, align 4
+  %inc = add nsw i32 %i.0, 1
+  %cmp = icmp slt i32 %inc, 1024
+  br i1 %cmp, label %for.body, label %for.end, !llvm.loop !0
+
+for.end:                                          ; preds = %for.body
+  ret void
+}
+
+!0 = distinct !{!0, !1}
+!1 = !{!"llvm.loop.parallelize_thread.enable", i1 true}
@@ -0,0 +1,46 @@
+; RUN: opt %loadPolly -polly-opt-isl -analyze -polly-ast < %s | FileCheck %s
+;
+;    void parallelize(int A[][512]) {
+;      #pragma clang loop parallelize_thread(enable)
+;      for (int i = 0; i < 1024; i++)
+;        for (int j = 0; j < 512; j++)
+;          A[i][j] = (i * j) % 42;
+;    }
+;
+; Verify that the loop is executed in parallel, although -polly-parallel is
+; not given.
+
+; CHECK:      #pragma omp parallel for
+; CHECK-NEXT: for (int c0 = 0; c0 <= 1023; c0 += 1)
+
+target datalayout = "e-m:e-p:32:32-i64:64-v128:64:128-n32-S64"
+
+define void @parallelize([512 x i32]* %A) {
+entry:
+  br label %for.body3.lr.ph
+
+for.body3.lr.ph:                                  ; preds = %for.inc5, %entry
+  %i.0 = phi i32 [ 0, %entry ], [ %inc6, %for.inc5 ]
+  br label %for.body3
+
+for.body3:                                        ; preds = %for.body3.lr.ph, %for.body3
+  %j.0 = phi i32 [ 0, %for.body3.lr.ph ], [ %inc, %for.body3 ]
+  %mul = mul nsw i32 %j.0, %i.0
+  %rem = srem i32 %mul, 42
+  %arrayidx4 = getelementptr inbounds [512 x i32], [512 x i32]* %A, i32 %i.0, i32 %j.0
+  store i32 %rem, i32* %arrayidx4, align 4
+  %inc = add nsw i32 %j.0, 1
+  %cmp2 = icmp slt i32 %inc, 512
+  br i1 %cmp2, label %for.body3, label %for.inc5
+
+for.inc5:                                         ; preds = %for.body3
+  %inc6 = add nsw i32 %i.0, 1
+  %cmp = icmp slt i32 %inc6, 1024
+  br i1 %cmp, label %for.body3.lr.ph, label %for.end7, !llvm.loop !0
+
+for.end7:                                         ; preds = %for.inc5
+  ret void
+}
+
+!0 = distinct !{!0, !1}
+!1 = !{!"llvm.loop.parallelize_thread.enable", i1 true}
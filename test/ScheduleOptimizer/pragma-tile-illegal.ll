@@ -0,0 +1,50 @@
+; RUN: opt %loadPolly -polly-opt-isl -analyze -polly-ast < %s 2>&1 \
+; RUN:   | FileCheck %s
+;
+;    void tile_skewed(int A[][513]) {
+;      #pragma clang loop tile depth(2) tile_size(32)
+;      for (int i = 1; i < 1024; i++)
+;        for (int j = 0; j < 512; j++)
+;          A[i][j] = A[i - 1][j + 1];
+;    }
+;
+; The dependence with distance (1, -1) crosses tile boundaries backwards in
+; the inner dimension. Verify that the directive is rejected with a warning.
+
+; CHECK: warning: {{.*}}loop not tiled: tiling would violate data dependences
+
+target datalayout = "e-m:e-p:32:32-i64:64-v128:64:128-n32-S64"
+
+define void @tile_skewed([513 x i32]* %A) {
+entry:
+  br label %for.body3.lr.ph
+
+for.body3.lr.ph:                                  ; preds = %for.inc, %entry
+  %i.0 = phi i32 [ 1, %entry ], [ %inc6, %for.inc ]
+  %sub = add nsw i32 %i.0, -1
+  br label %for.body3
+
+for.body3:                                        ; preds = %for.body3.lr.ph, %for.body3
+  %j.0 = phi i32 [ 0, %for.body3.lr.ph ], [ %inc, %for.body3 ]
+  %add = add nsw i32 %j.0, 1
+  %arrayidx = getelementptr inbounds [513 x i32], [513 x i32]* %A, i32 %sub, i32 %add
+  %val = load i32, i32* %arrayidx, align 4
+  %arrayidx4 = getelementptr inbounds [513 x i32], [513 x i32]* %A, i32 %i.0, i32 %j.0
+  store i32 %val, i32* %arrayidx4, align 4
+  %inc = add nsw i32 %j.0, 1
+  %cmp2 = icmp slt i32 %inc, 512
+  br i1 %cmp2, label %for.body3, label %for.inc
+
+for.inc:                                          ; preds = %for.body3
+  %inc6 = add nsw i32 %i.0, 1
+  %cmp = icmp slt i32 %inc6, 1024
+  br i1 %cmp, label %for.body3.lr.ph, label %for.end, !llvm.loop !0
+
+for.end:                                          ; preds = %for.inc
+  ret void
+}
+
+!0 = distinct !{!0, !1, !2, !3}
+!1 = !{!"llvm.loop.tile.enable", i1 true}
+!2 = !{!"llvm.loop.tile.depth", i32 2}
+!3 = !{!"llvm.loop.tile.size", i32 32}
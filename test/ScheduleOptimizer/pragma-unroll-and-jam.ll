@@ -0,0 +1,52 @@
+; RUN: opt %loadPolly -polly-opt-isl -analyze -polly-ast < %s | FileCheck %s
+;
+;    void unroll_and_jam(int A[][512]) {
+;      #pragma unroll_and_jam(4)
+;      for (int i = 0; i < 1024; i++)
+;        for (int j = 0; j < 512; j++)
+;          A[i][j] = (i * j) % 42;
+;    }
+;
+; Verify that four iterations of the outer loop are jammed into the body of
+; the inner loop.
+
+; CHECK:      for (int c0 = 0; c0 <= 255; c0 += 1)
+; CHECK-NEXT:   for (int c1 = 0; c1 <= 511; c1 += 1) {
+; CHECK-NEXT:     Stmt_for_body3(4 * c0, c1);
+; CHECK-NEXT:     Stmt_for_body3(4 * c0 + 1, c1);
+; CHECK-NEXT:     Stmt_for_body3(4 * c0 + 2, c1);
+; CHECK-NEXT:     Stmt_for_body3(4 * c0 + 3, c1);
+; CHECK-NEXT:   }
+
+target datalayout = "e-m:e-p:32:32-i64:64-v128:64:128-n32-S64"
+
+define void @unroll_and_jam([512 x i32]* %A) {
+entry:
+  br label %for.body3.lr.ph
+
+for.body3.lr.ph:                                  ; preds = %for.inc5, %entry
+  %i.0 = phi i32 [ 0, %entry ], [ %inc6, %for.inc5 ]
+  br label %for.body3
+
+for.body3:                                        ; preds = %for.body3.lr.ph, %for.body3
+  %j.0 = phi i32 [ 0, %for.body3.lr.ph ], [ %inc, %for.body3 ]
+  %mul = mul nsw i32 %j.0, %i.0
+  %rem = srem i32 %mul, 42
+  %arrayidx4 = getelementptr inbounds [512 x i32], [512 x i32]* %A, i32 %i.0, i32 %j.0
+  store i32 %rem, i32* %arrayidx4, align 4
+  %inc = add nsw i32 %j.0, 1
+  %cmp2 = icmp slt i32 %inc, 512
+  br i1 %cmp2, label %for.body3, label %for.inc5
+
+for.inc5:                                         ; preds = %for.body3
+  %inc6 = add nsw i32 %i.0, 1
+  %cmp = icmp slt i32 %inc6, 1024
+  br i1 %cmp, label %for.body3.lr.ph, label %for.end7, !llvm.loop !0
+
+for.end7:                                         ; preds = %for.inc5
+  ret void
+}
+
+!0 = distinct !{!0, !1, !2}
+!1 = !{!"llvm.loop.unroll_and_jam.enable", i1 true}
+!2 = !{!"llvm.loop.unroll_and_jam.count", i32 4}
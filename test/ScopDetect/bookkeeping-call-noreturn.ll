@@ -0,0 +1,138 @@
+; RUN: opt %loadPolly -basicaa -polly-absorb-bookkeeping-calls -polly-detect \
+; RUN:   -analyze < %s | FileCheck %s
+;
+; Verify that calls which may not return are not absorbed as bookkeeping
+; calls: neither a call to the noreturn function exit(), nor a call to a
+; function that is not known to return (not willreturn). Otherwise, the loop
+; nest after the call would be executed although the program terminated or
+; hangs in the call.
+;
+;    void f(double *restrict A, double *restrict B, long n) {
+;      for (long i = 0; i < n; i++)
+;        A[i] = i;
+;      exit(1);                        // resp. wait();
+;      for (long i = 0; i < n; i++)
+;        B[i] = A[i];
+;    }
+;
+; CHECK-NOT: Valid Region for Scop: for1.cond => exit
+; CHECK:     Valid Region for Scop: for1.cond => exit
+; CHECK-NOT: Valid Region for Scop: for1.cond => exit
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @exit_call(double* noalias %A, double* noalias %B, i64 %n) {
+entry:
+  br label %for1.cond
+
+for1.cond:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for1.body ]
+  %cmp1 = icmp slt i64 %i, %n
+  br i1 %cmp1, label %for1.body, label %mid
+
+for1.body:
+  %conv = sitofp i64 %i to double
+  %arrayidx = getelementptr inbounds double, double* %A, i64 %i
+  store double %conv, double* %arrayidx
+  %i.next = add nuw nsw i64 %i, 1
+  br label %for1.cond
+
+mid:
+  call void @exit(i32 1)
+  br label %for2.cond
+
+for2.cond:
+  %j = phi i64 [ 0, %mid ], [ %j.next, %for2.body ]
+  %cmp2 = icmp slt i64 %j, %n
+  br i1 %cmp2, label %for2.body, label %exit
+
+for2.body:
+  %arrayidx.A = getelementptr inbounds double, double* %A, i64 %j
+  %val = load double, double* %arrayidx.A
+  %arrayidx.B = getelementptr inbounds double, double* %B, i64 %j
+  store double %val, double* %arrayidx.B
+  %j.next = add nuw nsw i64 %j, 1
+  br label %for2.cond
+
+exit:
+  ret void
+}
+
+define void @no_willreturn(double* noalias %A, double* noalias %B, i64 %n) {
+entry:
+  br label %for1.cond
+
+for1.cond:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for1.body ]
+  %cmp1 = icmp slt i64 %i, %n
+  br i1 %cmp1, label %for1.body, label %mid
+
+for1.body:
+  %conv = sitofp i64 %i to double
+  %arrayidx = getelementptr inbounds double, double* %A, i64 %i
+  store double %conv, double* %arrayidx
+  %i.next = add nuw nsw i64 %i, 1
+  br label %for1.cond
+
+mid:
+  call void @wait()
+  br label %for2.cond
+
+for2.cond:
+  %j = phi i64 [ 0, %mid ], [ %j.next, %for2.body ]
+  %cmp2 = icmp slt i64 %j, %n
+  br i1 %cmp2, label %for2.body, label %exit
+
+for2.body:
+  %arrayidx.A = getelementptr inbounds double, double* %A, i64 %j
+  %val = load double, double* %arrayidx.A
+  %arrayidx.B = getelementptr inbounds double, double* %B, i64 %j
+  store double %val, double* %arrayidx.B
+  %j.next = add nuw nsw i64 %j, 1
+  br label %for2.cond
+
+exit:
+  ret void
+}
+
+; Same as above, but the call is known to return; it is absorbed.
+define void @willreturn(double* noalias %A, double* noalias %B, i64 %n) {
+entry:
+  br label %for1.cond
+
+for1.cond:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for1.body ]
+  %cmp1 = icmp slt i64 %i, %n
+  br i1 %cmp1, label %for1.body, label %mid
+
+for1.body:
+  %conv = sitofp i64 %i to double
+  %arrayidx = getelementptr inbounds double, double* %A, i64 %i
+  store double %conv, double* %arrayidx
+  %i.next = add nuw nsw i64 %i, 1
+  br label %for1.cond
+
+mid:
+  call void @tick()
+  br label %for2.cond
+
+for2.cond:
+  %j = phi i64 [ 0, %mid ], [ %j.next, %for2.body ]
+  %cmp2 = icmp slt i64 %j, %n
+  br i1 %cmp2, label %for2.body, label %exit
+
+for2.body:
+  %arrayidx.A = getelementptr inbounds double, double* %A, i64 %j
+  %val = load double, double* %arrayidx.A
+  %arrayidx.B = getelementptr inbounds double, double* %B, i64 %j
+  store double %val, double* %arrayidx.B
+  %j.next = add nuw nsw i64 %j, 1
+  br label %for2.cond
+
+exit:
+  ret void
+}
+
+declare void @exit(i32) noreturn nounwind
+declare void @wait() nounwind
+declare void @tick() nounwind willreturn
@@ -0,0 +1,59 @@
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-detect -analyze \
+; RUN:   < %s | FileCheck %s -check-prefix=REJECT
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-allow-early-exit-loops \
+; RUN:   -polly-detect -analyze < %s | FileCheck %s
+;
+; The inner loop leaves early under a data-dependent condition, but its latch
+; bounds it by an affine number of iterations. With -polly-allow-early-exit-loops
+; it is over-approximated by a region statement, such that the outer loop can
+; be modeled.
+;
+;    void f(int A[restrict], long B[restrict], int x) {
+;      for (long j = 0; j < 128; j++) {
+;        long i;
+;        for (i = 0; i < 1024; i++)
+;          if (A[j * 1024 + i] == x)
+;            break;
+;        B[j] = i;
+;      }
+;    }
+;
+; REJECT-NOT: Valid Region for Scop:
+;
+; CHECK: Valid Region for Scop: outer => exit
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(i32* noalias %A, i64* noalias %B, i32 %x) {
+entry:
+  br label %outer
+
+outer:
+  %j = phi i64 [ 0, %entry ], [ %j.next, %outer.inc ]
+  %row = mul nsw i64 %j, 1024
+  br label %inner
+
+inner:
+  %i = phi i64 [ 0, %outer ], [ %i.next, %inner.inc ]
+  %idx = add nsw i64 %row, %i
+  %A.idx = getelementptr inbounds i32, i32* %A, i64 %idx
+  %val = load i32, i32* %A.idx
+  %match = icmp eq i32 %val, %x
+  br i1 %match, label %outer.inc, label %inner.inc
+
+inner.inc:
+  %i.next = add nuw nsw i64 %i, 1
+  %inner.cond = icmp slt i64 %i.next, 1024
+  br i1 %inner.cond, label %inner, label %outer.inc
+
+outer.inc:
+  %i.lcssa = phi i64 [ %i, %inner ], [ 1024, %inner.inc ]
+  %B.j = getelementptr inbounds i64, i64* %B, i64 %j
+  store i64 %i.lcssa, i64* %B.j
+  %j.next = add nuw nsw i64 %j, 1
+  %outer.cond = icmp slt i64 %j.next, 128
+  br i1 %outer.cond, label %outer, label %exit
+
+exit:
+  ret void
+}
@@ -0,0 +1,83 @@
+; RUN: opt %loadPolly -basicaa -polly-absorb-bookkeeping-calls -polly-scops \
+; RUN:   -analyze < %s | FileCheck %s
+; RUN: opt %loadPolly -basicaa -polly-absorb-bookkeeping-calls \
+; RUN:   -polly-dependences -analyze < %s | FileCheck %s --check-prefix=DEPS
+; RUN: opt %loadPolly -basicaa -polly-scops -analyze < %s \
+; RUN:   | FileCheck %s --check-prefix=NOBOOKKEEPING
+;
+; Verify that calls with unknown side effects between two loop nests do not
+; split the SCoP. They cannot access the restrict arrays A and B, hence their
+; statements have no accesses, but they stay ordered among each other.
+;
+;    void f(double *restrict A, double *restrict B, long n) {
+;      for (long i = 0; i < n; i++)
+;        A[i] = i;
+;      tick();
+;      for (long i = 0; i < n; i++)
+;        B[i] = A[i];
+;      tick();
+;    }
+;
+; CHECK:      Region: %for1.cond---%exit
+; CHECK:      Stmt_mid1
+; CHECK-NEXT:     Domain :=
+; CHECK-NEXT:         [n] -> { Stmt_mid1[] };
+; CHECK-NEXT:     Schedule :=
+; CHECK-NEXT:         [n] -> { Stmt_mid1[] -> [1, 0] };
+; CHECK-NEXT: Stmt_for2_body
+; CHECK:      Stmt_mid2
+; CHECK-NEXT:     Domain :=
+; CHECK-NEXT:         [n] -> { Stmt_mid2[] };
+; CHECK-NEXT:     Schedule :=
+; CHECK-NEXT:         [n] -> { Stmt_mid2[] -> [3, 0] };
+; CHECK-NEXT: }
+;
+; DEPS: RAW dependences:
+; DEPS-NEXT: {{.*}}Stmt_mid1[] -> Stmt_mid2[]{{.*}}
+;
+; NOBOOKKEEPING-NOT: Region: %for1.cond---%exit
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(double* noalias %A, double* noalias %B, i64 %n) {
+entry:
+  br label %for1.cond
+
+for1.cond:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for1.body ]
+  %cmp1 = icmp slt i64 %i, %n
+  br i1 %cmp1, label %for1.body, label %mid1
+
+for1.body:
+  %conv = sitofp i64 %i to double
+  %arrayidx = getelementptr inbounds double, double* %A, i64 %i
+  store double %conv, double* %arrayidx
+  %i.next = add nuw nsw i64 %i, 1
+  br label %for1.cond
+
+mid1:
+  call void @tick()
+  br label %for2.cond
+
+for2.cond:
+  %j = phi i64 [ 0, %mid1 ], [ %j.next, %for2.body ]
+  %cmp2 = icmp slt i64 %j, %n
+  br i1 %cmp2, label %for2.body, label %mid2
+
+for2.body:
+  %arrayidx.A = getelementptr inbounds double, double* %A, i64 %j
+  %val = load double, double* %arrayidx.A
+  %arrayidx.B = getelementptr inbounds double, double* %B, i64 %j
+  store double %val, double* %arrayidx.B
+  %j.next = add nuw nsw i64 %j, 1
+  br label %for2.cond
+
+mid2:
+  call void @tick()
+  br label %exit
+
+exit:
+  ret void
+}
+
+declare void @tick() nounwind willreturn
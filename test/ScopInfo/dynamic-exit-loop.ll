@@ -0,0 +1,87 @@
+; RUN: opt %loadPolly -polly-process-unprofitable -polly-detect -analyze \
+; RUN:   < %s | FileCheck %s -check-prefix=REJECT
+; RUN: opt %loadPolly -polly-process-unprofitable \
+; RUN:   -polly-allow-dynamic-exit-loops -polly-scops -analyze < %s \
+; RUN:   | FileCheck %s
+; RUN: opt %loadPolly -polly-process-unprofitable \
+; RUN:   -polly-allow-dynamic-exit-loops -polly-dependences -analyze < %s \
+; RUN:   | FileCheck %s -check-prefix=DEPS
+;
+; The outer loop iterates until the values in A converge, which is only known
+; at run time. With -polly-allow-dynamic-exit-loops its iteration domain is
+; over-approximated by a large constant bound, such that the affine nests in
+; its body can be modeled. The statement of the latch evaluates the exit
+; condition: it depends on the statements of its iteration, and the statements
+; of later iterations depend on it.
+;
+;    void f(double A[restrict 1024], double B[restrict 1024]) {
+;      do {
+;        for (long i = 0; i < 1024; i++)
+;          B[i] = A[i] * 0.5;
+;        for (long i = 0; i < 1024; i++)
+;          A[i] = B[i];
+;      } while (A[0] > 1.0);
+;    }
+;
+; REJECT-NOT: Valid Region for Scop:
+;
+; CHECK:      Statements {
+; CHECK-NEXT:   Stmt_loop1
+; CHECK-NEXT:     Domain :=
+; CHECK-NEXT:       { Stmt_loop1[i0, i1] : 0 <= i0 <= 4611686018427387903 and 0 <= i1 <= 1023 };
+; CHECK:        Stmt_loop2
+; CHECK-NEXT:     Domain :=
+; CHECK-NEXT:       { Stmt_loop2[i0, i1] : 0 <= i0 <= 4611686018427387903 and 0 <= i1 <= 1023 };
+; CHECK:        Stmt_latch
+; CHECK-NEXT:     Domain :=
+; CHECK-NEXT:       { Stmt_latch[i0] : 0 <= i0 <= 4611686018427387903 };
+; CHECK:            ReadAccess := [Reduction Type: NONE] [Scalar: 0]
+; CHECK-NEXT:         { Stmt_latch[i0] -> MemRef_A[0] };
+; CHECK-NEXT: }
+;
+; DEPS:      RAW dependences:
+; DEPS-NEXT:   {{.*}}Stmt_loop1[i0, i1] -> Stmt_latch[i0]
+; DEPS-SAME:   Stmt_latch[i0] -> Stmt_loop1[o0, o1] : {{.*}}o0 > i0
+; DEPS:      WAR dependences:
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(double* noalias %A, double* noalias %B) {
+entry:
+  br label %header
+
+header:
+  br label %loop1
+
+loop1:
+  %i = phi i64 [ 0, %header ], [ %i.next, %loop1 ]
+  %A.i = getelementptr inbounds double, double* %A, i64 %i
+  %a = load double, double* %A.i
+  %half = fmul double %a, 5.000000e-01
+  %B.i = getelementptr inbounds double, double* %B, i64 %i
+  store double %half, double* %B.i
+  %i.next = add nuw nsw i64 %i, 1
+  %cond1 = icmp slt i64 %i.next, 1024
+  br i1 %cond1, label %loop1, label %mid
+
+mid:
+  br label %loop2
+
+loop2:
+  %k = phi i64 [ 0, %mid ], [ %k.next, %loop2 ]
+  %B.k = getelementptr inbounds double, double* %B, i64 %k
+  %b = load double, double* %B.k
+  %A.k = getelementptr inbounds double, double* %A, i64 %k
+  store double %b, double* %A.k
+  %k.next = add nuw nsw i64 %k, 1
+  %cond2 = icmp slt i64 %k.next, 1024
+  br i1 %cond2, label %loop2, label %latch
+
+latch:
+  %a0 = load double, double* %A
+  %notconverged = fcmp ogt double %a0, 1.000000e+00
+  br i1 %notconverged, label %header, label %exit
+
+exit:
+  ret void
+}
@@ -0,0 +1,44 @@
+; RUN: opt %loadPolly -polly-scops -polly-print-scop-memory-usage -analyze \
+; RUN:   < %s | FileCheck %s
+; RUN: opt %loadPolly -polly-scops -polly-print-scop-memory-usage \
+; RUN:   -polly-compact-scops=false -analyze < %s \
+; RUN:   | FileCheck %s --check-prefix=NOCOMPACT
+;
+; Verify that the load and the store of A[i], which access the same element,
+; share their access relation after the SCoP has been compacted.
+;
+;    void f(float *A) {
+;      for (long i = 0; i < 1024; i++)
+;        A[i] += i;
+;    }
+;
+; CHECK:      Memory Usage: {
+; CHECK-NEXT:     Statements: 1
+; CHECK-NEXT:     Accesses: 2
+; CHECK-NEXT:     Access relations: 2 (1 distinct)
+;
+; NOCOMPACT:      Memory Usage: {
+; NOCOMPACT-NEXT:     Statements: 1
+; NOCOMPACT-NEXT:     Accesses: 2
+; NOCOMPACT-NEXT:     Access relations: 2 (2 distinct)
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @f(float* %A) {
+entry:
+  br label %for.body
+
+for.body:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for.body ]
+  %conv = sitofp i64 %i to float
+  %arrayidx = getelementptr inbounds float, float* %A, i64 %i
+  %val = load float, float* %arrayidx
+  %add = fadd float %val, %conv
+  store float %add, float* %arrayidx
+  %i.next = add nuw nsw i64 %i, 1
+  %exitcond = icmp ne i64 %i.next, 1024
+  br i1 %exitcond, label %for.body, label %exit
+
+exit:
+  ret void
+}
@@ -0,0 +1,87 @@
+; RUN: opt %loadPolly -polly-process-unprofitable=false -polly-scop-summaries \
+; RUN:   -polly-scops -analyze < %s | FileCheck %s
+; RUN: opt %loadPolly -polly-process-unprofitable=false -polly-scops -analyze \
+; RUN:   < %s | FileCheck %s --check-prefix=NOSUMMARY
+;
+; Verify that @init is summarized although it is not a profitable SCoP on its
+; own, such that the profitable SCoP of @caller can model the call.
+;
+;    void init(double *A, long n) {
+;      for (long j = 0; j < n; j++)
+;        A[j] = 0;
+;    }
+;
+;    void caller(double *A, double *B, long m, long n) {
+;      for (long i = 0; i < m; i++) {
+;        for (long k = 0; k < n; k++)
+;          B[100 * i + k] += 1;
+;        init(&A[100 * i], n);
+;      }
+;    }
+;
+; CHECK-NOT: Function: init
+; CHECK-LABEL: Function: caller
+; CHECK:      Stmt_for_call
+; CHECK:        MayWriteAccess := [Reduction Type: NONE] [Scalar: 0]
+; CHECK-NEXT:       {{.*}} { Stmt_for_call[i0] -> MemRef_A[o0] : 100i0 <= o0 < 100i0 + n };
+;
+; NOSUMMARY-NOT: Function: caller
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @init(double* %A, i64 %n) {
+entry:
+  br label %for.cond
+
+for.cond:
+  %j = phi i64 [ 0, %entry ], [ %j.next, %for.body ]
+  %cmp = icmp slt i64 %j, %n
+  br i1 %cmp, label %for.body, label %for.end
+
+for.body:
+  %arrayidx = getelementptr inbounds double, double* %A, i64 %j
+  store double 0.000000e+00, double* %arrayidx
+  %j.next = add nuw nsw i64 %j, 1
+  br label %for.cond
+
+for.end:
+  ret void
+}
+
+define void @caller(double* %A, double* %B, i64 %m, i64 %n) {
+entry:
+  br label %for.cond
+
+for.cond:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for.inc ]
+  %cmp = icmp slt i64 %i, %m
+  br i1 %cmp, label %for.inner, label %for.end
+
+for.inner:
+  %k = phi i64 [ 0, %for.cond ], [ %k.next, %for.body ]
+  %cmp.inner = icmp slt i64 %k, %n
+  br i1 %cmp.inner, label %for.body, label %for.call
+
+for.body:
+  %offset.B = mul nsw i64 %i, 100
+  %idx.B = add nsw i64 %offset.B, %k
+  %arrayidx.B = getelementptr inbounds double, double* %B, i64 %idx.B
+  %val = load double, double* %arrayidx.B
+  %add = fadd double %val, 1.000000e+00
+  store double %add, double* %arrayidx.B
+  %k.next = add nuw nsw i64 %k, 1
+  br label %for.inner
+
+for.call:
+  %offset = mul nsw i64 %i, 100
+  %arrayidx = getelementptr inbounds double, double* %A, i64 %offset
+  call void @init(double* %arrayidx, i64 %n)
+  br label %for.inc
+
+for.inc:
+  %i.next = add nuw nsw i64 %i, 1
+  br label %for.cond
+
+for.end:
+  ret void
+}
@@ -0,0 +1,69 @@
+; RUN: opt %loadPolly -polly-scop-summaries -polly-scops -analyze < %s \
+; RUN:   | FileCheck %s
+; RUN: opt %loadPolly -polly-scops -analyze < %s \
+; RUN:   | FileCheck %s --check-prefix=NOSUMMARY
+;
+; Verify that the call to @init is modeled by the summary of its accesses,
+; i.e. that each call writes the n elements starting at &A[100 * i].
+;
+;    void init(double *A, long n) {
+;      for (long j = 0; j < n; j++)
+;        A[j] = 0;
+;    }
+;
+;    void caller(double *A, long m, long n) {
+;      for (long i = 0; i < m; i++)
+;        init(&A[100 * i], n);
+;    }
+;
+; CHECK-LABEL: Function: caller
+; CHECK:      Stmt_for_body
+; CHECK-NEXT:   Domain :=
+; CHECK-NEXT:       [m, n] -> { Stmt_for_body[i0] : 0 <= i0 < m };
+; CHECK-NEXT:   Schedule :=
+; CHECK-NEXT:       [m, n] -> { Stmt_for_body[i0] -> [i0] };
+; CHECK-NEXT:   MayWriteAccess := [Reduction Type: NONE] [Scalar: 0]
+; CHECK-NEXT:       [m, n] -> { Stmt_for_body[i0] -> MemRef_A[o0] : 100i0 <= o0 < 100i0 + n };
+;
+; NOSUMMARY-NOT: Function: caller
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+define void @init(double* %A, i64 %n) {
+entry:
+  br label %for.cond
+
+for.cond:
+  %j = phi i64 [ 0, %entry ], [ %j.next, %for.body ]
+  %cmp = icmp slt i64 %j, %n
+  br i1 %cmp, label %for.body, label %for.end
+
+for.body:
+  %arrayidx = getelementptr inbounds double, double* %A, i64 %j
+  store double 0.000000e+00, double* %arrayidx
+  %j.next = add nuw nsw i64 %j, 1
+  br label %for.cond
+
+for.end:
+  ret void
+}
+
+define void @caller(double* %A, i64 %m, i64 %n) {
+entry:
+  br label %for.cond
+
+for.cond:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %for.body ]
+  %cmp = icmp slt i64 %i, %m
+  br i1 %cmp, label %for.body, label %for.end
+
+for.body:
+  %offset = mul nsw i64 %i, 100
+  %arrayidx = getelementptr inbounds double, double* %A, i64 %offset
+  call void @init(double* %arrayidx, i64 %n)
+  %i.next = add nuw nsw i64 %i, 1
+  br label %for.cond
+
+for.end:
+  ret void
+}
@@ -28,6 +28,7 @@
 
 #include <assert.h>
 #include <dlfcn.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,6 +37,7 @@
 
 static int DebugMode;
 static int CacheMode;
+static PollyGPUStatistics Statistics;
 #define max(x, y) ((x) > (y) ? (x) : (y))
 
 static PollyGPURuntime Runtime = RUNTIME_NONE;
@@ -51,8 +53,6 @@ static void debug_print(const char *format, ...) {
 }
 #define dump_function() debug_print("-> %s\n", __func__)
 
-#define KERNEL_CACHE_SIZE 10
-
 static void err_runtime() __attribute__((noreturn));
 static void err_runtime() {
   fprintf(stderr, "Runtime not correctly initialized.\n");
@@ -71,6 +71,218 @@ struct PollyGPUDevicePtrT {
   void *DevicePtr;
 };
 
+/******************************************************************************/
+/*                                Kernel cache                                */
+/******************************************************************************/
+
+#define INITIAL_HASH 14695981039346656037ULL
+
+static unsigned long long hashBytes(const void *Data, long Size,
+                                    unsigned long long Hash) {
+  /* FNV-1a, over 64-bit words as far as possible. */
+  const unsigned long long Prime = 1099511628211ULL;
+  const unsigned char *Bytes = (const unsigned char *)Data;
+  long i = 0;
+
+  for (; i + 8 <= Size; i += 8) {
+    unsigned long long Word;
+    memcpy(&Word, Bytes + i, 8);
+    Hash = (Hash ^ Word) * Prime;
+  }
+  for (; i < Size; i++)
+    Hash = (Hash ^ Bytes[i]) * Prime;
+
+  return Hash;
+}
+
+/* A kernel that stays loaded for the rest of the process. Kernels are shared
+ * between the threads that use the same context. */
+typedef struct CachedKernelT {
+  PollyGPUContext *Context;
+  const char *BinaryString;
+  unsigned long long Hash;
+  char *KernelName;
+  PollyGPUFunction *Function;
+} CachedKernel;
+
+static CachedKernel *CachedKernels;
+static long NumCachedKernels;
+static long MaxCachedKernels;
+static pthread_mutex_t CachedKernelsLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* The context of the calling thread, as last returned by polly_initContext. */
+static __thread PollyGPUContext *ThreadContext;
+
+static PollyGPUFunction *findCachedKernel(const char *BinaryBuffer,
+                                          const char *KernelName) {
+  unsigned long long Hash = 0;
+  int HasHash = 0;
+
+  for (long i = 0; i < NumCachedKernels; i++) {
+    CachedKernel *Kernel = &CachedKernels[i];
+    if (Kernel->Context != ThreadContext ||
+        strcmp(Kernel->KernelName, KernelName) != 0)
+      continue;
+
+    // All Polly-ACC kernels are allocated as global constants, hence the
+    // binary of a kernel is usually found by its address. Equal binaries at
+    // other addresses, e.g. in other modules, are found by their hash.
+    if (Kernel->BinaryString == BinaryBuffer)
+      return Kernel->Function;
+
+    if (!HasHash) {
+      Hash = hashBytes(BinaryBuffer, strlen(BinaryBuffer), INITIAL_HASH);
+      HasHash = 1;
+    }
+    if (Kernel->Hash == Hash && strcmp(Kernel->BinaryString, BinaryBuffer) == 0)
+      return Kernel->Function;
+  }
+
+  return NULL;
+}
+
+static void addCachedKernel(const char *BinaryBuffer, const char *KernelName,
+                            PollyGPUFunction *Function) {
+  if (NumCachedKernels == MaxCachedKernels) {
+    MaxCachedKernels = max(2 * MaxCachedKernels, 16);
+    CachedKernels =
+        realloc(CachedKernels, MaxCachedKernels * sizeof(CachedKernel));
+    if (CachedKernels == 0) {
+      fprintf(stderr, "Allocate memory for Polly kernel cache failed.\n");
+      exit(-1);
+    }
+  }
+
+  CachedKernel *Kernel = &CachedKernels[NumCachedKernels++];
+  Kernel->Context = ThreadContext;
+  Kernel->BinaryString = BinaryBuffer;
+  Kernel->Hash = hashBytes(BinaryBuffer, strlen(BinaryBuffer), INITIAL_HASH);
+  Kernel->KernelName = strdup(KernelName);
+  Kernel->Function = Function;
+  if (Kernel->KernelName == 0) {
+    fprintf(stderr, "Allocate memory for Polly kernel cache failed.\n");
+    exit(-1);
+  }
+}
+
+/* The on-disk cache stores the kernels compiled by the driver in the
+ * directory POLLY_KERNEL_CACHE_DIR, such that they are not compiled again
+ * when the program is restarted. The host emulation, which compiles nothing,
+ * stores the kernel binary itself, such that the cache can be tested without
+ * a GPU. A file is named by the hash of the kernel
+ * binary, the kernel name and the device, and holds the size and the contents
+ * of the kernel binary, followed by the compiled kernel. The kernel binary is
+ * compared on load, hence colliding hashes only cause cache misses. */
+
+/* Return the path of the cached compilation of a kernel for the device
+ * @p DeviceName, or NULL if there is no on-disk cache. The caller frees it. */
+static char *getKernelCachePath(const char *BinaryBuffer,
+                                const char *KernelName,
+                                const char *DeviceName) {
+  const char *Dir = getenv("POLLY_KERNEL_CACHE_DIR");
+  if (!Dir || !*Dir)
+    return NULL;
+
+  unsigned long long Hash =
+      hashBytes(BinaryBuffer, strlen(BinaryBuffer) + 1, INITIAL_HASH);
+  Hash = hashBytes(KernelName, strlen(KernelName) + 1, Hash);
+  Hash = hashBytes(DeviceName, strlen(DeviceName) + 1, Hash);
+
+  size_t Size = strlen(Dir) + 64;
+  char *Path = malloc(Size);
+  if (Path == 0) {
+    fprintf(stderr, "Allocate memory for Polly kernel cache failed.\n");
+    exit(-1);
+  }
+  snprintf(Path, Size, "%s/polly-kernel-%016llx.bin", Dir, Hash);
+  return Path;
+}
+
+/* Read the compilation of @p BinaryBuffer cached at @p Path. Returns NULL if
+ * there is none, and otherwise a buffer of *Size bytes the caller frees. */
+static void *readCachedKernel(const char *Path, const char *BinaryBuffer,
+                              size_t *Size) {
+  FILE *File = fopen(Path, "rb");
+  if (!File)
+    return NULL;
+
+  size_t BinarySize = strlen(BinaryBuffer);
+  size_t StoredSize;
+  char *Stored = NULL;
+  void *Compiled = NULL;
+  long FileSize;
+
+  if (fseek(File, 0, SEEK_END) != 0 || (FileSize = ftell(File)) < 0 ||
+      fseek(File, 0, SEEK_SET) != 0)
+    goto out;
+
+  if (fread(&StoredSize, sizeof(StoredSize), 1, File) != 1 ||
+      StoredSize != BinarySize ||
+      (size_t)FileSize <= sizeof(StoredSize) + StoredSize)
+    goto out;
+
+  Stored = malloc(StoredSize);
+  *Size = FileSize - sizeof(StoredSize) - StoredSize;
+  Compiled = malloc(*Size);
+  if (!Stored || !Compiled ||
+      fread(Stored, 1, StoredSize, File) != StoredSize ||
+      memcmp(Stored, BinaryBuffer, StoredSize) != 0 ||
+      fread(Compiled, 1, *Size, File) != *Size) {
+    free(Compiled);
+    Compiled = NULL;
+  }
+
+out:
+  free(Stored);
+  fclose(File);
+  debug_print("  -> %s %s\n", Compiled ? "loaded" : "no cached kernel in",
+              Path);
+  return Compiled;
+}
+
+/* Store the compilation @p Compiled of @p BinaryBuffer at @p Path. The file is
+ * written under a temporary name and then renamed, such that concurrent
+ * processes only see complete files. Errors leave the cache unchanged. */
+static void writeCachedKernel(const char *Path, const char *BinaryBuffer,
+                              const void *Compiled, size_t Size) {
+  size_t PathSize = strlen(Path) + 8;
+  char *TmpPath = malloc(PathSize);
+  if (!TmpPath)
+    return;
+  snprintf(TmpPath, PathSize, "%s.XXXXXX", Path);
+
+  int Fd = mkstemp(TmpPath);
+  if (Fd < 0) {
+    free(TmpPath);
+    return;
+  }
+
+  FILE *File = fdopen(Fd, "wb");
+  size_t BinarySize = strlen(BinaryBuffer);
+  int Success =
+      File && fwrite(&BinarySize, sizeof(BinarySize), 1, File) == 1 &&
+      fwrite(BinaryBuffer, 1, BinarySize, File) == BinarySize &&
+      fwrite(Compiled, 1, Size, File) == Size;
+  if (File)
+    Success = fclose(File) == 0 && Success;
+  else
+    close(Fd);
+
+  if (Success && rename(TmpPath, Path) == 0)
+    debug_print("  -> stored %s\n", Path);
+  else
+    unlink(TmpPath);
+  free(TmpPath);
+}
+
+/* Remove the cached compilation at @p Path, which the driver failed to load,
+ * e.g. because it was compiled by another driver version. The kernel is then
+ * compiled and stored again. */
+static void discardCachedKernel(const char *Path) {
+  debug_print("  -> discarding %s\n", Path);
+  unlink(Path);
+}
+
 /******************************************************************************/
 /*                                  OpenCL                                    */
 /******************************************************************************/
@@ -163,6 +375,12 @@ typedef cl_int clBuildProgramFcnTy(
     void *UserData);
 static clBuildProgramFcnTy *clBuildProgramFcnPtr;
 
+typedef cl_int clGetProgramInfoFcnTy(cl_program Program,
+                                     cl_program_info ParamName,
+                                     size_t ParamValueSize, void *ParamValue,
+                                     size_t *ParamValueSizeRet);
+static clGetProgramInfoFcnTy *clGetProgramInfoFcnPtr;
+
 typedef cl_kernel clCreateKernelFcnTy(cl_program Program,
                                       const char *KernelName,
                                       cl_int *ErrcodeRet);
@@ -292,6 +510,9 @@ static int initialDeviceAPIsCL() {
   clBuildProgramFcnPtr =
       (clBuildProgramFcnTy *)getAPIHandleCL(Handle, "clBuildProgram");
 
+  clGetProgramInfoFcnPtr =
+      (clGetProgramInfoFcnTy *)getAPIHandleCL(Handle, "clGetProgramInfo");
+
   clCreateKernelFcnPtr =
       (clCreateKernelFcnTy *)getAPIHandleCL(Handle, "clCreateKernel");
 
@@ -331,6 +552,10 @@ static int initialDeviceAPIsCL() {
 static PollyGPUContext *GlobalContext = NULL;
 static cl_device_id GlobalDeviceID = NULL;
 
+/* The name, version and driver version of the device, which identify the
+ * device for the on-disk kernel cache. */
+static char CLDeviceTag[768];
+
 /* Fd-Decl: Print out OpenCL Error codes to human readable strings. */
 static void printOpenCLError(int Error);
 
@@ -398,6 +623,15 @@ static PollyGPUContext *initContextCL() {
                               DeviceName, &DeviceNameRetSize);
   checkOpenCLError(Ret, "Failed to fetch device name.\n");
 
+  /* Get driver version. */
+  char DriverVersion[256];
+  Ret = clGetDeviceInfoFcnPtr(DeviceID, CL_DRIVER_VERSION,
+                              sizeof(DriverVersion), DriverVersion, NULL);
+  checkOpenCLError(Ret, "Failed to fetch driver version.\n");
+
+  snprintf(CLDeviceTag, sizeof(CLDeviceTag), "%s/%s/%s", DeviceName,
+           DeviceRevision, DriverVersion);
+
   debug_print("> Running on GPU device %d : %s.\n", DeviceID, DeviceName);
 
   /* Create context on the device. */
@@ -464,6 +698,27 @@ static void freeKernelCL(PollyGPUFunction *Kernel) {
     free(Kernel);
 }
 
+/* Store the device binary of the built @p Program in the on-disk kernel
+ * cache. */
+static void storeProgramCL(const char *CachePath, const char *BinaryBuffer,
+                           cl_program Program) {
+  size_t Size;
+  cl_int Ret = clGetProgramInfoFcnPtr(Program, CL_PROGRAM_BINARY_SIZES,
+                                      sizeof(Size), &Size, NULL);
+  if (Ret != CL_SUCCESS || Size == 0)
+    return;
+
+  unsigned char *Binary = malloc(Size);
+  if (!Binary)
+    return;
+
+  Ret = clGetProgramInfoFcnPtr(Program, CL_PROGRAM_BINARIES, sizeof(Binary),
+                               &Binary, NULL);
+  if (Ret == CL_SUCCESS)
+    writeCachedKernel(CachePath, BinaryBuffer, Binary, Size);
+  free(Binary);
+}
+
 static PollyGPUFunction *getKernelCL(const char *BinaryBuffer,
                                      const char *KernelName) {
   dump_function();
@@ -473,21 +728,6 @@ static PollyGPUFunction *getKernelCL(const char *BinaryBuffer,
     exit(-1);
   }
 
-  static __thread PollyGPUFunction *KernelCache[KERNEL_CACHE_SIZE];
-  static __thread int NextCacheItem = 0;
-
-  for (long i = 0; i < KERNEL_CACHE_SIZE; i++) {
-    // We exploit here the property that all Polly-ACC kernels are allocated
-    // as global constants, hence a pointer comparision is sufficient to
-    // determin equality.
-    if (KernelCache[i] &&
-        ((OpenCLKernel *)KernelCache[i]->Kernel)->BinaryString ==
-            BinaryBuffer) {
-      debug_print("  -> using cached kernel\n");
-      return KernelCache[i];
-    }
-  }
-
   PollyGPUFunction *Function = malloc(sizeof(PollyGPUFunction));
   if (Function == 0) {
     fprintf(stderr, "Allocate memory for Polly GPU function failed.\n");
@@ -506,7 +746,36 @@ static PollyGPUFunction *getKernelCL(const char *BinaryBuffer,
 
   cl_int Ret;
 
-  if (HandleOpenCLBeignet) {
+  char *CachePath = getKernelCachePath(BinaryBuffer, KernelName, CLDeviceTag);
+  unsigned char *CachedBinary = NULL;
+  size_t CachedSize;
+  if (CachePath)
+    CachedBinary = readCachedKernel(CachePath, BinaryBuffer, &CachedSize);
+
+  cl_program Program = NULL;
+  if (CachedBinary) {
+    Program = clCreateProgramWithBinaryFcnPtr(
+        ((OpenCLContext *)GlobalContext->Context)->Context, 1, &GlobalDeviceID,
+        (const size_t *)&CachedSize, (const unsigned char **)&CachedBinary,
+        NULL, &Ret);
+    if (Ret == CL_SUCCESS) {
+      Ret = clBuildProgramFcnPtr(Program, 1, &GlobalDeviceID, NULL, NULL, NULL);
+      if (Ret != CL_SUCCESS)
+        clReleaseProgramFcnPtr(Program);
+    }
+    free(CachedBinary);
+
+    if (Ret == CL_SUCCESS) {
+      Statistics.NumKernelDiskCacheHits++;
+    } else {
+      Program = NULL;
+      discardCachedKernel(CachePath);
+    }
+  }
+
+  if (Program) {
+    ((OpenCLKernel *)Function->Kernel)->Program = Program;
+  } else if (HandleOpenCLBeignet) {
     // This is a workaround, since clCreateProgramWithLLVMIntel only
     // accepts a filename to a valid llvm-ir file as an argument, instead
     // of accepting the BinaryBuffer directly.
@@ -531,9 +800,16 @@ static PollyGPUFunction *getKernelCL(const char *BinaryBuffer,
     checkOpenCLError(Ret, "Failed to create program from binary.\n");
   }
 
-  Ret = clBuildProgramFcnPtr(((OpenCLKernel *)Function->Kernel)->Program, 1,
-                             &GlobalDeviceID, NULL, NULL, NULL);
-  checkOpenCLError(Ret, "Failed to build program.\n");
+  if (!Program) {
+    Ret = clBuildProgramFcnPtr(((OpenCLKernel *)Function->Kernel)->Program, 1,
+                               &GlobalDeviceID, NULL, NULL, NULL);
+    checkOpenCLError(Ret, "Failed to build program.\n");
+
+    if (CachePath)
+      storeProgramCL(CachePath, BinaryBuffer,
+                     ((OpenCLKernel *)Function->Kernel)->Program);
+  }
+  free(CachePath);
 
   ((OpenCLKernel *)Function->Kernel)->Kernel = clCreateKernelFcnPtr(
       ((OpenCLKernel *)Function->Kernel)->Program, KernelName, &Ret);
@@ -541,15 +817,6 @@ static PollyGPUFunction *getKernelCL(const char *BinaryBuffer,
 
   ((OpenCLKernel *)Function->Kernel)->BinaryString = BinaryBuffer;
 
-  if (CacheMode) {
-    if (KernelCache[NextCacheItem])
-      freeKernelCL(KernelCache[NextCacheItem]);
-
-    KernelCache[NextCacheItem] = Function;
-
-    NextCacheItem = (NextCacheItem + 1) % KERNEL_CACHE_SIZE;
-  }
-
   return Function;
 }
 
@@ -937,6 +1204,10 @@ struct CUDADevicePtrT {
 static void *HandleCuda;
 static void *HandleCudaRT;
 
+/* The compute capability of the device, which identifies the device for the
+ * on-disk kernel cache. */
+static char CUDADeviceTag[32];
+
 /* Type-defines of function pointer to CUDA driver APIs. */
 typedef CUresult CUDAAPI CuMemAllocFcnTy(CUdeviceptr *, size_t);
 static CuMemAllocFcnTy *CuMemAllocFcnPtr;
@@ -1195,6 +1466,7 @@ static PollyGPUContext *initContextCUDA() {
 
   /* Get compute capabilities and the device name. */
   CuDeviceComputeCapabilityFcnPtr(&Major, &Minor, Device);
+  snprintf(CUDADeviceTag, sizeof(CUDADeviceTag), "sm_%d%d", Major, Minor);
   CuDeviceGetNameFcnPtr(DeviceName, 256, Device);
   debug_print("> Running on GPU device %d : %s.\n", DeviceID, DeviceName);
 
@@ -1259,44 +1531,17 @@ static void freeKernelCUDA(PollyGPUFunction *Kernel) {
     free(Kernel);
 }
 
-static PollyGPUFunction *getKernelCUDA(const char *BinaryBuffer,
-                                       const char *KernelName) {
-  dump_function();
-
-  static __thread PollyGPUFunction *KernelCache[KERNEL_CACHE_SIZE];
-  static __thread int NextCacheItem = 0;
-
-  for (long i = 0; i < KERNEL_CACHE_SIZE; i++) {
-    // We exploit here the property that all Polly-ACC kernels are allocated
-    // as global constants, hence a pointer comparision is sufficient to
-    // determin equality.
-    if (KernelCache[i] &&
-        ((CUDAKernel *)KernelCache[i]->Kernel)->BinaryString == BinaryBuffer) {
-      debug_print("  -> using cached kernel\n");
-      return KernelCache[i];
-    }
-  }
-
-  PollyGPUFunction *Function = malloc(sizeof(PollyGPUFunction));
-  if (Function == 0) {
-    fprintf(stderr, "Allocate memory for Polly GPU function failed.\n");
-    exit(-1);
-  }
-  Function->Kernel = (CUDAKernel *)malloc(sizeof(CUDAKernel));
-  if (Function->Kernel == 0) {
-    fprintf(stderr, "Allocate memory for Polly CUDA function failed.\n");
-    exit(-1);
-  }
-
+/* JIT-compile the PTX in @p BinaryBuffer with the linker @p LState, which owns
+ * the returned binary of *OutSize bytes until it is destroyed. */
+static void *linkKernelCUDA(const char *BinaryBuffer, CUlinkState *LState,
+                            size_t *OutSize) {
   CUresult Res;
-  CUlinkState LState;
   CUjit_option Options[6];
   void *OptionVals[6];
   float Walltime = 0;
   unsigned long LogSize = 8192;
   char ErrorLog[8192], InfoLog[8192];
   void *CuOut;
-  size_t OutSize;
 
   // Setup linker options
   // Return walltime from JIT compilation
@@ -1320,15 +1565,15 @@ static PollyGPUFunction *getKernelCUDA(const char *BinaryBuffer,
 
   memset(ErrorLog, 0, sizeof(ErrorLog));
 
-  CuLinkCreateFcnPtr(6, Options, OptionVals, &LState);
-  Res = CuLinkAddDataFcnPtr(LState, CU_JIT_INPUT_PTX, (void *)BinaryBuffer,
+  CuLinkCreateFcnPtr(6, Options, OptionVals, LState);
+  Res = CuLinkAddDataFcnPtr(*LState, CU_JIT_INPUT_PTX, (void *)BinaryBuffer,
                             strlen(BinaryBuffer) + 1, 0, 0, 0, 0);
   if (Res != CUDA_SUCCESS) {
     fprintf(stderr, "PTX Linker Error:\n%s\n%s", ErrorLog, InfoLog);
     exit(-1);
   }
 
-  Res = CuLinkCompleteFcnPtr(LState, &CuOut, &OutSize);
+  Res = CuLinkCompleteFcnPtr(*LState, &CuOut, OutSize);
   if (Res != CUDA_SUCCESS) {
     fprintf(stderr, "Complete ptx linker step failed.\n");
     fprintf(stderr, "\n%s\n", ErrorLog);
@@ -1338,12 +1583,59 @@ static PollyGPUFunction *getKernelCUDA(const char *BinaryBuffer,
   debug_print("CUDA Link Completed in %fms. Linker Output:\n%s\n", Walltime,
               InfoLog);
 
-  Res = CuModuleLoadDataFcnPtr(&(((CUDAKernel *)Function->Kernel)->CudaModule),
-                               CuOut);
-  if (Res != CUDA_SUCCESS) {
-    fprintf(stderr, "Loading ptx assembly text failed.\n");
+  return CuOut;
+}
+
+static PollyGPUFunction *getKernelCUDA(const char *BinaryBuffer,
+                                       const char *KernelName) {
+  dump_function();
+
+  PollyGPUFunction *Function = malloc(sizeof(PollyGPUFunction));
+  if (Function == 0) {
+    fprintf(stderr, "Allocate memory for Polly GPU function failed.\n");
     exit(-1);
   }
+  Function->Kernel = (CUDAKernel *)malloc(sizeof(CUDAKernel));
+  if (Function->Kernel == 0) {
+    fprintf(stderr, "Allocate memory for Polly CUDA function failed.\n");
+    exit(-1);
+  }
+
+  CUresult Res;
+  CUlinkState LState;
+  void *CuOut;
+  size_t OutSize;
+  CUmodule *Module = &((CUDAKernel *)Function->Kernel)->CudaModule;
+
+  char *CachePath =
+      getKernelCachePath(BinaryBuffer, KernelName, CUDADeviceTag);
+  void *CachedOut = NULL;
+  if (CachePath)
+    CachedOut = readCachedKernel(CachePath, BinaryBuffer, &OutSize);
+
+  int Loaded = 0;
+  if (CachedOut) {
+    Loaded = CuModuleLoadDataFcnPtr(Module, CachedOut) == CUDA_SUCCESS;
+    free(CachedOut);
+    if (Loaded)
+      Statistics.NumKernelDiskCacheHits++;
+    else
+      discardCachedKernel(CachePath);
+  }
+
+  if (!Loaded) {
+    CuOut = linkKernelCUDA(BinaryBuffer, &LState, &OutSize);
+    Res = CuModuleLoadDataFcnPtr(Module, CuOut);
+    if (Res != CUDA_SUCCESS) {
+      fprintf(stderr, "Loading ptx assembly text failed.\n");
+      exit(-1);
+    }
+
+    if (CachePath)
+      writeCachedKernel(CachePath, BinaryBuffer, CuOut, OutSize);
+    CuLinkDestroyFcnPtr(LState);
+  }
+  free(CachePath);
 
   Res = CuModuleGetFunctionFcnPtr(&(((CUDAKernel *)Function->Kernel)->Cuda),
                                   ((CUDAKernel *)Function->Kernel)->CudaModule,
@@ -1353,19 +1645,8 @@ static PollyGPUFunction *getKernelCUDA(const char *BinaryBuffer,
     exit(-1);
   }
 
-  CuLinkDestroyFcnPtr(LState);
-
   ((CUDAKernel *)Function->Kernel)->BinaryString = BinaryBuffer;
 
-  if (CacheMode) {
-    if (KernelCache[NextCacheItem])
-      freeKernelCUDA(KernelCache[NextCacheItem]);
-
-    KernelCache[NextCacheItem] = Function;
-
-    NextCacheItem = (NextCacheItem + 1) % KERNEL_CACHE_SIZE;
-  }
-
   return Function;
 }
 
@@ -1568,16 +1849,294 @@ static void freeContextCUDA(PollyGPUContext *Context) {
 }
 
 #endif /* HAS_LIBCUDART */
+/******************************************************************************/
+/*                               Host emulation                               */
+/******************************************************************************/
+
+/* The host runtime emulates a device on the CPU, such that the data movement
+ * of Polly-ACC can be tested and measured without a GPU. Device memory is
+ * allocated with malloc, and transfers copy between host buffers.
+ *
+ * The kernel binaries are not interpreted. Instead, a kernel is executed by its
+ * host version (see PollyHostKernelFcnTy), which the program must export, e.g.
+ * by linking or preloading it. Launches of kernels without a host version are
+ * counted, but not executed. The threads of a launch are executed one after
+ * another, hence kernels must not synchronize between threads. */
+
+struct HostKernelT {
+  PollyHostKernelFcnTy *Function;
+  const char *BinaryString;
+};
+
+/* Dynamic library handle for the symbols of the program. */
+static void *HandleHost;
+
+static PollyGPUContext *initContextHost() {
+  dump_function();
+
+  static PollyGPUContext Context = {NULL};
+
+  if (!HandleHost)
+    HandleHost = dlopen(NULL, RTLD_LAZY);
+
+  return &Context;
+}
+
+static void freeKernelHost(PollyGPUFunction *Kernel) {
+  dump_function();
+
+  if (CacheMode)
+    return;
+
+  free(Kernel->Kernel);
+  free(Kernel);
+}
+
+static PollyGPUFunction *getKernelHost(const char *BinaryBuffer,
+                                       const char *KernelName) {
+  dump_function();
+
+  PollyGPUFunction *Function = malloc(sizeof(PollyGPUFunction));
+  if (Function == 0) {
+    fprintf(stderr, "Allocate memory for Polly GPU function failed.\n");
+    exit(-1);
+  }
+  HostKernel *Kernel = (HostKernel *)malloc(sizeof(HostKernel));
+  if (Kernel == 0) {
+    fprintf(stderr, "Allocate memory for Polly host function failed.\n");
+    exit(-1);
+  }
+
+  /* The "compilation" of a kernel is its binary, which is loaded only if it
+   * is stored unchanged. */
+  char *CachePath = getKernelCachePath(BinaryBuffer, KernelName, "host");
+  if (CachePath) {
+    size_t Size;
+    size_t BinarySize = strlen(BinaryBuffer) + 1;
+    void *Compiled = readCachedKernel(CachePath, BinaryBuffer, &Size);
+    int Loaded = Compiled && Size == BinarySize &&
+                 memcmp(Compiled, BinaryBuffer, BinarySize) == 0;
+    if (Loaded)
+      Statistics.NumKernelDiskCacheHits++;
+    else if (Compiled)
+      discardCachedKernel(CachePath);
+    if (!Loaded)
+      writeCachedKernel(CachePath, BinaryBuffer, BinaryBuffer, BinarySize);
+    free(Compiled);
+    free(CachePath);
+  }
+
+  /* POSIX guarantees that the object pointer returned by dlsym can be
+   * converted to a function pointer. */
+  *(void **)&Kernel->Function = dlsym(HandleHost, KernelName);
+  if (!Kernel->Function)
+    debug_print("  -> no host version of %s, its launches are skipped\n",
+                KernelName);
+
+  Kernel->BinaryString = BinaryBuffer;
+  Function->Kernel = Kernel;
+  return Function;
+}
+
+static void synchronizeDeviceHost() { dump_function(); }
+
+static void copyFromHostToDeviceHost(void *HostData, PollyGPUDevicePtr *DevData,
+                                     long MemSize) {
+  dump_function();
+
+  memcpy(DevData->DevicePtr, HostData, MemSize);
+}
+
+static void copyFromDeviceToHostHost(PollyGPUDevicePtr *DevData, void *HostData,
+                                     long MemSize) {
+  dump_function();
+
+  memcpy(HostData, DevData->DevicePtr, MemSize);
+}
+
+static void launchKernelHost(PollyGPUFunction *Kernel, unsigned int GridDimX,
+                             unsigned int GridDimY, unsigned int BlockDimX,
+                             unsigned int BlockDimY, unsigned int BlockDimZ,
+                             void **Parameters) {
+  dump_function();
+
+  PollyHostKernelFcnTy *Function = ((HostKernel *)Kernel->Kernel)->Function;
+  if (!Function)
+    return;
+
+  for (unsigned BlockIdxY = 0; BlockIdxY < GridDimY; BlockIdxY++)
+    for (unsigned BlockIdxX = 0; BlockIdxX < GridDimX; BlockIdxX++)
+      for (unsigned ThreadIdxZ = 0; ThreadIdxZ < BlockDimZ; ThreadIdxZ++)
+        for (unsigned ThreadIdxY = 0; ThreadIdxY < BlockDimY; ThreadIdxY++)
+          for (unsigned ThreadIdxX = 0; ThreadIdxX < BlockDimX; ThreadIdxX++)
+            Function(BlockIdxX, BlockIdxY, ThreadIdxX, ThreadIdxY, ThreadIdxZ,
+                     Parameters);
+}
+
+static void freeDeviceMemoryHost(PollyGPUDevicePtr *Allocation) {
+  dump_function();
+
+  free(Allocation->DevicePtr);
+  free(Allocation);
+}
+
+static PollyGPUDevicePtr *allocateMemoryForDeviceHost(long MemSize) {
+  dump_function();
+
+  // see: [Size 0 allocations]
+  MemSize = max(MemSize, 1);
+
+  PollyGPUDevicePtr *DevData = malloc(sizeof(PollyGPUDevicePtr));
+  if (DevData == 0) {
+    fprintf(stderr,
+            "Allocate memory for GPU device memory pointer failed."
+            " Line: %d | Size: %ld\n",
+            __LINE__, MemSize);
+    exit(-1);
+  }
+  DevData->DevicePtr = malloc(MemSize);
+  if (DevData->DevicePtr == 0) {
+    fprintf(stderr,
+            "Allocate memory for GPU device memory pointer failed."
+            " Line: %d | Size: %ld\n",
+            __LINE__, MemSize);
+    exit(-1);
+  }
+
+  return DevData;
+}
+
+static void *getDevicePtrHost(PollyGPUDevicePtr *Allocation) {
+  dump_function();
+
+  return Allocation->DevicePtr;
+}
+
+static void freeContextHost(PollyGPUContext *Context) { dump_function(); }
+
 /******************************************************************************/
 /*                                    API                                     */
 /******************************************************************************/
 
+static void printStatistics() {
+  fprintf(stderr, "Polly GPU runtime statistics:\n");
+  fprintf(stderr, "  allocations:            %ld (%ld bytes)\n",
+          Statistics.NumAllocations, Statistics.BytesAllocated);
+  fprintf(stderr, "  host to device copies:  %ld (%ld bytes)\n",
+          Statistics.NumHostToDeviceTransfers, Statistics.BytesHostToDevice);
+  fprintf(stderr, "  device to host copies:  %ld (%ld bytes)\n",
+          Statistics.NumDeviceToHostTransfers, Statistics.BytesDeviceToHost);
+  fprintf(stderr, "  skipped copies:         %ld (%ld bytes)\n",
+          Statistics.NumSkippedHostToDeviceTransfers,
+          Statistics.BytesSkippedHostToDevice);
+  fprintf(stderr, "  kernel requests:        %ld\n",
+          Statistics.NumKernelRequests);
+  fprintf(stderr, "  kernel cache hits:      %ld (%ld misses, %ld from disk)\n",
+          Statistics.NumKernelCacheHits, Statistics.NumKernelCacheMisses,
+          Statistics.NumKernelDiskCacheHits);
+  fprintf(stderr, "  kernel launches:        %ld\n",
+          Statistics.NumKernelLaunches);
+}
+
+void polly_getStatistics(PollyGPUStatistics *Stats) { *Stats = Statistics; }
+
+void polly_resetStatistics() { memset(&Statistics, 0, sizeof(Statistics)); }
+
+/* A device array that stays allocated across SCoPs, see
+ * polly_acquireDeviceMemory.
+ *
+ * Its device copy is valid if it was equal to the host data when Shadow was
+ * copied from it, and if kernels have not written it since. The host data is
+ * considered unchanged as long as it compares equal to Shadow, which costs a
+ * host copy of every resident array, but unlike a hash never mistakes changed
+ * data for unchanged data. */
+typedef struct ResidentArrayT {
+  /* The context the device array was allocated in. */
+  PollyGPUContext *Context;
+  void *HostData;
+  long MemSize;
+  PollyGPUDevicePtr *DevData;
+  int InUse;
+  int Valid;
+  /* A copy of the host data as of the last transfer, or NULL. */
+  void *Shadow;
+  /* The value of LaunchEpoch when the copies were last made equal. */
+  long SyncEpoch;
+  /* The value of ReleaseEpoch when the array was last released. */
+  long ReleaseEpoch;
+} ResidentArray;
+
+#define RESIDENT_ARRAYS_SIZE 64
+
+/* The resident arrays of all contexts. Each thread only uses the arrays of
+ * its own context. The table, including the epochs, is protected by
+ * ResidentArraysLock, which is not held while data is transferred. */
+static ResidentArray ResidentArrays[RESIDENT_ARRAYS_SIZE];
+static int NumResidentArrays;
+static pthread_mutex_t ResidentArraysLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* The number of kernel launches and of releases of resident arrays. */
+static long LaunchEpoch;
+static long ReleaseEpoch;
+
+static ResidentArray *findResidentArray(PollyGPUDevicePtr *DevData) {
+  for (int i = 0; i < NumResidentArrays; i++)
+    if (ResidentArrays[i].Context == ThreadContext &&
+        ResidentArrays[i].DevData == DevData)
+      return &ResidentArrays[i];
+  return NULL;
+}
+
+/* Remember that the device copy of @p Array was made equal to the host data
+ * at @p HostData. */
+static void syncResidentArray(ResidentArray *Array, void *HostData,
+                              long MemSize) {
+  Array->Valid = HostData == Array->HostData && MemSize == Array->MemSize;
+  Array->SyncEpoch = LaunchEpoch;
+  if (!Array->Valid)
+    return;
+
+  if (!Array->Shadow)
+    Array->Shadow = malloc(max(MemSize, 1));
+  if (Array->Shadow)
+    memcpy(Array->Shadow, HostData, MemSize);
+  else
+    Array->Valid = 0;
+}
+
+/* Free the device array of @p Array and forget its host data. */
+static void freeResidentArray(ResidentArray *Array) {
+  polly_freeDeviceMemory(Array->DevData);
+  free(Array->Shadow);
+  Array->Shadow = NULL;
+}
+
+/* Free the released resident arrays of @p Context. */
+static void freeResidentArrays(PollyGPUContext *Context) {
+  pthread_mutex_lock(&ResidentArraysLock);
+  int NumKept = 0;
+  for (int i = 0; i < NumResidentArrays; i++) {
+    if (ResidentArrays[i].Context != Context || ResidentArrays[i].InUse)
+      ResidentArrays[NumKept++] = ResidentArrays[i];
+    else
+      freeResidentArray(&ResidentArrays[i]);
+  }
+  NumResidentArrays = NumKept;
+  pthread_mutex_unlock(&ResidentArraysLock);
+}
+
 PollyGPUContext *polly_initContext() {
   DebugMode = getenv("POLLY_DEBUG") != 0;
   CacheMode = getenv("POLLY_NOCACHE") == 0;
 
   dump_function();
 
+  static int PrintStatistics = 0;
+  if (!PrintStatistics && getenv("POLLY_STATISTICS")) {
+    PrintStatistics = 1;
+    atexit(printStatistics);
+  }
+
   PollyGPUContext *Context;
 
   switch (Runtime) {
@@ -1591,10 +2150,14 @@ PollyGPUContext *polly_initContext() {
     Context = initContextCL();
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    Context = initContextHost();
+    break;
   default:
     err_runtime();
   }
 
+  ThreadContext = Context;
   return Context;
 }
 
@@ -1612,6 +2175,9 @@ void polly_freeKernel(PollyGPUFunction *Kernel) {
     freeKernelCL(Kernel);
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    freeKernelHost(Kernel);
+    break;
   default:
     err_runtime();
   }
@@ -1621,8 +2187,24 @@ PollyGPUFunction *polly_getKernel(const char *BinaryBuffer,
                                   const char *KernelName) {
   dump_function();
 
+  Statistics.NumKernelRequests++;
+
   PollyGPUFunction *Function;
 
+  // The kernel is compiled while the cache is locked, such that threads that
+  // request it at the same time do not compile it twice.
+  if (CacheMode) {
+    pthread_mutex_lock(&CachedKernelsLock);
+    Function = findCachedKernel(BinaryBuffer, KernelName);
+    if (Function) {
+      pthread_mutex_unlock(&CachedKernelsLock);
+      debug_print("  -> using cached kernel\n");
+      Statistics.NumKernelCacheHits++;
+      return Function;
+    }
+    Statistics.NumKernelCacheMisses++;
+  }
+
   switch (Runtime) {
 #ifdef HAS_LIBCUDART
   case RUNTIME_CUDA:
@@ -1634,10 +2216,18 @@ PollyGPUFunction *polly_getKernel(const char *BinaryBuffer,
     Function = getKernelCL(BinaryBuffer, KernelName);
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    Function = getKernelHost(BinaryBuffer, KernelName);
+    break;
   default:
     err_runtime();
   }
 
+  if (CacheMode) {
+    addCachedKernel(BinaryBuffer, KernelName, Function);
+    pthread_mutex_unlock(&CachedKernelsLock);
+  }
+
   return Function;
 }
 
@@ -1645,6 +2235,23 @@ void polly_copyFromHostToDevice(void *HostData, PollyGPUDevicePtr *DevData,
                                 long MemSize) {
   dump_function();
 
+  pthread_mutex_lock(&ResidentArraysLock);
+  ResidentArray *Array = findResidentArray(DevData);
+  int UpToDate = Array && Array->Valid && Array->HostData == HostData &&
+                 Array->MemSize == MemSize &&
+                 memcmp(Array->Shadow, HostData, MemSize) == 0;
+  pthread_mutex_unlock(&ResidentArraysLock);
+
+  if (UpToDate) {
+    debug_print("  -> device copy is up to date\n");
+    Statistics.NumSkippedHostToDeviceTransfers++;
+    Statistics.BytesSkippedHostToDevice += MemSize;
+    return;
+  }
+
+  Statistics.NumHostToDeviceTransfers++;
+  Statistics.BytesHostToDevice += MemSize;
+
   switch (Runtime) {
 #ifdef HAS_LIBCUDART
   case RUNTIME_CUDA:
@@ -1656,15 +2263,27 @@ void polly_copyFromHostToDevice(void *HostData, PollyGPUDevicePtr *DevData,
     copyFromHostToDeviceCL(HostData, DevData, MemSize);
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    copyFromHostToDeviceHost(HostData, DevData, MemSize);
+    break;
   default:
     err_runtime();
   }
+
+  pthread_mutex_lock(&ResidentArraysLock);
+  Array = findResidentArray(DevData);
+  if (Array)
+    syncResidentArray(Array, HostData, MemSize);
+  pthread_mutex_unlock(&ResidentArraysLock);
 }
 
 void polly_copyFromDeviceToHost(PollyGPUDevicePtr *DevData, void *HostData,
                                 long MemSize) {
   dump_function();
 
+  Statistics.NumDeviceToHostTransfers++;
+  Statistics.BytesDeviceToHost += MemSize;
+
   switch (Runtime) {
 #ifdef HAS_LIBCUDART
   case RUNTIME_CUDA:
@@ -1676,9 +2295,18 @@ void polly_copyFromDeviceToHost(PollyGPUDevicePtr *DevData, void *HostData,
     copyFromDeviceToHostCL(DevData, HostData, MemSize);
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    copyFromDeviceToHostHost(DevData, HostData, MemSize);
+    break;
   default:
     err_runtime();
   }
+
+  pthread_mutex_lock(&ResidentArraysLock);
+  ResidentArray *Array = findResidentArray(DevData);
+  if (Array)
+    syncResidentArray(Array, HostData, MemSize);
+  pthread_mutex_unlock(&ResidentArraysLock);
 }
 
 void polly_launchKernel(PollyGPUFunction *Kernel, unsigned int GridDimX,
@@ -1687,6 +2315,11 @@ void polly_launchKernel(PollyGPUFunction *Kernel, unsigned int GridDimX,
                         void **Parameters) {
   dump_function();
 
+  Statistics.NumKernelLaunches++;
+  pthread_mutex_lock(&ResidentArraysLock);
+  LaunchEpoch++;
+  pthread_mutex_unlock(&ResidentArraysLock);
+
   switch (Runtime) {
 #ifdef HAS_LIBCUDART
   case RUNTIME_CUDA:
@@ -1700,6 +2333,10 @@ void polly_launchKernel(PollyGPUFunction *Kernel, unsigned int GridDimX,
                    Parameters);
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    launchKernelHost(Kernel, GridDimX, GridDimY, BlockDimX, BlockDimY,
+                     BlockDimZ, Parameters);
+    break;
   default:
     err_runtime();
   }
@@ -1719,6 +2356,9 @@ void polly_freeDeviceMemory(PollyGPUDevicePtr *Allocation) {
     freeDeviceMemoryCL(Allocation);
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    freeDeviceMemoryHost(Allocation);
+    break;
   default:
     err_runtime();
   }
@@ -1727,6 +2367,9 @@ void polly_freeDeviceMemory(PollyGPUDevicePtr *Allocation) {
 PollyGPUDevicePtr *polly_allocateMemoryForDevice(long MemSize) {
   dump_function();
 
+  Statistics.NumAllocations++;
+  Statistics.BytesAllocated += MemSize;
+
   PollyGPUDevicePtr *DevData;
 
   switch (Runtime) {
@@ -1740,6 +2383,9 @@ PollyGPUDevicePtr *polly_allocateMemoryForDevice(long MemSize) {
     DevData = allocateMemoryForDeviceCL(MemSize);
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    DevData = allocateMemoryForDeviceHost(MemSize);
+    break;
   default:
     err_runtime();
   }
@@ -1763,6 +2409,9 @@ void *polly_getDevicePtr(PollyGPUDevicePtr *Allocation) {
     DevPtr = getDevicePtrCL(Allocation);
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    DevPtr = getDevicePtrHost(Allocation);
+    break;
   default:
     err_runtime();
   }
@@ -1784,6 +2433,9 @@ void polly_synchronizeDevice() {
     synchronizeDeviceCL();
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    synchronizeDeviceHost();
+    break;
   default:
     err_runtime();
   }
@@ -1795,6 +2447,8 @@ void polly_freeContext(PollyGPUContext *Context) {
   if (CacheMode)
     return;
 
+  freeResidentArrays(Context);
+
   switch (Runtime) {
 #ifdef HAS_LIBCUDART
   case RUNTIME_CUDA:
@@ -1806,11 +2460,91 @@ void polly_freeContext(PollyGPUContext *Context) {
     freeContextCL(Context);
     break;
 #endif /* HAS_LIBOPENCL */
+  case RUNTIME_HOST:
+    freeContextHost(Context);
+    break;
   default:
     err_runtime();
   }
 }
 
+PollyGPUDevicePtr *polly_acquireDeviceMemory(void *HostData, long MemSize) {
+  dump_function();
+
+  /* The slot to reuse if the range is not resident: a released array of the
+   * same host data, or else the least recently released array. */
+  pthread_mutex_lock(&ResidentArraysLock);
+  ResidentArray *Slot = NULL;
+  for (int i = 0; i < NumResidentArrays; i++) {
+    ResidentArray *Array = &ResidentArrays[i];
+    if (Array->Context != ThreadContext || Array->InUse)
+      continue;
+
+    if (Array->HostData == HostData) {
+      if (Array->MemSize == MemSize) {
+        debug_print("  -> using resident device array\n");
+        Array->InUse = 1;
+        pthread_mutex_unlock(&ResidentArraysLock);
+        return Array->DevData;
+      }
+      Slot = Array;
+      break;
+    }
+
+    if (!Slot || Array->ReleaseEpoch < Slot->ReleaseEpoch)
+      Slot = Array;
+  }
+
+  if (NumResidentArrays < RESIDENT_ARRAYS_SIZE &&
+      (!Slot || Slot->HostData != HostData)) {
+    Slot = &ResidentArrays[NumResidentArrays++];
+    Slot->Context = ThreadContext;
+    Slot->Shadow = NULL;
+  } else if (Slot) {
+    freeResidentArray(Slot);
+  } else {
+    pthread_mutex_unlock(&ResidentArraysLock);
+    return polly_allocateMemoryForDevice(MemSize);
+  }
+
+  Slot->HostData = HostData;
+  Slot->MemSize = MemSize;
+  Slot->DevData = polly_allocateMemoryForDevice(MemSize);
+  Slot->InUse = 1;
+  Slot->Valid = 0;
+  PollyGPUDevicePtr *DevData = Slot->DevData;
+  pthread_mutex_unlock(&ResidentArraysLock);
+  return DevData;
+}
+
+void polly_releaseDeviceMemory(PollyGPUDevicePtr *Allocation, int Written) {
+  dump_function();
+
+  pthread_mutex_lock(&ResidentArraysLock);
+  ResidentArray *Array = findResidentArray(Allocation);
+  if (!Array) {
+    pthread_mutex_unlock(&ResidentArraysLock);
+    polly_freeDeviceMemory(Allocation);
+    return;
+  }
+
+  /* Kernels launched after the last transfer may have changed the device
+   * copy. Launches of other threads are counted as well, which only makes
+   * this conservative. */
+  if (Written && Array->SyncEpoch != LaunchEpoch)
+    Array->Valid = 0;
+
+  Array->InUse = 0;
+  Array->ReleaseEpoch = ++ReleaseEpoch;
+  pthread_mutex_unlock(&ResidentArraysLock);
+}
+
+void polly_freeResidentDeviceMemory() {
+  dump_function();
+
+  freeResidentArrays(ThreadContext);
+}
+
 void polly_freeManaged(void *mem) {
   dump_function();
 
@@ -1844,6 +2578,12 @@ PollyGPUContext *polly_initContextCUDA() {
 #endif /* HAS_LIBCUDART */
 }
 
+/* Initialize GPUJIT with the host emulation as runtime library. */
+PollyGPUContext *polly_initContextHost() {
+  Runtime = RUNTIME_HOST;
+  return polly_initContext();
+}
+
 /* Initialize GPUJIT with OpenCL as runtime library. */
 PollyGPUContext *polly_initContextCL() {
 #ifdef HAS_LIBOPENCL
@@ -15,6 +15,10 @@
 #define GPUJIT_H_
 #include "stddef.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*
  * The following demostrates how we can use the GPURuntime library to
  * execute a GPU kernel.
@@ -80,7 +84,8 @@
 typedef enum PollyGPURuntimeT {
   RUNTIME_NONE,
   RUNTIME_CUDA,
-  RUNTIME_CL
+  RUNTIME_CL,
+  RUNTIME_HOST
 } PollyGPURuntime;
 
 typedef struct PollyGPUContextT PollyGPUContext;
@@ -95,8 +100,58 @@ typedef struct CUDAContextT CUDAContext;
 typedef struct CUDAKernelT CUDAKernel;
 typedef struct CUDADevicePtrT CUDADevicePtr;
 
+typedef struct HostKernelT HostKernel;
+
+/*
+ * The host version of a kernel, which the host runtime executes instead of
+ * the kernel binary. It is called once for every thread of a launch, with the
+ * indices of the block and the thread and the parameters of the launch as
+ * passed to polly_launchKernel. Host versions are looked up by the name of
+ * the kernel among the symbols of the program, e.g.
+ *
+ * void FUNC_f_SCOP_0_KERNEL_0(unsigned BlockIdxX, unsigned BlockIdxY,
+ *                             unsigned ThreadIdxX, unsigned ThreadIdxY,
+ *                             unsigned ThreadIdxZ, void **Parameters) {
+ *   double *A = *(double **)Parameters[0];
+ *   A[BlockIdxX * 32 + ThreadIdxX] += 1;
+ * }
+ */
+typedef void PollyHostKernelFcnTy(unsigned BlockIdxX, unsigned BlockIdxY,
+                                  unsigned ThreadIdxX, unsigned ThreadIdxY,
+                                  unsigned ThreadIdxZ, void **Parameters);
+
+/*
+ * The number and the volume of the operations requested from the runtime.
+ * They are counted for all runtimes, and printed at exit if the environment
+ * variable POLLY_STATISTICS is set. The counters are not synchronized between
+ * threads.
+ *
+ * Kernels stay loaded once requested, unless the environment variable
+ * POLLY_NOCACHE is set, and later requests of the same kernel binary and name
+ * are cache hits. Kernels compiled by the driver are also stored in the
+ * directory given by the environment variable POLLY_KERNEL_CACHE_DIR, if set,
+ * and cache misses that load a stored kernel instead of compiling it are disk
+ * cache hits. The host runtime stores the kernel binaries instead.
+ */
+typedef struct PollyGPUStatisticsT {
+  long NumAllocations;
+  long BytesAllocated;
+  long NumHostToDeviceTransfers;
+  long BytesHostToDevice;
+  long NumDeviceToHostTransfers;
+  long BytesDeviceToHost;
+  long NumSkippedHostToDeviceTransfers;
+  long BytesSkippedHostToDevice;
+  long NumKernelRequests;
+  long NumKernelCacheHits;
+  long NumKernelCacheMisses;
+  long NumKernelDiskCacheHits;
+  long NumKernelLaunches;
+} PollyGPUStatistics;
+
 PollyGPUContext *polly_initContextCUDA();
 PollyGPUContext *polly_initContextCL();
+PollyGPUContext *polly_initContextHost();
 PollyGPUFunction *polly_getKernel(const char *BinaryBuffer,
                                   const char *KernelName);
 void polly_freeKernel(PollyGPUFunction *Kernel);
@@ -110,7 +165,22 @@ void polly_launchKernel(PollyGPUFunction *Kernel, unsigned int GridDimX,
                         unsigned int BlockSizeY, unsigned int BlockSizeZ,
                         void **Parameters);
 void polly_freeDeviceMemory(PollyGPUDevicePtr *Allocation);
+PollyGPUDevicePtr *polly_allocateMemoryForDevice(long MemSize);
+void *polly_getDevicePtr(PollyGPUDevicePtr *Allocation);
 void polly_freeContext(PollyGPUContext *Context);
+void polly_getStatistics(PollyGPUStatistics *Statistics);
+void polly_resetStatistics();
+
+/*
+ * Device arrays that stay allocated across SCoPs. An array acquired for a
+ * range of host memory is reused by later acquisitions of the same range, and
+ * copies of unchanged host data to it are skipped. Written must be non-zero if
+ * kernels may have written the array since it was acquired. The arrays belong
+ * to the context of the calling thread and may be used by several threads.
+ */
+PollyGPUDevicePtr *polly_acquireDeviceMemory(void *HostData, long MemSize);
+void polly_releaseDeviceMemory(PollyGPUDevicePtr *Allocation, int Written);
+void polly_freeResidentDeviceMemory();
 
 // Note that polly_{malloc/free}Managed are currently not used by Polly.
 // We use them in COSMO by replacing all malloc with polly_mallocManaged and all
@@ -120,4 +190,8 @@ void polly_freeContext(PollyGPUContext *Context);
 // If this is still present, ping Siddharth Bhat <siddu.druid@gmail.com>
 void *polly_mallocManaged(size_t size);
 void polly_freeManaged(void *mem);
+
+#ifdef __cplusplus
+}
+#endif
 #endif /* GPUJIT_H_ */
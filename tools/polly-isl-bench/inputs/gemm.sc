@@ -0,0 +1,6 @@
+# The schedule constraints of gemm (see gemm.ai).
+domain: "[ni, nj, nk] -> { Stmt1[i, j] : 0 <= i < ni and 0 <= j < nj; Stmt2[i, j, k] : 0 <= i < ni and 0 <= j < nj and 0 <= k < nk }"
+context: "[ni, nj, nk] -> { : -2147483648 <= ni <= 2147483647 and -2147483648 <= nj <= 2147483647 and -2147483648 <= nk <= 2147483647 }"
+validity: "[ni, nj, nk] -> { Stmt1[i, j] -> Stmt2[i, j, 0] : 0 <= i < ni and 0 <= j < nj and nk > 0; Stmt2[i, j, k] -> Stmt2[i, j, 1 + k] : 0 <= i < ni and 0 <= j < nj and 0 <= k <= nk - 2 }"
+proximity: "[ni, nj, nk] -> { Stmt1[i, j] -> Stmt2[i, j, 0] : 0 <= i < ni and 0 <= j < nj and nk > 0; Stmt2[i, j, k] -> Stmt2[i, j, 1 + k] : 0 <= i < ni and 0 <= j < nj and 0 <= k <= nk - 2 }"
+coincidence: "[ni, nj, nk] -> { Stmt1[i, j] -> Stmt2[i, j, 0] : 0 <= i < ni and 0 <= j < nj and nk > 0; Stmt2[i, j, k] -> Stmt2[i, j, 1 + k] : 0 <= i < ni and 0 <= j < nj and 0 <= k <= nk - 2 }"
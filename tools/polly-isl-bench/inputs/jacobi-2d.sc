@@ -0,0 +1,4 @@
+# The schedule constraints of the Jacobi stencil (see jacobi-2d.ai).
+domain: "[T, n] -> { S[t, i, j] : 0 <= t < T and 0 < i < n - 1 and 0 < j < n - 1; U[t, i, j] : 0 <= t < T and 0 < i < n - 1 and 0 < j < n - 1 }"
+validity: "[T, n] -> { S[t, i, j] -> U[t, x, y] : -1 <= x - i <= 1 and -1 <= y - j <= 1 and -1 <= x - i + y - j <= 1 and -1 <= x - i - y + j <= 1 and 0 <= t < T and 0 < i < n - 1 and 0 < j < n - 1 and 0 < x < n - 1 and 0 < y < n - 1; U[t, i, j] -> S[t + 1, x, y] : -1 <= x - i <= 1 and -1 <= y - j <= 1 and -1 <= x - i + y - j <= 1 and -1 <= x - i - y + j <= 1 and 0 <= t < T - 1 and 0 < i < n - 1 and 0 < j < n - 1 and 0 < x < n - 1 and 0 < y < n - 1; S[t, i, j] -> S[t + 1, i, j] : 0 <= t < T - 1 and 0 < i < n - 1 and 0 < j < n - 1; U[t, i, j] -> U[t + 1, i, j] : 0 <= t < T - 1 and 0 < i < n - 1 and 0 < j < n - 1 }"
+proximity: "[T, n] -> { S[t, i, j] -> U[t, x, y] : -1 <= x - i <= 1 and -1 <= y - j <= 1 and -1 <= x - i + y - j <= 1 and -1 <= x - i - y + j <= 1 and 0 <= t < T and 0 < i < n - 1 and 0 < j < n - 1 and 0 < x < n - 1 and 0 < y < n - 1; U[t, i, j] -> S[t + 1, x, y] : -1 <= x - i <= 1 and -1 <= y - j <= 1 and -1 <= x - i + y - j <= 1 and -1 <= x - i - y + j <= 1 and 0 <= t < T - 1 and 0 < i < n - 1 and 0 < j < n - 1 and 0 < x < n - 1 and 0 < y < n - 1 }"
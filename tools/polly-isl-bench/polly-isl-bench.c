@@ -0,0 +1,300 @@
+/*************** polly-isl-bench.c - Time isl on captured inputs **************/
+/*                                                                            */
+/* Part of the LLVM Project, under the Apache License v2.0 with LLVM          */
+/* Exceptions.                                                                */
+/* See https://llvm.org/LICENSE.txt for license information.                  */
+/* SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception                    */
+/*                                                                            */
+/******************************************************************************/
+/*                                                                            */
+/*  This file implements polly-isl-bench, which replays the isl inputs that   */
+/*  Polly writes with -polly-capture-isl-inputs and times the isl operations  */
+/*  that Polly performs on them, without the rest of the compiler:            */
+/*                                                                            */
+/*    .ai  dependence analysis (isl_union_access_info_compute_flow) and the   */
+/*         simplifications of its result                                      */
+/*    .sc  scheduling (isl_schedule_constraints_compute_schedule)             */
+/*    .st  AST generation (isl_ast_build_node_from_schedule)                  */
+/*                                                                            */
+/*  Every operation is run a number of times, and the fastest run, the        */
+/*  resulting rate and the number of isl operations are printed as JSON.      */
+/*  isl options given on the command line, e.g. --schedule-whole-component,   */
+/*  override the defaults that Polly uses.                                    */
+/*                                                                            */
+/******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <isl/ast.h>
+#include <isl/ast_build.h>
+#include <isl/ctx.h>
+#include <isl/flow.h>
+#include <isl/options.h>
+#include <isl/schedule.h>
+#include <isl/set.h>
+#include <isl/union_map.h>
+#include <isl/union_set.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The isl options that Polly sets before scheduling (see
+ * ScheduleOptimizer.cpp). They are passed before the options of the user,
+ * such that the latter take precedence. */
+static const char *PollyOptions[] = {
+    "--schedule-serialize-sccs",       "--schedule-maximize-band-depth",
+    "--no-schedule-outer-coincidence", "--schedule-max-constant-term=20",
+    "--schedule-max-coefficient=20",   "--no-tile-scale-tile-loops",
+};
+
+#define NUM_POLLY_OPTIONS (sizeof(PollyOptions) / sizeof(PollyOptions[0]))
+
+static int Reps = 10;
+static int FirstResult = 1;
+
+static double getTime(void) {
+  struct timespec TS;
+  clock_gettime(CLOCK_MONOTONIC, &TS);
+  return TS.tv_sec + TS.tv_nsec * 1e-9;
+}
+
+/* The operation being timed. It takes the input object, which must not be
+ * modified, and returns zero on failure. */
+typedef int (*BenchFn)(void *Input);
+
+static void printResult(const char *File, const char *Op, double Time,
+                        unsigned long Operations, int Success) {
+  printf("%s\n    {\"input\": \"%s\", \"op\": \"%s\", \"reps\": %d, "
+         "\"time\": %.9f, \"ops_per_second\": %.3f, "
+         "\"isl_operations\": %lu, \"success\": %s}",
+         FirstResult ? "" : ",", File, Op, Reps, Time,
+         Time > 0 ? 1.0 / Time : 0.0, Operations,
+         Success ? "true" : "false");
+  FirstResult = 0;
+}
+
+/* Run @p Fn on @p Input Reps times and print the fastest run and the isl
+ * operations of the first one. */
+static int bench(isl_ctx *Ctx, const char *File, const char *Op, BenchFn Fn,
+                 void *Input) {
+  double Best = -1;
+  unsigned long Operations = 0;
+  int Success = 1;
+  int i;
+
+  for (i = 0; i < Reps; i++) {
+    double Start, Time;
+
+    isl_ctx_reset_operations(Ctx);
+    Start = getTime();
+    Success = Fn(Input) && Success;
+    Time = getTime() - Start;
+    if (i == 0)
+      Operations = isl_ctx_get_operations(Ctx);
+    if (Best < 0 || Time < Best)
+      Best = Time;
+    isl_ctx_reset_error(Ctx);
+  }
+
+  printResult(File, Op, Best, Operations, Success);
+  return Success;
+}
+
+static int computeFlow(void *Input) {
+  isl_union_access_info *AI = isl_union_access_info_copy(Input);
+  isl_union_flow *Flow = isl_union_access_info_compute_flow(AI);
+  int Success = Flow != NULL;
+  isl_union_flow_free(Flow);
+  return Success;
+}
+
+static int coalesce(void *Input) {
+  isl_union_map *Map = isl_union_map_coalesce(isl_union_map_copy(Input));
+  int Success = Map != NULL;
+  isl_union_map_free(Map);
+  return Success;
+}
+
+static int lexmin(void *Input) {
+  isl_union_set *Set = isl_union_map_domain(isl_union_map_copy(Input));
+  Set = isl_union_set_lexmin(Set);
+  int Success = Set != NULL;
+  isl_union_set_free(Set);
+  return Success;
+}
+
+static int lexmax(void *Input) {
+  isl_union_set *Set = isl_union_map_range(isl_union_map_copy(Input));
+  Set = isl_union_set_lexmax(Set);
+  int Success = Set != NULL;
+  isl_union_set_free(Set);
+  return Success;
+}
+
+static int computeSchedule(void *Input) {
+  isl_schedule_constraints *SC = isl_schedule_constraints_copy(Input);
+  isl_schedule *Schedule = isl_schedule_constraints_compute_schedule(SC);
+  int Success = Schedule != NULL;
+  isl_schedule_free(Schedule);
+  return Success;
+}
+
+/* The parameter context of the SCoP is part of the captured schedule, so the
+ * build starts without constraints. */
+static int buildAst(void *Input) {
+  isl_schedule *Schedule = Input;
+  isl_ast_build *Build = isl_ast_build_alloc(isl_schedule_get_ctx(Schedule));
+  isl_ast_node *Root =
+      isl_ast_build_node_from_schedule(Build, isl_schedule_copy(Schedule));
+  int Success = Root != NULL;
+  isl_ast_node_free(Root);
+  isl_ast_build_free(Build);
+  return Success;
+}
+
+static int benchFlow(isl_ctx *Ctx, const char *File, FILE *Input) {
+  isl_union_access_info *AI = isl_union_access_info_read_from_file(Ctx, Input);
+  isl_union_flow *Flow;
+  isl_union_map *Dep;
+  int Success;
+
+  if (!AI)
+    return 0;
+  Success = bench(Ctx, File, "flow", computeFlow, AI);
+
+  /* The dependences are simplified and their extremes are computed when
+   * Polly checks the legality of transformations and reports them. */
+  Flow = isl_union_access_info_compute_flow(AI);
+  Dep = isl_union_flow_get_may_dependence(Flow);
+  isl_union_flow_free(Flow);
+  if (!Dep)
+    return 0;
+  Success = bench(Ctx, File, "coalesce", coalesce, Dep) && Success;
+  Success = bench(Ctx, File, "lexmin", lexmin, Dep) && Success;
+  Success = bench(Ctx, File, "lexmax", lexmax, Dep) && Success;
+  isl_union_map_free(Dep);
+  return Success;
+}
+
+static int benchSchedule(isl_ctx *Ctx, const char *File, FILE *Input) {
+  isl_schedule_constraints *SC =
+      isl_schedule_constraints_read_from_file(Ctx, Input);
+  int Success;
+
+  if (!SC)
+    return 0;
+  Success = bench(Ctx, File, "schedule", computeSchedule, SC);
+  isl_schedule_constraints_free(SC);
+  return Success;
+}
+
+static int benchAst(isl_ctx *Ctx, const char *File, FILE *Input) {
+  isl_schedule *Schedule = isl_schedule_read_from_file(Ctx, Input);
+  int Success;
+
+  if (!Schedule)
+    return 0;
+  Success = bench(Ctx, File, "ast", buildAst, Schedule);
+  isl_schedule_free(Schedule);
+  return Success;
+}
+
+static int benchFile(isl_ctx *Ctx, const char *File) {
+  const char *Ext = strrchr(File, '.');
+  FILE *Input;
+  int Success;
+
+  if (!Ext ||
+      (strcmp(Ext, ".ai") && strcmp(Ext, ".sc") && strcmp(Ext, ".st"))) {
+    fprintf(stderr, "%s: unknown input kind, expected .ai, .sc or .st\n",
+            File);
+    return 0;
+  }
+
+  Input = fopen(File, "r");
+  if (!Input) {
+    perror(File);
+    return 0;
+  }
+
+  if (!strcmp(Ext, ".ai"))
+    Success = benchFlow(Ctx, File, Input);
+  else if (!strcmp(Ext, ".sc"))
+    Success = benchSchedule(Ctx, File, Input);
+  else
+    Success = benchAst(Ctx, File, Input);
+  fclose(Input);
+
+  if (!Success)
+    fprintf(stderr, "%s: isl failed on this input\n", File);
+  return Success;
+}
+
+static void printUsage(const char *Prog) {
+  fprintf(stderr,
+          "usage: %s [--reps=N] [isl options] file.{ai,sc,st}...\n"
+          "Time the isl operations of Polly on inputs captured with "
+          "-polly-capture-isl-inputs.\n"
+          "Run with --help for the isl options.\n",
+          Prog);
+}
+
+int main(int argc, char **argv) {
+  struct isl_options *Options;
+  isl_ctx *Ctx;
+  char **Args;
+  int NumArgs, i, Failed = 0, NumFiles = 0;
+
+  /* Insert Polly's defaults in front of the options of the user. */
+  Args = malloc((argc + NUM_POLLY_OPTIONS + 1) * sizeof(char *));
+  if (!Args)
+    return 1;
+  Args[0] = argv[0];
+  for (i = 0; i < (int)NUM_POLLY_OPTIONS; i++)
+    Args[1 + i] = (char *)PollyOptions[i];
+  for (i = 1; i < argc; i++)
+    Args[NUM_POLLY_OPTIONS + i] = argv[i];
+  NumArgs = argc + NUM_POLLY_OPTIONS;
+  Args[NumArgs] = NULL;
+
+  /* Leave the options isl does not know and the input files in Args. */
+  Options = isl_options_new_with_defaults();
+  NumArgs = isl_options_parse(Options, NumArgs, Args, 0);
+  Ctx = isl_ctx_alloc_with_options(&isl_options_args, Options);
+  isl_options_set_on_error(Ctx, ISL_ON_ERROR_WARN);
+
+  for (i = 1; i < NumArgs; i++) {
+    if (!strncmp(Args[i], "--reps=", 7)) {
+      Reps = atoi(Args[i] + 7);
+      if (Reps < 1) {
+        printUsage(argv[0]);
+        return 1;
+      }
+    } else if (Args[i][0] == '-') {
+      fprintf(stderr, "%s: unknown option: %s\n", argv[0], Args[i]);
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  printf("{\"results\": [");
+  for (i = 1; i < NumArgs; i++) {
+    if (Args[i][0] == '-')
+      continue;
+    NumFiles++;
+    if (!benchFile(Ctx, Args[i]))
+      Failed = 1;
+  }
+  printf("\n]}\n");
+
+  isl_ctx_free(Ctx);
+  free(Args);
+
+  if (NumFiles == 0) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  return Failed;
+}
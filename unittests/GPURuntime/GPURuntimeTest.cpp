@@ -0,0 +1,291 @@
+//===- GPURuntimeTest.cpp - Tests of the GPU runtime ----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "GPUJIT.h"
+#include "gtest/gtest.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include <climits>
+#include <cstdlib>
+#include <string>
+
+// The host versions of the kernels launched by the tests.
+extern "C" {
+void polly_test_increment(unsigned BlockIdxX, unsigned BlockIdxY,
+                          unsigned ThreadIdxX, unsigned ThreadIdxY,
+                          unsigned ThreadIdxZ, void **Parameters) {
+  int *A = *(int **)Parameters[0];
+  A[BlockIdxX * 4 + ThreadIdxX] += 1;
+}
+}
+
+namespace {
+
+// The host runtime does not interpret the binaries; they only identify the
+// kernels.
+const char IncrementBinary[] = "increment";
+const char MissingBinary[] = "missing";
+const char CachedBinary[] = "cached";
+const char StoredBinary[] = "stored";
+const char OtherStoredBinary[] = "other stored";
+const char DamagedBinary[] = "damaged";
+
+PollyGPUStatistics getStatistics() {
+  PollyGPUStatistics Stats;
+  polly_getStatistics(&Stats);
+  return Stats;
+}
+
+TEST(GPURuntime, HostCountsOperations) {
+  unsetenv("POLLY_NOCACHE");
+  PollyGPUContext *Context = polly_initContextHost();
+  polly_resetStatistics();
+
+  int Host[16] = {0};
+  PollyGPUDevicePtr *DevArray = polly_allocateMemoryForDevice(sizeof(Host));
+  polly_copyFromHostToDevice(Host, DevArray, sizeof(Host));
+
+  PollyGPUFunction *Kernel =
+      polly_getKernel(IncrementBinary, "polly_test_increment");
+  void *DevPtr = polly_getDevicePtr(DevArray);
+  void *Parameters[] = {&DevPtr};
+  polly_launchKernel(Kernel, 4, 1, 4, 1, 1, Parameters);
+  polly_copyFromDeviceToHost(DevArray, Host, sizeof(Host));
+  polly_freeKernel(Kernel);
+
+  // The launch is executed by the host version of the kernel.
+  for (int i = 0; i < 16; i++)
+    EXPECT_EQ(1, Host[i]);
+
+  // Launches of kernels without a host version are counted, but skipped.
+  Kernel = polly_getKernel(MissingBinary, "polly_test_missing");
+  polly_launchKernel(Kernel, 1, 1, 1, 1, 1, Parameters);
+  polly_freeKernel(Kernel);
+
+  PollyGPUStatistics Stats = getStatistics();
+  EXPECT_EQ(1, Stats.NumAllocations);
+  EXPECT_EQ((long)sizeof(Host), Stats.BytesAllocated);
+  EXPECT_EQ(1, Stats.NumHostToDeviceTransfers);
+  EXPECT_EQ((long)sizeof(Host), Stats.BytesHostToDevice);
+  EXPECT_EQ(1, Stats.NumDeviceToHostTransfers);
+  EXPECT_EQ((long)sizeof(Host), Stats.BytesDeviceToHost);
+  EXPECT_EQ(0, Stats.NumSkippedHostToDeviceTransfers);
+  EXPECT_EQ(2, Stats.NumKernelRequests);
+  EXPECT_EQ(2, Stats.NumKernelLaunches);
+
+  polly_freeDeviceMemory(DevArray);
+  polly_freeContext(Context);
+
+  polly_resetStatistics();
+  Stats = getStatistics();
+  EXPECT_EQ(0, Stats.NumAllocations);
+  EXPECT_EQ(0, Stats.BytesAllocated);
+  EXPECT_EQ(0, Stats.NumHostToDeviceTransfers);
+  EXPECT_EQ(0, Stats.NumDeviceToHostTransfers);
+  EXPECT_EQ(0, Stats.NumKernelRequests);
+  EXPECT_EQ(0, Stats.NumKernelLaunches);
+}
+
+TEST(GPURuntime, HostKernelIsReused) {
+  unsetenv("POLLY_NOCACHE");
+  PollyGPUContext *Context = polly_initContextHost();
+
+  // Every execution of a SCoP requests and frees its kernels. The kernel is
+  // kept, instead of allocating another one for every request.
+  PollyGPUFunction *First =
+      polly_getKernel(IncrementBinary, "polly_test_increment");
+  polly_freeKernel(First);
+  PollyGPUFunction *Second =
+      polly_getKernel(IncrementBinary, "polly_test_increment");
+  polly_freeKernel(Second);
+  EXPECT_EQ(First, Second);
+
+  polly_freeContext(Context);
+}
+
+/// Execute a SCoP on the resident device array of @p Host, which launches
+/// @p Kernel if given, as generated with -polly-acc-device-residency.
+///
+/// @return The number of skipped transfers to the device.
+long runResidentScop(int *Host, long Size, PollyGPUFunction *Kernel,
+                     bool CopyBack) {
+  polly_resetStatistics();
+  PollyGPUDevicePtr *DevArray = polly_acquireDeviceMemory(Host, Size);
+  polly_copyFromHostToDevice(Host, DevArray, Size);
+  if (Kernel) {
+    void *DevPtr = polly_getDevicePtr(DevArray);
+    void *Parameters[] = {&DevPtr};
+    polly_launchKernel(Kernel, 4, 1, 4, 1, 1, Parameters);
+    if (CopyBack)
+      polly_copyFromDeviceToHost(DevArray, Host, Size);
+  }
+  polly_releaseDeviceMemory(DevArray, Kernel != nullptr);
+  return getStatistics().NumSkippedHostToDeviceTransfers;
+}
+
+TEST(GPURuntime, HostSkipsTransfersOfUnchangedArrays) {
+  unsetenv("POLLY_NOCACHE");
+  PollyGPUContext *Context = polly_initContextHost();
+  PollyGPUFunction *Kernel =
+      polly_getKernel(IncrementBinary, "polly_test_increment");
+
+  int Host[1024];
+  for (int i = 0; i < 1024; i++)
+    Host[i] = i;
+
+  // The first transfer is needed, the second one is skipped.
+  EXPECT_EQ(0, runResidentScop(Host, sizeof(Host), nullptr, false));
+  EXPECT_EQ(1, runResidentScop(Host, sizeof(Host), nullptr, false));
+  EXPECT_EQ((long)sizeof(Host), getStatistics().BytesSkippedHostToDevice);
+
+  // Host writes are detected, even if they only flip the top bits of two
+  // 64-bit words, which cancel out in simple hashes.
+  Host[3] ^= INT_MIN;
+  Host[701] ^= INT_MIN;
+  EXPECT_EQ(0, runResidentScop(Host, sizeof(Host), nullptr, false));
+  EXPECT_EQ(1, runResidentScop(Host, sizeof(Host), nullptr, false));
+
+  // A kernel wrote the device array, which was copied back. Host and device
+  // are still equal.
+  EXPECT_EQ(1, runResidentScop(Host, sizeof(Host), Kernel, true));
+  EXPECT_EQ(1, Host[0]);
+  EXPECT_EQ(1, runResidentScop(Host, sizeof(Host), nullptr, false));
+
+  // A kernel wrote the device array, which was not copied back. The device
+  // array differs from the unchanged host data.
+  EXPECT_EQ(1, runResidentScop(Host, sizeof(Host), Kernel, false));
+  EXPECT_EQ(1, Host[0]);
+  EXPECT_EQ(0, runResidentScop(Host, sizeof(Host), nullptr, false));
+
+  polly_freeKernel(Kernel);
+  polly_freeResidentDeviceMemory();
+  polly_freeContext(Context);
+}
+
+TEST(GPURuntime, HostCachesKernels) {
+  unsetenv("POLLY_NOCACHE");
+  PollyGPUContext *Context = polly_initContextHost();
+  polly_resetStatistics();
+
+  for (int i = 0; i < 4; i++)
+    polly_freeKernel(polly_getKernel(CachedBinary, "polly_test_increment"));
+
+  // An equal binary at another address is found by its contents.
+  std::string Copy = CachedBinary;
+  polly_freeKernel(polly_getKernel(Copy.c_str(), "polly_test_increment"));
+
+  PollyGPUStatistics Stats = getStatistics();
+  EXPECT_EQ(5, Stats.NumKernelRequests);
+  EXPECT_EQ(1, Stats.NumKernelCacheMisses);
+  EXPECT_EQ(4, Stats.NumKernelCacheHits);
+
+  polly_freeContext(Context);
+}
+
+TEST(GPURuntime, HostBypassesKernelCache) {
+  setenv("POLLY_NOCACHE", "1", 1);
+  PollyGPUContext *Context = polly_initContextHost();
+  polly_resetStatistics();
+
+  PollyGPUFunction *Kernel =
+      polly_getKernel(CachedBinary, "polly_test_increment");
+  int Host[16] = {0};
+  void *HostPtr = Host;
+  void *Parameters[] = {&HostPtr};
+  polly_launchKernel(Kernel, 4, 1, 4, 1, 1, Parameters);
+  EXPECT_EQ(1, Host[15]);
+  polly_freeKernel(Kernel);
+  polly_freeKernel(polly_getKernel(CachedBinary, "polly_test_increment"));
+
+  PollyGPUStatistics Stats = getStatistics();
+  EXPECT_EQ(2, Stats.NumKernelRequests);
+  EXPECT_EQ(0, Stats.NumKernelCacheMisses);
+  EXPECT_EQ(0, Stats.NumKernelCacheHits);
+
+  polly_freeContext(Context);
+  unsetenv("POLLY_NOCACHE");
+}
+
+TEST(GPURuntime, HostStoresKernelsOnDisk) {
+  llvm::SmallString<128> Dir;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("polly-kernels", Dir));
+  setenv("POLLY_KERNEL_CACHE_DIR", Dir.c_str(), 1);
+
+  // Without the in-memory cache every request reads the on-disk cache, as
+  // the first request of a restarted program does.
+  setenv("POLLY_NOCACHE", "1", 1);
+  PollyGPUContext *Context = polly_initContextHost();
+  polly_resetStatistics();
+
+  polly_freeKernel(polly_getKernel(StoredBinary, "polly_test_increment"));
+  EXPECT_EQ(0, getStatistics().NumKernelDiskCacheHits);
+  polly_freeKernel(polly_getKernel(StoredBinary, "polly_test_increment"));
+  EXPECT_EQ(1, getStatistics().NumKernelDiskCacheHits);
+
+  // Other binaries and other kernel names are stored separately.
+  polly_freeKernel(polly_getKernel(OtherStoredBinary, "polly_test_increment"));
+  polly_freeKernel(polly_getKernel(StoredBinary, "polly_test_other"));
+  EXPECT_EQ(1, getStatistics().NumKernelDiskCacheHits);
+  polly_freeKernel(polly_getKernel(OtherStoredBinary, "polly_test_increment"));
+  EXPECT_EQ(2, getStatistics().NumKernelDiskCacheHits);
+
+  int NumFiles = 0;
+  std::error_code EC;
+  for (llvm::sys::fs::directory_iterator It(Dir, EC), End; It != End && !EC;
+       It.increment(EC))
+    NumFiles++;
+  EXPECT_EQ(3, NumFiles);
+
+  polly_freeContext(Context);
+  unsetenv("POLLY_NOCACHE");
+  unsetenv("POLLY_KERNEL_CACHE_DIR");
+  llvm::sys::fs::remove_directories(Dir);
+}
+
+TEST(GPURuntime, HostDiscardsUnloadableKernels) {
+  llvm::SmallString<128> Dir;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("polly-kernels", Dir));
+  setenv("POLLY_KERNEL_CACHE_DIR", Dir.c_str(), 1);
+  setenv("POLLY_NOCACHE", "1", 1);
+  PollyGPUContext *Context = polly_initContextHost();
+  polly_resetStatistics();
+
+  polly_freeKernel(polly_getKernel(DamagedBinary, "polly_test_increment"));
+
+  // Damage the stored compilation, which follows the kernel binary.
+  std::error_code EC;
+  llvm::sys::fs::directory_iterator It(Dir, EC);
+  ASSERT_FALSE(EC);
+  std::string Path = It->path();
+  FILE *File = fopen(Path.c_str(), "r+b");
+  ASSERT_NE(nullptr, File);
+  ASSERT_EQ(0, fseek(File, -1, SEEK_END));
+  fputc('x', File);
+  fclose(File);
+
+  // The damaged file is replaced by a new compilation, which is loaded by
+  // later requests.
+  PollyGPUFunction *Kernel =
+      polly_getKernel(DamagedBinary, "polly_test_increment");
+  EXPECT_EQ(0, getStatistics().NumKernelDiskCacheHits);
+  int Host[16] = {0};
+  void *HostPtr = Host;
+  void *Parameters[] = {&HostPtr};
+  polly_launchKernel(Kernel, 4, 1, 4, 1, 1, Parameters);
+  EXPECT_EQ(1, Host[15]);
+  polly_freeKernel(Kernel);
+  polly_freeKernel(polly_getKernel(DamagedBinary, "polly_test_increment"));
+  EXPECT_EQ(1, getStatistics().NumKernelDiskCacheHits);
+
+  polly_freeContext(Context);
+  unsetenv("POLLY_NOCACHE");
+  unsetenv("POLLY_KERNEL_CACHE_DIR");
+  llvm::sys::fs::remove_directories(Dir);
+}
+
+} // anonymous namespace
@@ -1,7 +1,13 @@
 #include "llvm/IR/PassManager.h"
+#include "polly/CodeGen/CodeGeneration.h"
 #include "polly/CodeGen/IslAst.h"
+#include "polly/DeLICM.h"
 #include "polly/DependenceInfo.h"
+#include "polly/ForwardOpTree.h"
+#include "polly/PruneUnprofitable.h"
+#include "polly/ScheduleOptimizer.h"
 #include "polly/ScopPass.h"
+#include "polly/Simplify.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/CGSCCPassManager.h"
 #include "llvm/Passes/PassBuilder.h"
@@ -63,4 +69,17 @@ TEST_F(ScopPassRegistry, PrinIslAstInfo) {
   // SPM.addPass(IslAstPrinterPass(errs()));
   FPM.addPass(createFunctionToScopPassAdaptor(std::move(SPM)));
 }
+
+TEST_F(ScopPassRegistry, BuildOptimizationPipeline) {
+  FunctionPassManager FPM;
+  ScopPassManager SPM;
+  SPM.addPass(SimplifyPass(0));
+  SPM.addPass(ForwardOpTreePass());
+  SPM.addPass(DeLICMPass());
+  SPM.addPass(SimplifyPass(1));
+  SPM.addPass(PruneUnprofitablePass());
+  SPM.addPass(IslScheduleOptimizerPass());
+  SPM.addPass(CodeGenerationPass());
+  FPM.addPass(createFunctionToScopPassAdaptor(std::move(SPM)));
+}
 } // namespace
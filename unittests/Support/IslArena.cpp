@@ -0,0 +1,65 @@
+#include "polly/Support/IslArena.h"
+#include "polly/Support/GICHelper.h"
+#include "gtest/gtest.h"
+#include "isl/ctx.h"
+#include <cstring>
+
+using namespace polly;
+
+TEST(IslArena, SizeClasses) {
+  IslArena Arena;
+
+  // Freed blocks are reused by blocks of the same size class.
+  void *A = Arena.allocate(24);
+  Arena.deallocate(A, 24);
+  void *B = Arena.allocate(30);
+  EXPECT_EQ(A, B);
+
+  // Blocks that stay within their size class are not moved.
+  EXPECT_EQ(B, Arena.reallocate(B, 30, 32));
+  std::memset(B, 7, 32);
+
+  // Blocks that grow beyond MaxSize keep their contents.
+  void *C = Arena.reallocate(B, 32, IslArena::MaxSize + 1);
+  ASSERT_NE(C, nullptr);
+  EXPECT_EQ(static_cast<char *>(C)[31], 7);
+  EXPECT_EQ(Arena.getBytesInUse(), IslArena::MaxSize + 1);
+
+  void *D = Arena.reallocate(C, IslArena::MaxSize + 1, 40);
+  ASSERT_NE(D, nullptr);
+  EXPECT_EQ(static_cast<char *>(D)[31], 7);
+  EXPECT_EQ(Arena.getBytesInUse(), 40u);
+
+  Arena.deallocate(D, 40);
+  EXPECT_EQ(Arena.getBytesInUse(), 0u);
+}
+
+TEST(IslArena, Ctx) {
+  std::shared_ptr<isl_ctx> ArenaCtx = allocIslCtxWithArena();
+  std::unique_ptr<isl_ctx, decltype(&isl_ctx_free)> MallocCtx(isl_ctx_alloc(),
+                                                              &isl_ctx_free);
+
+  const char *Str = "[n] -> { [i, j] : 0 <= i < n and 0 <= j <= i and "
+                    "(i + j) mod 3 = 0 }";
+  isl::set A = isl::set(isl::ctx(ArenaCtx.get()), Str);
+  isl::set B = isl::set(isl::ctx(MallocCtx.get()), Str);
+  EXPECT_EQ(stringFromIslObj(A.coalesce().lexmin().get()),
+            stringFromIslObj(B.coalesce().lexmin().get()));
+
+  const IslArena *Arena = getIslArena(ArenaCtx);
+  ASSERT_NE(Arena, nullptr);
+  EXPECT_GT(Arena->getBytesInUse(), 0u);
+  EXPECT_EQ(getIslArena(std::shared_ptr<isl_ctx>(isl_ctx_alloc(),
+                                                 isl_ctx_free)),
+            nullptr);
+
+  // The allocator cannot be changed while blocks are in use.
+  isl_options_set_on_error(ArenaCtx.get(), ISL_ON_ERROR_CONTINUE);
+  auto Alloc = [](void *, size_t) -> void * { return nullptr; };
+  auto Realloc = [](void *, void *, size_t, size_t) -> void * {
+    return nullptr;
+  };
+  auto Free = [](void *, void *, size_t) {};
+  EXPECT_EQ(isl_stat_error, isl_ctx_set_blk_allocator(ArenaCtx.get(), Alloc,
+                                                      Realloc, Free, nullptr));
+}
@@ -0,0 +1,226 @@
+#! /usr/bin/env python3
+# -*- coding: UTF-8 -*-
+
+# Polly/LLVM generate-scop.py
+# Write an LLVM-IR function that forms a single SCoP whose size is controlled
+# by the command line: the number of statements, arrays and parameters, the
+# depth of the loop nests, the number of conditionally executed statements
+# and the complexity of the array accesses. It is meant to find superlinear
+# compile time in Polly by scaling one of these dimensions at a time (see
+# perf/compile-time/run-scaling.py).
+#
+# Every statement is in its own loop nest:
+#
+#   for (long i0 = 0; i0 < n0; i0++)
+#     ...
+#       for (long iD = 0; iD < nD; iD++)
+#         if (iD <= m)                          // for conditional statements
+#           A3[i0 + 2 * iD + o1] = A1[...] + A0[...] + ...;
+#
+# The loop bounds n<d> and the offsets o<k> of the subscripts are the
+# parameters of the SCoP. The arrays are one-dimensional and are either
+# noalias arguments or, with --may-alias, may alias each other.
+
+import argparse
+import random
+import sys
+
+
+class Function:
+    """Emits the body of an LLVM-IR function."""
+
+    def __init__(self):
+        self.lines = []
+        self.num_values = 0
+
+    def value(self, prefix):
+        self.num_values += 1
+        return '%%%s%d' % (prefix, self.num_values)
+
+    def emit(self, line):
+        self.lines.append('  ' + line)
+
+    def label(self, name):
+        self.lines.append('')
+        self.lines.append(name + ':')
+
+    def linear(self, terms, const=0):
+        """Return the value of sum(coef * value for coef, value in terms) +
+        const."""
+        result = None
+        for coef, val in terms:
+            if coef != 1:
+                prod = self.value('mul')
+                self.emit('%s = mul nsw i64 %s, %d' % (prod, val, coef))
+                val = prod
+            if result is None:
+                result = val
+                continue
+            s = self.value('add')
+            self.emit('%s = add nsw i64 %s, %s' % (s, result, val))
+            result = s
+        if result is None:
+            return str(const)
+        if const != 0:
+            s = self.value('add')
+            self.emit('%s = add nsw i64 %s, %d' % (s, result, const))
+            result = s
+        return result
+
+    def load(self, array, index):
+        ptr = self.value('gep')
+        val = self.value('ld')
+        self.emit('%s = getelementptr inbounds double, double* %s, i64 %s' %
+                  (ptr, array, index))
+        self.emit('%s = load double, double* %s' % (val, ptr))
+        return val
+
+    def store(self, array, index, val):
+        ptr = self.value('gep')
+        self.emit('%s = getelementptr inbounds double, double* %s, i64 %s' %
+                  (ptr, array, index))
+        self.emit('store double %s, double* %s' % (val, ptr))
+
+    def fadd(self, a, b):
+        s = self.value('fadd')
+        self.emit('%s = fadd double %s, %s' % (s, a, b))
+        return s
+
+
+def emit_loop_nest(f, name, bounds, pred, body):
+    """Emit a loop nest with the upper bounds @bounds after the block @pred
+    and call @body with the induction variables in the innermost body.
+    Return the label of the exit block."""
+    ivs = ['%%%s.i%d' % (name, d) for d in range(len(bounds))]
+    for d, bound in enumerate(bounds):
+        header = '%s.loop%d' % (name, d)
+        exit = '%s.inc%d' % (name, d - 1) if d > 0 else name + '.exit'
+        f.emit('br label %' + header)
+        f.label(header)
+        f.emit('%s = phi i64 [ 0, %%%s ], [ %s.next, %%%s.inc%d ]' %
+               (ivs[d], pred, ivs[d], name, d))
+        f.emit('%s.cmp = icmp slt i64 %s, %s' % (ivs[d], ivs[d], bound))
+        f.emit('br i1 %s.cmp, label %%%s.body%d, label %%%s' %
+               (ivs[d], name, d, exit))
+        pred = '%s.body%d' % (name, d)
+        f.label(pred)
+    body(ivs)
+    f.emit('br label %%%s.inc%d' % (name, len(bounds) - 1))
+    for d in reversed(range(len(bounds))):
+        f.label('%s.inc%d' % (name, d))
+        f.emit('%s.next = add nuw nsw i64 %s, 1' % (ivs[d], ivs[d]))
+        f.emit('br label %%%s.loop%d' % (name, d))
+    f.label(name + '.exit')
+    return name + '.exit'
+
+
+def generate(args):
+    rng = random.Random(args.seed)
+    f = Function()
+
+    # The first parameters are the loop bounds, the others are offsets in the
+    # subscripts and the bounds of the conditions.
+    params = ['%%p%d' % p for p in range(args.parameters)]
+    bound_params = params[:args.depth]
+    other_params = params[args.depth:]
+    bounds = [bound_params[d] if d < len(bound_params) else str(args.size)
+              for d in range(args.depth)]
+    arrays = ['%%A%d' % a for a in range(args.arrays)]
+    conditional = set(rng.sample(range(args.statements),
+                                 min(args.conditionals, args.statements)))
+
+    def subscript(ivs):
+        # A sum of @args.terms induction variables with small coefficients
+        # plus a parameter offset, if there are parameters left.
+        terms = [(rng.randint(1, 3), iv)
+                 for iv in rng.sample(ivs, min(args.terms, len(ivs)))]
+        if other_params:
+            terms.append((1, rng.choice(other_params)))
+        return f.linear(terms, rng.randint(0, 2))
+
+    pred = 'entry'
+    for s in range(args.statements):
+        name = 'S%d' % s
+
+        def body(ivs, s=s, name=name):
+            if s in conditional:
+                limit = rng.choice(other_params) if other_params else str(
+                    args.size // 2)
+                cond = f.value('cond')
+                f.emit('%s = icmp sle i64 %s, %s' % (cond, ivs[-1], limit))
+                f.emit('br i1 %s, label %%%s.then, label %%%s.inc%d' %
+                       (cond, name, name, len(ivs) - 1))
+                f.label(name + '.then')
+            val = None
+            for _ in range(args.reads):
+                ld = f.load(rng.choice(arrays), subscript(ivs))
+                val = ld if val is None else f.fadd(val, ld)
+            if val is None:
+                val = '1.000000e+00'
+            f.store(arrays[s % len(arrays)], subscript(ivs), val)
+
+        pred = emit_loop_nest(f, name, bounds, pred, body)
+    f.emit('ret void')
+
+    noalias = '' if args.may_alias else 'noalias '
+    signature = ['i64 ' + p for p in params] + [
+        'double* %s%s' % (noalias, a) for a in arrays]
+    out = ['; Generated by utils/generate-scop.py ' + ' '.join(sys.argv[1:]),
+           '',
+           'target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"',
+           '',
+           'define void @%s(%s) {' % (args.function, ', '.join(signature)),
+           'entry:']
+    out += f.lines
+    out.append('}')
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Generate an LLVM-IR SCoP of a given size')
+    parser.add_argument('--statements', type=int, default=1,
+                        help='the number of statements (loop nests)')
+    parser.add_argument('--arrays', type=int, default=2,
+                        help='the number of arrays')
+    parser.add_argument('--parameters', type=int, default=1,
+                        help='the number of parameters; the first DEPTH are '
+                        'loop bounds, the others subscript offsets and '
+                        'condition bounds')
+    parser.add_argument('--depth', type=int, default=1,
+                        help='the depth of the loop nests')
+    parser.add_argument('--conditionals', type=int, default=0,
+                        help='the number of statements executed under a '
+                        'condition')
+    parser.add_argument('--reads', type=int, default=2,
+                        help='the number of reads per statement')
+    parser.add_argument('--terms', type=int, default=1,
+                        help='the number of induction variables in every '
+                        'subscript')
+    parser.add_argument('--size', type=int, default=1024,
+                        help='the constant loop bound used when there are '
+                        'fewer parameters than loops')
+    parser.add_argument('--may-alias', action='store_true',
+                        help='do not mark the arrays noalias, such that run-'
+                        'time alias checks are needed')
+    parser.add_argument('--seed', type=int, default=0,
+                        help='the seed for choosing arrays and subscripts')
+    parser.add_argument('--function', default='f',
+                        help='the name of the generated function')
+    parser.add_argument('-o', '--output', default='-',
+                        help='the file to write the IR to')
+    args = parser.parse_args()
+    if args.statements < 1 or args.arrays < 1 or args.depth < 1:
+        parser.error('there must be at least one statement, array and loop')
+
+    ir = generate(args)
+    if args.output == '-':
+        sys.stdout.write(ir)
+    else:
+        with open(args.output, 'w') as f:
+            f.write(ir)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())